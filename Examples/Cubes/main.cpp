@@ -18,6 +18,7 @@
 #include <Skyrocket/Graphics/Renderer/Vertex.hpp>
 #include <Skyrocket/Input/Keyboard.hpp>
 #include <Skyrocket/Resource/Font.hpp>
+#include <Skyrocket/Resource/ResourceManager.hpp>
 
 #include <Skyrocket/Framework/Application.hpp>
 
@@ -59,6 +60,13 @@ private:
 
 };
 
+/// A texture along with the image it was uploaded from, which is kept alive until the upload
+/// commands have been processed
+struct TextureResource {
+    sky::Image image;
+    uint32_t texture{0};
+};
+
 class CubeApp : public sky::Application {
 public:
     CubeApp()
@@ -159,11 +167,22 @@ public:
         auto cam_speed = 10.0f;
         auto target_frametime = 16.6;
 
-        sky::Image img;
-        img.load_from_file(common::get_image(resinfo_, "cube.png"));
+        // The cube texture streams in on the job workers and a plain white texture is drawn
+        // until it's ready
+        uint8_t white[] = { 255, 255, 255, 255 };
+        placeholder_.texture = cmdlist.create_texture(1, 1, sky::PixelFormat::Enum::rgba8);
+        cmdlist.create_texture_region(placeholder_.texture, sky::UIntRect(0, 0, 1, 1),
+                                      sky::PixelFormat::Enum::rgba8, white);
+
+        sky::ResourceLoader texture_loader;
+        texture_loader.load = load_texture;
+        texture_loader.finalize = upload_texture;
+        texture_loader.unload = unload_texture;
+        texture_loader.placeholder = &placeholder_;
+        texture_loader.user_data = this;
 
-        texture_ = cmdlist.create_texture(img.width, img.height, img.pixel_format);
-        cmdlist.create_texture_region(texture_, sky::UIntRect(0, 0, img.width, img.height), img.pixel_format, img.data);
+        auto texture_type = resources_.register_type(texture_loader);
+        texture_ = resources_.load(texture_type, common::get_image(resinfo_, "cube.png"));
 
         renderer.submit(cmdlist);
         renderer.commit_frame();
@@ -191,6 +210,10 @@ public:
 
         auto cmdlist = renderer.make_command_list();
 
+        upload_cmdlist_ = &cmdlist;
+        resources_.update();
+        upload_cmdlist_ = nullptr;
+
         cmdlist.set_state(sky::RenderPipelineState::culling_backface);
         cmdlist.set_program(program_);
 
@@ -200,7 +223,7 @@ public:
         cmdlist.set_vertex_buffer(vbuf_id_, 0, static_cast<uint32_t>(vertices_.size()));
         cmdlist.set_instance_buffer(model_ubuf_, modelpos);
         cmdlist.set_uniform(view_proj_ubuf_, viewpos);
-        cmdlist.set_texture(texture_, 0);
+        cmdlist.set_texture(resources_.get<TextureResource>(texture_)->texture, 0);
 
         cam_.move(cam_movement * cam_speed_ * static_cast<float>(dt));
 
@@ -233,7 +256,7 @@ public:
 
     void on_shutdown() override
     {
-
+        resources_.release(texture_);
     }
 
 private:
@@ -253,6 +276,44 @@ private:
     float cam_speed_{2.0f};
 
     uint32_t program_{}, vbuf_id_{}, model_ubuf_{}, view_proj_ubuf_{}, texture_{};
+
+    sky::ResourceManager resources_;
+    sky::CommandList* upload_cmdlist_{nullptr};
+    TextureResource placeholder_;
+
+    static void* load_texture(const sky::Path& path, void* /*user_data*/)
+    {
+        auto resource = new TextureResource;
+        if ( !resource->image.load_from_file(path) || !resource->image.generate_mipmaps() ) {
+            delete resource;
+            return nullptr;
+        }
+
+        return resource;
+    }
+
+    static bool upload_texture(void* data, void* user_data)
+    {
+        auto cmdlist = static_cast<CubeApp*>(user_data)->upload_cmdlist_;
+        auto& img = static_cast<TextureResource*>(data)->image;
+
+        auto texture = cmdlist->create_texture(img.width, img.height, img.pixel_format,
+                                               img.mip_levels > 1);
+        for ( uint32_t level = 0; level < img.mip_levels; ++level ) {
+            sky::UIntRect region(0, 0, img.level_width(level), img.level_height(level));
+            cmdlist->create_texture_region(texture, region, img.pixel_format,
+                                           img.level_data(level), level);
+        }
+
+        static_cast<TextureResource*>(data)->texture = texture;
+        return true;
+    }
+
+    static void unload_texture(void* data, const bool /*finalized*/, void* /*user_data*/)
+    {
+        // The renderer can't destroy textures yet so only the CPU copy is freed
+        delete static_cast<TextureResource*>(data);
+    }
     std::vector<sky::Vertex> vertices_;
     std::array<Cube, num_cubes_> cubes;
 };
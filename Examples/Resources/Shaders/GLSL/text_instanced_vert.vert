@@ -0,0 +1,21 @@
+#version 330 core
+
+layout (location = 0) in vec4 position;
+layout (location = 1) in vec4 color;
+layout (location = 2) in vec2 tex;
+// Columns are the glyphs position rect, atlas rect and color
+layout (location = 3) in mat3x4 sky_instance__glyph;
+
+out vec4 frag_color;
+out vec2 frag_tex;
+
+uniform mat4 viewproj;
+
+void main() {
+    vec4 rect = sky_instance__glyph[0];
+    vec4 uv = sky_instance__glyph[1];
+
+    frag_color = sky_instance__glyph[2];
+    frag_tex = mix(uv.xy, uv.zw, tex);
+	gl_Position = viewproj * vec4(rect.xy + position.xy * rect.zw, position.zw);
+}
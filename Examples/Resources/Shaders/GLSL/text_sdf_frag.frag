@@ -0,0 +1,17 @@
+#version 330 core
+
+in vec4 frag_color;
+in vec2 frag_tex;
+
+out vec4 color_out;
+
+uniform sampler2D text_texture;
+
+void main() {
+    // The glyph edge is at 0.5 in the distance field. Smoothing over the distance covered by one
+    // screen pixel keeps edges sharp at any scale
+    float distance = texture(text_texture, frag_tex).r;
+    float smoothing = clamp(fwidth(distance) * 0.75, 1.0 / 255.0, 0.5);
+    float alpha = smoothstep(0.5 - smoothing, 0.5 + smoothing, distance);
+    color_out = vec4(frag_color.rgb, frag_color.a * alpha);
+}
@@ -0,0 +1,32 @@
+#include <metal_stdlib>
+
+using namespace metal;
+
+struct Vertex {
+    float4 position [[position]];
+    float4 color;
+    float2 tex_coords;
+};
+
+struct GlyphInstance {
+    float4 rect;
+    float4 uv;
+    float4 color;
+};
+
+vertex Vertex text_instanced_vert(device Vertex* vertices [[buffer(0)]],
+                                  constant GlyphInstance* glyphs [[buffer(1)]],
+                                  constant float4x4& viewproj [[buffer(2)]],
+                                  uint vid [[vertex_id]],
+                                  uint iid [[instance_id]])
+{
+    auto glyph = glyphs[iid];
+    auto corner = vertices[vid];
+
+    Vertex out;
+    out.position = viewproj * float4(glyph.rect.xy + corner.position.xy * glyph.rect.zw,
+                                     corner.position.zw);
+    out.color = glyph.color;
+    out.tex_coords = mix(glyph.uv.xy, glyph.uv.zw, corner.tex_coords);
+    return out;
+}
@@ -0,0 +1,23 @@
+#include <metal_stdlib>
+
+using namespace metal;
+
+struct Vertex {
+    float4 position [[position]];
+    float4 color;
+    float2 tex_coords;
+};
+
+
+fragment half4 text_sdf_frag(Vertex in [[stage_in]],
+                             texture2d<float> texture [[texture(0)]])
+{
+    constexpr sampler s(filter::linear);
+
+    // The glyph edge is at 0.5 in the distance field. Smoothing over the distance covered by one
+    // screen pixel keeps edges sharp at any scale
+    const float distance = texture.sample(s, in.tex_coords).r;
+    const float smoothing = clamp(fwidth(distance) * 0.75f, 1.0f / 255.0f, 0.5f);
+    const float alpha = smoothstep(0.5f - smoothing, 0.5f + smoothing, distance);
+    return half4(in.color.r, in.color.g, in.color.b, in.color.a * alpha);
+}
@@ -22,7 +22,11 @@ class TextApplication : public sky::Application {
 public:
     TextApplication()
         : Application("Skyrocket Text Rendering Example"),
-          tb_(&renderer, &font_),
+          batch_(&renderer, &font_),
+          sdf_batch_(&renderer, &sdf_font_),
+          tb_(&batch_),
+          help_tb_(&batch_),
+          sdf_tb_(&sdf_batch_),
           cam_speed_(4.5f),
           program_(0),
           viewproj_(0)
@@ -34,13 +38,20 @@ public:
     {
         auto cmdlist = renderer.make_command_list();
 
-        tb_.init();
+        batch_.init();
 
-        auto vert_path = common::get_vertex_shader(resinfo_, "text_basic_vert");
+        auto vert_path = common::get_vertex_shader(resinfo_, "text_instanced_vert");
         auto frag_path = common::get_fragment_shader(resinfo_, "text_basic_frag");
         program_ = cmdlist.create_program(vert_path, frag_path);
 
-        tb_.set_program(program_);
+        batch_.set_program(program_);
+
+        // Distance field text is drawn at several sizes from a single atlas
+        sdf_batch_.init();
+        sdf_program_ = cmdlist.create_program(
+            vert_path, common::get_fragment_shader(resinfo_, "text_sdf_frag")
+        );
+        sdf_batch_.set_program(sdf_program_);
 
         viewproj_ = cmdlist.create_uniform(sky::UniformType::mat4, sizeof(sky::Matrix4f));
 
@@ -55,9 +66,28 @@ public:
         cam_.setup(primary_view.size(), 0.1f, 1000.0f);
         cam_.set_position({0.0f, 0.0f});
 
-        font_.load_from_file(common::get_font(resinfo_, "Go-Regular.ttf"), font_size);
+        font_.load_from_file(common::get_font(resinfo_, "Go-Regular.ttf"),
+                            static_cast<uint32_t>(font_size));
+        sdf_font_.load_from_file(common::get_font(resinfo_, "Go-Regular.ttf"),
+                                 static_cast<uint32_t>(sdf_font_size), sky::Font::default_atlas_size,
+                                 sky::GlyphRenderMode::distance_field);
+
+        uint32_t ascii[127 - 32];
+        for (uint32_t c = 32; c < 127; ++c) {
+            ascii[c - 32] = c;
+        }
+
+        // Glyphs baked on a previous run are restored without touching FreeType
+        auto cache_path = font_.atlas_cache_path(sky::Path::executable_path().parent());
+        if (!font_.load_atlas_cache(cache_path)) {
+            font_.preload_glyphs(ascii, 127 - 32);
+            font_.save_atlas_cache(cache_path);
+        }
+
+        sdf_font_.preload_glyphs(ascii, 127 - 32);
+        sdf_tb_.set_color(sky::Color(255, 200, 80));
 
-        textpos_ = sky::Vector3f(10.0f, primary_view.size().y - (font_size + 10.0f), 1.0f);
+        textpos_ = sky::Vector2f(10.0f, primary_view.size().y - (font_size + 10.0f));
 
         create_graphics_resources();
 
@@ -101,8 +131,15 @@ public:
                  4, frame.cpu_time,
                  4, frame.gpu_time);
 
+        // Strings in the same batch are drawn together and are only laid out again if they change
         tb_.set_text(dtbuffer, strlen(dtbuffer), textpos_);
 
+        const char* help_text = "Press space to switch backends";
+        help_tb_.set_text(help_text, strlen(help_text), sky::Vector2f(10.0f, 120.0f));
+
+        const char* sdf_text = "Distance field text";
+        sdf_tb_.set_text(sdf_text, strlen(sdf_text), sky::Vector2f(10.0f, 40.0f));
+
         cam_mat_ = cam_.get_matrix();
 
         auto cmdlist = renderer.make_command_list();
@@ -114,7 +151,8 @@ public:
 
         renderer.submit(cmdlist);
 
-        tb_.submit(viewproj_);
+        batch_.submit(viewproj_);
+        sdf_batch_.submit(viewproj_);
 
         cmdlist = renderer.make_command_list();
 
@@ -140,19 +178,26 @@ public:
 
 private:
     static constexpr float font_size = 16.0f;
+    static constexpr float sdf_font_size = 64.0f;
 
     sky::Keyboard keyboard_;
     sky::Font font_;
+    sky::Font sdf_font_;
     common::ResourceInfo resinfo_;
 
     uint32_t program_, viewproj_;
+    uint32_t sdf_program_{0};
 
+    sky::TextBatch batch_;
+    sky::TextBatch sdf_batch_;
     sky::TextBuffer tb_;
+    sky::TextBuffer help_tb_;
+    sky::TextBuffer sdf_tb_;
 
     sky::Camera2D cam_;
     float cam_speed_;
     sky::Matrix4f cam_mat_;
-    sky::Vector3f textpos_;
+    sky::Vector2f textpos_;
 };
 
 int main(int argc, const char** argv)
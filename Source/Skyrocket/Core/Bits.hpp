@@ -0,0 +1,67 @@
+//
+//  Bits.hpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#pragma once
+
+#include "Skyrocket/Core/Config.hpp"
+
+#include <cstdint>
+
+#if SKY_COMPILER_MSVC == 1
+#include <intrin.h>
+#endif
+
+namespace sky {
+
+
+/// @brief Gets the index of the lowest set bit in `value`, which must not be zero
+SKY_FORCE_INLINE uint32_t count_trailing_zeros(const uint32_t value)
+{
+#if SKY_COMPILER_MSVC == 1
+    unsigned long index = 0;
+    _BitScanForward(&index, value);
+    return static_cast<uint32_t>(index);
+#else
+    return static_cast<uint32_t>(__builtin_ctz(value));
+#endif
+}
+
+/// @brief Gets the index of the lowest set bit in `value`, which must not be zero
+SKY_FORCE_INLINE uint32_t count_trailing_zeros(const uint64_t value)
+{
+#if SKY_COMPILER_MSVC == 1
+    unsigned long index = 0;
+    _BitScanForward64(&index, value);
+    return static_cast<uint32_t>(index);
+#else
+    return static_cast<uint32_t>(__builtin_ctzll(value));
+#endif
+}
+
+/// @brief Counts the number of set bits in `value`
+SKY_FORCE_INLINE uint32_t popcount(uint64_t value)
+{
+#if SKY_COMPILER_MSVC == 1 && SKY_SIMD_AVX2 == 1
+    return static_cast<uint32_t>(__popcnt64(value));
+#elif SKY_COMPILER_MSVC == 1
+    // The popcnt instruction isn't guaranteed without AVX2 so MSVC falls back to counting in
+    // parallel within the word
+    value -= (value >> 1) & 0x5555555555555555ULL;
+    value = (value & 0x3333333333333333ULL) + ((value >> 2) & 0x3333333333333333ULL);
+    value = (value + (value >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    return static_cast<uint32_t>((value * 0x0101010101010101ULL) >> 56);
+#else
+    return static_cast<uint32_t>(__builtin_popcountll(value));
+#endif
+}
+
+
+} // namespace sky
@@ -0,0 +1,563 @@
+//
+//  Compression.cpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#include "Skyrocket/Core/Compression.hpp"
+#include "Skyrocket/Platform/Jobs.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace sky {
+namespace lz {
+
+
+static constexpr size_t min_match = 4;
+/// The format requires the last 5 bytes of a block to be literals and the last match to start at
+/// least 12 bytes before the end, which lets the decoder copy in whole 16 byte chunks
+static constexpr size_t last_literals = 5;
+static constexpr size_t match_find_limit = 12;
+static constexpr size_t max_offset = 65535;
+static constexpr uint32_t hash_log = 12;
+static constexpr size_t max_block_size = raw_block_flag - 1;
+
+static inline uint32_t read32(const uint8_t* ptr)
+{
+    uint32_t value = 0;
+    memcpy(&value, ptr, sizeof(uint32_t));
+    return value;
+}
+
+static inline uint64_t read64(const uint8_t* ptr)
+{
+    uint64_t value = 0;
+    memcpy(&value, ptr, sizeof(uint64_t));
+    return value;
+}
+
+static inline uint32_t hash4(const uint32_t value)
+{
+    return (value * 2654435761u) >> (32 - hash_log);
+}
+
+static size_t count_match(const uint8_t* ip, const uint8_t* ref, const uint8_t* limit)
+{
+    auto start = ip;
+
+    while ( ip + sizeof(uint64_t) <= limit && read64(ip) == read64(ref) ) {
+        ip += sizeof(uint64_t);
+        ref += sizeof(uint64_t);
+    }
+
+    while ( ip < limit && *ip == *ref ) {
+        ++ip;
+        ++ref;
+    }
+
+    return static_cast<size_t>(ip - start);
+}
+
+/// Gets the number of bytes needed to extend a 4-bit length nibble to `length`
+static inline size_t length_bytes(const size_t length)
+{
+    return length >= 15 ? (length - 15) / 255 + 1 : 0;
+}
+
+static inline uint8_t* write_length(uint8_t* op, size_t length)
+{
+    length -= 15;
+    while ( length >= 255 ) {
+        *op++ = 255;
+        length -= 255;
+    }
+    *op++ = static_cast<uint8_t>(length);
+    return op;
+}
+
+/// Writes a sequence of literals followed by a match, or just literals if `match_length` is 0 for
+/// the last sequence in a block. Returns nullptr if the sequence doesn't fit
+static uint8_t* write_sequence(uint8_t* op, const uint8_t* op_end, const uint8_t* literals,
+                               const size_t literal_length, const size_t offset,
+                               const size_t match_length)
+{
+    const auto match_code = match_length > 0 ? match_length - min_match : 0;
+    auto required = 1 + length_bytes(literal_length) + literal_length;
+    if ( match_length > 0 ) {
+        required += 2 + length_bytes(match_code);
+    }
+
+    if ( required > static_cast<size_t>(op_end - op) ) {
+        return nullptr;
+    }
+
+    auto token = op++;
+    *token = static_cast<uint8_t>(std::min<size_t>(literal_length, 15) << 4);
+    if ( literal_length >= 15 ) {
+        op = write_length(op, literal_length);
+    }
+
+    if ( literal_length > 0 ) {
+        memcpy(op, literals, literal_length);
+        op += literal_length;
+    }
+
+    if ( match_length == 0 ) {
+        return op;
+    }
+
+    *op++ = static_cast<uint8_t>(offset & 0xFF);
+    *op++ = static_cast<uint8_t>(offset >> 8);
+
+    *token |= static_cast<uint8_t>(std::min<size_t>(match_code, 15));
+    if ( match_code >= 15 ) {
+        op = write_length(op, match_code);
+    }
+
+    return op;
+}
+
+/// Copies in 16 byte chunks, which compile to single unaligned vector moves, writing up to 15
+/// bytes past `dest + size`
+static inline void wild_copy(uint8_t* dest, const uint8_t* src, const size_t size)
+{
+    auto end = dest + size;
+    do {
+        memcpy(dest, src, 16);
+        dest += 16;
+        src += 16;
+    } while ( dest < end );
+}
+
+/// Reads the extension bytes of a literal or match length
+static inline bool read_length(const uint8_t** ip, const uint8_t* ip_end, size_t* length)
+{
+    uint8_t byte = 0;
+    do {
+        if ( *ip >= ip_end ) {
+            return false;
+        }
+        byte = *(*ip)++;
+        *length += byte;
+    } while ( byte == 255 );
+
+    return true;
+}
+
+size_t compress_bound(const size_t size)
+{
+    return size + size / 255 + 16;
+}
+
+size_t compress(const uint8_t* src, const size_t size, uint8_t* dest, const size_t capacity)
+{
+    auto op = dest;
+    auto op_end = dest + capacity;
+    auto anchor = src;
+    auto end = src + size;
+
+    if ( size > match_find_limit ) {
+        // Positions are stored relative to `src` and every candidate is verified so stale or
+        // zeroed entries only cost a missed match
+        uint32_t table[1u << hash_log];
+        memset(table, 0, sizeof(table));
+
+        const auto match_limit = end - match_find_limit;
+        const auto match_end = end - last_literals;
+        auto ip = src + 1;
+
+        while ( ip < match_limit ) {
+            const uint8_t* ref = nullptr;
+            uint32_t attempts = 0;
+
+            // Skip ahead faster the longer no match is found so incompressible data stays fast
+            for ( ; ip < match_limit; ip += 1 + (attempts++ >> 6) ) {
+                auto h = hash4(read32(ip));
+                ref = src + table[h];
+                table[h] = static_cast<uint32_t>(ip - src);
+
+                if ( static_cast<size_t>(ip - ref) <= max_offset && read32(ref) == read32(ip) ) {
+                    break;
+                }
+            }
+
+            if ( ip >= match_limit ) {
+                break;
+            }
+
+            while ( ip > anchor && ref > src && ip[-1] == ref[-1] ) {
+                --ip;
+                --ref;
+            }
+
+            auto match_length = min_match + count_match(ip + min_match, ref + min_match, match_end);
+            op = write_sequence(op, op_end, anchor, static_cast<size_t>(ip - anchor),
+                                static_cast<size_t>(ip - ref), match_length);
+            if ( op == nullptr ) {
+                return 0;
+            }
+
+            ip += match_length;
+            anchor = ip;
+
+            if ( ip < match_limit ) {
+                table[hash4(read32(ip - 2))] = static_cast<uint32_t>(ip - 2 - src);
+            }
+        }
+    }
+
+    op = write_sequence(op, op_end, anchor, static_cast<size_t>(end - anchor), 0, 0);
+    return op != nullptr ? static_cast<size_t>(op - dest) : 0;
+}
+
+bool decompress(const uint8_t* src, const size_t compressed_size, uint8_t* dest,
+                const size_t size)
+{
+    auto ip = src;
+    auto ip_end = src + compressed_size;
+    auto op = dest;
+    auto op_end = dest + size;
+
+    while ( ip < ip_end ) {
+        auto token = *ip++;
+
+        size_t literal_length = token >> 4;
+        if ( literal_length == 15 && !read_length(&ip, ip_end, &literal_length) ) {
+            return false;
+        }
+
+        if ( literal_length > static_cast<size_t>(ip_end - ip)
+            || literal_length > static_cast<size_t>(op_end - op) ) {
+            return false;
+        }
+
+        if ( static_cast<size_t>(ip_end - ip) >= literal_length + 16
+            && static_cast<size_t>(op_end - op) >= literal_length + 16 ) {
+            wild_copy(op, ip, literal_length);
+        } else if ( literal_length > 0 ) {
+            memcpy(op, ip, literal_length);
+        }
+
+        ip += literal_length;
+        op += literal_length;
+
+        // Only the last sequence ends without a match
+        if ( ip == ip_end ) {
+            return op == op_end;
+        }
+
+        if ( ip_end - ip < 2 ) {
+            return false;
+        }
+
+        auto offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+        ip += 2;
+
+        if ( offset == 0 || offset > static_cast<size_t>(op - dest) ) {
+            return false;
+        }
+
+        size_t match_length = token & 0x0F;
+        if ( match_length == 15 && !read_length(&ip, ip_end, &match_length) ) {
+            return false;
+        }
+
+        match_length += min_match;
+        if ( match_length > static_cast<size_t>(op_end - op) ) {
+            return false;
+        }
+
+        auto match = op - offset;
+
+        // Chunks never overlap the bytes they're copying from once the offset is at least 16
+        if ( offset >= 16 && static_cast<size_t>(op_end - op) >= match_length + 16 ) {
+            wild_copy(op, match, match_length);
+            op += match_length;
+        } else {
+            for ( size_t i = 0; i < match_length; ++i ) {
+                *op++ = *match++;
+            }
+        }
+    }
+
+    return size == 0 && compressed_size == 0;
+}
+
+//==========================================
+//  Frames
+//==========================================
+
+static size_t frame_block_size(const size_t block_size)
+{
+    return block_size == 0 ? default_block_size : std::min(block_size, max_block_size);
+}
+
+/// Compresses a block into `dest`, which must hold a BlockHeader and `size` bytes, storing it
+/// uncompressed if it doesn't shrink. Returns the size written including the header
+static size_t write_block(const uint8_t* src, const size_t size, uint8_t* dest)
+{
+    BlockHeader header{};
+    header.size = static_cast<uint32_t>(size);
+
+    auto payload = dest + sizeof(BlockHeader);
+    auto compressed_size = compress(src, size, payload, size > 0 ? size - 1 : 0);
+
+    if ( compressed_size == 0 ) {
+        memcpy(payload, src, size);
+        header.compressed_size = static_cast<uint32_t>(size) | raw_block_flag;
+        compressed_size = size;
+    } else {
+        header.compressed_size = static_cast<uint32_t>(compressed_size);
+    }
+
+    memcpy(dest, &header, sizeof(BlockHeader));
+    return sizeof(BlockHeader) + compressed_size;
+}
+
+static bool read_block(const uint8_t* src, const BlockHeader& header, uint8_t* dest)
+{
+    if ( (header.compressed_size & raw_block_flag) != 0 ) {
+        memcpy(dest, src, header.size);
+        return true;
+    }
+
+    return decompress(src, header.compressed_size, dest, header.size);
+}
+
+/// Validates a block header and gets its payload size
+static bool block_payload_size(const BlockHeader& header, size_t* payload_size)
+{
+    auto compressed_size = header.compressed_size & ~raw_block_flag;
+    auto raw = (header.compressed_size & raw_block_flag) != 0;
+
+    if ( header.size > max_block_size || (raw && compressed_size != header.size) ) {
+        return false;
+    }
+
+    *payload_size = compressed_size;
+    return true;
+}
+
+struct FrameCompressJob {
+    const uint8_t* src;
+    size_t size;
+    uint8_t* dest;
+    size_t block_size;
+    size_t* written;
+};
+
+static void compress_frame_blocks(const uint32_t begin, const uint32_t end, void* user_data)
+{
+    auto job = static_cast<FrameCompressJob*>(user_data);
+
+    for ( uint32_t b = begin; b < end; ++b ) {
+        auto offset = static_cast<size_t>(b) * job->block_size;
+        auto size = std::min(job->block_size, job->size - offset);
+        auto slot = job->dest + static_cast<size_t>(b) * (sizeof(BlockHeader) + job->block_size);
+        job->written[b] = write_block(job->src + offset, size, slot);
+    }
+}
+
+size_t frame_bound(const size_t size, const size_t block_size)
+{
+    auto bs = frame_block_size(block_size);
+    auto blocks = (size + bs - 1) / bs;
+    return size + blocks * sizeof(BlockHeader);
+}
+
+size_t compress_frame(const uint8_t* src, const size_t size, uint8_t* dest, const size_t capacity,
+                      const size_t block_size)
+{
+    auto bs = frame_block_size(block_size);
+    if ( capacity < frame_bound(size, bs) ) {
+        return 0;
+    }
+
+    auto blocks = (size + bs - 1) / bs;
+    std::vector<size_t> written(blocks);
+
+    // Every block is compressed into its worst case slot so they can run independently, then
+    // the frame is compacted. Blocks only ever move towards the start of the frame
+    FrameCompressJob job { src, size, dest, bs, written.data() };
+    jobs::parallel_for(static_cast<uint32_t>(blocks), 1, compress_frame_blocks, &job);
+
+    size_t frame_size = 0;
+    for ( size_t b = 0; b < blocks; ++b ) {
+        auto slot = dest + b * (sizeof(BlockHeader) + bs);
+        if ( dest + frame_size != slot ) {
+            memmove(dest + frame_size, slot, written[b]);
+        }
+        frame_size += written[b];
+    }
+
+    return frame_size;
+}
+
+struct FrameBlock {
+    const uint8_t* src;
+    BlockHeader header;
+    uint8_t* dest;
+};
+
+struct FrameDecompressJob {
+    const FrameBlock* blocks;
+    std::atomic<bool> failed;
+};
+
+static void decompress_frame_blocks(const uint32_t begin, const uint32_t end, void* user_data)
+{
+    auto job = static_cast<FrameDecompressJob*>(user_data);
+
+    for ( uint32_t b = begin; b < end; ++b ) {
+        const auto& block = job->blocks[b];
+        if ( !read_block(block.src, block.header, block.dest) ) {
+            job->failed = true;
+            return;
+        }
+    }
+}
+
+bool decompress_frame(const uint8_t* src, const size_t frame_size, uint8_t* dest,
+                      const size_t size)
+{
+    std::vector<FrameBlock> blocks;
+    size_t offset = 0;
+    size_t dest_offset = 0;
+
+    // Headers are walked first so every block's source and destination are known up front
+    while ( offset < frame_size ) {
+        FrameBlock block{};
+        size_t payload_size = 0;
+
+        if ( frame_size - offset < sizeof(BlockHeader) ) {
+            return false;
+        }
+
+        memcpy(&block.header, src + offset, sizeof(BlockHeader));
+        offset += sizeof(BlockHeader);
+
+        if ( !block_payload_size(block.header, &payload_size)
+            || payload_size > frame_size - offset || block.header.size > size - dest_offset ) {
+            return false;
+        }
+
+        block.src = src + offset;
+        block.dest = dest + dest_offset;
+        blocks.push_back(block);
+
+        offset += payload_size;
+        dest_offset += block.header.size;
+    }
+
+    if ( dest_offset != size ) {
+        return false;
+    }
+
+    FrameDecompressJob job{};
+    job.blocks = blocks.data();
+    job.failed = false;
+    jobs::parallel_for(static_cast<uint32_t>(blocks.size()), 1, decompress_frame_blocks, &job);
+
+    return !job.failed;
+}
+
+//==========================================
+//  Streams
+//==========================================
+
+StreamEncoder::StreamEncoder(const size_t block_size)
+    : block_size_(frame_block_size(block_size))
+{
+    block_.reserve(block_size_);
+}
+
+void StreamEncoder::write(const void* data, size_t size)
+{
+    auto bytes = static_cast<const uint8_t*>(data);
+
+    while ( size > 0 ) {
+        auto count = std::min(size, block_size_ - block_.size());
+        block_.insert(block_.end(), bytes, bytes + count);
+        bytes += count;
+        size -= count;
+
+        if ( block_.size() == block_size_ ) {
+            compress_block();
+        }
+    }
+}
+
+void StreamEncoder::flush()
+{
+    if ( !block_.empty() ) {
+        compress_block();
+    }
+}
+
+void StreamEncoder::compress_block()
+{
+    auto offset = output_.size();
+    output_.resize(offset + sizeof(BlockHeader) + block_.size());
+    auto written = write_block(block_.data(), block_.size(), output_.data() + offset);
+    output_.resize(offset + written);
+    block_.clear();
+}
+
+bool StreamDecoder::write(const void* data, const size_t size)
+{
+    if ( corrupt_ ) {
+        return false;
+    }
+
+    auto bytes = static_cast<const uint8_t*>(data);
+    input_.insert(input_.end(), bytes, bytes + size);
+
+    size_t offset = 0;
+    while ( input_.size() - offset >= sizeof(BlockHeader) ) {
+        BlockHeader header{};
+        size_t payload_size = 0;
+        memcpy(&header, input_.data() + offset, sizeof(BlockHeader));
+
+        if ( !block_payload_size(header, &payload_size) ) {
+            corrupt_ = true;
+            return false;
+        }
+
+        if ( input_.size() - offset - sizeof(BlockHeader) < payload_size ) {
+            break;
+        }
+
+        auto dest_offset = output_.size();
+        output_.resize(dest_offset + header.size);
+
+        if ( !read_block(input_.data() + offset + sizeof(BlockHeader), header,
+                         output_.data() + dest_offset) ) {
+            output_.resize(dest_offset);
+            corrupt_ = true;
+            return false;
+        }
+
+        offset += sizeof(BlockHeader) + payload_size;
+    }
+
+    input_.erase(input_.begin(), input_.begin() + offset);
+    return true;
+}
+
+void StreamDecoder::reset()
+{
+    input_.clear();
+    output_.clear();
+    corrupt_ = false;
+}
+
+
+} // namespace lz
+} // namespace sky
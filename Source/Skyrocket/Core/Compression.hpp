@@ -0,0 +1,133 @@
+//
+//  Compression.hpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sky {
+
+/// @brief Fast LZ77 block compression using the LZ4 block format. Compression ratios are modest
+/// but decompression runs at memory speed so it's suited to assets and captures that are read far
+/// more often than they're written.
+///
+/// Frames split larger data into independent blocks, each prefixed with a BlockHeader, so blocks
+/// can be compressed and decompressed in parallel or streamed through a StreamEncoder and
+/// StreamDecoder
+namespace lz {
+
+
+constexpr size_t default_block_size = 64 * 1024;
+
+/// Set in `BlockHeader::compressed_size` for blocks that didn't compress and are stored as is
+constexpr uint32_t raw_block_flag = 0x80000000;
+
+struct BlockHeader {
+    uint32_t compressed_size;
+    uint32_t size;
+};
+
+/// @brief Gets the largest possible compressed size of a `size` byte block
+size_t compress_bound(size_t size);
+
+/// @brief Compresses a block of data into `dest`.
+/// @return The compressed size, or 0 if it didn't fit in `capacity` bytes. Compression never
+/// fails if `capacity` is at least `compress_bound(size)`
+size_t compress(const uint8_t* src, size_t size, uint8_t* dest, size_t capacity);
+
+/// @brief Decompresses a block compressed with `compress`. `size` must be exactly the
+/// block's original size.
+/// @return false if the compressed data is corrupt
+bool decompress(const uint8_t* src, size_t compressed_size, uint8_t* dest, size_t size);
+
+/// @brief Gets the largest possible size of a frame compressed from `size` bytes
+size_t frame_bound(size_t size, size_t block_size = default_block_size);
+
+/// @brief Compresses data into a frame of independent blocks, compressed in parallel on the job
+/// workers if running. Blocks that don't compress are stored uncompressed.
+/// @return The frame's size, or 0 if `capacity` is less than `frame_bound(size, block_size)`
+size_t compress_frame(const uint8_t* src, size_t size, uint8_t* dest, size_t capacity,
+                      size_t block_size = default_block_size);
+
+/// @brief Decompresses every block of a frame into `dest`, in parallel on the job workers if
+/// running.
+/// @return false if the frame is corrupt or doesn't decompress to exactly `size` bytes
+bool decompress_frame(const uint8_t* src, size_t frame_size, uint8_t* dest, size_t size);
+
+/// @brief Incrementally compresses data written in chunks of any size into a frame, i.e. for a
+/// capture written over many frames. Each block is compressed as soon as it fills up
+class StreamEncoder {
+public:
+    explicit StreamEncoder(size_t block_size = default_block_size);
+
+    void write(const void* data, size_t size);
+
+    /// @brief Compresses any partially filled block so all data written so far is in `output`
+    void flush();
+
+    /// @brief Gets the frame compressed so far
+    inline const std::vector<uint8_t>& output() const
+    {
+        return output_;
+    }
+
+    /// @brief Discards the compressed output, i.e. once it's been written to a file. The
+    /// remaining output continues the same frame
+    inline void clear_output()
+    {
+        output_.clear();
+    }
+
+private:
+    size_t block_size_;
+    std::vector<uint8_t> block_;
+    std::vector<uint8_t> output_;
+
+    void compress_block();
+};
+
+/// @brief Incrementally decompresses a frame that's read in chunks of any size
+class StreamDecoder {
+public:
+    /// @brief Decompresses every block completed by `data`, buffering any partial block.
+    /// @return false if the frame is corrupt, after which the decoder must be reset
+    bool write(const void* data, size_t size);
+
+    /// @brief Discards all buffered and decompressed data to start decoding a new frame
+    void reset();
+
+    /// @brief Checks if every block written so far has been decompressed
+    inline bool complete() const
+    {
+        return input_.empty();
+    }
+
+    inline const std::vector<uint8_t>& output() const
+    {
+        return output_;
+    }
+
+    inline void clear_output()
+    {
+        output_.clear();
+    }
+
+private:
+    std::vector<uint8_t> input_;
+    std::vector<uint8_t> output_;
+    bool corrupt_{false};
+};
+
+
+} // namespace lz
+} // namespace sky
@@ -183,6 +183,38 @@ const auto target_compiler = Compiler::unknown;
 
 #endif
 
+/////////////////////////////
+// SIMD instruction sets   //
+/////////////////////////////
+
+/// Each SIMD macro is 1 if the instruction set is available to the current translation unit.
+/// Code using them should always provide a scalar fallback
+
+#define SKY_SIMD_SSE2 0
+#define SKY_SIMD_SSE41 0
+#define SKY_SIMD_AVX2 0
+#define SKY_SIMD_NEON 0
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#undef SKY_SIMD_SSE2
+#define SKY_SIMD_SSE2 1
+#endif
+
+#if defined(__SSE4_1__) || defined(__AVX__)
+#undef SKY_SIMD_SSE41
+#define SKY_SIMD_SSE41 1
+#endif
+
+#if defined(__AVX2__)
+#undef SKY_SIMD_AVX2
+#define SKY_SIMD_AVX2 1
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#undef SKY_SIMD_NEON
+#define SKY_SIMD_NEON 1
+#endif
+
 ///////////////////////////////
 // Graphics API definitions  //
 ///////////////////////////////
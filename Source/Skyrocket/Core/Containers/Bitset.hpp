@@ -11,61 +11,308 @@
 
 #pragma once
 
+#include <Skyrocket/Core/Bits.hpp>
 #include <Skyrocket/Core/Config.hpp>
 
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
 
+#if SKY_SIMD_SSE2 == 1
+#include <emmintrin.h>
+#endif
+
 namespace sky {
 
+/// @brief A fixed-size set of bits stored in 64-bit words. Besides single-bit operations it can
+/// count and search for set bits a word at a time using the compiler's bit intrinsics, and combine
+/// whole sets with and/or/xor/and-not, two words at a time with SSE2 where available. Bits past
+/// `Size` in the last word are always kept clear so they never show up in counts or searches
 template <size_t Size>
 struct Bitset {
-    static constexpr uint32_t data_size = 32 - 1;
-    using array_type_t = uint32_t[Size];
+    using word_t = uint64_t;
+
+    static constexpr size_t word_bits = 64;
+    static constexpr size_t word_count = (Size + word_bits - 1) / word_bits;
+
+    /// Returned by searches that don't find a bit
+    static constexpr size_t npos = SIZE_MAX;
+
+    word_t words[word_count]{};
+
+    Bitset() = default;
 
-    array_type_t bits{};
+    static constexpr size_t size() noexcept
+    {
+        return Size;
+    }
 
-    SKY_FORCE_INLINE Bitset()
+    SKY_FORCE_INLINE static constexpr size_t word_position(const size_t bit) noexcept
     {
-        clear_all();
+        return bit / word_bits;
     }
 
-    SKY_FORCE_INLINE constexpr size_t byte_position(const size_t bit) const noexcept
+    SKY_FORCE_INLINE static constexpr word_t bit_mask(const size_t bit) noexcept
     {
-        return bit >> 5; // log2(32)
+        return word_t(1) << (bit % word_bits);
     }
 
     SKY_FORCE_INLINE bool is_set(const size_t bit) const noexcept
     {
-        return (bits[byte_position(bit)] & (1 << (bit & data_size))) != 0;
+        return (words[word_position(bit)] & bit_mask(bit)) != 0;
     }
 
     SKY_FORCE_INLINE void set_bit(const size_t bit) noexcept
     {
-        bits[byte_position(bit)] |= 1 << (bit & data_size);
+        words[word_position(bit)] |= bit_mask(bit);
     }
 
     SKY_FORCE_INLINE void clear_bit(const size_t bit) noexcept
     {
-        bits[byte_position(bit)] &= ~(1 << (bit & data_size));
+        words[word_position(bit)] &= ~bit_mask(bit);
     }
 
     SKY_FORCE_INLINE void toggle_bit(const size_t bit) noexcept
     {
-        bits[byte_position(bit)] ^= 1 << (bit & data_size);
+        words[word_position(bit)] ^= bit_mask(bit);
     }
 
     SKY_FORCE_INLINE void set_all() noexcept
     {
-        memset(bits, UINT32_MAX, Size);
+        memset(words, 0xff, sizeof(words));
+        clear_tail();
     }
 
     SKY_FORCE_INLINE void clear_all() noexcept
     {
-        memset(bits, 0, Size);
+        memset(words, 0, sizeof(words));
+    }
+
+    /// @brief Flips every bit in the set
+    SKY_FORCE_INLINE void toggle_all() noexcept
+    {
+        for ( size_t i = 0; i < word_count; ++i ) {
+            words[i] = ~words[i];
+        }
+        clear_tail();
+    }
+
+    /// @brief Counts the number of set bits
+    size_t popcount() const noexcept
+    {
+        size_t count = 0;
+        for ( size_t i = 0; i < word_count; ++i ) {
+            count += sky::popcount(words[i]);
+        }
+        return count;
+    }
+
+    bool any() const noexcept
+    {
+        for ( size_t i = 0; i < word_count; ++i ) {
+            if ( words[i] != 0 ) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    inline bool none() const noexcept
+    {
+        return !any();
+    }
+
+    /// @brief Gets the index of the lowest set bit
+    /// @return `npos` if no bits are set
+    inline size_t find_first_set() const noexcept
+    {
+        return find_next_set(0);
+    }
+
+    /// @brief Gets the index of the lowest set bit at or after `bit`, i.e. iterating every set
+    /// bit with `for ( auto i = set.find_first_set(); i != npos; i = set.find_next_set(i + 1) )`
+    /// @return `npos` if no bits are set at or after `bit`
+    size_t find_next_set(const size_t bit) const noexcept
+    {
+        if ( bit >= Size ) {
+            return npos;
+        }
+
+        auto index = word_position(bit);
+        auto word = words[index] & (~word_t(0) << (bit % word_bits));
+
+        while ( word == 0 ) {
+            if ( ++index >= word_count ) {
+                return npos;
+            }
+            word = words[index];
+        }
+
+        return index * word_bits + count_trailing_zeros(word);
+    }
+
+    /// @brief Gets the index of the lowest clear bit, i.e. the first free slot in a free-list
+    /// @return `npos` if every bit is set
+    size_t find_first_clear() const noexcept
+    {
+        for ( size_t i = 0; i < word_count; ++i ) {
+            if ( words[i] != ~word_t(0) ) {
+                auto bit = i * word_bits + count_trailing_zeros(~words[i]);
+                return bit < Size ? bit : npos;
+            }
+        }
+        return npos;
+    }
+
+    /// @brief Calls `fn(bit)` with the index of every set bit in ascending order
+    template <typename Fn>
+    void for_each_set(Fn&& fn) const
+    {
+        for ( size_t i = 0; i < word_count; ++i ) {
+            for ( auto word = words[i]; word != 0; word &= word - 1 ) {
+                fn(i * word_bits + count_trailing_zeros(word));
+            }
+        }
+    }
+
+    Bitset& operator&=(const Bitset& other) noexcept
+    {
+        combine<AndOp>(other);
+        return *this;
+    }
+
+    Bitset& operator|=(const Bitset& other) noexcept
+    {
+        combine<OrOp>(other);
+        return *this;
+    }
+
+    Bitset& operator^=(const Bitset& other) noexcept
+    {
+        combine<XorOp>(other);
+        return *this;
+    }
+
+    /// @brief Clears every bit that's set in `other`, i.e. `*this &= ~other`
+    Bitset& and_not(const Bitset& other) noexcept
+    {
+        combine<AndNotOp>(other);
+        return *this;
+    }
+
+    bool operator==(const Bitset& other) const noexcept
+    {
+        return memcmp(words, other.words, sizeof(words)) == 0;
+    }
+
+    bool operator!=(const Bitset& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+private:
+    SKY_FORCE_INLINE void clear_tail() noexcept
+    {
+        if ( Size % word_bits != 0 ) {
+            words[word_count - 1] &= (word_t(1) << (Size % word_bits)) - 1;
+        }
+    }
+
+    struct AndOp {
+        static word_t apply(const word_t lhs, const word_t rhs)
+        {
+            return lhs & rhs;
+        }
+#if SKY_SIMD_SSE2 == 1
+        static __m128i apply(const __m128i lhs, const __m128i rhs)
+        {
+            return _mm_and_si128(lhs, rhs);
+        }
+#endif
+    };
+
+    struct OrOp {
+        static word_t apply(const word_t lhs, const word_t rhs)
+        {
+            return lhs | rhs;
+        }
+#if SKY_SIMD_SSE2 == 1
+        static __m128i apply(const __m128i lhs, const __m128i rhs)
+        {
+            return _mm_or_si128(lhs, rhs);
+        }
+#endif
+    };
+
+    struct XorOp {
+        static word_t apply(const word_t lhs, const word_t rhs)
+        {
+            return lhs ^ rhs;
+        }
+#if SKY_SIMD_SSE2 == 1
+        static __m128i apply(const __m128i lhs, const __m128i rhs)
+        {
+            return _mm_xor_si128(lhs, rhs);
+        }
+#endif
+    };
+
+    struct AndNotOp {
+        static word_t apply(const word_t lhs, const word_t rhs)
+        {
+            return lhs & ~rhs;
+        }
+#if SKY_SIMD_SSE2 == 1
+        static __m128i apply(const __m128i lhs, const __m128i rhs)
+        {
+            return _mm_andnot_si128(rhs, lhs);
+        }
+#endif
+    };
+
+    template <typename Op>
+    SKY_FORCE_INLINE void combine(const Bitset& other) noexcept
+    {
+        size_t i = 0;
+#if SKY_SIMD_SSE2 == 1
+        for ( ; i + 2 <= word_count; i += 2 ) {
+            auto lhs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + i));
+            auto rhs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(other.words + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(words + i), Op::apply(lhs, rhs));
+        }
+#endif
+        for ( ; i < word_count; ++i ) {
+            words[i] = Op::apply(words[i], other.words[i]);
+        }
     }
 };
 
+template <size_t Size>
+inline Bitset<Size> operator&(Bitset<Size> lhs, const Bitset<Size>& rhs) noexcept
+{
+    return lhs &= rhs;
+}
+
+template <size_t Size>
+inline Bitset<Size> operator|(Bitset<Size> lhs, const Bitset<Size>& rhs) noexcept
+{
+    return lhs |= rhs;
+}
+
+template <size_t Size>
+inline Bitset<Size> operator^(Bitset<Size> lhs, const Bitset<Size>& rhs) noexcept
+{
+    return lhs ^= rhs;
+}
+
+template <size_t Size>
+constexpr size_t Bitset<Size>::word_bits;
+
+template <size_t Size>
+constexpr size_t Bitset<Size>::word_count;
+
+template <size_t Size>
+constexpr size_t Bitset<Size>::npos;
+
 
-} // namespace sky
\ No newline at end of file
+} // namespace sky
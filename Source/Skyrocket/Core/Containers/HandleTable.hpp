@@ -16,6 +16,9 @@
 #include <algorithm>
 #include <cinttypes>
 #include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
 
 namespace sky {
 
@@ -28,127 +31,175 @@ struct Handle {
     T data{T()};
 };
 
-/// @brief A static table of integer id -> data mappings. Avoids the overhead of a hashmap
-/// by allocating upfront and using array indexing for faster lookup. It doesn't handle
-/// generation of ID's but only maps them to handles.
+/// @brief A sparse set of integer id -> data mappings. Avoids the overhead of a hashmap by
+/// indexing a sparse array with the id to find the data's index in a dense array, so creating,
+/// destroying and looking up handles are all O(1) and the live handles can be iterated
+/// contiguously with `begin` and `end`.
+///
+/// Ids are split into a 24-bit index into the sparse array and an 8-bit generation. The table
+/// either generates ids itself with `add(data)`, bumping the generation each time an index is
+/// reused so stale ids are rejected rather than aliasing newer handles, or maps ids generated
+/// elsewhere, i.e. by a `CommandList`, with `create(id, data)` - a single table shouldn't mix the
+/// two. The sparse array grows in pages as higher indices are used, so the table has no fixed
+/// capacity. Pointers to data are invalidated by any create or destroy
 /// @tparam T The type of data to store in the table
-/// @tparam Capacity The maximum capacity of the table
-template<typename T, uint32_t Capacity>
+template<typename T>
 class HandleTable {
 public:
     /// @brief ID number that represents an invalid handle. This should be used for error
     /// checking
     static constexpr uint32_t invalid_id = 0;
 
-    /// @brief Allocates a number of default instances of the specified data type
-    /// equal to the capacity of the table.
+    static constexpr uint32_t index_bits = 24;
+    static constexpr uint32_t index_mask = (1u << index_bits) - 1;
+    static constexpr uint32_t max_generation = UINT32_MAX >> index_bits;
+
+    /// Index 0 is reserved so a generated id is never `invalid_id`
     HandleTable()
-        :
-        indicies_()
-    {
-        for ( uint32_t i = 0; i < Capacity; ++i ) {
-            indicies_[i] = i;
-        }
-    }
+        : generations_(1, 0)
+    {}
 
-    /// @brief Gets the tables capacity
-    /// @return Capacity
-    uint32_t capacity()
+    /// @brief Gets the number of handles the dense array can hold before it has to grow
+    uint32_t capacity() const
     {
-        return Capacity;
+        return static_cast<uint32_t>(handles_.capacity());
     }
 
     /// @brief Gets the number of elements active in the table
     /// @return The size of the table
-    uint32_t size()
+    uint32_t size() const
+    {
+        return static_cast<uint32_t>(handles_.size());
+    }
+
+    bool empty() const
+    {
+        return handles_.empty();
+    }
+
+    /// @brief Makes room in the dense array for `count` handles
+    void reserve(const uint32_t count)
     {
-        return count_;
+        handles_.reserve(count);
     }
 
     /// @brief Checks if the table contains the id specified
-    /// @param id
-    /// @return
-    bool contains(const uint32_t id)
+    bool contains(const uint32_t id) const
     {
-        return id < Capacity && indicies_[id] < count_;
+        return find(id) != invalid_dense;
     }
 
-    /// @brief Creates a new handle with the id specified, copying the data into
-    /// its entry in the table
-    /// @param id
-    /// @param data
-    T* create(const uint32_t id, const T& data)
+    /// @brief Creates a new handle with a generated id, moving the data into its entry in the
+    /// table
+    /// @return The new handle's id or `invalid_id` if every index is in use
+    uint32_t add(T data)
     {
-        if ( count_ + 1 >= Capacity || count_ + 1 == invalid_id ) {
-            SKY_ERROR("HandleTable", "Creating new handle while capacity (%"
-                PRIu32
-                ") is reached", Capacity);
-            return nullptr;
+        uint32_t index = 0;
+        uint32_t generation = 0;
+
+        if ( !free_indices_.empty() ) {
+            index = free_indices_.back();
+            free_indices_.pop_back();
+            generation = generations_[index];
+        } else {
+            if ( generations_.size() > index_mask ) {
+                SKY_ERROR("HandleTable", "Creating new handle while every index is in use");
+                return invalid_id;
+            }
+
+            index = static_cast<uint32_t>(generations_.size());
+            generations_.push_back(0);
         }
 
-        if ( contains(id) ) {
-            SKY_ERROR("HandleTable", "Creating new handle with existing (%"
-                PRIu32
-                ")", id);
+        auto id = make_id(index, generation);
+        insert(id, std::move(data));
+        return id;
+    }
+
+    /// @brief Creates a new handle with the id specified, moving the data into
+    /// its entry in the table
+    /// @return Pointer to the new handle's data or nullptr if the id is invalid or already in use
+    T* create(const uint32_t id, T data)
+    {
+        if ( id == invalid_id ) {
+            SKY_ERROR("HandleTable", "Creating new handle with invalid ID (%" PRIu32 ")", id);
             return nullptr;
         }
 
-        if ( id == invalid_id || id >= Capacity ) {
-            SKY_ERROR("HandleTable", "Creating new handle with invalid ID (%"
-                PRIu32
-                ")", id);
+        if ( sparse_slot(id & index_mask) != nullptr
+            && *sparse_slot(id & index_mask) != invalid_dense ) {
+            SKY_ERROR("HandleTable", "Creating new handle with existing (%" PRIu32 ")", id);
             return nullptr;
         }
 
-        auto index = count_;
-        indicies_[id] = index;
-
-        handles_[index].id = id;
-        handles_[index].data = data;
-
-        count_++;
-
-        return get(id);
+        return &insert(id, std::move(data)).data;
     }
 
     /// @brief Creates a new handle in the table with the ID specified using the default
     /// constructor of the tables data type to create the data
-    /// @param id
     T* create(const uint32_t id)
     {
         return create(id, T());
     }
 
-    /// @brief Destroys an element and erases it from the table
-    /// @param id
+    /// @brief Destroys an element and erases it from the table. The last element in the dense
+    /// array is moved into its place to keep the array contiguous
     void destroy(const uint32_t id)
     {
-        if ( !contains(id) ) {
-            SKY_ERROR("HandleTable", "Trying to destroy invalid id (%"
-                PRIu32
-                ")", id);
+        auto dense = find(id);
+        if ( dense == invalid_dense ) {
+            SKY_ERROR("HandleTable", "Trying to destroy invalid id (%" PRIu32 ")", id);
             return;
         }
 
-        auto index = indicies_[id];
-        std::swap(handles_[index], handles_[count_ - 1]);
-        indicies_[index] = invalid_id;
-        indicies_[count_ - 1] = index;
-        --count_;
+        auto last = size() - 1;
+        if ( dense != last ) {
+            handles_[dense] = std::move(handles_[last]);
+            *sparse_slot(handles_[dense].id & index_mask) = dense;
+        }
+
+        handles_.pop_back();
+
+        auto index = id & index_mask;
+        *sparse_slot(index) = invalid_dense;
+
+        // Only indices this table generated are recycled
+        if ( index < generations_.size() && make_id(index, generations_[index]) == id ) {
+            generations_[index] = (generations_[index] + 1) & max_generation;
+            free_indices_.push_back(index);
+        }
+    }
+
+    /// @brief Destroys every element, keeping the memory allocated
+    void clear()
+    {
+        while ( !handles_.empty() ) {
+            destroy(handles_.back().id);
+        }
     }
 
     /// @brief Returns a pointer to the first element in the raw data buffer
     /// @return Pointer to the first raw data element
     Handle<T>* begin()
     {
-        return &handles_[0];
+        return handles_.data();
     }
 
     /// @brief Returns a pointer to one past the last element in the raw data buffer
     /// @return Pointer to one past the last data element
     Handle<T>* end()
     {
-        return handles_ + count_;
+        return handles_.data() + handles_.size();
+    }
+
+    const Handle<T>* begin() const
+    {
+        return handles_.data();
+    }
+
+    const Handle<T>* end() const
+    {
+        return handles_.data() + handles_.size();
     }
 
     /// @brief Returns a pointer to the element associated with the given id
@@ -156,19 +207,103 @@ public:
     /// @return Pointer to the element
     T* get(const uint32_t id)
     {
-        if ( !contains(id) ) {
+        auto dense = find(id);
+        if ( dense == invalid_dense ) {
             SKY_ERROR("HandleTable", "Trying to get invalid id (%" PRIu32 ")", id);
             return nullptr;
         }
 
-        return &handles_[indicies_[id]].data;
+        return &handles_[dense].data;
+    }
+
+    const T* get(const uint32_t id) const
+    {
+        return const_cast<HandleTable*>(this)->get(id);
     }
 
 private:
-    uint32_t count_{0};
-    Handle<T> handles_[Capacity];
-    uint32_t indicies_[Capacity];
+    static constexpr uint32_t invalid_dense = UINT32_MAX;
+    static constexpr uint32_t page_bits = 10;
+    static constexpr uint32_t page_size = 1u << page_bits;
+
+    using page_t = std::unique_ptr<uint32_t[]>;
+
+    std::vector<Handle<T>> handles_;
+    std::vector<page_t> pages_;
+    std::vector<uint8_t> generations_;
+    std::vector<uint32_t> free_indices_;
+
+    static inline uint32_t make_id(const uint32_t index, const uint32_t generation)
+    {
+        return (generation << index_bits) | index;
+    }
+
+    uint32_t* sparse_slot(const uint32_t index) const
+    {
+        auto page = index >> page_bits;
+        if ( page >= pages_.size() || pages_[page] == nullptr ) {
+            return nullptr;
+        }
+
+        return &pages_[page][index & (page_size - 1)];
+    }
+
+    uint32_t find(const uint32_t id) const
+    {
+        if ( id == invalid_id ) {
+            return invalid_dense;
+        }
+
+        auto slot = sparse_slot(id & index_mask);
+        if ( slot == nullptr || *slot == invalid_dense ) {
+            return invalid_dense;
+        }
+
+        // Comparing the whole id rejects ids from an older generation of the same index
+        return handles_[*slot].id == id ? *slot : invalid_dense;
+    }
+
+    Handle<T>& insert(const uint32_t id, T&& data)
+    {
+        auto index = id & index_mask;
+        auto page = index >> page_bits;
+
+        if ( page >= pages_.size() ) {
+            pages_.resize(page + 1);
+        }
+
+        if ( pages_[page] == nullptr ) {
+            pages_[page].reset(new uint32_t[page_size]);
+            std::fill(pages_[page].get(), pages_[page].get() + page_size, invalid_dense);
+        }
+
+        pages_[page][index & (page_size - 1)] = size();
+
+        handles_.push_back(Handle<T>{id, std::move(data)});
+        return handles_.back();
+    }
 };
 
+template<typename T>
+constexpr uint32_t HandleTable<T>::invalid_id;
+
+template<typename T>
+constexpr uint32_t HandleTable<T>::index_bits;
+
+template<typename T>
+constexpr uint32_t HandleTable<T>::index_mask;
+
+template<typename T>
+constexpr uint32_t HandleTable<T>::max_generation;
+
+template<typename T>
+constexpr uint32_t HandleTable<T>::invalid_dense;
+
+template<typename T>
+constexpr uint32_t HandleTable<T>::page_bits;
+
+template<typename T>
+constexpr uint32_t HandleTable<T>::page_size;
+
 
 } // namespace sky
@@ -0,0 +1,598 @@
+//
+//  HashMap.hpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#pragma once
+
+#include "Skyrocket/Core/Bits.hpp"
+#include "Skyrocket/Core/Config.hpp"
+#include "Skyrocket/Core/Diagnostics/Error.hpp"
+#include "Skyrocket/Core/Hash.hpp"
+#include "Skyrocket/Core/Memory/Allocator.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#if SKY_SIMD_SSE2 == 1
+#include <emmintrin.h>
+#endif
+
+namespace sky {
+
+
+/// @brief Hashes a key for a HashMap. Specialized for integers, enums, pointers, strings and
+/// 128-bit hashes - other key types need to supply their own hash function
+template <typename K, typename Enable = void>
+struct DefaultHash {
+    static_assert(sizeof(K) == 0, "HashMap has no default hash for this key type");
+};
+
+namespace detail {
+
+
+/// Sequential integer keys, i.e. ids, are mixed with a 64-bit finalizer so they spread over the
+/// whole hash rather than just the low bits
+constexpr size_t hash_mix64(uint64_t key)
+{
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+    return static_cast<size_t>(key);
+}
+
+
+} // namespace detail
+
+template <typename K>
+struct DefaultHash<K, typename std::enable_if<std::is_integral<K>::value
+                                              || std::is_enum<K>::value>::type> {
+    size_t operator()(const K key) const
+    {
+        return detail::hash_mix64(static_cast<uint64_t>(key));
+    }
+};
+
+template <typename T>
+struct DefaultHash<T*> {
+    size_t operator()(const T* key) const
+    {
+        return detail::hash_mix64(reinterpret_cast<uintptr_t>(key));
+    }
+};
+
+template <>
+struct DefaultHash<std::string> {
+    size_t operator()(const std::string& key) const
+    {
+        return static_cast<size_t>(hash::xxh3_64(key.data(), key.size()));
+    }
+};
+
+template <>
+struct DefaultHash<hash::Hash128> {
+    /// The halves are already well distributed so they only need folding together
+    size_t operator()(const hash::Hash128& key) const
+    {
+        return static_cast<size_t>(key.low ^ (key.high * 0x9E3779B185EBCA87ULL));
+    }
+};
+
+/// @brief An open-addressing hash map in the style of Google's SwissTable. Entries are stored
+/// inline in one flat array alongside an array of one-byte control codes holding seven bits of
+/// each entry's hash. Lookups compare a whole group of 16 control bytes against the hash at once
+/// (with SSE2 where available) and only compare keys for the few entries whose bits match, so
+/// even a miss usually touches a single cache line of control bytes rather than chasing the
+/// per-node allocations of a std::unordered_map.
+///
+/// Pointers to values are invalidated by any insert that grows the table. The table's memory can
+/// come from a custom `Allocator`, which must outlive the map
+/// @tparam K The key type. Must be equality comparable
+/// @tparam V The value type
+/// @tparam Hash A function object returning a size_t hash for a `const K&`
+template <typename K, typename V, typename Hash = DefaultHash<K>>
+class HashMap {
+public:
+    struct Entry {
+        K key;
+        V value;
+    };
+
+    /// Number of control bytes compared at once during a lookup
+    static constexpr size_t group_width = 16;
+
+    explicit HashMap(Allocator* allocator = nullptr, const Hash& hash = Hash())
+        : allocator_(allocator), hash_(hash)
+    {}
+
+    HashMap(const HashMap& other)
+        : allocator_(other.allocator_), hash_(other.hash_)
+    {
+        copy_from(other);
+    }
+
+    HashMap(HashMap&& other) noexcept
+        : allocator_(other.allocator_), hash_(std::move(other.hash_))
+    {
+        take(other);
+    }
+
+    HashMap& operator=(const HashMap& other)
+    {
+        if ( this != &other ) {
+            destroy();
+            copy_from(other);
+        }
+        return *this;
+    }
+
+    HashMap& operator=(HashMap&& other) noexcept
+    {
+        if ( this != &other ) {
+            destroy();
+            allocator_ = other.allocator_;
+            hash_ = std::move(other.hash_);
+            take(other);
+        }
+        return *this;
+    }
+
+    ~HashMap()
+    {
+        destroy();
+    }
+
+    const V* find(const K& key) const
+    {
+        if ( size_ == 0 ) {
+            return nullptr;
+        }
+
+        auto index = find_index(key, hash_(key));
+        return index != invalid_index ? &entries_[index].value : nullptr;
+    }
+
+    V* find(const K& key)
+    {
+        return const_cast<V*>(static_cast<const HashMap*>(this)->find(key));
+    }
+
+    inline bool contains(const K& key) const
+    {
+        return find(key) != nullptr;
+    }
+
+    /// @brief Inserts a value for `key`, replacing any value already stored for it
+    /// @return true if `key` wasn't already in the map
+    bool insert(const K& key, V value)
+    {
+        bool inserted = false;
+        auto entry = find_or_prepare(key, &inserted);
+        if ( inserted ) {
+            new (&entry->value) V(std::move(value));
+        } else {
+            entry->value = std::move(value);
+        }
+        return inserted;
+    }
+
+    /// @brief Gets the value for `key`, default constructing one if it isn't in the map
+    V& operator[](const K& key)
+    {
+        bool inserted = false;
+        auto entry = find_or_prepare(key, &inserted);
+        if ( inserted ) {
+            new (&entry->value) V();
+        }
+        return entry->value;
+    }
+
+    /// @brief Removes the value for `key`.
+    /// @return false if there was no value for `key`
+    bool erase(const K& key)
+    {
+        if ( size_ == 0 ) {
+            return false;
+        }
+
+        auto index = find_index(key, hash_(key));
+        if ( index == invalid_index ) {
+            return false;
+        }
+
+        entries_[index].~Entry();
+        --size_;
+
+        // A lookup only stops at a group with an empty byte, so if this slot's group has no
+        // empty bytes a later key may have probed past it and the slot has to be a tombstone
+        // instead. Groups are aligned so this only needs to check the slot's own group
+        Group group(ctrl_ + (index & ~(group_width - 1)));
+        if ( group.match_empty() != 0 ) {
+            ctrl_[index] = ctrl_empty;
+            ++growth_left_;
+        } else {
+            ctrl_[index] = ctrl_deleted;
+        }
+
+        return true;
+    }
+
+    /// @brief Makes room for `count` values without rehashing
+    void reserve(const size_t count)
+    {
+        if ( count == 0 ) {
+            return;
+        }
+
+        auto capacity = capacity_ > 0 ? capacity_ : min_capacity;
+        while ( max_load(capacity) < count ) {
+            capacity *= 2;
+        }
+
+        if ( capacity > capacity_ ) {
+            rehash(capacity);
+        }
+    }
+
+    /// @brief Removes every value, keeping the memory allocated
+    void clear()
+    {
+        destroy_entries();
+        if ( capacity_ > 0 ) {
+            memset(ctrl_, ctrl_empty, capacity_);
+        }
+        size_ = 0;
+        growth_left_ = max_load(capacity_);
+    }
+
+    inline size_t size() const
+    {
+        return size_;
+    }
+
+    inline bool empty() const
+    {
+        return size_ == 0;
+    }
+
+    /// @brief Gets the number of slots allocated, including those kept empty by the load factor
+    inline size_t capacity() const
+    {
+        return capacity_;
+    }
+
+    /// @brief Calls `fn(key, value)` for every value in an unspecified order
+    template <typename Fn>
+    void for_each(Fn&& fn) const
+    {
+        for ( size_t i = 0; i < capacity_; ++i ) {
+            if ( is_full(ctrl_[i]) ) {
+                fn(entries_[i].key, entries_[i].value);
+            }
+        }
+    }
+
+    /// @brief Calls `fn(key, value)` for every value in an unspecified order, allowing the
+    /// values to be modified
+    template <typename Fn>
+    void for_each(Fn&& fn)
+    {
+        for ( size_t i = 0; i < capacity_; ++i ) {
+            if ( is_full(ctrl_[i]) ) {
+                fn(static_cast<const K&>(entries_[i].key), entries_[i].value);
+            }
+        }
+    }
+
+private:
+    static constexpr size_t min_capacity = group_width;
+    static constexpr size_t invalid_index = SIZE_MAX;
+
+    // Full slots store the low 7 bits of their hash, so only empty and deleted slots are negative
+    static constexpr int8_t ctrl_empty = -128;
+    static constexpr int8_t ctrl_deleted = -2;
+
+    static_assert(alignof(Entry) <= alignof(std::max_align_t),
+                  "HashMap entries can't be over-aligned");
+
+    /// A group of control bytes that can be compared all at once, returning a bitmask with a bit
+    /// set for each matching byte
+    struct Group {
+#if SKY_SIMD_SSE2 == 1
+        __m128i ctrl;
+
+        explicit Group(const int8_t* pos)
+            : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos)))
+        {}
+
+        inline uint32_t match(const int8_t h2) const
+        {
+            return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl,
+                                                                         _mm_set1_epi8(h2))));
+        }
+
+        inline uint32_t match_empty() const
+        {
+            return match(ctrl_empty);
+        }
+
+        /// Empty and deleted bytes are the only ones with their sign bit set
+        inline uint32_t match_empty_or_deleted() const
+        {
+            return static_cast<uint32_t>(_mm_movemask_epi8(ctrl));
+        }
+#else
+        const int8_t* ctrl;
+
+        explicit Group(const int8_t* pos)
+            : ctrl(pos)
+        {}
+
+        inline uint32_t match(const int8_t h2) const
+        {
+            uint32_t mask = 0;
+            for ( uint32_t i = 0; i < group_width; ++i ) {
+                mask |= static_cast<uint32_t>(ctrl[i] == h2) << i;
+            }
+            return mask;
+        }
+
+        inline uint32_t match_empty() const
+        {
+            return match(ctrl_empty);
+        }
+
+        inline uint32_t match_empty_or_deleted() const
+        {
+            uint32_t mask = 0;
+            for ( uint32_t i = 0; i < group_width; ++i ) {
+                mask |= static_cast<uint32_t>(ctrl[i] < 0) << i;
+            }
+            return mask;
+        }
+#endif
+    };
+
+    Allocator* allocator_{nullptr};
+    Hash hash_;
+
+    void* memory_{nullptr};
+    int8_t* ctrl_{nullptr};
+    Entry* entries_{nullptr};
+    size_t capacity_{0};
+    size_t size_{0};
+    size_t growth_left_{0};
+
+    /// Tables are kept at most 7/8 full - group probing stays fast at much higher loads than
+    /// linear probing would
+    static constexpr size_t max_load(const size_t capacity)
+    {
+        return capacity - capacity / 8;
+    }
+
+    static inline bool is_full(const int8_t ctrl)
+    {
+        return ctrl >= 0;
+    }
+
+    static inline int8_t hash_h2(const size_t hash)
+    {
+        return static_cast<int8_t>(hash & 0x7f);
+    }
+
+    /// Gets the first group to probe for a hash. Probing moves over whole, aligned groups in
+    /// triangular steps, which visits every group exactly once for power-of-two group counts
+    inline size_t probe_start(const size_t hash) const
+    {
+        return (hash >> 7) & (capacity_ - 1) & ~(group_width - 1);
+    }
+
+    size_t find_index(const K& key, const size_t hash) const
+    {
+        auto h2 = hash_h2(hash);
+        auto offset = probe_start(hash);
+
+        for ( size_t step = group_width; ; step += group_width ) {
+            Group group(ctrl_ + offset);
+            for ( auto bits = group.match(h2); bits != 0; bits &= bits - 1 ) {
+                auto index = offset + count_trailing_zeros(bits);
+                if ( entries_[index].key == key ) {
+                    return index;
+                }
+            }
+
+            // There's always at least one empty slot so this terminates
+            if ( group.match_empty() != 0 ) {
+                return invalid_index;
+            }
+
+            offset = (offset + step) & (capacity_ - 1);
+        }
+    }
+
+    size_t find_insert_index(const size_t hash) const
+    {
+        auto offset = probe_start(hash);
+        for ( size_t step = group_width; ; step += group_width ) {
+            auto bits = Group(ctrl_ + offset).match_empty_or_deleted();
+            if ( bits != 0 ) {
+                return offset + count_trailing_zeros(bits);
+            }
+            offset = (offset + step) & (capacity_ - 1);
+        }
+    }
+
+    /// Finds the entry for `key` or, if there isn't one, constructs its key in a new slot and
+    /// leaves its value for the caller to construct
+    Entry* find_or_prepare(const K& key, bool* inserted)
+    {
+        auto hash = hash_(key);
+        if ( size_ > 0 ) {
+            auto index = find_index(key, hash);
+            if ( index != invalid_index ) {
+                *inserted = false;
+                return &entries_[index];
+            }
+        }
+
+        if ( growth_left_ == 0 ) {
+            // Tombstones eat into the growth left, so a table that's mostly tombstones is
+            // cleaned up in place rather than doubled
+            auto grow = capacity_ == 0 || size_ + 1 > max_load(capacity_) / 2;
+            rehash(grow ? (capacity_ > 0 ? capacity_ * 2 : min_capacity) : capacity_);
+        }
+
+        auto index = find_insert_index(hash);
+        if ( ctrl_[index] == ctrl_empty ) {
+            --growth_left_;
+        }
+
+        ctrl_[index] = hash_h2(hash);
+        new (&entries_[index].key) K(key);
+        ++size_;
+
+        *inserted = true;
+        return &entries_[index];
+    }
+
+    void rehash(const size_t capacity)
+    {
+        SKY_ASSERT(capacity >= min_capacity && (capacity & (capacity - 1)) == 0,
+                   "Hash map capacity is a power of two");
+
+        auto old_memory = memory_;
+        auto old_ctrl = ctrl_;
+        auto old_entries = entries_;
+        auto old_capacity = capacity_;
+
+        // Control bytes and entries share one allocation. The capacity is a multiple of
+        // the group width so the entries that follow the control bytes stay aligned
+        memory_ = allocate(capacity + capacity * sizeof(Entry));
+        ctrl_ = static_cast<int8_t*>(memory_);
+        entries_ = reinterpret_cast<Entry*>(ctrl_ + capacity);
+        capacity_ = capacity;
+        growth_left_ = max_load(capacity) - size_;
+        memset(ctrl_, ctrl_empty, capacity);
+
+        for ( size_t i = 0; i < old_capacity; ++i ) {
+            if ( !is_full(old_ctrl[i]) ) {
+                continue;
+            }
+
+            auto hash = hash_(old_entries[i].key);
+            auto index = find_insert_index(hash);
+            ctrl_[index] = hash_h2(hash);
+            new (&entries_[index]) Entry(std::move(old_entries[i]));
+            old_entries[i].~Entry();
+        }
+
+        deallocate(old_memory);
+    }
+
+    void* allocate(const size_t bytes)
+    {
+        if ( allocator_ != nullptr ) {
+            auto memory = allocator_->allocate(bytes, alignof(std::max_align_t));
+            SKY_ASSERT(memory != nullptr, "Hash map allocator has enough memory for %zu bytes",
+                       bytes);
+            return memory;
+        }
+
+        return ::operator new(bytes);
+    }
+
+    void deallocate(void* memory)
+    {
+        if ( memory == nullptr ) {
+            return;
+        }
+
+        if ( allocator_ != nullptr ) {
+            allocator_->free(memory);
+        } else {
+            ::operator delete(memory);
+        }
+    }
+
+    void destroy_entries()
+    {
+        if ( std::is_trivially_destructible<Entry>::value ) {
+            return;
+        }
+
+        for ( size_t i = 0; i < capacity_; ++i ) {
+            if ( is_full(ctrl_[i]) ) {
+                entries_[i].~Entry();
+            }
+        }
+    }
+
+    void destroy()
+    {
+        destroy_entries();
+        deallocate(memory_);
+
+        memory_ = nullptr;
+        ctrl_ = nullptr;
+        entries_ = nullptr;
+        capacity_ = 0;
+        size_ = 0;
+        growth_left_ = 0;
+    }
+
+    void copy_from(const HashMap& other)
+    {
+        reserve(other.size_);
+        other.for_each([&](const K& key, const V& value) {
+            insert(key, value);
+        });
+    }
+
+    void take(HashMap& other)
+    {
+        memory_ = other.memory_;
+        ctrl_ = other.ctrl_;
+        entries_ = other.entries_;
+        capacity_ = other.capacity_;
+        size_ = other.size_;
+        growth_left_ = other.growth_left_;
+
+        other.memory_ = nullptr;
+        other.ctrl_ = nullptr;
+        other.entries_ = nullptr;
+        other.capacity_ = 0;
+        other.size_ = 0;
+        other.growth_left_ = 0;
+    }
+};
+
+template <typename K, typename V, typename Hash>
+constexpr size_t HashMap<K, V, Hash>::group_width;
+
+template <typename K, typename V, typename Hash>
+constexpr size_t HashMap<K, V, Hash>::min_capacity;
+
+template <typename K, typename V, typename Hash>
+constexpr size_t HashMap<K, V, Hash>::invalid_index;
+
+template <typename K, typename V, typename Hash>
+constexpr int8_t HashMap<K, V, Hash>::ctrl_empty;
+
+template <typename K, typename V, typename Hash>
+constexpr int8_t HashMap<K, V, Hash>::ctrl_deleted;
+
+
+} // namespace sky
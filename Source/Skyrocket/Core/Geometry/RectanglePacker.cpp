@@ -0,0 +1,550 @@
+//
+//  RectanglePacker.cpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#include "Skyrocket/Core/Geometry/RectanglePacker.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace sky {
+
+
+static bool rect_encloses(const UIntRect& outer, const UIntRect& inner)
+{
+    return inner.position.x >= outer.position.x && inner.position.y >= outer.position.y
+        && inner.right() <= outer.right() && inner.bottom() <= outer.bottom();
+}
+
+RectanglePacker::RectanglePacker(const uint32_t width, const uint32_t height,
+                                 const Heuristic heuristic, const uint32_t padding)
+{
+    reset(width, height, heuristic, padding);
+}
+
+void RectanglePacker::reset(const uint32_t width, const uint32_t height,
+                            const Heuristic heuristic, const uint32_t padding)
+{
+    heuristic_ = heuristic;
+    width_ = width;
+    height_ = height;
+    padding_ = padding;
+    clear();
+}
+
+void RectanglePacker::clear()
+{
+    used_area_ = 0;
+    skyline_.clear();
+    free_rects_.clear();
+
+    if ( width_ == 0 || height_ == 0 ) {
+        return;
+    }
+
+    if ( heuristic_ == Heuristic::skyline_bottom_left ) {
+        skyline_.push_back(SkylineNode { 0, 0, width_ });
+    } else {
+        free_rects_.emplace_back(0, 0, width_, height_);
+    }
+}
+
+bool RectanglePacker::insert(const uint32_t width, const uint32_t height, UIntRect* rect)
+{
+    if ( width == 0 || height == 0 ) {
+        *rect = UIntRect(0, 0, width, height);
+        return true;
+    }
+
+    auto padded_width = width + padding_;
+    auto padded_height = height + padding_;
+    UIntRect placed;
+
+    if ( heuristic_ == Heuristic::skyline_bottom_left ) {
+        // Holes left by `remove` are reused before raising the skyline
+        if ( free_rect_find(padded_width, padded_height, false, &placed) ) {
+            free_rect_place(placed);
+        } else if ( !skyline_insert(padded_width, padded_height, &placed) ) {
+            return false;
+        }
+    } else {
+        auto best_area = heuristic_ == Heuristic::maxrects_best_area;
+        if ( !free_rect_find(padded_width, padded_height, best_area, &placed) ) {
+            return false;
+        }
+        free_rect_place(placed);
+    }
+
+    *rect = UIntRect(placed.position.x, placed.position.y, width, height);
+    used_area_ += static_cast<uint64_t>(width) * height;
+    return true;
+}
+
+bool RectanglePacker::insert_and_grow(const uint32_t width, const uint32_t height,
+                                      const uint32_t max_size, UIntRect* rect)
+{
+    while ( !insert(width, height, rect) ) {
+        auto new_width = width_;
+        auto new_height = height_;
+
+        if ( new_width <= new_height && new_width < max_size ) {
+            new_width = std::max(new_width * 2, 1u);
+        } else if ( new_height < max_size ) {
+            new_height = std::max(new_height * 2, 1u);
+        } else if ( new_width < max_size ) {
+            new_width = std::max(new_width * 2, 1u);
+        } else {
+            return false;
+        }
+
+        resize(std::min(new_width, max_size), std::min(new_height, max_size));
+    }
+
+    return true;
+}
+
+void RectanglePacker::occupy(const UIntRect& rect)
+{
+    if ( rect.width == 0 || rect.height == 0 ) {
+        return;
+    }
+
+    UIntRect padded(rect.position.x, rect.position.y,
+                    std::min(rect.width + padding_, width_ - rect.position.x),
+                    std::min(rect.height + padding_, height_ - rect.position.y));
+
+    used_area_ += static_cast<uint64_t>(rect.width) * rect.height;
+
+    if ( heuristic_ != Heuristic::skyline_bottom_left ) {
+        free_rect_place(padded);
+        return;
+    }
+
+    // Split the skyline at both edges of the rectangle then raise every node in between
+    auto split = [&](const uint32_t x) {
+        for ( size_t i = 0; i < skyline_.size(); ++i ) {
+            auto& node = skyline_[i];
+            if ( x > node.x && x < node.x + node.width ) {
+                SkylineNode right { x, node.y, node.x + node.width - x };
+                node.width = x - node.x;
+                skyline_.insert(skyline_.begin() + i + 1, right);
+                return;
+            }
+        }
+    };
+
+    split(padded.position.x);
+    split(padded.right());
+
+    for ( auto& node : skyline_ ) {
+        if ( node.x >= padded.position.x && node.x + node.width <= padded.right() ) {
+            node.y = std::max(node.y, padded.bottom());
+        }
+    }
+
+    for ( size_t i = 1; i < skyline_.size(); ) {
+        if ( skyline_[i - 1].y == skyline_[i].y ) {
+            skyline_[i - 1].width += skyline_[i].width;
+            skyline_.erase(skyline_.begin() + i);
+        } else {
+            ++i;
+        }
+    }
+
+    if ( !free_rects_.empty() ) {
+        free_rect_place(padded);
+    }
+}
+
+void RectanglePacker::remove(const UIntRect& rect)
+{
+    if ( rect.width == 0 || rect.height == 0 ) {
+        return;
+    }
+
+    auto used = static_cast<uint64_t>(rect.width) * rect.height;
+    used_area_ = used <= used_area_ ? used_area_ - used : 0;
+
+    // Nothing is left so start again from a single free area rather than stitching it back
+    // together from the pieces
+    if ( used_area_ == 0 ) {
+        clear();
+        return;
+    }
+
+    UIntRect freed(rect.position.x, rect.position.y,
+                   std::min(rect.width + padding_, width_ - rect.position.x),
+                   std::min(rect.height + padding_, height_ - rect.position.y));
+
+    if ( heuristic_ == Heuristic::skyline_bottom_left ) {
+        // If nothing was stacked on top of the rectangle the skyline can simply be lowered,
+        // otherwise the space becomes a hole to fill with later inserts
+        auto lowered = false;
+        for ( auto& node : skyline_ ) {
+            if ( node.x == freed.position.x && node.width == freed.width
+                && node.y == freed.bottom() ) {
+                node.y = freed.position.y;
+                lowered = true;
+                break;
+            }
+        }
+
+        if ( lowered ) {
+            for ( size_t i = 1; i < skyline_.size(); ) {
+                if ( skyline_[i - 1].y == skyline_[i].y ) {
+                    skyline_[i - 1].width += skyline_[i].width;
+                    skyline_.erase(skyline_.begin() + i);
+                } else {
+                    ++i;
+                }
+            }
+            return;
+        }
+    }
+
+    free_rect_merge(freed);
+}
+
+bool RectanglePacker::resize(const uint32_t width, const uint32_t height)
+{
+    if ( width < width_ || height < height_ ) {
+        return false;
+    }
+
+    if ( width == width_ && height == height_ ) {
+        return true;
+    }
+
+    if ( heuristic_ == Heuristic::skyline_bottom_left ) {
+        if ( width > width_ ) {
+            if ( !skyline_.empty() && skyline_.back().y == 0 ) {
+                skyline_.back().width += width - width_;
+            } else {
+                skyline_.push_back(SkylineNode { width_, 0, width - width_ });
+            }
+        }
+    } else {
+        // Free rectangles touching the old edges extend into the new space so they stay maximal
+        for ( auto& free_rect : free_rects_ ) {
+            if ( free_rect.right() == width_ ) {
+                free_rect.width = width - free_rect.position.x;
+            }
+            if ( free_rect.bottom() == height_ ) {
+                free_rect.height = height - free_rect.position.y;
+            }
+        }
+
+        if ( width > width_ ) {
+            free_rects_.emplace_back(width_, 0, width - width_, height);
+        }
+        if ( height > height_ ) {
+            free_rects_.emplace_back(0, height_, width, height - height_);
+        }
+
+        free_rect_prune();
+    }
+
+    width_ = width;
+    height_ = height;
+    return true;
+}
+
+float RectanglePacker::occupancy() const
+{
+    auto total = static_cast<uint64_t>(width_) * height_;
+    if ( total == 0 ) {
+        return 0.0f;
+    }
+
+    return static_cast<float>(static_cast<double>(used_area_) / static_cast<double>(total));
+}
+
+uint32_t RectanglePacker::next_power_of_two(uint32_t value)
+{
+    if ( value <= 1 ) {
+        return 1;
+    }
+
+    --value;
+    value |= value >> 1;
+    value |= value >> 2;
+    value |= value >> 4;
+    value |= value >> 8;
+    value |= value >> 16;
+    return value + 1;
+}
+
+//==========================================
+//  Skyline
+//==========================================
+
+bool RectanglePacker::skyline_fit(const size_t node, const uint32_t width, const uint32_t height,
+                                  uint32_t* y) const
+{
+    auto x = skyline_[node].x;
+    if ( x + width > width_ ) {
+        return false;
+    }
+
+    // The rectangle rests on the highest node it spans
+    uint32_t top = 0;
+    auto remaining = static_cast<int64_t>(width);
+    for ( auto i = node; remaining > 0 && i < skyline_.size(); ++i ) {
+        top = std::max(top, skyline_[i].y);
+        if ( top + height > height_ ) {
+            return false;
+        }
+        remaining -= skyline_[i].width;
+    }
+
+    *y = top;
+    return true;
+}
+
+bool RectanglePacker::skyline_insert(const uint32_t width, const uint32_t height, UIntRect* rect)
+{
+    auto best_bottom = std::numeric_limits<uint32_t>::max();
+    auto best_width = std::numeric_limits<uint32_t>::max();
+    auto best_node = skyline_.size();
+    uint32_t best_y = 0;
+    uint32_t y = 0;
+
+    for ( size_t i = 0; i < skyline_.size(); ++i ) {
+        if ( !skyline_fit(i, width, height, &y) ) {
+            continue;
+        }
+
+        auto bottom = y + height;
+        if ( bottom < best_bottom || (bottom == best_bottom && skyline_[i].width < best_width) ) {
+            best_bottom = bottom;
+            best_width = skyline_[i].width;
+            best_node = i;
+            best_y = y;
+        }
+    }
+
+    if ( best_node == skyline_.size() ) {
+        return false;
+    }
+
+    *rect = UIntRect(skyline_[best_node].x, best_y, width, height);
+    skyline_add(best_node, *rect);
+    return true;
+}
+
+void RectanglePacker::skyline_add(const size_t node, const UIntRect& rect)
+{
+    // Space between the old skyline and the bottom of the rectangle becomes unreachable for the
+    // skyline, so it's tracked as free space instead
+    auto remaining = static_cast<int64_t>(rect.width);
+    for ( auto i = node; remaining > 0 && i < skyline_.size(); ++i ) {
+        const auto& old = skyline_[i];
+        auto left = std::max(old.x, rect.position.x);
+        auto right = std::min(old.x + old.width, rect.right());
+        if ( old.y < rect.position.y && right > left ) {
+            free_rects_.emplace_back(left, old.y, right - left, rect.position.y - old.y);
+        }
+        remaining -= old.width;
+    }
+
+    skyline_.insert(skyline_.begin() + node,
+                    SkylineNode { rect.position.x, rect.bottom(), rect.width });
+
+    for ( auto i = node + 1; i < skyline_.size(); ) {
+        auto& prev = skyline_[i - 1];
+        auto& cur = skyline_[i];
+        auto prev_right = prev.x + prev.width;
+
+        if ( cur.x >= prev_right ) {
+            break;
+        }
+
+        auto shrink = prev_right - cur.x;
+        if ( cur.width <= shrink ) {
+            skyline_.erase(skyline_.begin() + i);
+            continue;
+        }
+
+        cur.x += shrink;
+        cur.width -= shrink;
+        break;
+    }
+
+    for ( size_t i = 1; i < skyline_.size(); ) {
+        if ( skyline_[i - 1].y == skyline_[i].y ) {
+            skyline_[i - 1].width += skyline_[i].width;
+            skyline_.erase(skyline_.begin() + i);
+        } else {
+            ++i;
+        }
+    }
+
+    if ( !free_rects_.empty() ) {
+        free_rect_prune();
+    }
+}
+
+//==========================================
+//  MaxRects
+//==========================================
+
+bool RectanglePacker::free_rect_find(const uint32_t width, const uint32_t height,
+                                     const bool best_area, UIntRect* rect) const
+{
+    auto best_primary = std::numeric_limits<uint64_t>::max();
+    auto best_secondary = std::numeric_limits<uint64_t>::max();
+    auto found = false;
+
+    for ( const auto& free_rect : free_rects_ ) {
+        if ( free_rect.width < width || free_rect.height < height ) {
+            continue;
+        }
+
+        uint64_t leftover_x = free_rect.width - width;
+        uint64_t leftover_y = free_rect.height - height;
+        auto short_side = std::min(leftover_x, leftover_y);
+        auto long_side = std::max(leftover_x, leftover_y);
+
+        uint64_t primary = short_side;
+        uint64_t secondary = long_side;
+        if ( best_area ) {
+            primary = static_cast<uint64_t>(free_rect.width) * free_rect.height
+                - static_cast<uint64_t>(width) * height;
+            secondary = short_side;
+        }
+
+        if ( primary < best_primary || (primary == best_primary && secondary < best_secondary) ) {
+            best_primary = primary;
+            best_secondary = secondary;
+            *rect = UIntRect(free_rect.position.x, free_rect.position.y, width, height);
+            found = true;
+        }
+    }
+
+    return found;
+}
+
+void RectanglePacker::free_rect_place(const UIntRect& rect)
+{
+    new_free_rects_.clear();
+
+    for ( size_t i = 0; i < free_rects_.size(); ) {
+        if ( free_rects_[i].intersects(rect) ) {
+            free_rect_split(free_rects_[i], rect);
+            free_rects_[i] = free_rects_.back();
+            free_rects_.pop_back();
+        } else {
+            ++i;
+        }
+    }
+
+    free_rects_.insert(free_rects_.end(), new_free_rects_.begin(), new_free_rects_.end());
+    free_rect_prune();
+}
+
+void RectanglePacker::free_rect_split(const UIntRect& free_rect, const UIntRect& used)
+{
+    // Each side of the free rectangle not covered by `used` becomes a new maximal free rectangle
+    if ( used.position.x > free_rect.position.x ) {
+        new_free_rects_.emplace_back(free_rect.position.x, free_rect.position.y,
+                                     used.position.x - free_rect.position.x, free_rect.height);
+    }
+    if ( used.right() < free_rect.right() ) {
+        new_free_rects_.emplace_back(used.right(), free_rect.position.y,
+                                     free_rect.right() - used.right(), free_rect.height);
+    }
+    if ( used.position.y > free_rect.position.y ) {
+        new_free_rects_.emplace_back(free_rect.position.x, free_rect.position.y,
+                                     free_rect.width, used.position.y - free_rect.position.y);
+    }
+    if ( used.bottom() < free_rect.bottom() ) {
+        new_free_rects_.emplace_back(free_rect.position.x, used.bottom(),
+                                     free_rect.width, free_rect.bottom() - used.bottom());
+    }
+}
+
+void RectanglePacker::free_rect_merge(const UIntRect& freed)
+{
+    // Free rectangles must stay maximal or freed space can only ever be reused in the pieces it
+    // was split into. Any two free rectangles that touch or overlap can be combined into one
+    // spanning the union of one axis over the shared part of the other, so the freed rectangle
+    // is combined with its neighbours, and the results with theirs, until nothing new is found
+    new_free_rects_.clear();
+    new_free_rects_.push_back(freed);
+
+    while ( !new_free_rects_.empty() ) {
+        auto rect = new_free_rects_.back();
+        new_free_rects_.pop_back();
+
+        auto enclosed = false;
+        for ( const auto& free_rect : free_rects_ ) {
+            if ( rect_encloses(free_rect, rect) ) {
+                enclosed = true;
+                break;
+            }
+        }
+
+        if ( enclosed ) {
+            continue;
+        }
+
+        free_rects_.erase(std::remove_if(free_rects_.begin(), free_rects_.end(),
+                                         [&](const UIntRect& free_rect) {
+                                             return rect_encloses(rect, free_rect);
+                                         }),
+                          free_rects_.end());
+
+        for ( const auto& free_rect : free_rects_ ) {
+            auto left = std::max(rect.position.x, free_rect.position.x);
+            auto right = std::min(rect.right(), free_rect.right());
+            auto top = std::max(rect.position.y, free_rect.position.y);
+            auto bottom = std::min(rect.bottom(), free_rect.bottom());
+
+            // Stacked vertically with a shared column
+            if ( right > left && top <= bottom ) {
+                auto y = std::min(rect.position.y, free_rect.position.y);
+                new_free_rects_.emplace_back(left, y, right - left,
+                                             std::max(rect.bottom(), free_rect.bottom()) - y);
+            }
+
+            // Side by side with a shared row
+            if ( bottom > top && left <= right ) {
+                auto x = std::min(rect.position.x, free_rect.position.x);
+                new_free_rects_.emplace_back(x, top,
+                                             std::max(rect.right(), free_rect.right()) - x,
+                                             bottom - top);
+            }
+        }
+
+        free_rects_.push_back(rect);
+    }
+}
+
+void RectanglePacker::free_rect_prune()
+{
+    for ( size_t i = 0; i < free_rects_.size(); ++i ) {
+        for ( size_t j = i + 1; j < free_rects_.size(); ) {
+            if ( rect_encloses(free_rects_[j], free_rects_[i]) ) {
+                free_rects_.erase(free_rects_.begin() + i);
+                --i;
+                break;
+            }
+
+            if ( rect_encloses(free_rects_[i], free_rects_[j]) ) {
+                free_rects_.erase(free_rects_.begin() + j);
+            } else {
+                ++j;
+            }
+        }
+    }
+}
+
+
+} // namespace sky
@@ -0,0 +1,133 @@
+//
+//  RectanglePacker.hpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#pragma once
+
+#include "Skyrocket/Core/Geometry/Rectangle.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace sky {
+
+
+/// @brief Incrementally packs rectangles into a 2D area, i.e. glyphs, sprites or lightmaps into
+/// a texture atlas. Packed rectangles can be removed again and the area grown in powers of two
+/// without moving anything that's already been placed
+class RectanglePacker {
+public:
+    enum class Heuristic {
+        /// Places each rectangle as low as possible on a skyline of the packed area. Very fast
+        /// with good occupancy when rectangles are inserted tallest first
+        skyline_bottom_left,
+        /// Tracks every maximal free rectangle and picks the one leaving the shortest leftover
+        /// side. Slower to insert but packs tighter, especially when rectangles are removed
+        maxrects_best_short_side,
+        /// Same as `maxrects_best_short_side` but picks the free rectangle with the smallest area
+        maxrects_best_area
+    };
+
+    RectanglePacker() = default;
+
+    /// @brief Creates a new packer with a `width` by `height` area. `padding` is left empty to
+    /// the right and below every rectangle to avoid bleeding when sampling a texture atlas
+    RectanglePacker(uint32_t width, uint32_t height,
+                    Heuristic heuristic = Heuristic::skyline_bottom_left, uint32_t padding = 0);
+
+    /// @brief Removes all rectangles and resets the packer to an empty `width` by `height` area
+    void reset(uint32_t width, uint32_t height,
+               Heuristic heuristic = Heuristic::skyline_bottom_left, uint32_t padding = 0);
+
+    /// @brief Removes all rectangles, keeping the current size, heuristic and padding
+    void clear();
+
+    /// @brief Finds a place for a `width` by `height` rectangle and writes it to `rect`.
+    /// @return false if there's no space left for the rectangle
+    bool insert(uint32_t width, uint32_t height, UIntRect* rect);
+
+    /// @brief Inserts a rectangle, doubling the smallest side of the area until it fits or
+    /// `max_size` is reached. The area stays a power of two if it started as one
+    bool insert_and_grow(uint32_t width, uint32_t height, uint32_t max_size, UIntRect* rect);
+
+    /// @brief Marks a rectangle at a known position as used, i.e. to restore a previously packed
+    /// layout. The rectangle must not overlap any other packed rectangle. Skylines are raised over
+    /// the whole rectangle so any free space below it can't be reused
+    void occupy(const UIntRect& rect);
+
+    /// @brief Frees the space used by a rectangle previously returned from `insert`
+    void remove(const UIntRect& rect);
+
+    /// @brief Grows the packed area. Rectangles already packed keep their positions.
+    /// @return false if the new size is smaller than the current size in either dimension
+    bool resize(uint32_t width, uint32_t height);
+
+    /// @brief Gets the fraction of the total area covered by packed rectangles, excluding padding
+    float occupancy() const;
+
+    inline uint64_t used_area() const
+    {
+        return used_area_;
+    }
+
+    inline uint32_t width() const
+    {
+        return width_;
+    }
+
+    inline uint32_t height() const
+    {
+        return height_;
+    }
+
+    inline uint32_t padding() const
+    {
+        return padding_;
+    }
+
+    inline Heuristic heuristic() const
+    {
+        return heuristic_;
+    }
+
+    /// @brief Gets the smallest power of two greater than or equal to `value`
+    static uint32_t next_power_of_two(uint32_t value);
+
+private:
+    struct SkylineNode {
+        uint32_t x;
+        uint32_t y;
+        uint32_t width;
+    };
+
+    Heuristic heuristic_{Heuristic::skyline_bottom_left};
+    uint32_t width_{0};
+    uint32_t height_{0};
+    uint32_t padding_{0};
+    uint64_t used_area_{0};
+
+    std::vector<SkylineNode> skyline_;
+    // Free rectangles for MaxRects or, for skylines, space freed by `remove` below the skyline
+    std::vector<UIntRect> free_rects_;
+    std::vector<UIntRect> new_free_rects_;
+
+    bool skyline_insert(uint32_t width, uint32_t height, UIntRect* rect);
+    bool skyline_fit(size_t node, uint32_t width, uint32_t height, uint32_t* y) const;
+    void skyline_add(size_t node, const UIntRect& rect);
+
+    bool free_rect_find(uint32_t width, uint32_t height, bool best_area, UIntRect* rect) const;
+    void free_rect_place(const UIntRect& rect);
+    void free_rect_split(const UIntRect& free_rect, const UIntRect& used);
+    void free_rect_merge(const UIntRect& freed);
+    void free_rect_prune();
+};
+
+
+} // namespace sky
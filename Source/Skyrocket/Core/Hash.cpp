@@ -12,6 +12,14 @@
 #include "Skyrocket/Core/Hash.hpp"
 #include "Config.hpp"
 
+#include <cstring>
+
+#if SKY_SIMD_AVX2 == 1
+#include <immintrin.h>
+#elif SKY_SIMD_SSE2 == 1
+#include <emmintrin.h>
+#endif
+
 #if SKY_COMPILER_MSVC == 1
 
 #include <stdlib.h>
@@ -96,7 +104,7 @@ uint32_t murmur3_32(const void* key, uint32_t len, uint32_t seed)
         case 2: k1 ^= tail[1] << 8;
         case 1:
         {
-            k1 ^= tail[0] << 16;
+            k1 ^= tail[0];
             k1 *= c1;
             k1 = ROTL32(k1, 15);
             k1 *= c2;
@@ -111,6 +119,424 @@ uint32_t murmur3_32(const void* key, uint32_t len, uint32_t seed)
     return h1;
 }
 
+//==========================================
+//  XXH3
+//==========================================
+
+using namespace detail;
+
+static constexpr size_t xxh3_stripes_per_block = (xxh3_secret_size - xxh3_stripe_len) / 8;
+static constexpr size_t xxh3_block_len = xxh3_stripe_len * xxh3_stripes_per_block;
+
+/// Offsets into the secret used when finishing long hashes
+static constexpr size_t xxh3_scramble_start = xxh3_secret_size - xxh3_stripe_len;
+static constexpr size_t xxh3_last_stripe_start = xxh3_scramble_start - 7;
+static constexpr size_t xxh3_merge_start = 11;
+
+/// Accumulates `stripes` consecutive 64 byte stripes, advancing through the secret 8 bytes per
+/// stripe. This is where nearly all the time goes for long inputs so the accumulators are kept in
+/// registers for the whole run
+static void xxh3_accumulate(uint64_t* acc, const uint8_t* input, const uint8_t* secret,
+                            const size_t stripes)
+{
+#if SKY_SIMD_AVX2 == 1
+    auto acc_lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc));
+    auto acc_hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc + 4));
+
+    for ( size_t s = 0; s < stripes; ++s ) {
+        auto stripe = input + s * xxh3_stripe_len;
+        auto key = secret + s * 8;
+
+        auto data_lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(stripe));
+        auto data_hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(stripe + 32));
+        auto key_lo = _mm256_xor_si256(data_lo, _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(key)));
+        auto key_hi = _mm256_xor_si256(data_hi, _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(key + 32)));
+
+        // Multiplies the low and high 32 bits of each keyed lane and adds the data to the
+        // neighbouring lane
+        auto product_lo = _mm256_mul_epu32(key_lo, _mm256_shuffle_epi32(key_lo, 0x31));
+        auto product_hi = _mm256_mul_epu32(key_hi, _mm256_shuffle_epi32(key_hi, 0x31));
+        acc_lo = _mm256_add_epi64(acc_lo, _mm256_add_epi64(
+            product_lo, _mm256_shuffle_epi32(data_lo, 0x4e)));
+        acc_hi = _mm256_add_epi64(acc_hi, _mm256_add_epi64(
+            product_hi, _mm256_shuffle_epi32(data_hi, 0x4e)));
+    }
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc), acc_lo);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + 4), acc_hi);
+#elif SKY_SIMD_SSE2 == 1
+    __m128i lanes[4];
+    for ( size_t i = 0; i < 4; ++i ) {
+        lanes[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc + 2 * i));
+    }
+
+    for ( size_t s = 0; s < stripes; ++s ) {
+        auto stripe = input + s * xxh3_stripe_len;
+        auto key = secret + s * 8;
+
+        for ( size_t i = 0; i < 4; ++i ) {
+            auto data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(stripe + 16 * i));
+            auto keyed = _mm_xor_si128(data, _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(key + 16 * i)));
+            auto product = _mm_mul_epu32(keyed, _mm_shuffle_epi32(keyed, 0x31));
+            lanes[i] = _mm_add_epi64(lanes[i], _mm_add_epi64(
+                product, _mm_shuffle_epi32(data, 0x4e)));
+        }
+    }
+
+    for ( size_t i = 0; i < 4; ++i ) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(acc + 2 * i), lanes[i]);
+    }
+#else
+    for ( size_t s = 0; s < stripes; ++s ) {
+        xxh3_accumulate_512(acc, input + s * xxh3_stripe_len, secret + s * 8);
+    }
+#endif
+}
+
+static void xxh3_scramble_accs(uint64_t* acc, const uint8_t* secret)
+{
+#if SKY_SIMD_AVX2 == 1
+    auto prime = _mm256_set1_epi32(static_cast<int>(prime32_1));
+    for ( size_t i = 0; i < 2; ++i ) {
+        auto lanes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc + 4 * i));
+        lanes = _mm256_xor_si256(lanes, _mm256_srli_epi64(lanes, 47));
+        lanes = _mm256_xor_si256(lanes, _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(secret + 32 * i)));
+
+        // 64-bit multiply by a 32-bit prime from two 32x32 multiplies
+        auto product_lo = _mm256_mul_epu32(lanes, prime);
+        auto product_hi = _mm256_mul_epu32(_mm256_shuffle_epi32(lanes, 0x31), prime);
+        lanes = _mm256_add_epi64(product_lo, _mm256_slli_epi64(product_hi, 32));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + 4 * i), lanes);
+    }
+#elif SKY_SIMD_SSE2 == 1
+    auto prime = _mm_set1_epi32(static_cast<int>(prime32_1));
+    for ( size_t i = 0; i < 4; ++i ) {
+        auto lanes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc + 2 * i));
+        lanes = _mm_xor_si128(lanes, _mm_srli_epi64(lanes, 47));
+        lanes = _mm_xor_si128(lanes, _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(secret + 16 * i)));
+
+        auto product_lo = _mm_mul_epu32(lanes, prime);
+        auto product_hi = _mm_mul_epu32(_mm_shuffle_epi32(lanes, 0x31), prime);
+        lanes = _mm_add_epi64(product_lo, _mm_slli_epi64(product_hi, 32));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(acc + 2 * i), lanes);
+    }
+#else
+    xxh3_scramble(acc, secret);
+#endif
+}
+
+/// Consumes stripes into the accumulators, scrambling them each time a block's worth of stripes
+/// has been accumulated. `stripes_so_far` tracks the position within the current block
+static void xxh3_consume_stripes(uint64_t* acc, size_t* stripes_so_far, const uint8_t* input,
+                                 size_t stripes, const uint8_t* secret)
+{
+    while ( stripes >= xxh3_stripes_per_block - *stripes_so_far ) {
+        auto to_end = xxh3_stripes_per_block - *stripes_so_far;
+        xxh3_accumulate(acc, input, secret + *stripes_so_far * 8, to_end);
+        xxh3_scramble_accs(acc, secret + xxh3_scramble_start);
+        input += to_end * xxh3_stripe_len;
+        stripes -= to_end;
+        *stripes_so_far = 0;
+    }
+
+    xxh3_accumulate(acc, input, secret + *stripes_so_far * 8, stripes);
+    *stripes_so_far += stripes;
+}
+
+/// Accumulates an input longer than 240 bytes
+static void xxh3_hash_long(uint64_t* acc, const uint8_t* input, const size_t len,
+                           const uint8_t* secret)
+{
+    xxh3_init_accs(acc);
+
+    auto blocks = (len - 1) / xxh3_block_len;
+    for ( size_t b = 0; b < blocks; ++b ) {
+        xxh3_accumulate(acc, input + b * xxh3_block_len, secret, xxh3_stripes_per_block);
+        xxh3_scramble_accs(acc, secret + xxh3_scramble_start);
+    }
+
+    auto stripes = ((len - 1) - xxh3_block_len * blocks) / xxh3_stripe_len;
+    xxh3_accumulate(acc, input + blocks * xxh3_block_len, secret, stripes);
+    xxh3_accumulate(acc, input + len - xxh3_stripe_len, secret + xxh3_last_stripe_start, 1);
+}
+
+static Hash128 xxh3_merge_128(const uint64_t* acc, const uint8_t* secret, const uint64_t len)
+{
+    return Hash128 {
+        xxh3_merge_accs(acc, secret + xxh3_merge_start, len * prime64_1),
+        xxh3_merge_accs(acc, secret + xxh3_secret_size - xxh3_stripe_len - xxh3_merge_start,
+                        ~(len * prime64_2))
+    };
+}
+
+uint64_t xxh3_64(const void* data, const size_t len, const uint64_t seed)
+{
+    auto input = static_cast<const uint8_t*>(data);
+    if ( len <= xxh3_midsize_max ) {
+        return xxh3_64_short(input, len, seed);
+    }
+
+    uint8_t seeded_secret[xxh3_secret_size];
+    auto secret = xxh3_secret;
+    if ( seed != 0 ) {
+        xxh3_init_secret(seeded_secret, seed);
+        secret = seeded_secret;
+    }
+
+    uint64_t acc[8];
+    xxh3_hash_long(acc, input, len, secret);
+    return xxh3_merge_accs(acc, secret + xxh3_merge_start, len * prime64_1);
+}
+
+static Hash128 xxh3_mix32(Hash128 acc, const uint8_t* input_1, const uint8_t* input_2,
+                          const uint8_t* secret, const uint64_t seed)
+{
+    acc.low += mix16(input_1, secret, seed);
+    acc.low ^= read64(input_2) + read64(input_2 + 8);
+    acc.high += mix16(input_2, secret + 16, seed);
+    acc.high ^= read64(input_1) + read64(input_1 + 8);
+    return acc;
+}
+
+static Hash128 xxh3_128_0to16(const uint8_t* input, const size_t len, const uint8_t* secret,
+                              uint64_t seed)
+{
+    if ( len > 8 ) {
+        auto bitflip_lo = (read64(secret + 32) ^ read64(secret + 40)) - seed;
+        auto bitflip_hi = (read64(secret + 48) ^ read64(secret + 56)) + seed;
+        auto input_lo = read64(input);
+        auto input_hi = read64(input + len - 8);
+
+        auto m128 = mul64to128(input_lo ^ input_hi ^ bitflip_lo, prime64_1);
+        m128.low += static_cast<uint64_t>(len - 1) << 54;
+        input_hi ^= bitflip_hi;
+        m128.high += input_hi + (input_hi & 0xFFFFFFFF) * (prime32_2 - 1);
+        m128.low ^= swap64(m128.high);
+
+        auto h128 = mul64to128(m128.low, prime64_2);
+        h128.high += m128.high * prime64_2;
+        return Hash128 { xxh3_avalanche(h128.low), xxh3_avalanche(h128.high) };
+    }
+
+    if ( len >= 4 ) {
+        seed ^= static_cast<uint64_t>(swap32(static_cast<uint32_t>(seed))) << 32;
+        auto input_lo = read32(input);
+        auto input_hi = read32(input + len - 4);
+        auto input64 = input_lo + (static_cast<uint64_t>(input_hi) << 32);
+        auto bitflip = (read64(secret + 16) ^ read64(secret + 24)) + seed;
+
+        auto m128 = mul64to128(input64 ^ bitflip, prime64_1 + (len << 2));
+        m128.high += m128.low << 1;
+        m128.low ^= m128.high >> 3;
+        m128.low ^= m128.low >> 35;
+        m128.low *= prime_mx2;
+        m128.low ^= m128.low >> 28;
+        m128.high = xxh3_avalanche(m128.high);
+        return m128;
+    }
+
+    if ( len > 0 ) {
+        auto combined_lo = (static_cast<uint32_t>(input[0]) << 16)
+            | (static_cast<uint32_t>(input[len >> 1]) << 24)
+            | static_cast<uint32_t>(input[len - 1]) | (static_cast<uint32_t>(len) << 8);
+        auto combined_hi = rotl32(swap32(combined_lo), 13);
+        auto bitflip_lo = (read32(secret) ^ read32(secret + 4)) + seed;
+        auto bitflip_hi = (read32(secret + 8) ^ read32(secret + 12)) - seed;
+        return Hash128 {
+            xxh64_avalanche(static_cast<uint64_t>(combined_lo) ^ bitflip_lo),
+            xxh64_avalanche(static_cast<uint64_t>(combined_hi) ^ bitflip_hi)
+        };
+    }
+
+    return Hash128 {
+        xxh64_avalanche(seed ^ read64(secret + 64) ^ read64(secret + 72)),
+        xxh64_avalanche(seed ^ read64(secret + 80) ^ read64(secret + 88))
+    };
+}
+
+static Hash128 xxh3_128_finish(const Hash128& acc, const size_t len, const uint64_t seed)
+{
+    auto low = acc.low + acc.high;
+    auto high = acc.low * prime64_1 + acc.high * prime64_4 + (len - seed) * prime64_2;
+    return Hash128 { xxh3_avalanche(low), 0 - xxh3_avalanche(high) };
+}
+
+static Hash128 xxh3_128_short(const uint8_t* input, const size_t len, const uint64_t seed)
+{
+    auto secret = xxh3_secret;
+    if ( len <= 16 ) {
+        return xxh3_128_0to16(input, len, secret, seed);
+    }
+
+    Hash128 acc { len * prime64_1, 0 };
+
+    if ( len <= 128 ) {
+        if ( len > 32 ) {
+            if ( len > 64 ) {
+                if ( len > 96 ) {
+                    acc = xxh3_mix32(acc, input + 48, input + len - 64, secret + 96, seed);
+                }
+                acc = xxh3_mix32(acc, input + 32, input + len - 48, secret + 64, seed);
+            }
+            acc = xxh3_mix32(acc, input + 16, input + len - 32, secret + 32, seed);
+        }
+        acc = xxh3_mix32(acc, input, input + len - 16, secret, seed);
+        return xxh3_128_finish(acc, len, seed);
+    }
+
+    auto rounds = len / 32;
+    for ( size_t i = 0; i < 4; ++i ) {
+        acc = xxh3_mix32(acc, input + 32 * i, input + 32 * i + 16, secret + 32 * i, seed);
+    }
+
+    acc.low = xxh3_avalanche(acc.low);
+    acc.high = xxh3_avalanche(acc.high);
+
+    for ( size_t i = 4; i < rounds; ++i ) {
+        acc = xxh3_mix32(acc, input + 32 * i, input + 32 * i + 16, secret + 3 + 32 * (i - 4),
+                         seed);
+    }
+
+    acc = xxh3_mix32(acc, input + len - 16, input + len - 32, secret + 136 - 17 - 16, 0 - seed);
+    return xxh3_128_finish(acc, len, seed);
+}
+
+Hash128 xxh3_128(const void* data, const size_t len, const uint64_t seed)
+{
+    auto input = static_cast<const uint8_t*>(data);
+    if ( len <= xxh3_midsize_max ) {
+        return xxh3_128_short(input, len, seed);
+    }
+
+    uint8_t seeded_secret[xxh3_secret_size];
+    auto secret = xxh3_secret;
+    if ( seed != 0 ) {
+        xxh3_init_secret(seeded_secret, seed);
+        secret = seeded_secret;
+    }
+
+    uint64_t acc[8];
+    xxh3_hash_long(acc, input, len, secret);
+    return xxh3_merge_128(acc, secret, len);
+}
+
+//==========================================
+//  StreamingHasher
+//==========================================
+
+constexpr size_t StreamingHasher::buffer_size_;
+constexpr size_t StreamingHasher::secret_size_;
+
+StreamingHasher::StreamingHasher(const uint64_t seed)
+{
+    reset(seed);
+}
+
+void StreamingHasher::reset(const uint64_t seed)
+{
+    xxh3_init_accs(acc_);
+    if ( seed == 0 ) {
+        memcpy(secret_, xxh3_secret, secret_size_);
+    } else {
+        xxh3_init_secret(secret_, seed);
+    }
+    buffered_size_ = 0;
+    stripes_so_far_ = 0;
+    total_len_ = 0;
+    seed_ = seed;
+}
+
+void StreamingHasher::update(const void* data, size_t len)
+{
+    static constexpr size_t buffer_stripes = buffer_size_ / xxh3_stripe_len;
+
+    auto input = static_cast<const uint8_t*>(data);
+    total_len_ += len;
+
+    if ( buffered_size_ + len <= buffer_size_ ) {
+        if ( len > 0 ) {
+            memcpy(buffer_ + buffered_size_, input, len);
+        }
+        buffered_size_ += len;
+        return;
+    }
+
+    // The buffer is only consumed once more data follows it so the final stripe is always
+    // available to the digest
+    if ( buffered_size_ > 0 ) {
+        auto fill = buffer_size_ - buffered_size_;
+        memcpy(buffer_ + buffered_size_, input, fill);
+        input += fill;
+        len -= fill;
+        xxh3_consume_stripes(acc_, &stripes_so_far_, buffer_, buffer_stripes, secret_);
+        buffered_size_ = 0;
+    }
+
+    if ( len > buffer_size_ ) {
+        auto stripes = (len - 1) / xxh3_stripe_len;
+        xxh3_consume_stripes(acc_, &stripes_so_far_, input, stripes, secret_);
+        input += stripes * xxh3_stripe_len;
+        len -= stripes * xxh3_stripe_len;
+
+        // Keeps the last consumed stripe in case fewer than a stripe's worth of bytes remain
+        memcpy(buffer_ + buffer_size_ - xxh3_stripe_len, input - xxh3_stripe_len,
+               xxh3_stripe_len);
+    }
+
+    memcpy(buffer_, input, len);
+    buffered_size_ = len;
+}
+
+void StreamingHasher::digest_long(uint64_t* acc) const
+{
+    memcpy(acc, acc_, sizeof(acc_));
+
+    uint8_t last_stripe[xxh3_stripe_len];
+    const uint8_t* last = nullptr;
+
+    if ( buffered_size_ >= xxh3_stripe_len ) {
+        auto stripes = (buffered_size_ - 1) / xxh3_stripe_len;
+        auto stripes_so_far = stripes_so_far_;
+        xxh3_consume_stripes(acc, &stripes_so_far, buffer_, stripes, secret_);
+        last = buffer_ + buffered_size_ - xxh3_stripe_len;
+    } else {
+        // The last stripe straddles the previously consumed data and the buffered bytes
+        auto catchup = xxh3_stripe_len - buffered_size_;
+        memcpy(last_stripe, buffer_ + buffer_size_ - catchup, catchup);
+        memcpy(last_stripe + catchup, buffer_, buffered_size_);
+        last = last_stripe;
+    }
+
+    xxh3_accumulate(acc, last, secret_ + xxh3_last_stripe_start, 1);
+}
+
+uint64_t StreamingHasher::digest64() const
+{
+    if ( total_len_ <= xxh3_midsize_max ) {
+        return xxh3_64(buffer_, static_cast<size_t>(total_len_), seed_);
+    }
+
+    uint64_t acc[8];
+    digest_long(acc);
+    return xxh3_merge_accs(acc, secret_ + xxh3_merge_start, total_len_ * prime64_1);
+}
+
+Hash128 StreamingHasher::digest128() const
+{
+    if ( total_len_ <= xxh3_midsize_max ) {
+        return xxh3_128(buffer_, static_cast<size_t>(total_len_), seed_);
+    }
+
+    uint64_t acc[8];
+    digest_long(acc);
+    return xxh3_merge_128(acc, secret_, total_len_);
+}
+
 
 } // namespace hash
 } // namespace sky
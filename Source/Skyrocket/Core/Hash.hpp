@@ -11,14 +11,405 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 namespace sky {
 namespace hash {
 
 
+struct Hash128 {
+    uint64_t low;
+    uint64_t high;
+};
+
+constexpr bool operator==(const Hash128& lhs, const Hash128& rhs)
+{
+    return lhs.low == rhs.low && lhs.high == rhs.high;
+}
+
+constexpr bool operator!=(const Hash128& lhs, const Hash128& rhs)
+{
+    return !(lhs == rhs);
+}
+
 uint32_t murmur3_32(const void* key, uint32_t len, uint32_t seed);
 
+/// @brief Hashes `len` bytes with XXH3, producing the same 64-bit hash as the reference
+/// implementation. Inputs longer than 240 bytes are hashed with SSE2 or AVX2 where available.
+/// Much faster than `murmur3_32` for anything but tiny keys and wide enough to use as an asset or
+/// pipeline state id without worrying about collisions
+uint64_t xxh3_64(const void* data, size_t len, uint64_t seed = 0);
+
+/// @brief Hashes `len` bytes with the 128-bit variant of XXH3
+Hash128 xxh3_128(const void* data, size_t len, uint64_t seed = 0);
+
+/// @brief Incrementally hashes data that arrives in pieces, i.e. streamed from disk. The digests
+/// are identical to hashing all the data at once with `xxh3_64` or `xxh3_128`
+class StreamingHasher {
+public:
+    explicit StreamingHasher(uint64_t seed = 0);
+
+    /// @brief Discards everything hashed so far to start a new hash
+    void reset(uint64_t seed = 0);
+
+    void update(const void* data, size_t len);
+
+    /// @brief Gets the hash of all data passed to `update` since the last reset. Can be called
+    /// more than once and hashing can continue afterwards
+    uint64_t digest64() const;
+
+    Hash128 digest128() const;
+
+private:
+    static constexpr size_t buffer_size_ = 256;
+    static constexpr size_t secret_size_ = 192;
+
+    uint64_t acc_[8];
+    uint8_t buffer_[buffer_size_];
+    uint8_t secret_[secret_size_];
+    size_t buffered_size_{0};
+    size_t stripes_so_far_{0};
+    uint64_t total_len_{0};
+    uint64_t seed_{0};
+
+    void digest_long(uint64_t* acc) const;
+};
+
+namespace detail {
+
+
+/// XXH3 implemented with only constexpr operations so string hashes can be computed at compile
+/// time. Inputs are read a byte at a time, which compilers fold into single loads at runtime, so
+/// the runtime hashes share this code for all but long inputs
+
+constexpr uint32_t prime32_1 = 0x9E3779B1U;
+constexpr uint32_t prime32_2 = 0x85EBCA77U;
+constexpr uint32_t prime32_3 = 0xC2B2AE3DU;
+constexpr uint64_t prime64_1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t prime64_2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t prime64_3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t prime64_4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t prime64_5 = 0x27D4EB2F165667C5ULL;
+constexpr uint64_t prime_mx1 = 0x165667919E3779F9ULL;
+constexpr uint64_t prime_mx2 = 0x9FB21C651E98DF25ULL;
+
+constexpr size_t xxh3_secret_size = 192;
+constexpr size_t xxh3_stripe_len = 64;
+constexpr size_t xxh3_midsize_max = 240;
+
+constexpr uint8_t xxh3_secret[xxh3_secret_size] = {
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+    0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+    0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+    0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+    0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+    0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+    0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+    0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+    0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+    0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+    0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+    0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e
+};
+
+template <typename Byte>
+constexpr uint32_t read32(const Byte* p)
+{
+    return static_cast<uint32_t>(static_cast<uint8_t>(p[0]))
+        | static_cast<uint32_t>(static_cast<uint8_t>(p[1])) << 8
+        | static_cast<uint32_t>(static_cast<uint8_t>(p[2])) << 16
+        | static_cast<uint32_t>(static_cast<uint8_t>(p[3])) << 24;
+}
+
+template <typename Byte>
+constexpr uint64_t read64(const Byte* p)
+{
+    return static_cast<uint64_t>(read32(p)) | static_cast<uint64_t>(read32(p + 4)) << 32;
+}
+
+constexpr uint32_t swap32(const uint32_t x)
+{
+    return ((x << 24) & 0xff000000) | ((x << 8) & 0x00ff0000) | ((x >> 8) & 0x0000ff00)
+        | ((x >> 24) & 0x000000ff);
+}
+
+constexpr uint64_t swap64(const uint64_t x)
+{
+    return static_cast<uint64_t>(swap32(static_cast<uint32_t>(x))) << 32
+        | swap32(static_cast<uint32_t>(x >> 32));
+}
+
+constexpr uint32_t rotl32(const uint32_t x, const int r)
+{
+    return (x << r) | (x >> (32 - r));
+}
+
+constexpr uint64_t rotl64(const uint64_t x, const int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+constexpr Hash128 mul64to128(const uint64_t lhs, const uint64_t rhs)
+{
+#if defined(__SIZEOF_INT128__)
+    return Hash128 {
+        static_cast<uint64_t>(static_cast<unsigned __int128>(lhs) * rhs),
+        static_cast<uint64_t>((static_cast<unsigned __int128>(lhs) * rhs) >> 64)
+    };
+#else
+    uint64_t lo_lo = (lhs & 0xFFFFFFFF) * (rhs & 0xFFFFFFFF);
+    uint64_t hi_lo = (lhs >> 32) * (rhs & 0xFFFFFFFF);
+    uint64_t lo_hi = (lhs & 0xFFFFFFFF) * (rhs >> 32);
+    uint64_t hi_hi = (lhs >> 32) * (rhs >> 32);
+    uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+    return Hash128 {
+        (cross << 32) | (lo_lo & 0xFFFFFFFF),
+        (hi_lo >> 32) + (cross >> 32) + hi_hi
+    };
+#endif
+}
+
+constexpr uint64_t mul128_fold64(const uint64_t lhs, const uint64_t rhs)
+{
+    auto product = mul64to128(lhs, rhs);
+    return product.low ^ product.high;
+}
+
+constexpr uint64_t xxh64_avalanche(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= prime64_2;
+    h ^= h >> 29;
+    h *= prime64_3;
+    h ^= h >> 32;
+    return h;
+}
+
+constexpr uint64_t xxh3_avalanche(uint64_t h)
+{
+    h ^= h >> 37;
+    h *= prime_mx1;
+    h ^= h >> 32;
+    return h;
+}
+
+constexpr uint64_t rrmxmx(uint64_t h, const uint64_t len)
+{
+    h ^= rotl64(h, 49) ^ rotl64(h, 24);
+    h *= prime_mx2;
+    h ^= (h >> 35) + len;
+    h *= prime_mx2;
+    h ^= h >> 28;
+    return h;
+}
+
+template <typename Byte>
+constexpr uint64_t mix16(const Byte* input, const uint8_t* secret, const uint64_t seed)
+{
+    return mul128_fold64(read64(input) ^ (read64(secret) + seed),
+                         read64(input + 8) ^ (read64(secret + 8) - seed));
+}
+
+template <typename Byte>
+constexpr uint64_t xxh3_64_0to16(const Byte* input, const size_t len, const uint8_t* secret,
+                                 uint64_t seed)
+{
+    if ( len > 8 ) {
+        auto bitflip1 = (read64(secret + 24) ^ read64(secret + 32)) + seed;
+        auto bitflip2 = (read64(secret + 40) ^ read64(secret + 48)) - seed;
+        auto input_lo = read64(input) ^ bitflip1;
+        auto input_hi = read64(input + len - 8) ^ bitflip2;
+        auto acc = len + swap64(input_lo) + input_hi + mul128_fold64(input_lo, input_hi);
+        return xxh3_avalanche(acc);
+    }
+
+    if ( len >= 4 ) {
+        seed ^= static_cast<uint64_t>(swap32(static_cast<uint32_t>(seed))) << 32;
+        auto input1 = read32(input);
+        auto input2 = read32(input + len - 4);
+        auto bitflip = (read64(secret + 8) ^ read64(secret + 16)) - seed;
+        auto input64 = input2 + (static_cast<uint64_t>(input1) << 32);
+        return rrmxmx(input64 ^ bitflip, len);
+    }
+
+    if ( len > 0 ) {
+        auto c1 = static_cast<uint8_t>(input[0]);
+        auto c2 = static_cast<uint8_t>(input[len >> 1]);
+        auto c3 = static_cast<uint8_t>(input[len - 1]);
+        auto combined = (static_cast<uint32_t>(c1) << 16) | (static_cast<uint32_t>(c2) << 24)
+            | static_cast<uint32_t>(c3) | (static_cast<uint32_t>(len) << 8);
+        auto bitflip = (read32(secret) ^ read32(secret + 4)) + seed;
+        return xxh64_avalanche(static_cast<uint64_t>(combined) ^ bitflip);
+    }
+
+    return xxh64_avalanche(seed ^ (read64(secret + 56) ^ read64(secret + 64)));
+}
+
+template <typename Byte>
+constexpr uint64_t xxh3_64_17to128(const Byte* input, const size_t len, const uint8_t* secret,
+                                   const uint64_t seed)
+{
+    uint64_t acc = len * prime64_1;
+    if ( len > 32 ) {
+        if ( len > 64 ) {
+            if ( len > 96 ) {
+                acc += mix16(input + 48, secret + 96, seed);
+                acc += mix16(input + len - 64, secret + 112, seed);
+            }
+            acc += mix16(input + 32, secret + 64, seed);
+            acc += mix16(input + len - 48, secret + 80, seed);
+        }
+        acc += mix16(input + 16, secret + 32, seed);
+        acc += mix16(input + len - 32, secret + 48, seed);
+    }
+    acc += mix16(input, secret, seed);
+    acc += mix16(input + len - 16, secret + 16, seed);
+    return xxh3_avalanche(acc);
+}
+
+template <typename Byte>
+constexpr uint64_t xxh3_64_129to240(const Byte* input, const size_t len, const uint8_t* secret,
+                                    const uint64_t seed)
+{
+    uint64_t acc = len * prime64_1;
+    auto rounds = len / 16;
+
+    for ( size_t i = 0; i < 8; ++i ) {
+        acc += mix16(input + 16 * i, secret + 16 * i, seed);
+    }
+
+    // The remaining rounds start 3 bytes into the secret and the last 16 bytes use the end of
+    // the minimum secret size
+    auto acc_end = mix16(input + len - 16, secret + 136 - 17, seed);
+    acc = xxh3_avalanche(acc);
+
+    for ( size_t i = 8; i < rounds; ++i ) {
+        acc_end += mix16(input + 16 * i, secret + 16 * (i - 8) + 3, seed);
+    }
+
+    return xxh3_avalanche(acc + acc_end);
+}
+
+template <typename Byte>
+constexpr void xxh3_accumulate_512(uint64_t* acc, const Byte* input, const uint8_t* secret)
+{
+    for ( size_t i = 0; i < 8; ++i ) {
+        auto data_val = read64(input + 8 * i);
+        auto data_key = data_val ^ read64(secret + 8 * i);
+        acc[i ^ 1] += data_val;
+        acc[i] += (data_key & 0xFFFFFFFF) * (data_key >> 32);
+    }
+}
+
+constexpr void xxh3_scramble(uint64_t* acc, const uint8_t* secret)
+{
+    for ( size_t i = 0; i < 8; ++i ) {
+        auto acc64 = acc[i];
+        acc64 ^= acc64 >> 47;
+        acc64 ^= read64(secret + 8 * i);
+        acc64 *= prime32_1;
+        acc[i] = acc64;
+    }
+}
+
+constexpr uint64_t xxh3_merge_accs(const uint64_t* acc, const uint8_t* secret, uint64_t start)
+{
+    for ( size_t i = 0; i < 4; ++i ) {
+        start += mul128_fold64(acc[2 * i] ^ read64(secret + 16 * i),
+                               acc[2 * i + 1] ^ read64(secret + 16 * i + 8));
+    }
+    return xxh3_avalanche(start);
+}
+
+constexpr void xxh3_init_accs(uint64_t* acc)
+{
+    acc[0] = prime32_3;
+    acc[1] = prime64_1;
+    acc[2] = prime64_2;
+    acc[3] = prime64_3;
+    acc[4] = prime64_4;
+    acc[5] = prime32_2;
+    acc[6] = prime64_5;
+    acc[7] = prime32_1;
+}
+
+/// Derives the secret used for seeded hashes of long inputs
+constexpr void xxh3_init_secret(uint8_t* secret, const uint64_t seed)
+{
+    for ( size_t i = 0; i < xxh3_secret_size / 16; ++i ) {
+        auto lo = read64(xxh3_secret + 16 * i) + seed;
+        auto hi = read64(xxh3_secret + 16 * i + 8) - seed;
+        for ( size_t b = 0; b < 8; ++b ) {
+            secret[16 * i + b] = static_cast<uint8_t>(lo >> (8 * b));
+            secret[16 * i + 8 + b] = static_cast<uint8_t>(hi >> (8 * b));
+        }
+    }
+}
+
+template <typename Byte>
+constexpr uint64_t xxh3_64_long(const Byte* input, const size_t len, const uint64_t seed)
+{
+    uint8_t secret[xxh3_secret_size] = {};
+    xxh3_init_secret(secret, seed);
+
+    uint64_t acc[8] = {};
+    xxh3_init_accs(acc);
+
+    constexpr size_t stripes_per_block = (xxh3_secret_size - xxh3_stripe_len) / 8;
+    constexpr size_t block_len = xxh3_stripe_len * stripes_per_block;
+    auto blocks = (len - 1) / block_len;
+
+    for ( size_t b = 0; b < blocks; ++b ) {
+        for ( size_t s = 0; s < stripes_per_block; ++s ) {
+            xxh3_accumulate_512(acc, input + b * block_len + s * xxh3_stripe_len, secret + s * 8);
+        }
+        xxh3_scramble(acc, secret + xxh3_secret_size - xxh3_stripe_len);
+    }
+
+    auto stripes = ((len - 1) - block_len * blocks) / xxh3_stripe_len;
+    for ( size_t s = 0; s < stripes; ++s ) {
+        xxh3_accumulate_512(acc, input + blocks * block_len + s * xxh3_stripe_len, secret + s * 8);
+    }
+
+    xxh3_accumulate_512(acc, input + len - xxh3_stripe_len,
+                        secret + xxh3_secret_size - xxh3_stripe_len - 7);
+    return xxh3_merge_accs(acc, secret + 11, len * prime64_1);
+}
+
+template <typename Byte>
+constexpr uint64_t xxh3_64_short(const Byte* input, const size_t len, const uint64_t seed)
+{
+    if ( len <= 16 ) {
+        return xxh3_64_0to16(input, len, xxh3_secret, seed);
+    }
+
+    if ( len <= 128 ) {
+        return xxh3_64_17to128(input, len, xxh3_secret, seed);
+    }
+
+    return xxh3_64_129to240(input, len, xxh3_secret, seed);
+}
+
+
+} // namespace detail
+
+/// @brief Hashes a string at compile time, i.e. `constexpr auto id = string_hash("Shaders/basic")`.
+/// The hash is identical to `xxh3_64` of the same characters so ids computed at compile time can
+/// be compared against ids computed at runtime
+constexpr uint64_t string_hash(const char* str, const size_t len, const uint64_t seed = 0)
+{
+    return len <= detail::xxh3_midsize_max ? detail::xxh3_64_short(str, len, seed)
+                                           : detail::xxh3_64_long(str, len, seed);
+}
+
+/// @brief Hashes a string literal at compile time, excluding its null terminator
+template <size_t N>
+constexpr uint64_t string_hash(const char (&str)[N], const uint64_t seed = 0)
+{
+    return string_hash(str, N - 1, seed);
+}
+
 
 } // namespace hash
-} // namespace sky
\ No newline at end of file
+} // namespace sky
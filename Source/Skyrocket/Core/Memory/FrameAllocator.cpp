@@ -0,0 +1,191 @@
+//
+//  FrameAllocator.cpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#include "Skyrocket/Core/Memory/FrameAllocator.hpp"
+#include "Skyrocket/Core/Diagnostics/Error.hpp"
+#include "Skyrocket/Core/Memory/Memory.hpp"
+
+#include <cinttypes>
+#include <cstddef>
+
+namespace sky {
+
+
+constexpr uint32_t FrameAllocator::max_frames;
+constexpr size_t FrameAllocator::local_chunk_size;
+
+/// The chunk of a frame allocator's region cached by each thread for `allocate_local`
+struct FrameLocalChunk {
+    uint64_t epoch{0};
+    uint8_t* cursor{nullptr};
+    uint8_t* end{nullptr};
+};
+
+/// Each thread caches a chunk per allocator so alternating between allocators doesn't throw
+/// chunks away. Allocators are spread over the slots by id - two sharing a slot still works as
+/// epochs are unique, it just costs a new chunk whenever the thread switches between them
+static constexpr uint32_t frame_local_slots = 8;
+static thread_local FrameLocalChunk frame_local_chunks[frame_local_slots];
+
+FrameAllocator::FrameAllocator(const size_t frame_capacity, const uint32_t frame_count)
+    : frame_capacity_(frame_capacity), frame_count_(frame_count)
+{
+    static std::atomic<uint32_t> next_id{0};
+    id_ = next_id.fetch_add(1, std::memory_order_relaxed);
+
+    SKY_ASSERT(frame_count > 0 && frame_count <= max_frames,
+               "Frame allocators have between 1 and %" PRIu32 " frames", max_frames);
+
+    memory_ = new uint8_t[frame_capacity_ * frame_count_];
+    reset();
+}
+
+FrameAllocator::~FrameAllocator()
+{
+    delete[] memory_;
+}
+
+void FrameAllocator::next_epoch()
+{
+    // Epochs come from one counter shared by every allocator so a thread's cached chunk can't
+    // be mistaken for one belonging to a different allocator
+    static std::atomic<uint64_t> epoch_source{0};
+    epoch_.store(epoch_source.fetch_add(1, std::memory_order_relaxed) + 1,
+                 std::memory_order_release);
+}
+
+uint8_t* FrameAllocator::bump(const size_t byte_size, const size_t alignment)
+{
+    auto base = region();
+    auto base_address = reinterpret_cast<uintptr_t>(base);
+    auto offset = offset_.load(std::memory_order_relaxed);
+    size_t aligned = 0;
+
+    do {
+        aligned = ((base_address + offset + alignment - 1) & ~(alignment - 1)) - base_address;
+        if ( aligned + byte_size > frame_capacity_ || aligned + byte_size < aligned ) {
+            return nullptr;
+        }
+    } while ( !offset_.compare_exchange_weak(offset, aligned + byte_size,
+                                             std::memory_order_relaxed) );
+
+    return base + aligned;
+}
+
+void* FrameAllocator::allocate(const size_t byte_size, const size_t alignment)
+{
+    if ( !is_power_of_two(alignment) ) {
+        SKY_ERROR("FrameAllocator", "Alignment must be a power of two");
+        return nullptr;
+    }
+
+    auto memory = bump(byte_size, alignment);
+    if ( memory == nullptr ) {
+        SKY_ERROR("FrameAllocator", "Unable to allocate %zu bytes: the frame has %zu of %zu "
+            "bytes available", byte_size, frame_capacity_ - frame_size(), frame_capacity_);
+    }
+
+    return memory;
+}
+
+void* FrameAllocator::allocate_local(const size_t byte_size, const size_t alignment)
+{
+    if ( byte_size > local_chunk_size / 4 || alignment > alignof(std::max_align_t) ) {
+        return allocate(byte_size, alignment);
+    }
+
+    if ( !is_power_of_two(alignment) ) {
+        SKY_ERROR("FrameAllocator", "Alignment must be a power of two");
+        return nullptr;
+    }
+
+    auto& chunk = frame_local_chunks[id_ % frame_local_slots];
+    auto epoch = epoch_.load(std::memory_order_acquire);
+
+    if ( chunk.epoch == epoch ) {
+        auto ptr = static_cast<uint8_t*>(align(chunk.cursor, alignment));
+        if ( ptr + byte_size <= chunk.end ) {
+            chunk.cursor = ptr + byte_size;
+            return ptr;
+        }
+    }
+
+    // The rest of the old chunk is abandoned until the region is reused. Once the region is
+    // too full for another chunk, allocations are made from what's left of it directly
+    auto memory = bump(local_chunk_size, alignof(std::max_align_t));
+    if ( memory == nullptr ) {
+        return allocate(byte_size, alignment);
+    }
+
+    chunk.epoch = epoch;
+    chunk.cursor = memory + byte_size;
+    chunk.end = memory + local_chunk_size;
+    return memory;
+}
+
+void FrameAllocator::free(void* /*ptr*/)
+{
+    // Memory is freed all at once when the frame's region is reused
+}
+
+void FrameAllocator::reset()
+{
+    frame_index_ = 0;
+    frame_ = 0;
+    offset_.store(0, std::memory_order_relaxed);
+    next_epoch();
+}
+
+bool FrameAllocator::is_valid(void* ptr) const
+{
+    return ptr >= memory_ && ptr < memory_ + frame_capacity_ * frame_count_;
+}
+
+void FrameAllocator::begin_frame()
+{
+    if ( frame_count_ == 0 ) {
+        SKY_ERROR("FrameAllocator", "Cannot begin a frame before the allocator has any regions");
+        return;
+    }
+
+    frame_index_ = (frame_index_ + 1) % frame_count_;
+    ++frame_;
+    offset_.store(0, std::memory_order_relaxed);
+    next_epoch();
+}
+
+FrameAllocator::Marker FrameAllocator::marker() const
+{
+    Marker marker;
+    marker.frame = frame_;
+    marker.offset = offset_.load(std::memory_order_relaxed);
+    return marker;
+}
+
+void FrameAllocator::rewind(const Marker& marker)
+{
+    if ( marker.frame != frame_ || marker.offset > offset_.load(std::memory_order_relaxed) ) {
+        return;
+    }
+
+    offset_.store(marker.offset, std::memory_order_relaxed);
+
+    // Chunks cached by threads may lie past the marker so they have to be carved again
+    next_epoch();
+}
+
+size_t FrameAllocator::frame_size() const
+{
+    return offset_.load(std::memory_order_relaxed);
+}
+
+
+} // namespace sky
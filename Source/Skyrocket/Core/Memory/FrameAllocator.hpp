@@ -0,0 +1,155 @@
+//
+//  FrameAllocator.hpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#pragma once
+
+#include "Skyrocket/Core/Memory/Allocator.hpp"
+
+#include <atomic>
+#include <cstdint>
+
+namespace sky {
+
+
+/// @brief A linear allocator for scratch memory that only needs to live for a frame or so, i.e.
+/// culling lists, sort keys and text vertices. Memory is split into one region per frame in
+/// flight and allocating just bumps an offset into the current region, so it costs about as much
+/// as a few instructions. `begin_frame` moves on to the next region and empties it in O(1)
+/// without zeroing anything - memory allocated during a frame stays valid until `begin_frame`
+/// has been called `frame_count` more times, which lets frames still being processed by the
+/// render thread or GPU keep reading their data.
+///
+/// `allocate` and `allocate_local` can be called from any thread during a frame. `allocate`
+/// bumps a shared atomic offset while `allocate_local` bumps a chunk cached by the calling thread
+/// which avoids contention between job workers allocating lots of small blocks. Everything else
+/// has to be called from a single thread while no other thread is allocating
+class FrameAllocator : public Allocator {
+public:
+    using Allocator::allocate;
+
+    /// @brief Position in the current frame's region that the frame can be rewound to with
+    /// `rewind`
+    struct Marker {
+        uint64_t frame{0};
+        size_t offset{0};
+    };
+
+    static constexpr uint32_t max_frames = 8;
+
+    /// Size of the chunks each thread carves out of the current region for `allocate_local`
+    static constexpr size_t local_chunk_size = 16 * 1024;
+
+    FrameAllocator() = default;
+
+    /// @brief Allocates `frame_count` regions of `frame_capacity` bytes each
+    explicit FrameAllocator(size_t frame_capacity, uint32_t frame_count = 2);
+
+    FrameAllocator(const FrameAllocator& other) = delete;
+    FrameAllocator& operator=(const FrameAllocator& other) = delete;
+
+    ~FrameAllocator();
+
+    /// @brief Allocates from the current frame's region
+    /// @return nullptr if the region is full or `alignment` isn't a power of two
+    void* allocate(size_t byte_size, size_t alignment) override;
+
+    template <typename T>
+    T* allocate_array(const size_t count)
+    {
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    /// @brief Allocates from a chunk of the current frame's region cached by the calling thread.
+    /// Allocations larger than a quarter of a chunk go straight to `allocate`
+    void* allocate_local(size_t byte_size, size_t alignment);
+
+    /// @brief Does nothing - memory is freed when its frame's region is reused
+    void free(void* ptr) override;
+
+    /// @brief Empties every region and starts again from the first
+    void reset() override;
+
+    bool is_valid(void* ptr) const override;
+
+    /// @brief Moves on to the next frame's region and empties it
+    void begin_frame();
+
+    /// @brief Gets a marker at the current position in the frame's region
+    Marker marker() const;
+
+    /// @brief Frees everything allocated in the current frame since `marker` was taken.
+    /// Markers from earlier frames are ignored
+    void rewind(const Marker& marker);
+
+    /// @brief Gets the number of bytes allocated in the current frame
+    size_t frame_size() const;
+
+    inline size_t frame_capacity() const
+    {
+        return frame_capacity_;
+    }
+
+    inline uint32_t frame_count() const
+    {
+        return frame_count_;
+    }
+
+    /// @brief Gets the number of times `begin_frame` has been called since the last reset
+    inline uint64_t frame() const
+    {
+        return frame_;
+    }
+
+private:
+    uint8_t* memory_{nullptr};
+    uint32_t id_{0};
+    size_t frame_capacity_{0};
+    uint32_t frame_count_{0};
+    uint32_t frame_index_{0};
+    uint64_t frame_{0};
+
+    /// Unique across every allocator and changed on every `begin_frame`, `rewind` and `reset` so
+    /// threads can tell when their cached chunk is no longer part of the current region
+    std::atomic<uint64_t> epoch_{0};
+    std::atomic<size_t> offset_{0};
+
+    inline uint8_t* region() const
+    {
+        return memory_ + static_cast<size_t>(frame_index_) * frame_capacity_;
+    }
+
+    uint8_t* bump(size_t byte_size, size_t alignment);
+    void next_epoch();
+};
+
+/// @brief Rewinds a frame allocator to where it was when the scope was created, freeing every
+/// allocation made while it was alive, i.e. temporary buffers used while building a frame
+class FrameScope {
+public:
+    explicit FrameScope(FrameAllocator* allocator)
+        : allocator_(allocator), marker_(allocator->marker())
+    {}
+
+    FrameScope(const FrameScope& other) = delete;
+    FrameScope& operator=(const FrameScope& other) = delete;
+
+    ~FrameScope()
+    {
+        allocator_->rewind(marker_);
+    }
+
+private:
+    FrameAllocator* allocator_;
+    FrameAllocator::Marker marker_;
+};
+
+
+} // namespace sky
@@ -0,0 +1,314 @@
+//
+//  PoolAllocator.cpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#include "Skyrocket/Core/Memory/PoolAllocator.hpp"
+#include "Skyrocket/Core/Diagnostics/Error.hpp"
+#include "Skyrocket/Core/Memory/Memory.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <thread>
+#include <utility>
+
+namespace sky {
+
+
+constexpr uint32_t FixedPoolAllocator::null_block;
+constexpr uint32_t FixedPoolAllocator::magazine_count;
+constexpr uint32_t FixedPoolAllocator::magazine_size;
+
+static uint64_t make_pool_head(const uint64_t tag, const uint32_t index)
+{
+    return (tag << 32) | index;
+}
+
+FixedPoolAllocator::FixedPoolAllocator(const size_t block_size, const uint32_t max_blocks,
+                                       const size_t alignment, const bool zero_blocks)
+    : block_size_(block_size), max_blocks_(max_blocks), zero_blocks_(zero_blocks)
+{
+    SKY_ASSERT(block_size > 0, "`block_size` is larger than zero");
+    SKY_ASSERT(max_blocks < null_block, "`max_blocks` is less than %u", null_block);
+
+    alignment_ = alignment;
+    if ( alignment_ == 0 ) {
+        // The lowest set bit is the largest power of two that divides the block size
+        alignment_ = block_size & (~block_size + 1);
+        if ( alignment_ > alignof(std::max_align_t) ) {
+            alignment_ = alignof(std::max_align_t);
+        }
+    }
+
+    SKY_ASSERT(is_power_of_two(alignment_), "Pool alignment (%zu) is a power of two", alignment_);
+
+    stride_ = (block_size_ + alignment_ - 1) & ~(alignment_ - 1);
+    memory_ = new uint8_t[stride_ * max_blocks_ + alignment_ - 1];
+    blocks_ = static_cast<uint8_t*>(align(memory_, alignment_));
+    next_.reset(new std::atomic<uint32_t>[max_blocks_]);
+    magazines_.reset(new Magazine[magazine_count]);
+
+    reset();
+}
+
+FixedPoolAllocator::FixedPoolAllocator(FixedPoolAllocator&& other) noexcept
+{
+    take(other);
+}
+
+FixedPoolAllocator& FixedPoolAllocator::operator=(FixedPoolAllocator&& other) noexcept
+{
+    if ( this != &other ) {
+        delete[] memory_;
+        take(other);
+    }
+
+    return *this;
+}
+
+FixedPoolAllocator::~FixedPoolAllocator()
+{
+    delete[] memory_;
+}
+
+void FixedPoolAllocator::take(FixedPoolAllocator& other)
+{
+    memory_ = other.memory_;
+    blocks_ = other.blocks_;
+    block_size_ = other.block_size_;
+    stride_ = other.stride_;
+    alignment_ = other.alignment_;
+    max_blocks_ = other.max_blocks_;
+    zero_blocks_ = other.zero_blocks_;
+    next_ = std::move(other.next_);
+    magazines_ = std::move(other.magazines_);
+    head_.store(other.head_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    blocks_initialized_.store(other.blocks_initialized_.load(std::memory_order_relaxed),
+                              std::memory_order_relaxed);
+
+    other.memory_ = nullptr;
+    other.blocks_ = nullptr;
+    other.max_blocks_ = 0;
+    other.head_.store(null_block, std::memory_order_relaxed);
+    other.blocks_initialized_.store(0, std::memory_order_relaxed);
+}
+
+FixedPoolAllocator::Magazine& FixedPoolAllocator::thread_magazine() const
+{
+    static std::atomic<uint32_t> next_thread{0};
+    thread_local uint32_t thread_index = next_thread.fetch_add(1, std::memory_order_relaxed);
+    return magazines_[thread_index % magazine_count];
+}
+
+bool FixedPoolAllocator::pop_shared(uint32_t* index)
+{
+    auto head = head_.load(std::memory_order_acquire);
+    while ( true ) {
+        auto first = static_cast<uint32_t>(head);
+        if ( first == null_block ) {
+            return false;
+        }
+
+        // If another thread pops `first` before the exchange, the link read here may be stale
+        // but the tag will have changed so the exchange fails and the link is read again
+        auto next = next_[first].load(std::memory_order_relaxed);
+        auto new_head = make_pool_head((head >> 32) + 1, next);
+        if ( head_.compare_exchange_weak(head, new_head, std::memory_order_acquire,
+                                         std::memory_order_acquire) ) {
+            *index = first;
+            return true;
+        }
+    }
+}
+
+void FixedPoolAllocator::push_shared(const uint32_t index)
+{
+    auto head = head_.load(std::memory_order_relaxed);
+    uint64_t new_head = 0;
+    do {
+        next_[index].store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+        new_head = make_pool_head((head >> 32) + 1, index);
+    } while ( !head_.compare_exchange_weak(head, new_head, std::memory_order_release,
+                                           std::memory_order_relaxed) );
+}
+
+void FixedPoolAllocator::refill(Magazine& magazine)
+{
+    // Blocks are stored in reverse so the magazine hands them out in the same order as the
+    // shared list, which keeps consecutive allocations adjacent in memory
+    uint32_t popped[magazine_size / 2];
+    uint32_t count = 0;
+    while ( count < magazine_size / 2 && pop_shared(&popped[count]) ) {
+        ++count;
+    }
+
+    for ( uint32_t i = 0; i < count; ++i ) {
+        magazine.blocks[i] = popped[count - 1 - i];
+    }
+    magazine.count = count;
+}
+
+bool FixedPoolAllocator::steal(uint32_t* index)
+{
+    // Magazines busy with their own thread are skipped at first, then waited on so blocks cached
+    // by other threads are always found. Magazines are only ever locked briefly and never while
+    // holding another, so waiting can't deadlock
+    for ( uint32_t pass = 0; pass < 2; ++pass ) {
+        for ( uint32_t i = 0; i < magazine_count; ++i ) {
+            auto& magazine = magazines_[i];
+            if ( magazine.locked.test_and_set(std::memory_order_acquire) ) {
+                if ( pass == 0 ) {
+                    continue;
+                }
+
+                while ( magazine.locked.test_and_set(std::memory_order_acquire) ) {
+                    std::this_thread::yield();
+                }
+            }
+
+            auto found = magazine.count > 0;
+            if ( found ) {
+                *index = magazine.blocks[--magazine.count];
+            }
+
+            magazine.locked.clear(std::memory_order_release);
+            if ( found ) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void* FixedPoolAllocator::allocate(const size_t byte_size, const size_t alignment)
+{
+    if ( byte_size > block_size_ || alignment > alignment_ || !is_power_of_two(alignment) ) {
+        SKY_ERROR("FixedPoolAllocator", "Unable to allocate %zu bytes aligned to %zu from a pool "
+            "of %zu byte blocks aligned to %zu", byte_size, alignment, block_size_, alignment_);
+        return nullptr;
+    }
+
+    // A block is claimed from the count before searching for one, so the pool only reports
+    // it's exhausted when every block really is allocated. Once claimed, a free block is
+    // guaranteed to be cached somewhere
+    auto allocated = blocks_initialized_.load(std::memory_order_relaxed);
+    do {
+        if ( allocated >= max_blocks_ ) {
+            return nullptr;
+        }
+    } while ( !blocks_initialized_.compare_exchange_weak(allocated, allocated + 1,
+                                                         std::memory_order_relaxed) );
+
+    auto index = null_block;
+    auto& magazine = thread_magazine();
+    while ( true ) {
+        if ( !magazine.locked.test_and_set(std::memory_order_acquire) ) {
+            if ( magazine.count == 0 ) {
+                refill(magazine);
+            }
+
+            if ( magazine.count > 0 ) {
+                index = magazine.blocks[--magazine.count];
+            }
+
+            magazine.locked.clear(std::memory_order_release);
+        }
+
+        // Blocks cached by other threads are only taken once the shared list is empty
+        if ( index != null_block || pop_shared(&index) || steal(&index) ) {
+            break;
+        }
+
+        // The claimed block is still on its way back from a concurrent `free`
+        std::this_thread::yield();
+    }
+
+    auto block = block_at(index);
+    if ( zero_blocks_ ) {
+        memset(block, 0, block_size_);
+    }
+
+    return block;
+}
+
+void FixedPoolAllocator::free(void* ptr)
+{
+    if ( ptr == nullptr ) {
+        SKY_ERROR("FixedPoolAllocator", "tried to free a null pointer");
+        return;
+    }
+
+    if ( !is_valid(ptr) ) {
+        SKY_ERROR("FixedPoolAllocator",
+                  "attempted to free memory that wasn't allocated by the pool");
+        return;
+    }
+
+    auto offset = static_cast<size_t>(static_cast<uint8_t*>(ptr) - blocks_);
+    if ( offset % stride_ != 0 ) {
+        SKY_ERROR("FixedPoolAllocator", "attempted to free a pointer into the middle of a block");
+        return;
+    }
+
+    // Checked and decremented in one step so two threads freeing the last allocated block at
+    // once can't both succeed
+    auto allocated = blocks_initialized_.load(std::memory_order_relaxed);
+    do {
+        if ( allocated == 0 ) {
+            SKY_ERROR("FixedPoolAllocator",
+                      "tried to free more blocks than the pool has available");
+            return;
+        }
+    } while ( !blocks_initialized_.compare_exchange_weak(allocated, allocated - 1,
+                                                         std::memory_order_relaxed) );
+
+    auto index = static_cast<uint32_t>(offset / stride_);
+    auto& magazine = thread_magazine();
+    if ( magazine.locked.test_and_set(std::memory_order_acquire) ) {
+        push_shared(index);
+        return;
+    }
+
+    // A full magazine returns its oldest half to the shared list so other threads can use them
+    if ( magazine.count == magazine_size ) {
+        constexpr uint32_t half = magazine_size / 2;
+        for ( uint32_t i = 0; i < half; ++i ) {
+            push_shared(magazine.blocks[i]);
+        }
+
+        memmove(magazine.blocks, magazine.blocks + half, half * sizeof(uint32_t));
+        magazine.count = half;
+    }
+
+    magazine.blocks[magazine.count++] = index;
+    magazine.locked.clear(std::memory_order_release);
+}
+
+void FixedPoolAllocator::reset()
+{
+    for ( uint32_t i = 0; i < max_blocks_; ++i ) {
+        next_[i].store(i + 1 < max_blocks_ ? i + 1 : null_block, std::memory_order_relaxed);
+    }
+
+    for ( uint32_t i = 0; magazines_ != nullptr && i < magazine_count; ++i ) {
+        magazines_[i].count = 0;
+    }
+
+    head_.store(max_blocks_ > 0 ? 0 : null_block, std::memory_order_release);
+    blocks_initialized_.store(0, std::memory_order_relaxed);
+}
+
+bool FixedPoolAllocator::is_valid(void* ptr) const
+{
+    return ptr >= blocks_ && ptr < blocks_ + stride_ * max_blocks_;
+}
+
+
+} // namespace sky
@@ -12,17 +12,24 @@
 #pragma once
 
 #include "Skyrocket/Core/Memory/Allocator.hpp"
-#include "Skyrocket/Core/Diagnostics/Error.hpp"
 
+#include <atomic>
 #include <cstdint>
+#include <memory>
 
 namespace sky {
 
 
-// TODO(Jacob): Implement alignment
-
 /// A pool of fixed-size that allocates raw memory in same-sized blocks. All memory managed by the
 /// allocator is created at construction and deleted at destruction.
+///
+/// `allocate` and `free` can be called from any number of threads at once. Free blocks are linked
+/// in a lock-free list whose head is tagged with a counter that changes on every push and pop, so
+/// a thread that was preempted mid-pop can't mistake a block that was popped and pushed again for
+/// the list it saw. Each thread also caches a small magazine of blocks so most allocations and
+/// frees never touch the shared list at all. When the list is empty an allocation takes blocks
+/// from other threads' magazines, briefly waiting for any that are in use, so it only fails once
+/// every block is allocated. `reset` and moving the allocator aren't thread-safe
 class FixedPoolAllocator : public Allocator {
 public:
     using Allocator::allocate;
@@ -30,107 +37,33 @@ public:
     FixedPoolAllocator() = default;
 
     /// Initializes the allocator with `block_size` bytes allocated per memory block and
-    /// `max_blocks` number of blocks capacity
-    FixedPoolAllocator(const size_t block_size, const uint32_t max_blocks)
-    {
-        SKY_ASSERT(block_size >= sizeof(void*), "`block_size` is larger than sizeof void* (%lu)",
-                   sizeof(void*));
-
-        block_size_ = block_size;
-        max_blocks_ = max_blocks;
-        memory_ = new uint8_t[block_size_ * max_blocks_];
-
-        reset();
-    }
+    /// `max_blocks` number of blocks capacity. Blocks are aligned to `alignment` which, if zero,
+    /// is the largest power of two that divides `block_size` up to the alignment of
+    /// std::max_align_t. If `zero_blocks` is true, every block is zeroed as it's allocated
+    FixedPoolAllocator(size_t block_size, uint32_t max_blocks, size_t alignment = 0,
+                       bool zero_blocks = true);
 
     FixedPoolAllocator(const FixedPoolAllocator& other) = delete;
     FixedPoolAllocator& operator=(const FixedPoolAllocator& other) = delete;
 
-    FixedPoolAllocator(FixedPoolAllocator&& other) noexcept
-    {
-        std::swap(memory_, other.memory_);
-        std::swap(next_, other.next_);
-        std::swap(block_size_, other.block_size_);
-        std::swap(max_blocks_, other.max_blocks_);
-        std::swap(blocks_initialized_, other.blocks_initialized_);
-    }
+    FixedPoolAllocator(FixedPoolAllocator&& other) noexcept;
 
-    FixedPoolAllocator& operator=(FixedPoolAllocator&& other) noexcept
-    {
-        std::swap(memory_, other.memory_);
-        std::swap(next_, other.next_);
-        std::swap(block_size_, other.block_size_);
-        std::swap(max_blocks_, other.max_blocks_);
-        std::swap(blocks_initialized_, other.blocks_initialized_);
+    FixedPoolAllocator& operator=(FixedPoolAllocator&& other) noexcept;
 
-        return *this;
-    }
+    ~FixedPoolAllocator();
 
-    ~FixedPoolAllocator()
-    {
-        delete[] memory_;
-    }
-
-    void* allocate(size_t byte_size, size_t alignment) override
-    {
-        // all blocks are of fixed size
-        if ( blocks_initialized_ == max_blocks_ ) {
-            return nullptr;
-        }
-
-        ++blocks_initialized_;
-
-        uint8_t* block = next_;
-        next_ = reinterpret_cast<uint8_t**>(next_)[0];
-        memset(block, 0, block_size_);
-        return block;
-    }
+    /// Allocates a block. Fails and returns nullptr if `byte_size` is larger than a block,
+    /// `alignment` is stricter than the pool's alignment or every block is allocated
+    void* allocate(size_t byte_size, size_t alignment) override;
 
     /// Frees memory allocated by `allocate()`. If the data wasn't allocated by the internal pool,
     /// this function causes undefined behaviour and will log an error
-    void free(void* ptr) override
-    {
-        if ( ptr == nullptr ) {
-            SKY_ERROR("FixedPoolAllocator", "tried to free a null pointer");
-            return;
-        }
-
-        if ( blocks_initialized_ <= 0 ) {
-            SKY_ERROR("FixedPoolAllocator",
-                      "tried to free more blocks than the pool has available");
-            return;
-        }
-
-        if ( !is_valid(ptr) ) {
-            SKY_ERROR("FixedPoolAllocator",
-                      "attempted to free memory that wasn't allocated by the pool");
-            return;
-        }
-
-        reinterpret_cast<uint8_t**>(ptr)[0] = next_;
-        next_ = static_cast<uint8_t*>(ptr);
-        --blocks_initialized_;
-    }
-
-    /// Resets the pool and zeroes out all memory
-    void reset() override
-    {
-        next_ = memory_;
-        blocks_initialized_ = 0;
-
-        uint8_t* ptr = &memory_[0];
-        uint8_t* last = &memory_[block_size_ * max_blocks_];
-        while ( ptr < last ) {
-            new (ptr) uint8_t*(ptr + block_size_);
+    void free(void* ptr) override;
 
-            ptr += block_size_;
-        }
-    }
+    /// Returns every block to the pool
+    void reset() override;
 
-    bool is_valid(void* ptr) const override
-    {
-        return ptr >= memory_ && ptr < memory_ + (block_size_ * max_blocks_);
-    }
+    bool is_valid(void* ptr) const override;
 
     /// Gets the maximum number of blocks the pool can allocate
     inline uint32_t block_capacity() const
@@ -141,17 +74,65 @@ public:
     /// Gets the current number of blocks allocated
     inline uint32_t blocks_initialized() const
     {
-        return blocks_initialized_;
+        return blocks_initialized_.load(std::memory_order_relaxed);
     }
+
+    inline size_t block_size() const
+    {
+        return block_size_;
+    }
+
+    inline size_t block_alignment() const
+    {
+        return alignment_;
+    }
+
 private:
+    static constexpr uint32_t null_block = UINT32_MAX;
+    static constexpr uint32_t magazine_count = 8;
+    static constexpr uint32_t magazine_size = 32;
+
+    /// A per-thread cache of free block indices. Threads are assigned magazines round-robin so
+    /// they can occasionally be shared - a thread that finds its own magazine locked just uses
+    /// the shared list instead of waiting
+    struct Magazine {
+        std::atomic_flag locked = ATOMIC_FLAG_INIT;
+        uint32_t count{0};
+        uint32_t blocks[magazine_size];
+    };
+
     uint8_t* memory_{nullptr};
-    uint8_t* next_{nullptr};
+    uint8_t* blocks_{nullptr};
 
     size_t block_size_{0};
+    size_t stride_{0};
+    size_t alignment_{0};
     uint32_t max_blocks_{0};
+    bool zero_blocks_{true};
+
+    /// The index of the next free block after each block. Kept outside the blocks themselves so
+    /// a thread reading a link that's concurrently being reallocated never races with the
+    /// block's new owner writing to it
+    std::unique_ptr<std::atomic<uint32_t>[]> next_;
+
+    /// Low 32 bits are the first free block's index and high 32 bits are the ABA tag
+    std::atomic<uint64_t> head_{null_block};
+
+    std::atomic<uint32_t> blocks_initialized_{0};
+    std::unique_ptr<Magazine[]> magazines_;
+
+    inline uint8_t* block_at(const uint32_t index) const
+    {
+        return blocks_ + index * stride_;
+    }
 
-    uint32_t blocks_initialized_{0};
+    Magazine& thread_magazine() const;
+    bool pop_shared(uint32_t* index);
+    void push_shared(uint32_t index);
+    void refill(Magazine& magazine);
+    bool steal(uint32_t* index);
+    void take(FixedPoolAllocator& other);
 };
 
 
-}
\ No newline at end of file
+} // namespace sky
@@ -15,6 +15,8 @@
 #include "Skyrocket/Core/Memory/Memory.hpp"
 #include "Skyrocket/Core/Memory/Allocator.hpp"
 
+#include <cstring>
+
 namespace sky {
 
 
@@ -25,8 +27,8 @@ public:
     explicit FixedStackAllocator(const size_t capacity)
         : cursor_(0), capacity_(capacity), buffer_(nullptr)
     {
-        buffer_ = new uint8_t[capacity_];
-        reset();
+        // Zeroed once up front - after that only the bytes actually used are zeroed on a free
+        buffer_ = new uint8_t[capacity_]();
     }
 
     ~FixedStackAllocator()
@@ -36,19 +38,20 @@ public:
 
     void* allocate(const size_t byte_size, const size_t alignment) override
     {
-        if (cursor_ + byte_size >= capacity_) {
-            SKY_ERROR("FixedStackAllocator",
-                      "Unable to allocate more memory than the allocator has available");
-            return nullptr;
-        }
-
         if (!is_power_of_two(alignment)) {
             SKY_ERROR("FixedStackAllocator", "Alignment must be a power of two");
             return nullptr;
         }
 
         auto ptr = align(&buffer_[cursor_], alignment);
-        cursor_ = (static_cast<uint8_t*>(ptr) - buffer_) + byte_size;
+        auto offset = static_cast<size_t>(static_cast<uint8_t*>(ptr) - buffer_);
+        if (offset + byte_size > capacity_) {
+            SKY_ERROR("FixedStackAllocator",
+                      "Unable to allocate more memory than the allocator has available");
+            return nullptr;
+        }
+
+        cursor_ = offset + byte_size;
         return ptr;
     }
 
@@ -61,7 +64,7 @@ public:
 
     void free_to_cursor(const size_t cursor)
     {
-        if (cursor >= cursor_) {
+        if (cursor > cursor_) {
             SKY_ERROR("FixedStackAllocator",
                       "Cannot free to cursor (%zu) larger than the allocators current "
                           "size (%zu) or capacity (%zu)",
@@ -69,8 +72,10 @@ public:
             return;
         }
 
+        // Everything past the old cursor is still zeroed from the last free so only the bytes
+        // that were allocated need clearing
+        memset(buffer_ + cursor, 0, cursor_ - cursor);
         cursor_ = cursor;
-        memset(buffer_ + cursor_, 0, capacity_ - cursor_);
     }
 
     void reset() override
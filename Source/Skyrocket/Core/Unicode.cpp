@@ -0,0 +1,125 @@
+//
+//  Unicode.cpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#include "Skyrocket/Core/Unicode.hpp"
+
+namespace sky {
+namespace unicode {
+
+
+uint32_t utf8_decode(const char* str, const size_t size, size_t* offset)
+{
+    auto bytes = reinterpret_cast<const uint8_t*>(str);
+    auto pos = *offset;
+    auto lead = bytes[pos];
+
+    // ASCII is by far the most common case so it's checked before anything else
+    if ( lead < 0x80 ) {
+        *offset = pos + 1;
+        return lead;
+    }
+
+    uint32_t length = 0;
+    uint32_t codepoint = 0;
+    uint32_t min_codepoint = 0;
+
+    if ( (lead & 0xE0) == 0xC0 ) {
+        length = 2;
+        codepoint = lead & 0x1Fu;
+        min_codepoint = 0x80;
+    } else if ( (lead & 0xF0) == 0xE0 ) {
+        length = 3;
+        codepoint = lead & 0x0Fu;
+        min_codepoint = 0x800;
+    } else if ( (lead & 0xF8) == 0xF0 ) {
+        length = 4;
+        codepoint = lead & 0x07u;
+        min_codepoint = 0x10000;
+    } else {
+        // Stray continuation byte or invalid lead byte
+        *offset = pos + 1;
+        return replacement_character;
+    }
+
+    uint32_t i = 1;
+    for ( ; i < length && pos + i < size; ++i ) {
+        auto byte = bytes[pos + i];
+        if ( (byte & 0xC0) != 0x80 ) {
+            break;
+        }
+        codepoint = (codepoint << 6) | (byte & 0x3Fu);
+    }
+
+    *offset = pos + i;
+
+    if ( i < length ) {
+        return replacement_character;
+    }
+
+    auto is_surrogate = codepoint >= 0xD800 && codepoint <= 0xDFFF;
+    if ( codepoint < min_codepoint || codepoint > max_codepoint || is_surrogate ) {
+        return replacement_character;
+    }
+
+    return codepoint;
+}
+
+uint32_t utf8_encode(const uint32_t codepoint, char* dest)
+{
+    auto out = reinterpret_cast<uint8_t*>(dest);
+
+    if ( codepoint < 0x80 ) {
+        out[0] = static_cast<uint8_t>(codepoint);
+        return 1;
+    }
+
+    if ( codepoint < 0x800 ) {
+        out[0] = static_cast<uint8_t>(0xC0 | (codepoint >> 6));
+        out[1] = static_cast<uint8_t>(0x80 | (codepoint & 0x3F));
+        return 2;
+    }
+
+    if ( codepoint >= 0xD800 && codepoint <= 0xDFFF ) {
+        return 0;
+    }
+
+    if ( codepoint < 0x10000 ) {
+        out[0] = static_cast<uint8_t>(0xE0 | (codepoint >> 12));
+        out[1] = static_cast<uint8_t>(0x80 | ((codepoint >> 6) & 0x3F));
+        out[2] = static_cast<uint8_t>(0x80 | (codepoint & 0x3F));
+        return 3;
+    }
+
+    if ( codepoint <= max_codepoint ) {
+        out[0] = static_cast<uint8_t>(0xF0 | (codepoint >> 18));
+        out[1] = static_cast<uint8_t>(0x80 | ((codepoint >> 12) & 0x3F));
+        out[2] = static_cast<uint8_t>(0x80 | ((codepoint >> 6) & 0x3F));
+        out[3] = static_cast<uint8_t>(0x80 | (codepoint & 0x3F));
+        return 4;
+    }
+
+    return 0;
+}
+
+size_t utf8_length(const char* str, const size_t size)
+{
+    size_t length = 0;
+    size_t offset = 0;
+    while ( offset < size ) {
+        utf8_decode(str, size, &offset);
+        ++length;
+    }
+    return length;
+}
+
+
+} // namespace unicode
+} // namespace sky
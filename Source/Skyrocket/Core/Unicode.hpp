@@ -0,0 +1,41 @@
+//
+//  Unicode.hpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace sky {
+namespace unicode {
+
+
+/// @brief Codepoint substituted for malformed UTF-8 sequences
+constexpr uint32_t replacement_character = 0xFFFD;
+
+constexpr uint32_t max_codepoint = 0x10FFFF;
+
+/// @brief Decodes the codepoint starting at `*offset` in a UTF-8 string, which must be less than
+/// `size`, and advances `offset` past it. Malformed, overlong and truncated sequences and surrogates decode to
+/// `replacement_character` and advance past the invalid bytes, so decoding always makes progress
+uint32_t utf8_decode(const char* str, size_t size, size_t* offset);
+
+/// @brief Encodes a codepoint as UTF-8 into `dest`, which must hold at least 4 bytes.
+/// @return The number of bytes written, or 0 if `codepoint` can't be encoded
+uint32_t utf8_encode(uint32_t codepoint, char* dest);
+
+/// @brief Gets the number of codepoints in a UTF-8 string, counting each malformed sequence
+/// as one codepoint
+size_t utf8_length(const char* str, size_t size);
+
+
+} // namespace unicode
+} // namespace sky
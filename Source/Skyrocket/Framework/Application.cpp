@@ -10,8 +10,7 @@
 //
 
 #include "Skyrocket/Framework/Application.hpp"
-
-#include <Jobrocket/Jobrocket.hpp>
+#include "Skyrocket/Platform/Jobs.hpp"
 
 namespace sky {
 
@@ -40,10 +39,10 @@ void Application::start(const Renderer::ThreadSupport graphics_threading,
         SKY_ASSERT(graphics_init_success, "Renderer initialized successfully");
 
         if ( graphics_threading == Renderer::ThreadSupport::multi_threaded ) {
-            jobrocket::startup(jobrocket::Scheduler::auto_thread_count, 1);
-            SKY_ASSERT(jobrocket::current_scheduler()->num_workers() > 0,
+            jobs::startup(1);
+            SKY_ASSERT(jobs::num_workers() > 0,
                        "Job scheduler initialized with correct number of workers")
-            SKY_ASSERT(jobrocket::current_scheduler()->num_main_threads() == 2,
+            SKY_ASSERT(jobs::num_main_threads() == 2,
                        "Job scheduler initialized with simulation and render threads")
         }
 
@@ -87,7 +86,7 @@ void Application::shutdown()
     active_ = false;
     on_shutdown();
     renderer.destroy();
-    jobrocket::shutdown();
+    jobs::shutdown();
 }
 
 void Application::set_frame_limit(const double fps)
@@ -11,10 +11,16 @@
 
 #include "Skyrocket/Graphics/Renderer/Definitions.hpp"
 #include "Skyrocket/Graphics/Image.hpp"
+#include "Skyrocket/Graphics/PixelConversion.hpp"
+#include "Skyrocket/Core/Diagnostics/Error.hpp"
 
 #define STB_IMAGE_IMPLEMENTATION
+// stb_image stores failure reasons in a global which races when decoding on the job workers
+#define STBI_NO_FAILURE_STRINGS
 #include <stb_image.h>
 
+#include <cstdlib>
+
 namespace sky {
 
 Image::~Image()
@@ -22,20 +28,82 @@ Image::~Image()
     if ( data != nullptr ) {
         stbi_image_free(data);
     }
+
+    if ( mip_data != nullptr ) {
+        free(mip_data);
+    }
+}
+
+/// Gets the number of channels stb_image needs to decode to for `format`, or 0 if it can't
+static int decoded_channels(const PixelFormat::Enum format)
+{
+    switch (format) {
+        case PixelFormat::Enum::unknown:
+            return 0;
+        case PixelFormat::Enum::r8:
+            return 1;
+        case PixelFormat::Enum::rg8:
+            return 2;
+        case PixelFormat::Enum::rgb8:
+            return 3;
+        case PixelFormat::Enum::rgba8:
+        case PixelFormat::Enum::bgra8:
+            return 4;
+        default:
+            return -1;
+    }
+}
+
+bool Image::load_from_file(const Path& path, const PixelFormat::Enum format)
+{
+    MappedFile file(path, MapAccess::sequential);
+    if ( !file.is_open() ) {
+        SKY_ERROR("Image", "Unable to open image file '%s'", path.str());
+        return false;
+    }
+
+    return load_from_memory(file.data(), file.size(), format);
 }
 
-void Image::load_from_file(const Path& path)
+bool Image::load_from_memory(const uint8_t* file_data, const size_t size,
+                             const PixelFormat::Enum format)
 {
+    auto channels = decoded_channels(format);
+    if ( channels < 0 ) {
+        SKY_ERROR("Image", "Images can only be decoded to 8-bit formats with up to four channels");
+        return false;
+    }
+
+    if ( data != nullptr ) {
+        stbi_image_free(data);
+        data = nullptr;
+    }
+
+    if ( mip_data != nullptr ) {
+        free(mip_data);
+        mip_data = nullptr;
+    }
+
+    mip_levels = 1;
+    width = 0;
+    height = 0;
+    pixel_format = PixelFormat::Enum::unknown;
+
     int channels_in_file = 0;
     int w = 0;
     int h = 0;
 
-    data = stbi_load(path.str(), &w, &h, &channels_in_file, 0);
+    data = stbi_load_from_memory(file_data, static_cast<int>(size), &w, &h, &channels_in_file,
+                                 channels);
+    if ( data == nullptr ) {
+        SKY_ERROR("Image", "Unable to decode image data");
+        return false;
+    }
 
     width = static_cast<uint32_t>(w);
     height = static_cast<uint32_t>(h);
 
-    switch (channels_in_file) {
+    switch (channels > 0 ? channels : channels_in_file) {
         case 1:
             pixel_format = PixelFormat::Enum::r8;
             break;
@@ -50,6 +118,62 @@ void Image::load_from_file(const Path& path)
             break;
         default:break;
     }
+
+    if ( format == PixelFormat::Enum::bgra8 ) {
+        convert_pixels(data, pixel_format, data, format, static_cast<size_t>(width) * height);
+        pixel_format = format;
+    }
+
+    return true;
+}
+
+bool Image::generate_mipmaps(const MipOptions& options)
+{
+    if ( data == nullptr ) {
+        return false;
+    }
+
+    auto levels = mip_level_count(width, height);
+    auto base_size = mip_chain_size(width, height, pixel_format, 1);
+    auto size = mip_chain_size(width, height, pixel_format, levels) - base_size;
+
+    if ( mip_data != nullptr ) {
+        free(mip_data);
+        mip_data = nullptr;
+        mip_levels = 1;
+    }
+
+    if ( size == 0 ) {
+        return true;
+    }
+
+    mip_data = static_cast<uint8_t*>(malloc(size));
+
+    // Level 1 is generated from the stb-owned base image and the rest from within the chain
+    if ( !generate_mip_level(data, width, height, pixel_format, options, mip_data)
+        || !generate_mip_chain(mip_data, level_width(1), level_height(1), pixel_format,
+                               levels - 1, options) ) {
+        free(mip_data);
+        mip_data = nullptr;
+        return false;
+    }
+
+    mip_levels = levels;
+    return true;
+}
+
+uint8_t* Image::level_data(const uint32_t level) const
+{
+    if ( level == 0 ) {
+        return data;
+    }
+
+    if ( level >= mip_levels ) {
+        return nullptr;
+    }
+
+    auto base_size = mip_chain_size(width, height, pixel_format, 1);
+    return mip_data + (mip_chain_size(width, height, pixel_format, level) - base_size);
 }
 
 
@@ -13,6 +13,7 @@
 
 #include "Skyrocket/Platform/Filesystem.hpp"
 #include "Skyrocket/Graphics/Renderer/Definitions.hpp"
+#include "Skyrocket/Graphics/Mipmap.hpp"
 
 #include <cstdint>
 
@@ -22,12 +23,42 @@ namespace sky {
 struct Image {
     ~Image();
 
-    void load_from_file(const Path& path);
+    /// @brief Decodes an image file. The image keeps the file's channel layout unless `format` is
+    /// given, in which case it's converted while decoding. Only uncompressed 8-bit formats with
+    /// up to four channels can be converted to.
+    /// @return false if the file couldn't be read or decoded
+    bool load_from_file(const Path& path, PixelFormat::Enum format = PixelFormat::Enum::unknown);
+
+    /// @brief Decodes an image file already in memory, i.e. from a mapped file or package
+    bool load_from_memory(const uint8_t* file_data, size_t size,
+                          PixelFormat::Enum format = PixelFormat::Enum::unknown);
+
+    /// @brief Generates a full mip chain down to 1x1 from the loaded image
+    bool generate_mipmaps(const MipOptions& options = MipOptions{});
+
+    /// @brief Gets the pixels of the given mip level, where level 0 is the loaded image
+    uint8_t* level_data(uint32_t level) const;
+
+    inline uint32_t level_width(const uint32_t level) const
+    {
+        return mip_dimension(width, level);
+    }
+
+    inline uint32_t level_height(const uint32_t level) const
+    {
+        return mip_dimension(height, level);
+    }
 
     uint8_t* data {nullptr};
     uint32_t width {0};
     uint32_t height {0};
-    PixelFormat::Enum pixel_format;
+    PixelFormat::Enum pixel_format {PixelFormat::Enum::unknown};
+
+    /// Number of mip levels available including the base level
+    uint32_t mip_levels {1};
+
+    /// Levels 1 to `mip_levels - 1`, tightly packed
+    uint8_t* mip_data {nullptr};
 };
 
 
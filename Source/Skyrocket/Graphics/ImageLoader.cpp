@@ -0,0 +1,73 @@
+//
+//  ImageLoader.cpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#include "Skyrocket/Graphics/ImageLoader.hpp"
+#include "Skyrocket/Platform/Jobs.hpp"
+
+#include <atomic>
+
+namespace sky {
+
+
+struct ImageBatch {
+    const Path* paths;
+    Image* images;
+    const ImageLoadOptions* options;
+    image_loaded_t on_loaded;
+    void* user_data;
+    std::atomic<uint32_t> loaded;
+};
+
+static void load_image_range(const uint32_t begin, const uint32_t end, void* user_data)
+{
+    auto batch = static_cast<ImageBatch*>(user_data);
+
+    for ( uint32_t i = begin; i < end; ++i ) {
+        auto& image = batch->images[i];
+        auto success = image.load_from_file(batch->paths[i], batch->options->format);
+
+        // Mips are generated here as well so the image is complete when the callback runs
+        if ( success && batch->options->generate_mipmaps ) {
+            success = image.generate_mipmaps(batch->options->mip_options);
+        }
+
+        if ( success ) {
+            batch->loaded.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        if ( batch->on_loaded != nullptr ) {
+            batch->on_loaded(i, &image, success, batch->user_data);
+        }
+    }
+}
+
+uint32_t load_images(const Path* paths, const uint32_t count, Image* images,
+                     const ImageLoadOptions& options, image_loaded_t on_loaded, void* user_data)
+{
+    if ( count == 0 ) {
+        return 0;
+    }
+
+    ImageBatch batch{};
+    batch.paths = paths;
+    batch.images = images;
+    batch.options = &options;
+    batch.on_loaded = on_loaded;
+    batch.user_data = user_data;
+    batch.loaded = 0;
+
+    jobs::parallel_for(count, 1, load_image_range, &batch);
+
+    return batch.loaded.load();
+}
+
+
+} // namespace sky
@@ -0,0 +1,45 @@
+//
+//  ImageLoader.hpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#pragma once
+
+#include "Skyrocket/Graphics/Image.hpp"
+
+#include <cstdint>
+
+namespace sky {
+
+
+struct ImageLoadOptions {
+    /// Format to convert every image to while decoding, or `unknown` to keep each file's layout
+    PixelFormat::Enum format{PixelFormat::Enum::unknown};
+
+    /// Generate a full mip chain for each image once it's decoded
+    bool generate_mipmaps{false};
+
+    MipOptions mip_options;
+};
+
+/// @brief Called once for every image in a batch as soon as it's finished loading. This is
+/// called on whichever job worker decoded the image so it must be thread safe
+using image_loaded_t = void (*)(uint32_t index, Image* image, bool success, void* user_data);
+
+/// @brief Decodes a batch of image files in parallel on the job workers, one image per job.
+/// Each file is memory mapped and decoded straight into `images[i]`, converted to
+/// `options.format` if given. Returns once every image in the batch is finished, or runs serially
+/// on the calling thread if the job scheduler isn't running.
+/// @return The number of images that loaded successfully
+uint32_t load_images(const Path* paths, uint32_t count, Image* images,
+                     const ImageLoadOptions& options = ImageLoadOptions{},
+                     image_loaded_t on_loaded = nullptr, void* user_data = nullptr);
+
+
+} // namespace sky
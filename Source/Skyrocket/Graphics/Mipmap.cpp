@@ -0,0 +1,428 @@
+//
+//  Mipmap.cpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#include "Skyrocket/Graphics/Mipmap.hpp"
+#include "Skyrocket/Core/Config.hpp"
+#include "Skyrocket/Core/Diagnostics/Error.hpp"
+#include "Skyrocket/Platform/Jobs.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#if SKY_SIMD_AVX2 == 1
+#include <immintrin.h>
+#elif SKY_SIMD_SSE2 == 1
+#include <emmintrin.h>
+#endif
+
+namespace sky {
+
+
+/// Number of output pixels each mip job should process before it's worth splitting work
+static constexpr uint32_t pixels_per_batch = 16384;
+
+/// Lookup tables used to decode 8-bit channels to linear floats and encode them back again
+struct MipColorTables {
+    static constexpr uint32_t encode_size = 4096;
+
+    float srgb_to_linear[256];
+    float unorm_to_float[256];
+    uint8_t linear_to_srgb[encode_size];
+};
+
+static MipColorTables make_color_tables()
+{
+    MipColorTables tables{};
+
+    for ( uint32_t i = 0; i < 256; ++i ) {
+        auto c = i / 255.0f;
+        tables.srgb_to_linear[i] = c <= 0.04045f ? c / 12.92f
+                                                 : std::pow((c + 0.055f) / 1.055f, 2.4f);
+        tables.unorm_to_float[i] = c;
+    }
+
+    for ( uint32_t i = 0; i < MipColorTables::encode_size; ++i ) {
+        auto l = i / static_cast<float>(MipColorTables::encode_size - 1);
+        auto s = l <= 0.0031308f ? l * 12.92f : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+        tables.linear_to_srgb[i] = static_cast<uint8_t>(s * 255.0f + 0.5f);
+    }
+
+    return tables;
+}
+
+static const MipColorTables& color_tables()
+{
+    static const MipColorTables tables = make_color_tables();
+    return tables;
+}
+
+/// Kaiser-windowed sinc for a 2:1 reduction. Taps sit at -2.5 to 2.5 source pixels from the
+/// center of each output pixel
+static constexpr int kaiser_taps = 6;
+
+struct KaiserKernel {
+    float weights[kaiser_taps];
+};
+
+static double bessel_i0(const double x)
+{
+    auto sum = 1.0;
+    auto term = 1.0;
+    for ( int k = 1; k < 32; ++k ) {
+        auto t = x / (2.0 * k);
+        term *= t * t;
+        sum += term;
+    }
+    return sum;
+}
+
+static KaiserKernel make_kaiser_kernel()
+{
+    static constexpr double alpha = 4.0;
+    static constexpr double radius = 3.0;
+    static constexpr double pi = 3.14159265358979323846;
+
+    KaiserKernel kernel{};
+    double weights[kaiser_taps];
+    auto total = 0.0;
+
+    for ( int t = 0; t < kaiser_taps; ++t ) {
+        auto d = t - 2.5;
+        auto x = pi * d * 0.5;
+        auto sinc = std::sin(x) / x;
+        auto r = d / radius;
+        auto window = bessel_i0(alpha * std::sqrt(std::max(0.0, 1.0 - r * r))) / bessel_i0(alpha);
+
+        weights[t] = sinc * window;
+        total += weights[t];
+    }
+
+    for ( int t = 0; t < kaiser_taps; ++t ) {
+        kernel.weights[t] = static_cast<float>(weights[t] / total);
+    }
+
+    return kernel;
+}
+
+static const KaiserKernel& kaiser_kernel()
+{
+    static const KaiserKernel kernel = make_kaiser_kernel();
+    return kernel;
+}
+
+/// Shared state for the row batches of a single mip level
+struct MipLevelJob {
+    const uint8_t* src;
+    uint8_t* dest;
+    uint32_t src_width;
+    uint32_t src_height;
+    uint32_t dest_width;
+    uint32_t dest_height;
+    uint32_t channels;
+    bool srgb[4];
+    const float* decode[4];
+};
+
+static inline uint8_t encode_channel(float value, const bool srgb, const MipColorTables& tables)
+{
+    value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+
+    if ( srgb ) {
+        auto index = static_cast<uint32_t>(value * (MipColorTables::encode_size - 1) + 0.5f);
+        return tables.linear_to_srgb[index];
+    }
+
+    return static_cast<uint8_t>(value * 255.0f + 0.5f);
+}
+
+/// Averages 2x2 blocks of linear 4-channel pixels using 16-bit integer lanes. Returns the number of
+/// output pixels written - the remainder is left to the scalar path
+static uint32_t box_rgba8_simd(const uint8_t* row0, const uint8_t* row1, uint8_t* dest,
+                               const uint32_t src_width, const uint32_t dest_width)
+{
+    uint32_t x = 0;
+
+#if SKY_SIMD_AVX2 == 1
+    {
+        const auto zero = _mm256_setzero_si256();
+        const auto round = _mm256_set1_epi16(2);
+
+        for ( ; (x + 8) * 2 <= src_width && x + 8 <= dest_width; x += 8 ) {
+            auto a0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row0 + x * 8));
+            auto a1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row0 + x * 8 + 32));
+            auto b0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row1 + x * 8));
+            auto b1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row1 + x * 8 + 32));
+
+            auto s0 = _mm256_add_epi16(_mm256_unpacklo_epi8(a0, zero), _mm256_unpacklo_epi8(b0, zero));
+            auto s1 = _mm256_add_epi16(_mm256_unpackhi_epi8(a0, zero), _mm256_unpackhi_epi8(b0, zero));
+            auto s2 = _mm256_add_epi16(_mm256_unpacklo_epi8(a1, zero), _mm256_unpacklo_epi8(b1, zero));
+            auto s3 = _mm256_add_epi16(_mm256_unpackhi_epi8(a1, zero), _mm256_unpackhi_epi8(b1, zero));
+
+            s0 = _mm256_add_epi16(s0, _mm256_srli_si256(s0, 8));
+            s1 = _mm256_add_epi16(s1, _mm256_srli_si256(s1, 8));
+            s2 = _mm256_add_epi16(s2, _mm256_srli_si256(s2, 8));
+            s3 = _mm256_add_epi16(s3, _mm256_srli_si256(s3, 8));
+
+            auto lo = _mm256_srli_epi16(_mm256_add_epi16(_mm256_unpacklo_epi64(s0, s1), round), 2);
+            auto hi = _mm256_srli_epi16(_mm256_add_epi16(_mm256_unpacklo_epi64(s2, s3), round), 2);
+
+            // Packing works within 128-bit lanes so the pixel pairs need reordering afterwards
+            auto packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(lo, hi),
+                                                   _MM_SHUFFLE(3, 1, 2, 0));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + x * 4), packed);
+        }
+    }
+#endif
+
+#if SKY_SIMD_SSE2 == 1
+    const auto zero = _mm_setzero_si128();
+    const auto round = _mm_set1_epi16(2);
+
+    for ( ; (x + 4) * 2 <= src_width && x + 4 <= dest_width; x += 4 ) {
+        auto a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x * 8));
+        auto a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x * 8 + 16));
+        auto b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x * 8));
+        auto b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x * 8 + 16));
+
+        // Sum the two rows in 16-bit lanes - each register then holds two adjacent source pixels
+        auto s0 = _mm_add_epi16(_mm_unpacklo_epi8(a0, zero), _mm_unpacklo_epi8(b0, zero));
+        auto s1 = _mm_add_epi16(_mm_unpackhi_epi8(a0, zero), _mm_unpackhi_epi8(b0, zero));
+        auto s2 = _mm_add_epi16(_mm_unpacklo_epi8(a1, zero), _mm_unpacklo_epi8(b1, zero));
+        auto s3 = _mm_add_epi16(_mm_unpackhi_epi8(a1, zero), _mm_unpackhi_epi8(b1, zero));
+
+        // Add the right pixel of each pair onto the left one
+        s0 = _mm_add_epi16(s0, _mm_srli_si128(s0, 8));
+        s1 = _mm_add_epi16(s1, _mm_srli_si128(s1, 8));
+        s2 = _mm_add_epi16(s2, _mm_srli_si128(s2, 8));
+        s3 = _mm_add_epi16(s3, _mm_srli_si128(s3, 8));
+
+        auto lo = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(s0, s1), round), 2);
+        auto hi = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(s2, s3), round), 2);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + x * 4), _mm_packus_epi16(lo, hi));
+    }
+#endif
+
+    return x;
+}
+
+static void box_filter_rows(const uint32_t begin, const uint32_t end, void* user_data)
+{
+    auto job = static_cast<const MipLevelJob*>(user_data);
+    auto& tables = color_tables();
+
+    const auto channels = job->channels;
+    const auto src_stride = job->src_width * channels;
+    const auto dest_stride = job->dest_width * channels;
+    const auto linear = !job->srgb[0] && !job->srgb[1] && !job->srgb[2];
+
+    for ( uint32_t y = begin; y < end; ++y ) {
+        auto row0 = job->src + std::min(y * 2, job->src_height - 1) * src_stride;
+        auto row1 = job->src + std::min(y * 2 + 1, job->src_height - 1) * src_stride;
+        auto out = job->dest + y * dest_stride;
+
+        uint32_t x = 0;
+        if ( linear && channels == 4 ) {
+            x = box_rgba8_simd(row0, row1, out, job->src_width, job->dest_width);
+        }
+
+        for ( ; x < job->dest_width; ++x ) {
+            auto left = std::min(x * 2, job->src_width - 1) * channels;
+            auto right = std::min(x * 2 + 1, job->src_width - 1) * channels;
+
+            for ( uint32_t c = 0; c < channels; ++c ) {
+                if ( !job->srgb[c] ) {
+                    auto sum = row0[left + c] + row0[right + c] + row1[left + c] + row1[right + c];
+                    out[x * channels + c] = static_cast<uint8_t>((sum + 2) >> 2);
+                    continue;
+                }
+
+                auto lut = job->decode[c];
+                auto sum = lut[row0[left + c]] + lut[row0[right + c]]
+                    + lut[row1[left + c]] + lut[row1[right + c]];
+                out[x * channels + c] = encode_channel(sum * 0.25f, true, tables);
+            }
+        }
+    }
+}
+
+static void kaiser_filter_rows(const uint32_t begin, const uint32_t end, void* user_data)
+{
+    auto job = static_cast<const MipLevelJob*>(user_data);
+    auto& tables = color_tables();
+    auto& kernel = kaiser_kernel();
+
+    const auto channels = job->channels;
+    const auto src_stride = job->src_width * channels;
+    const auto dest_stride = job->dest_width * channels;
+    const auto max_x = static_cast<int>(job->src_width) - 1;
+    const auto max_y = static_cast<int>(job->src_height) - 1;
+
+    // Holds the vertically filtered source row for the current output row
+    std::vector<float> column(src_stride);
+
+    for ( uint32_t y = begin; y < end; ++y ) {
+        std::fill(column.begin(), column.end(), 0.0f);
+
+        for ( int t = 0; t < kaiser_taps; ++t ) {
+            auto sy = std::min(std::max(static_cast<int>(y * 2) - 2 + t, 0), max_y);
+            auto row = job->src + sy * src_stride;
+            auto weight = kernel.weights[t];
+
+#if SKY_SIMD_SSE2 == 1
+            if ( channels == 4 ) {
+                auto w = _mm_set1_ps(weight);
+                for ( uint32_t i = 0; i < src_stride; i += 4 ) {
+                    auto px = _mm_setr_ps(job->decode[0][row[i]], job->decode[1][row[i + 1]],
+                                          job->decode[2][row[i + 2]], job->decode[3][row[i + 3]]);
+                    auto acc = _mm_loadu_ps(&column[i]);
+                    _mm_storeu_ps(&column[i], _mm_add_ps(acc, _mm_mul_ps(px, w)));
+                }
+                continue;
+            }
+#endif
+
+            for ( uint32_t i = 0; i < src_stride; i += channels ) {
+                for ( uint32_t c = 0; c < channels; ++c ) {
+                    column[i + c] += weight * job->decode[c][row[i + c]];
+                }
+            }
+        }
+
+        auto out = job->dest + y * dest_stride;
+
+        for ( uint32_t x = 0; x < job->dest_width; ++x ) {
+            auto first = static_cast<int>(x * 2) - 2;
+
+#if SKY_SIMD_SSE2 == 1
+            if ( channels == 4 ) {
+                auto acc = _mm_setzero_ps();
+                for ( int t = 0; t < kaiser_taps; ++t ) {
+                    auto sx = std::min(std::max(first + t, 0), max_x);
+                    acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(&column[sx * 4]),
+                                                     _mm_set1_ps(kernel.weights[t])));
+                }
+
+                float result[4];
+                _mm_storeu_ps(result, acc);
+                for ( uint32_t c = 0; c < 4; ++c ) {
+                    out[x * 4 + c] = encode_channel(result[c], job->srgb[c], tables);
+                }
+                continue;
+            }
+#endif
+
+            for ( uint32_t c = 0; c < channels; ++c ) {
+                auto acc = 0.0f;
+                for ( int t = 0; t < kaiser_taps; ++t ) {
+                    auto sx = std::min(std::max(first + t, 0), max_x);
+                    acc += kernel.weights[t] * column[sx * channels + c];
+                }
+                out[x * channels + c] = encode_channel(acc, job->srgb[c], tables);
+            }
+        }
+    }
+}
+
+uint32_t mip_level_count(const uint32_t width, const uint32_t height)
+{
+    auto size = std::max(width, height);
+    uint32_t levels = 1;
+    while ( size > 1 ) {
+        size >>= 1;
+        ++levels;
+    }
+    return levels;
+}
+
+size_t mip_chain_size(const uint32_t width, const uint32_t height,
+                      const PixelFormat::Enum format, const uint32_t levels)
+{
+    size_t size = 0;
+
+    for ( uint32_t level = 0; level < levels; ++level ) {
+        size += PixelFormat::image_size(format, mip_dimension(width, level),
+                                        mip_dimension(height, level));
+    }
+
+    return size;
+}
+
+bool mip_generation_supported(const PixelFormat::Enum format)
+{
+    switch (format) {
+        case PixelFormat::Enum::r8:
+        case PixelFormat::Enum::rg8:
+        case PixelFormat::Enum::rgb8:
+        case PixelFormat::Enum::bgra8:
+        case PixelFormat::Enum::rgba8:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool generate_mip_level(const uint8_t* src, const uint32_t width, const uint32_t height,
+                        const PixelFormat::Enum format, const MipOptions& options, uint8_t* dest)
+{
+    if ( !mip_generation_supported(format) ) {
+        SKY_ERROR("Mipmap", "Mip generation is only supported for 8-bit channel formats");
+        return false;
+    }
+
+    auto& tables = color_tables();
+
+    MipLevelJob job{};
+    job.src = src;
+    job.dest = dest;
+    job.src_width = width;
+    job.src_height = height;
+    job.dest_width = mip_dimension(width, 1);
+    job.dest_height = mip_dimension(height, 1);
+    job.channels = PixelFormat::bytes_per_pixel(format);
+
+    // Single and dual channel formats are usually data (masks, normals, glyphs) rather than color
+    auto color_channels = job.channels >= 3 && options.srgb ? 3u : 0u;
+    for ( uint32_t c = 0; c < 4; ++c ) {
+        job.srgb[c] = c < color_channels;
+        job.decode[c] = job.srgb[c] ? tables.srgb_to_linear : tables.unorm_to_float;
+    }
+
+    auto rows_per_batch = std::max(1u, pixels_per_batch / job.dest_width);
+    auto fn = options.filter == MipFilter::kaiser ? kaiser_filter_rows : box_filter_rows;
+    jobs::parallel_for(job.dest_height, rows_per_batch, fn, &job);
+    return true;
+}
+
+bool generate_mip_chain(uint8_t* chain, const uint32_t width, const uint32_t height,
+                        const PixelFormat::Enum format, const uint32_t levels,
+                        const MipOptions& options)
+{
+    auto bpp = PixelFormat::bytes_per_pixel(format);
+    auto src = chain;
+
+    for ( uint32_t level = 1; level < levels; ++level ) {
+        auto src_width = mip_dimension(width, level - 1);
+        auto src_height = mip_dimension(height, level - 1);
+        auto dest = src + static_cast<size_t>(src_width) * src_height * bpp;
+
+        if ( !generate_mip_level(src, src_width, src_height, format, options, dest) ) {
+            return false;
+        }
+
+        src = dest;
+    }
+
+    return true;
+}
+
+
+} // namespace sky
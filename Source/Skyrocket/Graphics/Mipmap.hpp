@@ -0,0 +1,67 @@
+//
+//  Mipmap.hpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#pragma once
+
+#include "Skyrocket/Graphics/Renderer/Definitions.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace sky {
+
+
+enum class MipFilter {
+    /// Averages each 2x2 block of the previous level. Fastest, slightly blurry
+    box,
+    /// Separable 6-tap Kaiser-windowed sinc. Sharper, with less aliasing on high-frequency detail
+    kaiser
+};
+
+struct MipOptions {
+    MipFilter filter{MipFilter::box};
+
+    /// Filter the color channels of rgb8, rgba8 and bgra8 data in linear space, treating the
+    /// source as sRGB encoded. Alpha is always filtered linearly
+    bool srgb{true};
+};
+
+/// @brief Gets the number of levels in a full mip chain down to 1x1, including the base level
+uint32_t mip_level_count(uint32_t width, uint32_t height);
+
+/// @brief Gets the size of a `base_size` dimension at the given mip level
+inline uint32_t mip_dimension(const uint32_t base_size, const uint32_t level)
+{
+    auto size = base_size >> level;
+    return size > 0 ? size : 1;
+}
+
+/// @brief Gets the total size in bytes of the first `levels` levels of a mip chain stored
+/// tightly packed one level after another
+size_t mip_chain_size(uint32_t width, uint32_t height, PixelFormat::Enum format, uint32_t levels);
+
+/// @brief Checks if mips can be generated for the pixel format. Only formats with 8-bit channels
+/// are supported
+bool mip_generation_supported(PixelFormat::Enum format);
+
+/// @brief Generates the next mip level of `src` into `dest`, which must hold
+/// mip_dimension(width, 1) * mip_dimension(height, 1) pixels. Rows are filtered in parallel on
+/// the job workers if running
+bool generate_mip_level(const uint8_t* src, uint32_t width, uint32_t height,
+                        PixelFormat::Enum format, const MipOptions& options, uint8_t* dest);
+
+/// @brief Generates levels 1 to `levels - 1` of a tightly packed mip chain from its base level,
+/// which must already be stored at the start of `chain`
+bool generate_mip_chain(uint8_t* chain, uint32_t width, uint32_t height, PixelFormat::Enum format,
+                        uint32_t levels, const MipOptions& options);
+
+
+} // namespace sky
@@ -0,0 +1,387 @@
+//
+//  PixelConversion.cpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#include "Skyrocket/Graphics/PixelConversion.hpp"
+#include "Skyrocket/Core/Config.hpp"
+
+#include <cmath>
+#include <cstring>
+
+#if SKY_SIMD_AVX2 == 1
+#include <immintrin.h>
+#elif SKY_SIMD_SSE41 == 1
+#include <smmintrin.h>
+#elif SKY_SIMD_SSE2 == 1
+#include <emmintrin.h>
+#endif
+
+namespace sky {
+
+
+/// Lookup tables for converting between 8-bit channels and linear floats. Each table holds the
+/// sRGB conversion followed by the plain unorm one so a single index offset picks per channel
+struct ColorTables {
+    static constexpr uint32_t encode_size = 4096;
+
+    float decode[512];
+    uint8_t encode[encode_size * 2];
+};
+
+constexpr uint32_t ColorTables::encode_size;
+
+static ColorTables make_color_tables()
+{
+    ColorTables tables{};
+
+    for ( uint32_t i = 0; i < 256; ++i ) {
+        auto c = i / 255.0f;
+        tables.decode[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+        tables.decode[256 + i] = c;
+    }
+
+    for ( uint32_t i = 0; i < ColorTables::encode_size; ++i ) {
+        auto l = i / static_cast<float>(ColorTables::encode_size - 1);
+        auto s = l <= 0.0031308f ? l * 12.92f : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+        tables.encode[i] = static_cast<uint8_t>(s * 255.0f + 0.5f);
+        tables.encode[ColorTables::encode_size + i] = static_cast<uint8_t>(l * 255.0f + 0.5f);
+    }
+
+    return tables;
+}
+
+static const ColorTables& color_tables()
+{
+    static const ColorTables tables = make_color_tables();
+    return tables;
+}
+
+/// Gets the number of 8-bit channels in formats that can be sRGB encoded, or 0 if unsupported
+static uint32_t color_channels(const PixelFormat::Enum format)
+{
+    switch (format) {
+        case PixelFormat::Enum::r8:
+        case PixelFormat::Enum::rg8:
+        case PixelFormat::Enum::rgb8:
+        case PixelFormat::Enum::rgba8:
+        case PixelFormat::Enum::bgra8:
+            return PixelFormat::bytes_per_pixel(format);
+        default:
+            return 0;
+    }
+}
+
+/// Divides a product of two 8-bit values by 255, rounding to nearest
+static inline uint8_t div255(const uint32_t value)
+{
+    auto v = value + 128;
+    return static_cast<uint8_t>((v + (v >> 8)) >> 8);
+}
+
+static void swap_red_blue(const uint8_t* src, uint8_t* dest, const size_t count)
+{
+    size_t i = 0;
+
+#if SKY_SIMD_AVX2 == 1
+    {
+        const auto green_alpha = _mm256_set1_epi32(static_cast<int>(0xFF00FF00));
+
+        for ( ; i + 8 <= count; i += 8 ) {
+            auto px = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4));
+            auto rb = _mm256_andnot_si256(green_alpha, px);
+            auto swapped = _mm256_or_si256(_mm256_slli_epi32(rb, 16), _mm256_srli_epi32(rb, 16));
+            px = _mm256_or_si256(_mm256_and_si256(px, green_alpha), swapped);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i * 4), px);
+        }
+    }
+#endif
+
+#if SKY_SIMD_SSE2 == 1
+    // Red and blue are the low bytes of each 16-bit half of a pixel so rotating the masked
+    // pixel by 16 bits swaps them without needing a byte shuffle
+    const auto green_alpha = _mm_set1_epi32(static_cast<int>(0xFF00FF00));
+
+    for ( ; i + 4 <= count; i += 4 ) {
+        auto px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+        auto rb = _mm_andnot_si128(green_alpha, px);
+        auto swapped = _mm_or_si128(_mm_slli_epi32(rb, 16), _mm_srli_epi32(rb, 16));
+        px = _mm_or_si128(_mm_and_si128(px, green_alpha), swapped);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i * 4), px);
+    }
+#endif
+
+    for ( ; i < count; ++i ) {
+        auto r = src[i * 4];
+        auto b = src[i * 4 + 2];
+        dest[i * 4] = b;
+        dest[i * 4 + 1] = src[i * 4 + 1];
+        dest[i * 4 + 2] = r;
+        dest[i * 4 + 3] = src[i * 4 + 3];
+    }
+}
+
+static void expand_rgb(const uint8_t* src, uint8_t* dest, const size_t count, const bool swap)
+{
+    size_t i = 0;
+
+#if SKY_SIMD_SSE41 == 1
+    // Shuffles four packed 3-byte pixels into 4-byte ones, leaving the alpha bytes zeroed
+    const auto shuffle = swap
+        ? _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1)
+        : _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    const auto alpha = _mm_set1_epi32(static_cast<int>(0xFF000000));
+
+    for ( ; i + 16 <= count; i += 16 ) {
+        auto in0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 3));
+        auto in1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 3 + 16));
+        auto in2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 3 + 32));
+
+        auto out = reinterpret_cast<__m128i*>(dest + i * 4);
+        _mm_storeu_si128(out, _mm_or_si128(_mm_shuffle_epi8(in0, shuffle), alpha));
+        _mm_storeu_si128(out + 1, _mm_or_si128(
+            _mm_shuffle_epi8(_mm_alignr_epi8(in1, in0, 12), shuffle), alpha));
+        _mm_storeu_si128(out + 2, _mm_or_si128(
+            _mm_shuffle_epi8(_mm_alignr_epi8(in2, in1, 8), shuffle), alpha));
+        _mm_storeu_si128(out + 3, _mm_or_si128(
+            _mm_shuffle_epi8(_mm_srli_si128(in2, 4), shuffle), alpha));
+    }
+#endif
+
+    const auto r = swap ? 2 : 0;
+
+    for ( ; i < count; ++i ) {
+        dest[i * 4 + r] = src[i * 3];
+        dest[i * 4 + 1] = src[i * 3 + 1];
+        dest[i * 4 + 2 - r] = src[i * 3 + 2];
+        dest[i * 4 + 3] = 255;
+    }
+}
+
+static void expand_grey(const uint8_t* src, uint8_t* dest, const size_t count)
+{
+    size_t i = 0;
+
+#if SKY_SIMD_SSE2 == 1
+    const auto opaque = _mm_set1_epi8(-1);
+
+    for ( ; i + 16 <= count; i += 16 ) {
+        auto grey = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+
+        // Pairs of (g, g) and (g, 255) interleave into (g, g, g, 255) pixels
+        auto gg_lo = _mm_unpacklo_epi8(grey, grey);
+        auto gg_hi = _mm_unpackhi_epi8(grey, grey);
+        auto ga_lo = _mm_unpacklo_epi8(grey, opaque);
+        auto ga_hi = _mm_unpackhi_epi8(grey, opaque);
+
+        auto out = reinterpret_cast<__m128i*>(dest + i * 4);
+        _mm_storeu_si128(out, _mm_unpacklo_epi16(gg_lo, ga_lo));
+        _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(gg_lo, ga_lo));
+        _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(gg_hi, ga_hi));
+        _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(gg_hi, ga_hi));
+    }
+#endif
+
+    for ( ; i < count; ++i ) {
+        dest[i * 4] = src[i];
+        dest[i * 4 + 1] = src[i];
+        dest[i * 4 + 2] = src[i];
+        dest[i * 4 + 3] = 255;
+    }
+}
+
+bool pixel_conversion_supported(const PixelFormat::Enum src_format,
+                                const PixelFormat::Enum dest_format)
+{
+    if ( src_format == dest_format ) {
+        return PixelFormat::bytes_per_pixel(src_format) > 0;
+    }
+
+    if ( dest_format != PixelFormat::Enum::rgba8 && dest_format != PixelFormat::Enum::bgra8 ) {
+        return false;
+    }
+
+    switch (src_format) {
+        case PixelFormat::Enum::r8:
+        case PixelFormat::Enum::rgb8:
+        case PixelFormat::Enum::rgba8:
+        case PixelFormat::Enum::bgra8:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool convert_pixels(const uint8_t* src, const PixelFormat::Enum src_format, uint8_t* dest,
+                    const PixelFormat::Enum dest_format, const size_t count)
+{
+    if ( !pixel_conversion_supported(src_format, dest_format) ) {
+        return false;
+    }
+
+    if ( src_format == dest_format ) {
+        if ( src != dest ) {
+            memmove(dest, src, count * PixelFormat::bytes_per_pixel(src_format));
+        }
+        return true;
+    }
+
+    switch (src_format) {
+        case PixelFormat::Enum::r8:
+            expand_grey(src, dest, count);
+            break;
+        case PixelFormat::Enum::rgb8:
+            expand_rgb(src, dest, count, dest_format == PixelFormat::Enum::bgra8);
+            break;
+        default:
+            swap_red_blue(src, dest, count);
+            break;
+    }
+
+    return true;
+}
+
+void premultiply_alpha(uint8_t* pixels, const size_t count)
+{
+    size_t i = 0;
+
+#if SKY_SIMD_AVX2 == 1
+    {
+        const auto zero = _mm256_setzero_si256();
+        const auto alpha_lanes = _mm256_set1_epi64x(0x00FF000000000000);
+        const auto round = _mm256_set1_epi16(128);
+
+        for ( ; i + 8 <= count; i += 8 ) {
+            auto px = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels + i * 4));
+            __m256i halves[2] = { _mm256_unpacklo_epi8(px, zero), _mm256_unpackhi_epi8(px, zero) };
+
+            for ( auto& c : halves ) {
+                auto a = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(c, 0xFF), 0xFF);
+                auto v = _mm256_add_epi16(_mm256_mullo_epi16(c, _mm256_or_si256(a, alpha_lanes)),
+                                          round);
+                c = _mm256_srli_epi16(_mm256_add_epi16(v, _mm256_srli_epi16(v, 8)), 8);
+            }
+
+            px = _mm256_packus_epi16(halves[0], halves[1]);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(pixels + i * 4), px);
+        }
+    }
+#endif
+
+#if SKY_SIMD_SSE2 == 1
+    const auto zero = _mm_setzero_si128();
+    // Alpha is multiplied by 255 instead of itself so it's left unchanged
+    const auto alpha_lanes = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const auto round = _mm_set1_epi16(128);
+
+    for ( ; i + 4 <= count; i += 4 ) {
+        auto px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i * 4));
+        __m128i halves[2] = { _mm_unpacklo_epi8(px, zero), _mm_unpackhi_epi8(px, zero) };
+
+        for ( auto& c : halves ) {
+            auto a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(c, 0xFF), 0xFF);
+            auto v = _mm_add_epi16(_mm_mullo_epi16(c, _mm_or_si128(a, alpha_lanes)), round);
+            c = _mm_srli_epi16(_mm_add_epi16(v, _mm_srli_epi16(v, 8)), 8);
+        }
+
+        px = _mm_packus_epi16(halves[0], halves[1]);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i * 4), px);
+    }
+#endif
+
+    for ( ; i < count; ++i ) {
+        auto px = pixels + i * 4;
+        auto a = px[3];
+        px[0] = div255(px[0] * a);
+        px[1] = div255(px[1] * a);
+        px[2] = div255(px[2] * a);
+    }
+}
+
+bool srgb_to_linear(const uint8_t* src, const PixelFormat::Enum format, float* dest,
+                    const size_t count)
+{
+    const auto channels = color_channels(format);
+    if ( channels == 0 ) {
+        return false;
+    }
+
+    auto& tables = color_tables();
+    const auto values = count * channels;
+    size_t i = 0;
+
+#if SKY_SIMD_AVX2 == 1
+    // Eight values always cover whole 4-channel pixels so the unorm table offset for alpha lines
+    // up with the same lanes every iteration
+    const auto offset = channels == 4 ? _mm256_setr_epi32(0, 0, 0, 256, 0, 0, 0, 256)
+                                      : _mm256_setzero_si256();
+
+    for ( ; i + 8 <= values; i += 8 ) {
+        auto bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i));
+        auto index = _mm256_add_epi32(_mm256_cvtepu8_epi32(bytes), offset);
+        _mm256_storeu_ps(dest + i, _mm256_i32gather_ps(tables.decode, index, 4));
+    }
+#endif
+
+    for ( ; i < values; ++i ) {
+        auto offset = channels == 4 && i % 4 == 3 ? 256 : 0;
+        dest[i] = tables.decode[offset + src[i]];
+    }
+
+    return true;
+}
+
+bool linear_to_srgb(const float* src, const PixelFormat::Enum format, uint8_t* dest,
+                    const size_t count)
+{
+    const auto channels = color_channels(format);
+    if ( channels == 0 ) {
+        return false;
+    }
+
+    auto& tables = color_tables();
+    const auto values = count * channels;
+    const auto scale = static_cast<float>(ColorTables::encode_size - 1);
+    size_t i = 0;
+
+#if SKY_SIMD_SSE2 == 1
+    const auto zero = _mm_setzero_ps();
+    const auto one = _mm_set1_ps(1.0f);
+    const auto half = _mm_set1_ps(0.5f);
+    const auto scale4 = _mm_set1_ps(scale);
+    const auto offset = channels == 4
+        ? _mm_setr_epi32(0, 0, 0, ColorTables::encode_size)
+        : _mm_setzero_si128();
+
+    // Clamping and quantizing is vectorized, leaving only the table lookups scalar
+    for ( ; i + 4 <= values; i += 4 ) {
+        auto v = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i), zero), one);
+        auto index = _mm_add_epi32(_mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(v, scale4), half)),
+                                   offset);
+
+        alignas(16) int32_t indices[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(indices), index);
+        dest[i] = tables.encode[indices[0]];
+        dest[i + 1] = tables.encode[indices[1]];
+        dest[i + 2] = tables.encode[indices[2]];
+        dest[i + 3] = tables.encode[indices[3]];
+    }
+#endif
+
+    for ( ; i < values; ++i ) {
+        auto v = src[i] < 0.0f ? 0.0f : (src[i] > 1.0f ? 1.0f : src[i]);
+        auto offset = channels == 4 && i % 4 == 3 ? ColorTables::encode_size : 0;
+        dest[i] = tables.encode[offset + static_cast<uint32_t>(v * scale + 0.5f)];
+    }
+
+    return true;
+}
+
+
+} // namespace sky
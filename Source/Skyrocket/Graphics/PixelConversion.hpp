@@ -0,0 +1,47 @@
+//
+//  PixelConversion.hpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#pragma once
+
+#include "Skyrocket/Graphics/Renderer/Definitions.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace sky {
+
+
+/// @brief Checks if `convert_pixels` can convert from `src_format` to `dest_format`. Any of r8,
+/// rgb8, rgba8 and bgra8 can be converted to rgba8 or bgra8, and every uncompressed format can be
+/// converted to itself
+bool pixel_conversion_supported(PixelFormat::Enum src_format, PixelFormat::Enum dest_format);
+
+/// @brief Converts `count` tightly packed pixels to another format, i.e. to expand rgb8 images to
+/// rgba8 before uploading them. r8 pixels are treated as greyscale and expanded to all three color
+/// channels and missing alpha channels are set to opaque. `src` and `dest` may be the same buffer
+/// if both formats are the same size.
+/// @return false if the conversion isn't supported
+bool convert_pixels(const uint8_t* src, PixelFormat::Enum src_format, uint8_t* dest,
+                    PixelFormat::Enum dest_format, size_t count);
+
+/// @brief Multiplies the color channels of `count` rgba8 or bgra8 pixels by their alpha, in place
+void premultiply_alpha(uint8_t* pixels, size_t count);
+
+/// @brief Decodes `count` pixels of 8-bit sRGB encoded color to linear floats in [0, 1], one per
+/// channel. The alpha channel of rgba8 and bgra8 pixels is converted without decoding
+bool srgb_to_linear(const uint8_t* src, PixelFormat::Enum format, float* dest, size_t count);
+
+/// @brief Encodes `count` pixels of linear floats, one per channel, to 8-bit sRGB. Values are
+/// clamped to [0, 1] and the alpha channel of rgba8 and bgra8 pixels is converted without encoding
+bool linear_to_srgb(const float* src, PixelFormat::Enum format, uint8_t* dest, size_t count);
+
+
+} // namespace sky
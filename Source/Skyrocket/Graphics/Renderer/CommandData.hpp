@@ -109,6 +109,7 @@ struct UpdateInstanceBufferData {
     uint32_t buf_id{0};
     uint8_t* data{nullptr};
     uint32_t index{0};
+    uint32_t count{1};
 };
 
 struct SetInstanceBufferData {
@@ -129,6 +130,7 @@ struct CreateTextureRegionData {
     UIntRect rect;
     PixelFormat::Enum format{PixelFormat::unknown};
     uint8_t* data{nullptr};
+    uint32_t level{0};
 };
 
 struct SetTextureData {
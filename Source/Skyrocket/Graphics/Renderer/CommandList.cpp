@@ -121,10 +121,11 @@ uint32_t CommandList::create_texture(const uint32_t width, const uint32_t height
 }
 
 void CommandList::create_texture_region(const uint32_t texture, const UIntRect& region,
-                                          const PixelFormat::Enum pixel_format, uint8_t* data)
+                                          const PixelFormat::Enum pixel_format, uint8_t* data,
+                                          const uint32_t mip_level)
 {
     buffer->write_command(CommandType::create_texture_region, CreateTextureRegionData {
-        texture, region, pixel_format, data
+        texture, region, pixel_format, data, mip_level
     });
 }
 
@@ -160,10 +161,11 @@ uint32_t CommandList::create_instance_buffer(uint32_t stride, uint32_t size)
     return handle;
 }
 
-void CommandList::update_instance_buffer(uint32_t id, uint8_t* data, uint32_t index)
+void CommandList::update_instance_buffer(uint32_t id, uint8_t* data, uint32_t index,
+                                         uint32_t count)
 {
     buffer->write_command(CommandType::update_instance_buffer, UpdateInstanceBufferData {
-        id, data, index
+        id, data, index, count
     });
 }
 
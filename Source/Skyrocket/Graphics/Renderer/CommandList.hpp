@@ -30,6 +30,14 @@ struct CommandBuffer {
         memset(buffer, 0, buffer_max);
     }
 
+    /// @brief Empties the buffer without zeroing it. Commands are only read up to `size` so
+    /// the stale bytes past it are never seen
+    inline void reset()
+    {
+        cursor_ = 0;
+        size_ = 0;
+    }
+
     inline void reset_cursor()
     {
         cursor_ = 0;
@@ -112,7 +120,7 @@ public:
     explicit CommandList(CommandBuffer* cmdbuffer)
         : buffer(cmdbuffer)
     {
-        clear();
+        reset();
     }
 
     /// Reads the number of bytes equal to sizeof(T) into `dest` and increments the internal cursor
@@ -127,6 +135,13 @@ public:
         buffer->clear();
     }
 
+    /// @brief Empties the buffer without zeroing it. Commands are only read up to `size` so
+    /// the stale bytes past it are never seen
+    inline void reset()
+    {
+        buffer->reset();
+    }
+
     inline void reset_cursor()
     {
         buffer->reset_cursor();
@@ -194,7 +209,10 @@ public:
 
     void set_instance_buffer(uint32_t ibuf_id, uint32_t index);
 
-    void update_instance_buffer(uint32_t id, uint8_t* data, uint32_t index);
+    /// @brief Sends a command to copy `count` tightly packed elements from `data` into an
+    /// instance buffer starting at element `index`. `data` must stay valid until the command is
+    /// processed by the renderer
+    void update_instance_buffer(uint32_t id, uint8_t* data, uint32_t index, uint32_t count = 1);
 
     /// @brief Sends a command to create a new shader
     /// @param vs_path
@@ -207,11 +225,14 @@ public:
     /// @return
     bool set_program(uint32_t program_id);
 
+    /// @brief Sends a command to create a new texture. Mipmapped textures are allocated with a
+    /// full mip chain which should be filled level by level with `create_texture_region`
     uint32_t create_texture(uint32_t width, uint32_t height,
                             PixelFormat::Enum pixel_format, bool mipmapped = false);
 
     void create_texture_region(uint32_t texture, const UIntRect& region,
-                               PixelFormat::Enum pixel_format, uint8_t* data);
+                               PixelFormat::Enum pixel_format, uint8_t* data,
+                               uint32_t mip_level = 0);
 
     bool set_texture(uint32_t texture, uint32_t index);
 
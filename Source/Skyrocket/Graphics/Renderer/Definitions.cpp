@@ -41,5 +41,35 @@ uint32_t PixelFormat::bytes_per_pixel(const Enum& format)
     }
 }
 
+bool PixelFormat::is_compressed(const Enum& format)
+{
+    return block_size(format) > 0;
+}
+
+uint32_t PixelFormat::block_size(const Enum& format)
+{
+    switch (format) {
+        case Enum::bc1:
+        case Enum::bc4:
+            return 8;
+        case Enum::bc3:
+        case Enum::bc5:
+        case Enum::bc7:
+            return 16;
+        default:
+            return 0;
+    }
+}
+
+size_t PixelFormat::image_size(const Enum& format, const uint32_t width, const uint32_t height)
+{
+    auto block_bytes = block_size(format);
+    if ( block_bytes > 0 ) {
+        return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * block_bytes;
+    }
+
+    return static_cast<size_t>(width) * height * bytes_per_pixel(format);
+}
+
 
 } // namespace sky
\ No newline at end of file
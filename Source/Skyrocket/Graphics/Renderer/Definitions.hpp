@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 namespace sky {
@@ -56,12 +57,27 @@ struct PixelFormat {
         rgba8,
         rgba16,
         rgba32,
+        bc1,
+        bc3,
+        bc4,
+        bc5,
+        bc7,
         depth,
         stencil,
         unknown
     };
 
+    /// @brief Gets the size of a single pixel. Returns 0 for block compressed formats
     static uint32_t bytes_per_pixel(const Enum& format);
+
+    static bool is_compressed(const Enum& format);
+
+    /// @brief Gets the size of a 4x4 block for block compressed formats, otherwise 0
+    static uint32_t block_size(const Enum& format);
+
+    /// @brief Gets the number of bytes required to store a `width` by `height` image in the given
+    /// format, rounding compressed formats up to whole blocks
+    static size_t image_size(const Enum& format, uint32_t width, uint32_t height);
 };
 
 
@@ -144,7 +144,7 @@ void GDI::submit(sky::CommandBuffer* cmdbuf)
     CommandType* typeptr = nullptr;
     state_.reset();
 
-    while (cmdbuf->cursor() <= cmdbuf->size()) {
+    while (cmdbuf->cursor() < cmdbuf->size()) {
 
         typeptr = cmdbuf->read_command<CommandType>();
         if (typeptr == nullptr) {
@@ -262,7 +262,7 @@ void GDI::submit(sky::CommandBuffer* cmdbuf)
             case CommandType::create_texture_region:
             {
                 auto cmd = cmdbuf->read_command<CreateTextureRegionData>();
-                create_texture_region(cmd->tex_id, cmd->rect, cmd->format, cmd->data);
+                create_texture_region(cmd->tex_id, cmd->rect, cmd->format, cmd->data, cmd->level);
             } break;
 
             case CommandType::set_texture:
@@ -297,7 +297,7 @@ void GDI::submit(sky::CommandBuffer* cmdbuf)
             case CommandType::update_instance_buffer:
             {
                 auto data = cmdbuf->read_command<UpdateInstanceBufferData>();
-                update_instance_buffer(data->buf_id, data->data, data->index);
+                update_instance_buffer(data->buf_id, data->data, data->index, data->count);
             } break;
 
             case CommandType::set_instance_buffer:
@@ -411,7 +411,8 @@ bool GDI::create_texture(const uint32_t  /*t_id*/, const uint32_t /*width*/,
 }
 
 bool GDI::create_texture_region(const uint32_t /*tex_id*/, const UIntRect& /*region*/,
-                                const PixelFormat::Enum /*pixel_format*/, uint8_t* /*data*/)
+                                const PixelFormat::Enum /*pixel_format*/, uint8_t* /*data*/,
+                                const uint32_t /*mip_level*/)
 {
     // no op
     return true;
@@ -446,7 +447,7 @@ bool GDI::create_instance_buffer(uint32_t inst_id, uint32_t stride, uint32_t siz
     return true;
 }
 
-bool GDI::update_instance_buffer(uint32_t inst_id, uint8_t* data, uint32_t index)
+bool GDI::update_instance_buffer(uint32_t inst_id, uint8_t* data, uint32_t index, uint32_t count)
 {
     return true;
 }
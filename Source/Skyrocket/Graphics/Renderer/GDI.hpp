@@ -100,12 +100,6 @@ struct RenderState {
 class GDI {
 public:
     static constexpr uint32_t invalid_handle = 0;
-    static constexpr uint16_t vertex_buffer_max = 1024;
-    static constexpr uint16_t index_buffer_max = 1024;
-    static constexpr uint16_t uniform_buffer_max = 512;
-    static constexpr uint16_t shader_max = 512;
-    static constexpr uint16_t texture_max = 512;
-    static constexpr uint16_t instance_buffer_max = 512;
     static constexpr uint16_t max_frames_in_flight = 3;
 
     GDI() = default;
@@ -205,14 +199,16 @@ protected:
 
     virtual bool set_instance_buffer(uint32_t inst_id, uint32_t index);
 
-    virtual bool update_instance_buffer(uint32_t inst_id, uint8_t* data, uint32_t index);
+    virtual bool update_instance_buffer(uint32_t inst_id, uint8_t* data, uint32_t index,
+                                        uint32_t count);
 
     virtual bool create_texture(uint32_t t_id, uint32_t width,
                                 uint32_t height, PixelFormat::Enum pixel_format,
                                 bool mipmapped);
 
     virtual bool create_texture_region(uint32_t tex_id, const UIntRect& region,
-                                       PixelFormat::Enum pixel_format, uint8_t* data);
+                                       PixelFormat::Enum pixel_format, uint8_t* data,
+                                       uint32_t mip_level);
 
     virtual bool set_texture(uint32_t t_id, uint32_t index);
 
@@ -23,6 +23,8 @@
 #import <Metal/Metal.h>
 #import <QuartzCore/CAMetalLayer.h>
 
+#include <vector>
+
 @class MetalView;
 
 namespace sky {
@@ -71,7 +73,8 @@ protected:
                         bool mipmapped) override;
 
     bool create_texture_region(uint32_t tex_id, const UIntRect& region,
-                               PixelFormat::Enum pixel_format, uint8_t* data) override;
+                               PixelFormat::Enum pixel_format, uint8_t* data,
+                               uint32_t mip_level) override;
 
     bool set_texture(uint32_t t_id, uint32_t index) override;
 
@@ -81,7 +84,8 @@ protected:
 
     bool set_state(uint32_t flags) override;
     bool create_instance_buffer(uint32_t inst_id, uint32_t stride, uint32_t size) override;
-    bool update_instance_buffer(uint32_t inst_id, uint8_t* data, uint32_t index) override;
+    bool update_instance_buffer(uint32_t inst_id, uint8_t* data, uint32_t index,
+                                uint32_t count) override;
     bool set_instance_buffer(uint32_t inst_id, uint32_t index) override;
 private:
     static constexpr uint8_t lib_max_ = 8;
@@ -93,11 +97,16 @@ private:
         MTLPixelFormatRG8Unorm, // rg8
         MTLPixelFormatRG16Unorm, // rg16
         MTLPixelFormatRG32Float, // rg32
-        MTLPixelFormatRGBA8Unorm, // rgb8
+        MTLPixelFormatRGBA8Unorm, // rgb8 - expanded on upload
         MTLPixelFormatBGRA8Unorm, // bgra8
         MTLPixelFormatRGBA8Unorm, // rgba8
         MTLPixelFormatRGBA16Unorm, // rgba16
         MTLPixelFormatRGBA32Float, // rgba32
+        MTLPixelFormatBC1_RGBA, // bc1
+        MTLPixelFormatBC3_RGBA, // bc3
+        MTLPixelFormatBC4_RUnorm, // bc4
+        MTLPixelFormatBC5_RGUnorm, // bc5
+        MTLPixelFormatBC7_RGBAUnorm, // bc7
         MTLPixelFormatDepth32Float, // depth
         MTLPixelFormatStencil8, // stencil
         MTLPixelFormatInvalid // unknown
@@ -128,14 +137,17 @@ private:
 
     Viewport* current_view_;
 
-    HandleTable<MetalBuffer<max_frames_in_flight>, vertex_buffer_max> vertex_buffers_;
-    HandleTable<MetalBuffer<max_frames_in_flight>, index_buffer_max> index_buffers_;
-    HandleTable<MetalBuffer<max_frames_in_flight>, uniform_buffer_max> uniform_buffers_;
-    HandleTable<MetalInstanceBuffer<max_frames_in_flight>, instance_buffer_max> instance_buffers_;
-    HandleTable<MetalProgram, shader_max> programs_;
-    HandleTable<id<MTLTexture>, texture_max> textures_;
+    HandleTable<MetalBuffer<max_frames_in_flight>> vertex_buffers_;
+    HandleTable<MetalBuffer<max_frames_in_flight>> index_buffers_;
+    HandleTable<MetalBuffer<max_frames_in_flight>> uniform_buffers_;
+    HandleTable<MetalInstanceBuffer<max_frames_in_flight>> instance_buffers_;
+    HandleTable<MetalProgram> programs_;
+    HandleTable<id<MTLTexture>> textures_;
 
     uint32_t buffer_index_{0};
+
+    /// Holds texture regions converted to a layout Metal supports before being uploaded
+    std::vector<uint8_t> conversion_buffer_;
 };
 
 
@@ -14,6 +14,7 @@
 #include "Skyrocket/Graphics/Renderer/Metal/MetalGDI.h"
 #include "Skyrocket/Graphics/Renderer/Metal/MetalView.h"
 #include "Skyrocket/Graphics/Apple/MacViewport.h"
+#include "Skyrocket/Graphics/PixelConversion.hpp"
 #include "Skyrocket/Platform/Filesystem.hpp"
 
 //TODO(Jacob): Textures
@@ -462,15 +463,32 @@ bool MetalGDI::create_texture(const uint32_t t_id, const uint32_t width,
 }
 
 bool MetalGDI::create_texture_region(const uint32_t tex_id, const UIntRect& region,
-                                        const PixelFormat::Enum pixel_format, uint8_t* data)
+                                        const PixelFormat::Enum pixel_format, uint8_t* data,
+                                        const uint32_t mip_level)
 {
     auto bytes_per_pixel = PixelFormat::bytes_per_pixel(pixel_format);
     auto tex = textures_.get(tex_id);
+
+    // Metal has no 3-byte pixel formats so rgb8 regions are expanded to match the rgba8 texture
+    if ( pixel_format == PixelFormat::Enum::rgb8 ) {
+        auto count = static_cast<size_t>(region.width) * region.height;
+        conversion_buffer_.resize(count * 4);
+        convert_pixels(data, pixel_format, conversion_buffer_.data(), PixelFormat::Enum::rgba8,
+                       count);
+        data = conversion_buffer_.data();
+        bytes_per_pixel = 4;
+    }
+
     auto bpr = bytes_per_pixel * region.width;
+
+    // Compressed formats are laid out in rows of 4x4 blocks
+    if ( PixelFormat::is_compressed(pixel_format) ) {
+        bpr = PixelFormat::block_size(pixel_format) * ((region.width + 3) / 4);
+    }
     MTLRegion mtl_region = MTLRegionMake2D(region.position.x, region.position.y,
                                            region.width, region.height);
     [*tex replaceRegion:mtl_region
-            mipmapLevel:0
+            mipmapLevel:mip_level
               withBytes:data
             bytesPerRow:bpr];
     return true;
@@ -565,7 +583,8 @@ bool MetalGDI::create_instance_buffer(uint32_t inst_id, uint32_t stride, uint32_
     return true;
 }
 
-bool MetalGDI::update_instance_buffer(uint32_t inst_id, uint8_t* data, uint32_t index)
+bool MetalGDI::update_instance_buffer(uint32_t inst_id, uint8_t* data, uint32_t index,
+                                      uint32_t count)
 {
     auto buf = instance_buffers_.get(inst_id);
 
@@ -574,7 +593,7 @@ bool MetalGDI::update_instance_buffer(uint32_t inst_id, uint8_t* data, uint32_t
         return false;
     }
 
-    buf->buffer.update(device_, data, buf->stride, index * buf->stride);
+    buf->buffer.update(device_, data, count * buf->stride, index * buf->stride);
 
     return true;
 }
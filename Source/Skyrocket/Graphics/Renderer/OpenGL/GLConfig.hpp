@@ -16,6 +16,20 @@
 
 #include <OpenGL/gl3.h>
 
+// S3TC and BPTC are only exposed as extensions on some core profiles (i.e. macOS) so their
+// enums aren't guaranteed to be defined by the GL headers
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#endif
+
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+#ifndef GL_COMPRESSED_RGBA_BPTC_UNORM
+#define GL_COMPRESSED_RGBA_BPTC_UNORM 0x8E8C
+#endif
+
 namespace sky {
 
 inline const char* gl_get_enum_name(GLenum glenum)
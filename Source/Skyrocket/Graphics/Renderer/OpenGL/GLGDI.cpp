@@ -10,11 +10,14 @@
 //
 
 #include "Skyrocket/Graphics/Renderer/OpenGL/GLGDI.hpp"
+#include "Skyrocket/Graphics/Mipmap.hpp"
 #include "Skyrocket/Graphics/Viewport.hpp"
 #include "Skyrocket/Graphics/Renderer/Vertex.hpp"
 #include "Skyrocket/Platform/Filesystem.hpp"
 #include "Skyrocket/Core/Math/Matrix4.hpp"
 
+#include <cstring>
+
 
 #if SKY_OS_MACOS == 1
 
@@ -92,6 +95,22 @@ void set_uniform_data_cubemap(GLint location, GLUniformSlot& slot)
 }
 
 
+static bool gl_has_extension(const char* name)
+{
+    GLint count = 0;
+    SKY_GL_CHECK(glGetIntegerv(GL_NUM_EXTENSIONS, &count));
+
+    for (GLint i = 0; i < count; ++i) {
+        auto extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+        if (extension != nullptr && strcmp(extension, name) == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
 OpenGLGDI::~OpenGLGDI() = default;
 
 void OpenGLGDI::set_uniform_data(GLint location, GLUniformSlot& slot)
@@ -137,6 +156,10 @@ bool OpenGLGDI::init(Viewport* viewport)
         } while (err != GL_NO_ERROR);
     }
 
+    // BPTC is core from 4.2 so the 4.1 core profile on macOS only has it if the driver exposes
+    // the extension
+    bptc_supported_ = gl_has_extension("GL_ARB_texture_compression_bptc");
+
     // Enable settings
     SKY_GL_CHECK(glEnable(GL_BLEND));
     SKY_GL_CHECK(glEnable(GL_CULL_FACE));
@@ -175,11 +198,13 @@ void main() {
 )";
 
     default_program_.create(basic_vert, basic_frag);
+    texture_uploader_.create();
     return true;
 }
 
 bool OpenGLGDI::destroy()
 {
+    texture_uploader_.destroy();
     context_.destroy();
     return true;
 }
@@ -202,6 +227,7 @@ bool OpenGLGDI::begin_frame(FrameInfo* frame_info)
 
 bool OpenGLGDI::end_frame(FrameInfo* frame_info)
 {
+    flush_texture_uploads();
     SKY_GL_CHECK(glBindVertexArray(0));
     frame_info->cpu_end();
     frame_info->gpu_start();
@@ -321,9 +347,18 @@ OpenGLGDI::create_program(uint32_t program_id, const Path& vs_path, const Path&
         return false;
     }
 
-    auto vs_source = fs::slurp_file(vs_path);
-    auto frag_source = fs::slurp_file(frag_path);
-    return glprog->create(vs_source.c_str(), frag_source.c_str());
+    // Shader sources are passed to the driver with explicit lengths so they can be compiled
+    // straight from the mapped files without copying them into null-terminated strings
+    MappedFile vs_source(vs_path, MapAccess::sequential);
+    MappedFile frag_source(frag_path, MapAccess::sequential);
+    if (!vs_source.is_open() || !frag_source.is_open()) {
+        return false;
+    }
+
+    return glprog->create(reinterpret_cast<const char*>(vs_source.data()),
+                          reinterpret_cast<const char*>(frag_source.data()),
+                          static_cast<GLint>(vs_source.size()),
+                          static_cast<GLint>(frag_source.size()));
 }
 
 bool OpenGLGDI::set_program(uint32_t program_id)
@@ -406,18 +441,19 @@ bool OpenGLGDI::create_instance_buffer(uint32_t inst_id, uint32_t stride, uint32
     return true;
 }
 
-bool OpenGLGDI::update_instance_buffer(uint32_t inst_id, uint8_t* data, uint32_t index)
+bool OpenGLGDI::update_instance_buffer(uint32_t inst_id, uint8_t* data, uint32_t index,
+                                       uint32_t count)
 {
     auto buf = instance_buffers_.get(inst_id);
     if (buf == nullptr) {
         return false;
     }
 
-    if (index > buf->bytes / buf->stride) {
+    if (index + count > buf->bytes / buf->stride) {
         return false;
     }
 
-    memcpy(buf->data + (index * buf->stride), data, buf->stride);
+    memcpy(buf->data + (index * buf->stride), data, count * buf->stride);
     return true;
 }
 
@@ -448,6 +484,12 @@ bool OpenGLGDI::set_instance_buffer(uint32_t inst_id, uint32_t index)
 bool OpenGLGDI::create_texture(uint32_t t_id, uint32_t width, uint32_t height,
                                PixelFormat::Enum pixel_format, bool mipmapped)
 {
+    if (pixel_format == PixelFormat::Enum::bc7 && !bptc_supported_) {
+        SKY_ERROR("OpenGL", "Unable to create texture with id %d: bc7 textures aren't supported "
+            "by this context", t_id);
+        return false;
+    }
+
     auto tex = textures_.create(t_id);
     if (tex == nullptr) {
         return false;
@@ -459,23 +501,43 @@ bool OpenGLGDI::create_texture(uint32_t t_id, uint32_t width, uint32_t height,
     }
     SKY_GL_CHECK(glBindTexture(GL_TEXTURE_2D, *tex));
 
-    // Specify no mipmap levels for the texture but keep mipmap filtering on.
     // OpenGL textures have a default max mipmap level of 1000 until specified otherwise - causing
-    // the texture to be considered incomplete if no mipmap levels are defined in the meantime.
+    // the texture to be considered incomplete if not all of those levels are defined. Mipmapped
+    // textures get a full chain down to 1x1, otherwise only the base level is used
+    auto levels = mipmapped ? mip_level_count(width, height) : 1;
     SKY_GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0));
-    SKY_GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0));
+    SKY_GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1));
+
+    if (mipmapped) {
+        SKY_GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+                                     GL_LINEAR_MIPMAP_LINEAR));
+    }
 
-    // Generate blank texture to be filled with `create_texture_region`
+    // Generate blank levels to be filled with `create_texture_region`
     auto pxlfmt = gl_pixel_formats_[pixel_format];
-    SKY_GL_CHECK(glTexImage2D(GL_TEXTURE_2D, 0, pxlfmt.internal_format, width, height, 0,
-                                    pxlfmt.data_format, GL_UNSIGNED_BYTE, nullptr));
+    for (uint32_t level = 0; level < levels; ++level) {
+        auto level_width = mip_dimension(width, level);
+        auto level_height = mip_dimension(height, level);
+
+        if (PixelFormat::is_compressed(pixel_format)) {
+            auto size = PixelFormat::image_size(pixel_format, level_width, level_height);
+            SKY_GL_CHECK(glCompressedTexImage2D(GL_TEXTURE_2D, level, pxlfmt.internal_format,
+                                                level_width, level_height, 0,
+                                                static_cast<GLsizei>(size), nullptr));
+            continue;
+        }
+
+        SKY_GL_CHECK(glTexImage2D(GL_TEXTURE_2D, level, pxlfmt.internal_format, level_width,
+                                  level_height, 0, pxlfmt.data_format, GL_UNSIGNED_BYTE, nullptr));
+    }
 
     SKY_GL_CHECK(glBindTexture(GL_TEXTURE_2D, 0));
     return true;
 }
 
 bool OpenGLGDI::create_texture_region(uint32_t tex_id, const UIntRect& region,
-                                      PixelFormat::Enum pixel_format, uint8_t* data)
+                                      PixelFormat::Enum pixel_format, uint8_t* data,
+                                      uint32_t mip_level)
 {
     auto tex = textures_.get(tex_id);
     if (tex == nullptr) {
@@ -485,16 +547,22 @@ bool OpenGLGDI::create_texture_region(uint32_t tex_id, const UIntRect& region,
     auto gl_pxlfmt = gl_pixel_formats_[pixel_format];
     auto bpp = PixelFormat::bytes_per_pixel(pixel_format);
 
-    // Adjust unpack alignment for 8 and 16 bit pixel formats
-    SKY_GL_CHECK(glPixelStorei(GL_UNPACK_ALIGNMENT, bpp));
-    SKY_GL_CHECK(glBindTexture(GL_TEXTURE_2D, *tex));
-    SKY_GL_CHECK(glTexSubImage2D(GL_TEXTURE_2D, 0, region.position.x, region.position.y,
-                                       region.width, region.height, gl_pxlfmt.data_format,
-                                       GL_UNSIGNED_BYTE, data));
-    SKY_GL_CHECK(glBindTexture(GL_TEXTURE_2D, 0));
+    // Regions are staged and only uploaded on the next draw or at the end of the frame
+    if (PixelFormat::is_compressed(pixel_format)) {
+        auto size = PixelFormat::image_size(pixel_format, region.width, region.height);
+        texture_uploader_.upload_compressed(*tex, region, mip_level, gl_pxlfmt.internal_format,
+                                            size, data);
+    } else if (pixel_format == PixelFormat::Enum::rgb8) {
+        // Drivers swizzle 3-byte rows on the CPU so rgb8 textures are stored as rgba8 instead
+        texture_uploader_.upload_converted(*tex, region, mip_level, gl_pxlfmt.data_format,
+                                           pixel_format, PixelFormat::Enum::rgba8, data);
+    } else {
+        texture_uploader_.upload(*tex, region, mip_level, gl_pxlfmt.data_format, bpp, data);
+    }
 
-    if (bpp != 4) {
-        SKY_GL_CHECK(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
+    // Regions too large to be staged are uploaded immediately which unbinds the current texture
+    if (!texture_uploader_.has_pending() && bound_texture_ != 0) {
+        SKY_GL_CHECK(glBindTexture(GL_TEXTURE_2D, bound_texture_));
     }
     return true;
 }
@@ -507,6 +575,7 @@ bool OpenGLGDI::set_texture(uint32_t t_id, uint32_t index)
     }
 
     SKY_GL_CHECK(glBindTexture(GL_TEXTURE_2D, *tex));
+    bound_texture_ = *tex;
     return true;
 }
 
@@ -568,12 +637,27 @@ bool OpenGLGDI::check_uniform_slots()
     return true;
 }
 
+void OpenGLGDI::flush_texture_uploads()
+{
+    if (!texture_uploader_.has_pending()) {
+        return;
+    }
+
+    // Flushing binds each uploaded texture in turn so the bound texture is restored afterwards
+    texture_uploader_.flush();
+    if (bound_texture_ != 0) {
+        SKY_GL_CHECK(glBindTexture(GL_TEXTURE_2D, bound_texture_));
+    }
+}
+
 bool OpenGLGDI::draw()
 {
     if (state_.vertex_buffer <= 0) {
         return false;
     }
 
+    flush_texture_uploads();
+
     if (!check_uniform_slots()) {
         return false;
     }
@@ -595,6 +679,8 @@ bool OpenGLGDI::draw_instanced(uint32_t instance)
         return false;
     }
 
+    flush_texture_uploads();
+
     if (!check_uniform_slots()) {
         return false;
     }
@@ -617,21 +703,21 @@ bool OpenGLGDI::draw_instanced(uint32_t instance)
             continue;
         }
 
-        // TODO(Jacob): Make sure it's really obvious that instance buffer elements have to be 16 byte multiples
-        // Below: dirty hack to get OpenGL to play nice with other API's - elements must be
-        // a 16 byte multiple
-        auto component_size = static_cast<GLint>(buf->stride) / 16;
+        // Instance elements must be a multiple of 16 bytes to match the other API's. Each 16
+        // bytes is bound as a vec4 at consecutive locations so elements can be declared as a
+        // single vec4 or matrix attribute, i.e. a mat4 or a mat3x4 of three vec4 columns
+        auto num_columns = static_cast<GLint>(buf->stride) / 16;
 
         SKY_GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, buf->id));
 
-        for (int i = 0; i < component_size; ++i) {
+        for (int i = 0; i < num_columns; ++i) {
             SKY_GL_CHECK(glEnableVertexAttribArray(static_cast<GLuint>(inst.location + i)));
             SKY_GL_CHECK(glVertexAttribPointer(static_cast<GLuint>(inst.location + i),
-                                               component_size,
+                                               4,
                                                GL_FLOAT,
                                                GL_FALSE,
                                                static_cast<GLsizei>(buf->stride),
-                                               reinterpret_cast<void*>(i * component_size * sizeof(float))));
+                                               reinterpret_cast<void*>(i * 4 * sizeof(float))));
             SKY_GL_CHECK(glVertexAttribDivisor(static_cast<GLuint>(inst.location + i), 1));
         }
 
@@ -16,6 +16,7 @@
 #include "Skyrocket/Graphics/Renderer/OpenGL/GLContext.hpp"
 #include "Skyrocket/Core/Containers/HandleTable.hpp"
 #include "Skyrocket/Graphics/Renderer/OpenGL/GLResource.hpp"
+#include "Skyrocket/Graphics/Renderer/OpenGL/GLTextureUpload.hpp"
 
 namespace sky {
 
@@ -54,13 +55,15 @@ protected:
     bool update_uniform(uint32_t u_id, const MemoryBlock& data, uint32_t offset) override;
 
     bool create_instance_buffer(uint32_t inst_id, uint32_t stride, uint32_t size) override;
-    bool update_instance_buffer(uint32_t inst_id, uint8_t* data, uint32_t index) override;
+    bool update_instance_buffer(uint32_t inst_id, uint8_t* data, uint32_t index,
+                                uint32_t count) override;
     bool set_instance_buffer(uint32_t inst_id, uint32_t index) override;
 
     bool create_texture(uint32_t t_id, uint32_t width, uint32_t height,
                                 PixelFormat::Enum pixel_format, bool mipmapped) override;
     bool create_texture_region(uint32_t tex_id, const UIntRect& region,
-                                       PixelFormat::Enum pixel_format, uint8_t* data) override;
+                                       PixelFormat::Enum pixel_format, uint8_t* data,
+                                       uint32_t mip_level) override;
     bool set_texture(uint32_t t_id, uint32_t index) override;
 
     bool set_state(uint32_t flags) override;
@@ -78,11 +81,16 @@ private:
         {GL_RG8,                GL_RG},                     // rg8
         {GL_RG16,               GL_RG},                     // rg16
         {GL_RG32F,              GL_RG},                     // rg32
-        {GL_RGB8,               GL_RGB},                    // rgb8
-        {GL_BGRA,               GL_BGRA},                   // bgra8
+        {GL_RGBA8,              GL_RGBA},                   // rgb8 - expanded on upload
+        {GL_RGBA8,              GL_BGRA},                   // bgra8
         {GL_RGBA8,              GL_RGBA},                   // rgba8
         {GL_RGBA16,             GL_RGBA},                   // rgba16
         {GL_RGBA32F,            GL_RGBA},                   // rgba32
+        {GL_COMPRESSED_RGBA_S3TC_DXT1_EXT,  GL_RGBA},       // bc1
+        {GL_COMPRESSED_RGBA_S3TC_DXT5_EXT,  GL_RGBA},       // bc3
+        {GL_COMPRESSED_RED_RGTC1,           GL_RED},        // bc4
+        {GL_COMPRESSED_RG_RGTC2,            GL_RG},         // bc5
+        {GL_COMPRESSED_RGBA_BPTC_UNORM,     GL_RGBA},       // bc7
         {GL_DEPTH_COMPONENT32,  GL_DEPTH_COMPONENT},        // depth
         {GL_STENCIL_INDEX8,     GL_STENCIL_INDEX},          // stencil
         {GL_FALSE,              GL_FALSE}                   // unknown
@@ -98,16 +106,20 @@ private:
     Viewport* viewport_{nullptr};
     GLuint default_vao_{0};
     GLProgram default_program_;
+    GLuint bound_texture_{0};
+    bool bptc_supported_{false};
+    GLTextureUploader texture_uploader_;
 
-    HandleTable<GLuint, vertex_buffer_max> vertex_buffers_;
-    HandleTable<GLuint, index_buffer_max> index_buffers_;
-    HandleTable<GLUniformSlot, uniform_buffer_max> uniform_buffers_;
-    HandleTable<GLInstanceBuffer, instance_buffer_max> instance_buffers_;
-    HandleTable<GLProgram, shader_max> programs_;
-    HandleTable<GLuint, texture_max> textures_;
+    HandleTable<GLuint> vertex_buffers_;
+    HandleTable<GLuint> index_buffers_;
+    HandleTable<GLUniformSlot> uniform_buffers_;
+    HandleTable<GLInstanceBuffer> instance_buffers_;
+    HandleTable<GLProgram> programs_;
+    HandleTable<GLuint> textures_;
 
     void set_uniform_data(GLint location, GLUniformSlot& slot);
     bool check_uniform_slots();
+    void flush_texture_uploads();
 };
 
 
@@ -51,12 +51,14 @@ void GLProgram::get_uniform_info(const uint32_t index, GLUniformInfo* info)
                                              &info->matrix_stride));
 }
 
-bool GLProgram::create(const char* vertex_source, const char* fragment_source)
+bool GLProgram::create(const char* vertex_source, const char* fragment_source,
+                       const GLint vertex_length, const GLint fragment_length)
 {
     GLShader<GLShaderType::vertex> vertex;
     GLShader<GLShaderType::fragment> fragment;
 
-    if (!vertex.create(vertex_source) || !fragment.create(fragment_source)) {
+    if (!vertex.create(vertex_source, vertex_length)
+        || !fragment.create(fragment_source, fragment_length)) {
         return false;
     }
 
@@ -103,6 +105,8 @@ bool GLProgram::create(const char* vertex_source, const char* fragment_source)
                                                  &info.name_len, &info.size, &type, info.name));
             SKY_GL_CHECK(info.location = glGetAttribLocation(id, info.name));
             if (strncmp(info.name, "sky_instance__", 14) == 0) {
+                // Instance buffers are assigned to slots matching their attribute location
+                info.index = static_cast<GLuint>(info.location);
                 info.type = gl_translate_uniform_type(type);
                 instances.push_back(info);
             }
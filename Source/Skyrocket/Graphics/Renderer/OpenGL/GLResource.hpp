@@ -35,7 +35,8 @@ struct GLShader {
         : id(0)
     {}
 
-    bool create(const char* source);
+    /// @brief Compiles the shader. A negative `length` indicates `source` is null-terminated
+    bool create(const char* source, GLint length = -1);
 
     void destroy();
 };
@@ -82,6 +83,7 @@ struct GLProgram {
         other.id = 0;
         other.num_attrs = 0;
         std::swap(uniforms, other.uniforms);
+        std::swap(instances, other.instances);
     }
 
     GLProgram& operator=(const GLProgram& other) = default;
@@ -97,10 +99,14 @@ struct GLProgram {
         other.num_attrs = 0;
 
         std::swap(uniforms, other.uniforms);
+        std::swap(instances, other.instances);
         return *this;
     }
 
-    bool create(const char* vertex_source, const char* fragment_source);
+    /// @brief Compiles and links the program. Negative lengths indicate the sources are
+    /// null-terminated
+    bool create(const char* vertex_source, const char* fragment_source,
+                GLint vertex_length = -1, GLint fragment_length = -1);
 
     void destroy();
 
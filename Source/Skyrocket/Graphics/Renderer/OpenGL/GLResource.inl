@@ -15,7 +15,7 @@ namespace sky {
 
 
 template <GLShaderType T>
-bool GLShader<T>::create(const char* source)
+bool GLShader<T>::create(const char* source, const GLint length)
 
 {
     auto type = static_cast<GLenum>(T);
@@ -25,7 +25,7 @@ bool GLShader<T>::create(const char* source)
         return false;
     }
 
-    SKY_GL_CHECK(glShaderSource(id, 1, &source, NULL));
+    SKY_GL_CHECK(glShaderSource(id, 1, &source, &length));
 
     SKY_GL_CHECK(glCompileShader(id));
 
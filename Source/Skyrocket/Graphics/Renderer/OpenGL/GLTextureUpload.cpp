@@ -0,0 +1,282 @@
+//
+//  GLTextureUpload.cpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#include "Skyrocket/Graphics/Renderer/OpenGL/GLTextureUpload.hpp"
+#include "Skyrocket/Graphics/PixelConversion.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace sky {
+
+
+constexpr size_t GLTextureUploader::buffer_size;
+constexpr GLint GLTextureUploader::default_unpack_alignment;
+
+/// Gets the largest unpack alignment GL accepts that evenly divides a row of pixels
+GLint get_row_alignment(const size_t row_bytes)
+{
+    if ( row_bytes % 8 == 0 ) {
+        return 8;
+    }
+
+    if ( row_bytes % 4 == 0 ) {
+        return 4;
+    }
+
+    return row_bytes % 2 == 0 ? 2 : 1;
+}
+
+void GLTextureUploader::create()
+{
+    for ( auto& buf : buffers_ ) {
+        SKY_GL_CHECK(glGenBuffers(1, &buf.pbo));
+        SKY_GL_CHECK(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buf.pbo));
+        SKY_GL_CHECK(glBufferData(GL_PIXEL_UNPACK_BUFFER, buffer_size, nullptr, GL_STREAM_DRAW));
+    }
+
+    SKY_GL_CHECK(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+
+    current_ = 0;
+    cursor_ = 0;
+    mapped_ = nullptr;
+    pending_.reserve(256);
+}
+
+void GLTextureUploader::destroy()
+{
+    if ( mapped_ != nullptr ) {
+        SKY_GL_CHECK(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffers_[current_].pbo));
+        SKY_GL_CHECK(glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER));
+        SKY_GL_CHECK(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+        mapped_ = nullptr;
+    }
+
+    for ( auto& buf : buffers_ ) {
+        if ( buf.fence != nullptr ) {
+            glDeleteSync(buf.fence);
+            buf.fence = nullptr;
+        }
+
+        if ( buf.pbo != 0 ) {
+            SKY_GL_CHECK(glDeleteBuffers(1, &buf.pbo));
+            buf.pbo = 0;
+        }
+    }
+
+    pending_.clear();
+}
+
+void GLTextureUploader::upload(const GLuint texture, const UIntRect& region, const GLint level,
+                               const GLenum data_format, const uint32_t bytes_per_pixel,
+                               const uint8_t* data)
+{
+    const auto row_bytes = static_cast<size_t>(region.width) * bytes_per_pixel;
+
+    Upload upload {
+        texture, level, region, data_format, get_row_alignment(row_bytes), 0, 0
+    };
+    stage(upload, row_bytes * region.height, data);
+}
+
+void GLTextureUploader::upload_converted(const GLuint texture, const UIntRect& region,
+                                         const GLint level, const GLenum data_format,
+                                         const PixelFormat::Enum src_format,
+                                         const PixelFormat::Enum dest_format,
+                                         const uint8_t* data)
+{
+    const auto count = static_cast<size_t>(region.width) * region.height;
+    const auto row_bytes = static_cast<size_t>(region.width)
+        * PixelFormat::bytes_per_pixel(dest_format);
+    const auto size = row_bytes * region.height;
+
+    if ( size == 0 ) {
+        return;
+    }
+
+    Upload upload {
+        texture, level, region, data_format, get_row_alignment(row_bytes), 0, 0
+    };
+
+    if ( size > buffer_size ) {
+        conversion_buffer_.resize(size);
+        convert_pixels(data, src_format, conversion_buffer_.data(), dest_format, count);
+        stage(upload, size, conversion_buffer_.data());
+        return;
+    }
+
+    // Converting straight into the staging buffer saves a second copy of the region
+    auto staging = reserve(upload, size);
+    if ( staging != nullptr ) {
+        convert_pixels(data, src_format, staging, dest_format, count);
+    }
+}
+
+void GLTextureUploader::upload_compressed(const GLuint texture, const UIntRect& region,
+                                          const GLint level, const GLenum internal_format,
+                                          const size_t size, const uint8_t* data)
+{
+    Upload upload {
+        texture, level, region, internal_format, default_unpack_alignment, 0, size
+    };
+    stage(upload, size, data);
+}
+
+void GLTextureUploader::stage(Upload& upload, const size_t size, const uint8_t* data)
+{
+    if ( size == 0 ) {
+        return;
+    }
+
+    // Regions that could never fit in a staging buffer are uploaded straight from client memory
+    if ( size > buffer_size ) {
+        flush();
+        SKY_GL_CHECK(glBindTexture(GL_TEXTURE_2D, upload.texture));
+        submit(upload, data);
+        set_unpack_alignment(default_unpack_alignment);
+        SKY_GL_CHECK(glBindTexture(GL_TEXTURE_2D, 0));
+        return;
+    }
+
+    auto staging = reserve(upload, size);
+    if ( staging != nullptr ) {
+        memcpy(staging, data, size);
+    }
+}
+
+uint8_t* GLTextureUploader::reserve(Upload& upload, const size_t size)
+{
+    // Keep every region 16 byte aligned within the staging buffer
+    auto offset = (cursor_ + 15) & ~static_cast<size_t>(15);
+    if ( offset + size > buffer_size ) {
+        flush();
+        next_buffer();
+        offset = 0;
+    }
+
+    if ( mapped_ == nullptr && !map_current() ) {
+        return nullptr;
+    }
+
+    cursor_ = offset + size;
+
+    upload.offset = offset;
+    pending_.push_back(upload);
+    return mapped_ + (offset - mapped_offset_);
+}
+
+void GLTextureUploader::submit(const Upload& upload, const void* pixels)
+{
+    const auto& region = upload.region;
+
+    if ( upload.compressed_size > 0 ) {
+        SKY_GL_CHECK(glCompressedTexSubImage2D(GL_TEXTURE_2D, upload.level, region.position.x,
+                                               region.position.y, region.width, region.height,
+                                               upload.format,
+                                               static_cast<GLsizei>(upload.compressed_size),
+                                               pixels));
+        return;
+    }
+
+    set_unpack_alignment(upload.alignment);
+    SKY_GL_CHECK(glTexSubImage2D(GL_TEXTURE_2D, upload.level, region.position.x,
+                                 region.position.y, region.width, region.height, upload.format,
+                                 GL_UNSIGNED_BYTE, pixels));
+}
+
+void GLTextureUploader::flush()
+{
+    if ( mapped_ == nullptr ) {
+        return;
+    }
+
+    SKY_GL_CHECK(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffers_[current_].pbo));
+    SKY_GL_CHECK(glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER));
+    mapped_ = nullptr;
+
+    // Group uploads by texture while preserving submission order within each texture
+    std::stable_sort(pending_.begin(), pending_.end(), [](const Upload& lhs, const Upload& rhs) {
+        return lhs.texture < rhs.texture;
+    });
+
+    GLuint bound_texture = 0;
+    for ( auto& upload : pending_ ) {
+        if ( upload.texture != bound_texture ) {
+            SKY_GL_CHECK(glBindTexture(GL_TEXTURE_2D, upload.texture));
+            bound_texture = upload.texture;
+        }
+
+        submit(upload, reinterpret_cast<const void*>(upload.offset));
+    }
+
+    set_unpack_alignment(default_unpack_alignment);
+    SKY_GL_CHECK(glBindTexture(GL_TEXTURE_2D, 0));
+    SKY_GL_CHECK(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+
+    pending_.clear();
+}
+
+bool GLTextureUploader::map_current()
+{
+    auto& buf = buffers_[current_];
+
+    // Only the unused tail of the buffer is mapped so any regions still being read by the GPU
+    // from earlier flushes are left untouched and no synchronization is required
+    SKY_GL_CHECK(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buf.pbo));
+    auto ptr = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, cursor_, buffer_size - cursor_,
+                                GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT
+                                    | GL_MAP_UNSYNCHRONIZED_BIT);
+    SKY_GL_CHECK(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+
+    if ( ptr == nullptr ) {
+        SKY_ERROR("OpenGL", "Unable to map texture staging buffer %u", buf.pbo);
+        return false;
+    }
+
+    mapped_ = static_cast<uint8_t*>(ptr);
+    mapped_offset_ = cursor_;
+    return true;
+}
+
+void GLTextureUploader::next_buffer()
+{
+    // Fence the buffer being left so it isn't overwritten until the GPU has consumed it
+    auto& prev = buffers_[current_];
+    prev.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    current_ = (current_ + 1) % num_buffers;
+    cursor_ = 0;
+
+    auto& next = buffers_[current_];
+    if ( next.fence != nullptr ) {
+        static constexpr GLuint64 timeout_ns = 1000000000;
+        auto result = glClientWaitSync(next.fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout_ns);
+        if ( result == GL_TIMEOUT_EXPIRED || result == GL_WAIT_FAILED ) {
+            SKY_ERROR("OpenGL", "Timed out waiting for texture staging buffer %u", next.pbo);
+        }
+
+        glDeleteSync(next.fence);
+        next.fence = nullptr;
+    }
+}
+
+void GLTextureUploader::set_unpack_alignment(const GLint alignment)
+{
+    if ( alignment == unpack_alignment_ ) {
+        return;
+    }
+
+    SKY_GL_CHECK(glPixelStorei(GL_UNPACK_ALIGNMENT, alignment));
+    unpack_alignment_ = alignment;
+}
+
+
+} // namespace sky
@@ -0,0 +1,111 @@
+//
+//  GLTextureUpload.hpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#pragma once
+
+#include "Skyrocket/Core/Geometry/Rectangle.hpp"
+#include "Skyrocket/Core/Memory/Memory.hpp"
+#include "Skyrocket/Graphics/Renderer/Definitions.hpp"
+#include "Skyrocket/Graphics/Renderer/OpenGL/GLConfig.hpp"
+
+#include <vector>
+
+namespace sky {
+
+
+/// @brief Stages texture region uploads through a ring of pixel buffer objects so that pixel
+/// data is handed to the driver asynchronously rather than being copied out of client memory
+/// synchronously by `glTexSubImage2D`.
+///
+/// Queued regions are copied tightly packed into the currently mapped staging buffer and the
+/// actual `glTexSubImage2D` calls are only issued on `flush`, grouped by texture so each texture
+/// is bound once and many small regions (i.e. glyphs) share one transfer. Each staging buffer is
+/// fenced when the ring moves past it and only reused once the GPU has consumed it.
+class GLTextureUploader {
+public:
+    static constexpr uint32_t num_buffers = 3;
+    static constexpr size_t buffer_size = mebibytes(4);
+
+    /// @brief Creates the staging buffers. Must be called with a current GL context
+    void create();
+
+    /// @brief Releases the staging buffers and any outstanding fences
+    void destroy();
+
+    /// @brief Queues an upload of `data` into `region` of `texture` at `level`. Regions too large
+    /// to fit in a staging buffer are uploaded directly after flushing any queued uploads so
+    /// upload order is always preserved.
+    void upload(GLuint texture, const UIntRect& region, GLint level, GLenum data_format,
+                uint32_t bytes_per_pixel, const uint8_t* data);
+
+    /// @brief Queues an upload of `data` in `src_format`, converting it to `dest_format` while
+    /// copying it into the staging buffer, i.e. to upload rgb8 pixels to an rgba8 texture
+    void upload_converted(GLuint texture, const UIntRect& region, GLint level, GLenum data_format,
+                          PixelFormat::Enum src_format, PixelFormat::Enum dest_format,
+                          const uint8_t* data);
+
+    /// @brief Queues an upload of block compressed `data` into `region` of `texture` at `level`.
+    /// The region must be aligned to 4x4 blocks and `size` must cover all of its blocks
+    void upload_compressed(GLuint texture, const UIntRect& region, GLint level,
+                           GLenum internal_format, size_t size, const uint8_t* data);
+
+    /// @brief Issues all queued uploads from the staging buffer
+    void flush();
+
+    inline bool has_pending() const
+    {
+        return !pending_.empty();
+    }
+private:
+    struct Upload {
+        GLuint texture;
+        GLint level;
+        UIntRect region;
+        GLenum format;
+        GLint alignment;
+        size_t offset;
+        /// Non-zero for block compressed regions, in which case `format` is the internal format
+        size_t compressed_size;
+    };
+
+    struct StagingBuffer {
+        GLuint pbo{0};
+        GLsync fence{nullptr};
+    };
+
+    StagingBuffer buffers_[num_buffers];
+    uint32_t current_{0};
+
+    uint8_t* mapped_{nullptr};
+    size_t mapped_offset_{0};
+    size_t cursor_{0};
+
+    /// GL's initial `GL_UNPACK_ALIGNMENT`, restored after every batch of uploads so texture
+    /// uploads made outside the uploader aren't affected
+    static constexpr GLint default_unpack_alignment = 4;
+
+    GLint unpack_alignment_{default_unpack_alignment};
+
+    std::vector<Upload> pending_;
+
+    /// Holds converted regions too large to be staged
+    std::vector<uint8_t> conversion_buffer_;
+
+    void stage(Upload& upload, size_t size, const uint8_t* data);
+    uint8_t* reserve(Upload& upload, size_t size);
+    void submit(const Upload& upload, const void* pixels);
+    bool map_current();
+    void next_buffer();
+    void set_unpack_alignment(GLint alignment);
+};
+
+
+} // namespace sky
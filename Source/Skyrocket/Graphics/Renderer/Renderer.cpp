@@ -14,7 +14,7 @@
 namespace sky {
 
 Renderer::Renderer()
-    : cmdpool_(sizeof(CommandBuffer), cmdpool_size_),
+    : cmdpool_(sizeof(CommandBuffer), cmdpool_size_, alignof(CommandBuffer), false),
       cmdlist_sem_(max_submissions_in_flight_),
       vsync_on_(false)
 {}
@@ -53,11 +53,11 @@ bool Renderer::destroy()
 
 CommandList Renderer::make_command_list()
 {
-    std::unique_lock<std::mutex> lock(cmdpool_mut_);
-    auto cmdbuf = static_cast<CommandBuffer*>(cmdpool_.allocate(0));
+    // The pool is lock-free so this can spin until the render thread frees a buffer
+    auto cmdbuf = static_cast<CommandBuffer*>(cmdpool_.allocate(sizeof(CommandBuffer)));
 
     while (cmdbuf == nullptr) {
-        cmdbuf = static_cast<CommandBuffer*>(cmdpool_.allocate(0));
+        cmdbuf = static_cast<CommandBuffer*>(cmdpool_.allocate(sizeof(CommandBuffer)));
         if (cmdbuf != nullptr) {
             break;
         }
@@ -133,7 +133,7 @@ void Renderer::process_command_list(CommandList* list)
 
     gdi_->submit(list->buffer);
 
-    list->clear();
+    list->reset();
 }
 
 void Renderer::render_thread_start()
@@ -169,8 +169,6 @@ void Renderer::render_thread_proc()
             if (gdi_->begin_frame(&current_frame())) {
                 for (int c = 0; c < node.submission->current_list; ++c) {
                     process_command_list(&node.submission->lists[c]);
-
-                    std::unique_lock<std::mutex> lock(cmdpool_mut_);
                     cmdpool_.free(node.submission->lists[c].buffer);
                 }
                 gdi_->end_frame(&current_frame());
@@ -104,7 +104,6 @@ private:
     std::condition_variable vsync_cv_;
 
     // Render thread properties/methods
-    std::mutex cmdpool_mut_;
     Semaphore cmdlist_sem_;
     ThreadSupport threadsupport_;
     std::condition_variable render_thread_cv_;
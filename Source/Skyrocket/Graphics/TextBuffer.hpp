@@ -12,84 +12,146 @@
 #pragma once
 
 #include "Skyrocket/Resource/Font.hpp"
+#include "Skyrocket/Resource/TextShaper.hpp"
 #include "Skyrocket/Graphics/Renderer/Renderer.hpp"
 #include "Skyrocket/Graphics/Renderer/Vertex.hpp"
+#include "Skyrocket/Graphics/Color.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace sky {
 
 
-class TextBuffer {
+/// @brief A single character drawn by a TextBatch. Each instance is expanded into a quad by the
+/// vertex shader from a shared unit quad so it's laid out as three vec4 columns, `rect`, `uv`
+/// and `color`, to match an instance attribute declared as `mat3x4 sky_instance__glyph`
+struct GlyphInstance {
+    float x{0.0f}, y{0.0f}, width{0.0f}, height{0.0f};
+    float s{0.0f}, t{0.0f}, s2{0.0f}, t2{0.0f};
+    float r{1.0f}, g{1.0f}, b{1.0f}, a{1.0f};
+};
+
+static_assert(sizeof(GlyphInstance) % 16 == 0,
+              "GlyphInstance must be a multiple of 16 bytes to be used as instance data");
+
+/// @brief Draws any number of independent strings set with one font in a single instanced draw.
+/// Strings are retained between frames and each owns a range of the batch's instance buffer, so
+/// strings that haven't changed aren't laid out again and instances are only uploaded in `submit`
+/// when a string has changed. Strings are usually created and set through a TextBuffer.
+/// Only one batch should be used per font as the batch that submits first uploads new glyphs
+class TextBatch {
 public:
-    static constexpr size_t max_characters = kibibytes(8);
+    static constexpr uint32_t default_max_characters = 4096;
+    static constexpr uint32_t invalid_string = UINT32_MAX;
 
-    TextBuffer(Renderer* renderer, Font* font)
-        : renderer_(renderer), font_(font)
+    /// @brief Creates a batch drawing at most `max_characters` characters across all its strings
+    TextBatch(Renderer* renderer, Font* font, const uint32_t max_characters = default_max_characters)
+        : renderer_(renderer),
+          font_(font),
+          shaper_(font),
+          max_characters_(max_characters),
+          instances_(new GlyphInstance[max_characters])
     {}
 
+    TextBatch(const TextBatch& other) = delete;
+    TextBatch& operator=(const TextBatch& other) = delete;
+
     void init()
     {
         auto cmdlist = renderer_->make_command_list();
+        // Glyphs are uploaded as they're rasterised into the fonts atlas in `submit`
         texid_ = cmdlist.create_texture(font_->width(), font_->height(), PixelFormat::Enum::r8);
-        for (auto& glyph : *font_) {
-            if ( glyph.bounds.width <= 0 || glyph.bounds.height <= 0 || glyph.data == nullptr ) {
-                continue;
-            }
-            cmdlist.create_texture_region(texid_, glyph.bounds, sky::PixelFormat::Enum::r8, glyph.data);
-        }
 
-        uint32_t vertex = 0;
-        for (uint32_t i = 0; i < max_characters; i += indices_per_char_) {
-            indices_[i] = vertex;
-            indices_[i + 1] = vertex + 1;
-            indices_[i + 2] = vertex + 2;
-            indices_[i + 3] = vertex;
-            indices_[i + 4] = vertex + 2;
-            indices_[i + 5] = vertex + 3;
-
-            vertex += verts_per_char_;
-        }
+        // Every character is drawn from the same unit quad. Its texture coordinates are used to
+        // interpolate between the corners of each instances position and atlas rectangles
+        update_quad(quad_z_);
 
         vbufid_ = cmdlist.create_vertex_buffer(MemoryBlock {
-            static_cast<uint32_t>(sizeof(Vertex) * max_characters), vertices_
+            static_cast<uint32_t>(sizeof(Vertex) * verts_per_char_), quad_
         }, BufferUsage::dynamic);
 
         ibufid_ = cmdlist.create_index_buffer(MemoryBlock {
-            static_cast<uint32_t>(sizeof(uint32_t) * max_characters), indices_
+            static_cast<uint32_t>(sizeof(uint32_t) * indices_per_char_), quad_indices_
         });
+
+        instbufid_ = cmdlist.create_instance_buffer(sizeof(GlyphInstance), max_characters_);
         renderer_->submit(cmdlist);
+
+        // Everything needs uploading again if the batch is recreated, i.e. for a new backend
+        instances_need_updating_ = true;
     }
 
-    void set_text(const char* str, const size_t str_size, const Vector3f& pos)
+    /// @brief Adds a new empty string to the batch
+    uint32_t create_string()
     {
-        Glyph glyph;
-        auto x = pos.x;
-        auto y = pos.y;
-        num_vertices_ = 0;
-        string_size_ = str_size;
-        for (size_t c = 0; c < str_size; ++c) {
-            if (str[c] == '\n') {
-                y -= font_->size();
-                x = pos.x;
-                continue;
-            }
+        uint32_t id = 0;
+        if (!free_strings_.empty()) {
+            id = free_strings_.back();
+            free_strings_.pop_back();
+        } else {
+            id = static_cast<uint32_t>(strings_.size());
+            strings_.emplace_back();
+        }
 
-            glyph = font_->get_glyph(str[c]);
+        strings_[id] = TextString{};
+        strings_[id].active = true;
+        return id;
+    }
 
-            auto& bounds = glyph.bounds;
+    /// @brief Removes a string from the batch, freeing its characters for other strings
+    void destroy_string(const uint32_t id)
+    {
+        if (id >= strings_.size() || !strings_[id].active) {
+            return;
+        }
+
+        release_range(&strings_[id]);
+        strings_[id] = TextString{};
+        free_strings_.push_back(id);
+    }
+
+    /// @brief Sets the UTF-8 text, position and color of a string. Nothing is laid out or
+    /// uploaded if they're the same as the last time the string was set, and strings with the
+    /// same text as another string in the batch reuse its layout.
+    /// @return false if there's no room left in the batch for the string
+    bool set_string(const uint32_t id, const char* str, const size_t str_size,
+                    const Vector2f& pos, const Color& color)
+    {
+        if (id >= strings_.size() || !strings_[id].active) {
+            return false;
+        }
 
-            auto ypos = y - (glyph.bounds.height - glyph.bearing.y);
-            auto xpos = x;
+        auto& string = strings_[id];
+        if (string.position == pos && string.color == color && string.text.size() == str_size
+            && memcmp(string.text.data(), str, str_size) == 0) {
+            return true;
+        }
 
-            vertices_[num_vertices_] = Vertex(xpos, ypos + bounds.height, pos.z, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, glyph.s, glyph.t);
-            vertices_[num_vertices_ + 1] = Vertex(xpos, ypos, pos.z, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, glyph.s, glyph.t2);
-            vertices_[num_vertices_ + 2] = Vertex(xpos + bounds.width, ypos, pos.z, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, glyph.s2, glyph.t2);
-            vertices_[num_vertices_ + 3] = Vertex(xpos + bounds.width, ypos + bounds.height, pos.z, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, glyph.s2, glyph.t);
+        string.text.assign(str, str_size);
+        string.position = pos;
+        string.color = color;
 
-            x += glyph.advance.x;
-            num_vertices_ += verts_per_char_;
+        if (!layout(&string)) {
+            // Nothing is drawn for the string so its text is forgotten, otherwise setting the
+            // same text again would be skipped as unchanged
+            string.text.clear();
+            return false;
         }
 
-        needs_updating_ = true;
+        return true;
+    }
+
+    /// @brief Sets the depth every string in the batch is drawn at
+    void set_depth(const float z)
+    {
+        if (z != quad_z_) {
+            update_quad(z);
+            quad_needs_updating_ = true;
+        }
     }
 
     inline void set_program(const uint32_t program_id)
@@ -99,49 +161,284 @@ public:
 
     void submit(const uint32_t viewprojection_matrix)
     {
+        // Glyphs used by strings that weren't changed may have been evicted by the ones that were
+        if (font_->atlas_generation() != generation_) {
+            relayout();
+        }
+
         auto cmdlist = renderer_->make_command_list();
 
-        if (needs_updating_) {
+        UIntRect dirty_region;
+        if (font_->flush_atlas(&dirty_region)) {
+            auto dirty_texels = font_->atlas_data() + dirty_region.position.y * font_->width();
+            cmdlist.create_texture_region(texid_, dirty_region, PixelFormat::Enum::r8,
+                                          const_cast<uint8_t*>(dirty_texels));
+        }
+
+        if (quad_needs_updating_) {
             cmdlist.update_vertex_buffer(vbufid_, MemoryBlock {
-                static_cast<uint32_t>(num_vertices_ * sizeof(Vertex)), vertices_
+                static_cast<uint32_t>(verts_per_char_ * sizeof(Vertex)), quad_
             });
-            needs_updating_ = false;
+            quad_needs_updating_ = false;
+        }
+
+        // Every instance is uploaded rather than just the changed strings as backends that
+        // multi-buffer dynamic data, i.e. Metal, write each update to a different buffer
+        if (instances_need_updating_ && end_ > 0) {
+            cmdlist.update_instance_buffer(instbufid_, reinterpret_cast<uint8_t*>(instances_.get()),
+                                           0, end_);
+            instances_need_updating_ = false;
         }
 
-        if (string_size_ > 0) {
-            uint32_t viewprojpos = (renderer_->active_backend() == RendererBackend::OpenGL) ? 0 : 1;
+        if (end_ > 0) {
+            auto is_opengl = renderer_->active_backend() == RendererBackend::OpenGL;
+            uint32_t instancepos = is_opengl ? 3 : 1;
+            uint32_t viewprojpos = is_opengl ? 0 : 2;
 
             cmdlist.set_program(programid_);
             cmdlist.set_texture(texid_, 0);
-            cmdlist.set_vertex_buffer(vbufid_, 0, num_vertices_);
-            cmdlist.set_index_buffer(ibufid_, 0, static_cast<uint32_t>(string_size_ * indices_per_char_));
+            cmdlist.set_vertex_buffer(vbufid_, 0, verts_per_char_);
+            cmdlist.set_index_buffer(ibufid_, 0, indices_per_char_);
+            cmdlist.set_instance_buffer(instbufid_, instancepos);
             cmdlist.set_uniform(viewprojection_matrix, viewprojpos);
-            cmdlist.draw();
+            cmdlist.draw_instanced(end_);
         }
 
         renderer_->submit(cmdlist);
     }
+
+    /// @brief Gets the number of instances drawn by the batch, including unused characters
+    /// reserved by strings
+    inline uint32_t instance_count() const
+    {
+        return end_;
+    }
+
+    inline uint32_t max_characters() const
+    {
+        return max_characters_;
+    }
 private:
     static constexpr uint32_t verts_per_char_ = 4;
     static constexpr uint32_t indices_per_char_ = 6;
+    /// Strings reserve characters in multiples of this so they can grow without moving
+    static constexpr uint32_t range_granularity_ = 16;
+
+    struct TextString {
+        std::string text;
+        Vector2f position;
+        Color color;
+        uint32_t first{0};
+        uint32_t count{0};
+        uint32_t capacity{0};
+        bool active{false};
+    };
 
-    bool needs_updating_{false};
+    // Resources used
+    Renderer* renderer_;
+    Font* font_;
+    TextShaper shaper_;
 
     // State members
-    size_t string_size_{0};
-    uint32_t num_vertices_{0};
+    uint32_t max_characters_{0};
+    uint32_t end_{0};
+    uint32_t free_characters_{0};
+    uint64_t generation_{0};
+    float quad_z_{1.0f};
+    bool quad_needs_updating_{false};
+    bool instances_need_updating_{false};
+
+    std::vector<TextString> strings_;
+    std::vector<uint32_t> free_strings_;
 
     // GDI resources
-    uint32_t texid_{0}, vbufid_{0}, ibufid_{0}, programid_{0};
+    uint32_t texid_{0}, vbufid_{0}, ibufid_{0}, instbufid_{0}, programid_{0};
 
-    // Resources used
-    Renderer* renderer_;
-    Font* font_;
+    // Buffers - instances are allocated once so pointers to them stay valid until the renderer
+    // has processed the upload
+    Vertex quad_[verts_per_char_]{};
+    uint32_t quad_indices_[indices_per_char_]{0, 1, 2, 0, 2, 3};
+    std::unique_ptr<GlyphInstance[]> instances_;
+
+    void update_quad(const float z)
+    {
+        quad_z_ = z;
+        quad_[0] = Vertex(0.0f, 1.0f, z, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 0.0f, 0.0f);
+        quad_[1] = Vertex(0.0f, 0.0f, z, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 0.0f, 1.0f);
+        quad_[2] = Vertex(1.0f, 0.0f, z, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f);
+        quad_[3] = Vertex(1.0f, 1.0f, z, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 0.0f);
+    }
 
-    // Buffers
-    Vertex vertices_[max_characters * verts_per_char_]{};
-    uint32_t indices_[max_characters * indices_per_char_]{};
+    /// Empty instances produce degenerate quads so unused characters can be drawn for free
+    void clear_instances(const uint32_t begin, const uint32_t end)
+    {
+        for (auto i = begin; i < end; ++i) {
+            instances_[i] = GlyphInstance{};
+        }
+        instances_need_updating_ = true;
+    }
+
+    void release_range(TextString* string)
+    {
+        clear_instances(string->first, string->first + string->count);
+        free_characters_ += string->capacity;
+
+        // Ranges at the end are given back straight away
+        if (string->first + string->capacity == end_) {
+            end_ = string->first;
+            free_characters_ -= string->capacity;
+        }
+
+        string->first = 0;
+        string->count = 0;
+        string->capacity = 0;
+    }
+
+    /// Moves every string to the front of the buffer, removing gaps left by strings that were
+    /// destroyed or moved
+    void compact()
+    {
+        std::vector<TextString*> order;
+        for (auto& string : strings_) {
+            if (string.active && string.capacity > 0) {
+                order.push_back(&string);
+            }
+        }
+
+        std::sort(order.begin(), order.end(), [](const TextString* a, const TextString* b) {
+            return a->first < b->first;
+        });
+
+        uint32_t next = 0;
+        for (auto string : order) {
+            if (string->first != next) {
+                memmove(&instances_[next], &instances_[string->first],
+                        string->capacity * sizeof(GlyphInstance));
+                string->first = next;
+            }
+            next += string->capacity;
+        }
+
+        instances_need_updating_ = true;
+        end_ = next;
+        free_characters_ = 0;
+    }
+
+    bool reserve_range(TextString* string, const uint32_t count)
+    {
+        if (count <= string->capacity) {
+            return true;
+        }
+
+        release_range(string);
+
+        auto capacity = (count + range_granularity_ - 1) / range_granularity_ * range_granularity_;
+        if (end_ + capacity > max_characters_ && free_characters_ > 0) {
+            compact();
+        }
+
+        if (end_ + capacity > max_characters_) {
+            capacity = count;
+        }
+
+        if (end_ + capacity > max_characters_) {
+            SKY_ERROR("TextBatch", "Unable to fit %u characters into a text batch with %u of "
+                      "%u characters free", count, max_characters_ - end_, max_characters_);
+            return false;
+        }
+
+        string->first = end_;
+        string->capacity = capacity;
+        end_ += capacity;
+        clear_instances(string->first, end_);
+        return true;
+    }
+
+    bool layout(TextString* string)
+    {
+        const auto& run = shaper_.shape(string->text.data(), string->text.size());
+        auto count = static_cast<uint32_t>(run.glyphs.size());
+
+        if (!reserve_range(string, count)) {
+            return false;
+        }
+
+        auto r = string->color.r / 255.0f;
+        auto g = string->color.g / 255.0f;
+        auto b = string->color.b / 255.0f;
+        auto a = string->color.a / 255.0f;
+
+        auto inst = &instances_[string->first];
+        for (const auto& glyph : run.glyphs) {
+            inst->x = string->position.x + glyph.x;
+            inst->y = string->position.y + glyph.y;
+            inst->width = glyph.width;
+            inst->height = glyph.height;
+            inst->s = glyph.s;
+            inst->t = glyph.t;
+            inst->s2 = glyph.s2;
+            inst->t2 = glyph.t2;
+            inst->r = r;
+            inst->g = g;
+            inst->b = b;
+            inst->a = a;
+            ++inst;
+        }
+
+        // Characters left over from a longer string are hidden
+        auto old_count = string->count;
+        string->count = count;
+        if (old_count > count) {
+            clear_instances(string->first + count, string->first + old_count);
+        }
+
+        instances_need_updating_ = true;
+        return true;
+    }
+
+    void relayout()
+    {
+        // Every string is looked up again so their glyphs are all marked as in use for this frame
+        for (auto& string : strings_) {
+            if (string.active && string.count > 0) {
+                layout(&string);
+            }
+        }
+        generation_ = font_->atlas_generation();
+    }
 };
 
+/// @brief A single string drawn as part of a TextBatch
+class TextBuffer {
+public:
+    explicit TextBuffer(TextBatch* batch)
+        : batch_(batch), id_(batch->create_string())
+    {}
+
+    ~TextBuffer()
+    {
+        batch_->destroy_string(id_);
+    }
+
+    TextBuffer(const TextBuffer& other) = delete;
+    TextBuffer& operator=(const TextBuffer& other) = delete;
+
+    /// @brief Sets the text and position of the string. Setting the same text at the same
+    /// position as the last call does nothing
+    bool set_text(const char* str, const size_t str_size, const Vector2f& pos)
+    {
+        return batch_->set_string(id_, str, str_size, pos, color_);
+    }
+
+    /// @brief Sets the color used for the string the next time its text is set
+    void set_color(const Color& color)
+    {
+        color_ = color;
+    }
+private:
+    TextBatch* batch_;
+    uint32_t id_;
+    Color color_;
+};
 
 }
\ No newline at end of file
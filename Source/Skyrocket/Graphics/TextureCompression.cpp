@@ -0,0 +1,936 @@
+//
+//  TextureCompression.cpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#include "Skyrocket/Graphics/TextureCompression.hpp"
+#include "Skyrocket/Core/Config.hpp"
+#include "Skyrocket/Core/Diagnostics/Error.hpp"
+#include "Skyrocket/Platform/Jobs.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+#if SKY_SIMD_SSE2 == 1
+#include <emmintrin.h>
+#endif
+
+namespace sky {
+
+
+/// Number of blocks each compression job should encode before it's worth splitting work
+static constexpr uint32_t blocks_per_batch = 256;
+
+static constexpr uint16_t all_pixels = 0xFFFF;
+
+/// A 4x4 block of pixels stored as one array per channel so four pixels can be processed at once
+struct BlockPixels {
+    alignas(16) float channels[4][16];
+};
+
+/// Endpoint fitting settings for each quality preset
+struct QualitySettings {
+    bool principal_axis;
+    uint32_t refine_iterations;
+    bool exhaustive_bc4;
+};
+
+static QualitySettings get_quality_settings(const CompressionQuality quality)
+{
+    switch (quality) {
+        case CompressionQuality::fast:
+            return QualitySettings { false, 0, false };
+        case CompressionQuality::normal:
+            return QualitySettings { true, 1, false };
+        case CompressionQuality::high:
+            return QualitySettings { true, 3, true };
+    }
+
+    return QualitySettings { true, 1, false };
+}
+
+//////////////////////////
+// Bit packing helpers  //
+//////////////////////////
+
+struct BitWriter {
+    uint8_t* data;
+    uint32_t pos;
+
+    void write(uint32_t value, const uint32_t bits)
+    {
+        for ( uint32_t b = 0; b < bits; ++b, ++pos, value >>= 1 ) {
+            data[pos >> 3] |= static_cast<uint8_t>((value & 1) << (pos & 7));
+        }
+    }
+};
+
+struct BitReader {
+    const uint8_t* data;
+    uint32_t pos;
+
+    uint32_t read(const uint32_t bits)
+    {
+        uint32_t value = 0;
+        for ( uint32_t b = 0; b < bits; ++b, ++pos ) {
+            value |= ((data[pos >> 3] >> (pos & 7)) & 1u) << b;
+        }
+        return value;
+    }
+};
+
+static inline float clamp_unorm8(const float value)
+{
+    return value < 0.0f ? 0.0f : (value > 255.0f ? 255.0f : value);
+}
+
+//////////////////////////
+// Block fitting        //
+//////////////////////////
+
+static void load_block(const uint8_t* src, const uint32_t width, const uint32_t height,
+                       const uint32_t src_channels, const uint32_t bx, const uint32_t by,
+                       BlockPixels& block)
+{
+    for ( uint32_t y = 0; y < 4; ++y ) {
+        // Edge blocks replicate the last row and column of the image
+        auto sy = std::min(by * 4 + y, height - 1);
+
+        for ( uint32_t x = 0; x < 4; ++x ) {
+            auto sx = std::min(bx * 4 + x, width - 1);
+            auto px = src + (static_cast<size_t>(sy) * width + sx) * src_channels;
+            auto i = y * 4 + x;
+
+            block.channels[0][i] = px[0];
+            block.channels[1][i] = src_channels > 1 ? px[1] : 0.0f;
+            block.channels[2][i] = src_channels > 2 ? px[2] : 0.0f;
+            block.channels[3][i] = src_channels > 3 ? px[3] : 255.0f;
+        }
+    }
+}
+
+/// Finds the closest palette entry for each pixel over channels [first, last). Pixels not in
+/// `mask` still get an index but don't contribute to the returned squared error
+static float fit_indices(const BlockPixels& block, const float (*palette)[4],
+                         const uint32_t palette_size, const uint32_t first, const uint32_t last,
+                         const uint16_t mask, uint8_t* indices)
+{
+#if SKY_SIMD_SSE2 == 1
+    auto total = _mm_setzero_ps();
+
+    for ( uint32_t g = 0; g < 16; g += 4 ) {
+        auto best = _mm_set1_ps(FLT_MAX);
+        auto best_index = _mm_setzero_ps();
+
+        for ( uint32_t k = 0; k < palette_size; ++k ) {
+            auto dist = _mm_setzero_ps();
+            for ( uint32_t c = first; c < last; ++c ) {
+                auto diff = _mm_sub_ps(_mm_load_ps(&block.channels[c][g]),
+                                       _mm_set1_ps(palette[k][c]));
+                dist = _mm_add_ps(dist, _mm_mul_ps(diff, diff));
+            }
+
+            auto closer = _mm_cmplt_ps(dist, best);
+            best = _mm_min_ps(dist, best);
+            best_index = _mm_or_ps(_mm_and_ps(closer, _mm_set1_ps(static_cast<float>(k))),
+                                   _mm_andnot_ps(closer, best_index));
+        }
+
+        // Expand the mask bits of this group into full lanes
+        auto group_mask = _mm_set_epi32((mask >> (g + 3)) & 1, (mask >> (g + 2)) & 1,
+                                        (mask >> (g + 1)) & 1, (mask >> g) & 1);
+        auto lanes = _mm_castsi128_ps(_mm_sub_epi32(_mm_setzero_si128(), group_mask));
+        total = _mm_add_ps(total, _mm_and_ps(lanes, best));
+
+        alignas(16) int32_t group[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(group), _mm_cvttps_epi32(best_index));
+        for ( uint32_t i = 0; i < 4; ++i ) {
+            indices[g + i] = static_cast<uint8_t>(group[i]);
+        }
+    }
+
+    alignas(16) float sums[4];
+    _mm_store_ps(sums, total);
+    return sums[0] + sums[1] + sums[2] + sums[3];
+#else
+    auto total = 0.0f;
+
+    for ( uint32_t i = 0; i < 16; ++i ) {
+        auto best = FLT_MAX;
+        for ( uint32_t k = 0; k < palette_size; ++k ) {
+            auto dist = 0.0f;
+            for ( uint32_t c = first; c < last; ++c ) {
+                auto diff = block.channels[c][i] - palette[k][c];
+                dist += diff * diff;
+            }
+
+            if ( dist < best ) {
+                best = dist;
+                indices[i] = static_cast<uint8_t>(k);
+            }
+        }
+
+        if ( (mask >> i) & 1 ) {
+            total += best;
+        }
+    }
+
+    return total;
+#endif
+}
+
+/// Initial endpoints from the bounding box of the block, inset slightly to reduce the error of the
+/// pixels clustered between them
+static void bounds_endpoints(const BlockPixels& block, const uint32_t first, const uint32_t last,
+                             const uint16_t mask, float* e0, float* e1)
+{
+    for ( uint32_t c = first; c < last; ++c ) {
+        auto lo = 255.0f;
+        auto hi = 0.0f;
+        for ( uint32_t i = 0; i < 16; ++i ) {
+            if ( (mask >> i) & 1 ) {
+                lo = std::min(lo, block.channels[c][i]);
+                hi = std::max(hi, block.channels[c][i]);
+            }
+        }
+
+        auto inset = (hi - lo) / 16.0f;
+        e0[c] = hi - inset;
+        e1[c] = lo + inset;
+    }
+}
+
+/// Initial endpoints from the extent of the block along the principal axis of its colors
+static void principal_endpoints(const BlockPixels& block, const uint32_t first,
+                                const uint32_t last, const uint16_t mask, float* e0, float* e1)
+{
+    float mean[4]{};
+    auto count = 0.0f;
+
+    for ( uint32_t i = 0; i < 16; ++i ) {
+        if ( (mask >> i) & 1 ) {
+            for ( uint32_t c = first; c < last; ++c ) {
+                mean[c] += block.channels[c][i];
+            }
+            count += 1.0f;
+        }
+    }
+
+    for ( uint32_t c = first; c < last; ++c ) {
+        mean[c] /= count;
+    }
+
+    float covariance[4][4]{};
+    for ( uint32_t i = 0; i < 16; ++i ) {
+        if ( ((mask >> i) & 1) == 0 ) {
+            continue;
+        }
+
+        for ( uint32_t a = first; a < last; ++a ) {
+            for ( uint32_t b = first; b < last; ++b ) {
+                covariance[a][b] += (block.channels[a][i] - mean[a])
+                    * (block.channels[b][i] - mean[b]);
+            }
+        }
+    }
+
+    // Power iteration converges on the dominant eigenvector quickly enough for a 4x4 matrix
+    float axis[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+    for ( int iteration = 0; iteration < 8; ++iteration ) {
+        float next[4]{};
+        auto length = 0.0f;
+
+        for ( uint32_t a = first; a < last; ++a ) {
+            for ( uint32_t b = first; b < last; ++b ) {
+                next[a] += covariance[a][b] * axis[b];
+            }
+            length = std::max(length, std::abs(next[a]));
+        }
+
+        if ( length < 1e-6f ) {
+            break;
+        }
+
+        for ( uint32_t c = first; c < last; ++c ) {
+            axis[c] = next[c] / length;
+        }
+    }
+
+    auto axis_length = 0.0f;
+    for ( uint32_t c = first; c < last; ++c ) {
+        axis_length += axis[c] * axis[c];
+    }
+
+    auto t_min = 0.0f;
+    auto t_max = 0.0f;
+
+    if ( axis_length > 1e-6f ) {
+        t_min = FLT_MAX;
+        t_max = -FLT_MAX;
+
+        for ( uint32_t i = 0; i < 16; ++i ) {
+            if ( ((mask >> i) & 1) == 0 ) {
+                continue;
+            }
+
+            auto t = 0.0f;
+            for ( uint32_t c = first; c < last; ++c ) {
+                t += (block.channels[c][i] - mean[c]) * axis[c];
+            }
+            t_min = std::min(t_min, t / axis_length);
+            t_max = std::max(t_max, t / axis_length);
+        }
+    }
+
+    for ( uint32_t c = first; c < last; ++c ) {
+        e0[c] = clamp_unorm8(mean[c] + axis[c] * t_max);
+        e1[c] = clamp_unorm8(mean[c] + axis[c] * t_min);
+    }
+}
+
+/// Solves for the pair of endpoints that minimize the squared error of the block given each
+/// pixel's interpolation weight towards `e1`
+static bool refine_endpoints(const BlockPixels& block, const float* weights, const uint32_t first,
+                             const uint32_t last, const uint16_t mask, float* e0, float* e1)
+{
+    auto aa = 0.0f;
+    auto ab = 0.0f;
+    auto bb = 0.0f;
+    float x0[4]{};
+    float x1[4]{};
+
+    for ( uint32_t i = 0; i < 16; ++i ) {
+        if ( ((mask >> i) & 1) == 0 ) {
+            continue;
+        }
+
+        auto b = weights[i];
+        auto a = 1.0f - b;
+        aa += a * a;
+        ab += a * b;
+        bb += b * b;
+
+        for ( uint32_t c = first; c < last; ++c ) {
+            x0[c] += a * block.channels[c][i];
+            x1[c] += b * block.channels[c][i];
+        }
+    }
+
+    auto det = aa * bb - ab * ab;
+    if ( std::abs(det) < 1e-6f ) {
+        return false;
+    }
+
+    for ( uint32_t c = first; c < last; ++c ) {
+        e0[c] = clamp_unorm8((bb * x0[c] - ab * x1[c]) / det);
+        e1[c] = clamp_unorm8((aa * x1[c] - ab * x0[c]) / det);
+    }
+
+    return true;
+}
+
+static void initial_endpoints(const BlockPixels& block, const QualitySettings& settings,
+                              const uint32_t first, const uint32_t last, const uint16_t mask,
+                              float* e0, float* e1)
+{
+    if ( settings.principal_axis ) {
+        principal_endpoints(block, first, last, mask, e0, e1);
+    } else {
+        bounds_endpoints(block, first, last, mask, e0, e1);
+    }
+}
+
+//////////////////////////
+// BC1                  //
+//////////////////////////
+
+static uint16_t pack_565(const float* rgb)
+{
+    auto r = static_cast<uint16_t>(clamp_unorm8(rgb[0]) * 31.0f / 255.0f + 0.5f);
+    auto g = static_cast<uint16_t>(clamp_unorm8(rgb[1]) * 63.0f / 255.0f + 0.5f);
+    auto b = static_cast<uint16_t>(clamp_unorm8(rgb[2]) * 31.0f / 255.0f + 0.5f);
+    return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+static void unpack_565(const uint16_t color, uint32_t* rgb)
+{
+    auto r = (color >> 11) & 31u;
+    auto g = (color >> 5) & 63u;
+    auto b = color & 31u;
+    rgb[0] = (r << 3) | (r >> 2);
+    rgb[1] = (g << 2) | (g >> 4);
+    rgb[2] = (b << 3) | (b >> 2);
+}
+
+/// Builds the four color palette of a BC1 block as RGBA values in the range [0, 255]. Blocks with
+/// color0 <= color1 use three colors plus transparent black
+static void bc1_palette(const uint16_t color0, const uint16_t color1, const bool four_color,
+                        uint32_t (*palette)[4])
+{
+    unpack_565(color0, palette[0]);
+    unpack_565(color1, palette[1]);
+    palette[0][3] = palette[1][3] = palette[2][3] = 255;
+
+    for ( uint32_t c = 0; c < 3; ++c ) {
+        if ( four_color ) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        } else {
+            palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+            palette[3][c] = 0;
+        }
+    }
+
+    palette[3][3] = four_color ? 255u : 0u;
+}
+
+/// Encodes the color part of a BC1/BC3 block. Pixels outside of `opaque` are encoded as
+/// transparent using BC1's three color mode
+static void encode_bc1_color(const BlockPixels& block, const QualitySettings& settings,
+                             const uint16_t opaque, uint8_t* out)
+{
+    static constexpr float four_color_weights[] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+    static constexpr float three_color_weights[] = { 0.0f, 1.0f, 0.5f, 0.0f };
+
+    const auto has_transparent = opaque != all_pixels;
+
+    memset(out, 0, 8);
+
+    if ( opaque == 0 ) {
+        // Equal endpoints select three color mode so index 3 is transparent for every pixel
+        out[4] = out[5] = out[6] = out[7] = 0xFF;
+        return;
+    }
+
+    float e0[4]{};
+    float e1[4]{};
+    initial_endpoints(block, settings, 0, 3, opaque, e0, e1);
+
+    auto best_error = FLT_MAX;
+    uint16_t best_color0 = 0;
+    uint16_t best_color1 = 0;
+    uint8_t best_indices[16]{};
+
+    for ( uint32_t iteration = 0; iteration <= settings.refine_iterations; ++iteration ) {
+        auto color0 = pack_565(e0);
+        auto color1 = pack_565(e1);
+
+        if ( has_transparent ? color0 > color1 : color0 < color1 ) {
+            std::swap(color0, color1);
+        }
+
+        const auto four_color = color0 > color1;
+        uint32_t palette_int[4][4]{};
+        bc1_palette(color0, color1, four_color, palette_int);
+
+        float palette[4][4]{};
+        for ( uint32_t k = 0; k < 4; ++k ) {
+            for ( uint32_t c = 0; c < 4; ++c ) {
+                palette[k][c] = static_cast<float>(palette_int[k][c]);
+            }
+        }
+
+        uint8_t indices[16]{};
+        auto palette_size = color0 == color1 ? 1u : (four_color ? 4u : 3u);
+        auto error = fit_indices(block, palette, palette_size, 0, 3, opaque, indices);
+
+        for ( uint32_t i = 0; i < 16; ++i ) {
+            if ( ((opaque >> i) & 1) == 0 ) {
+                indices[i] = 3;
+            }
+        }
+
+        if ( error < best_error ) {
+            best_error = error;
+            best_color0 = color0;
+            best_color1 = color1;
+            memcpy(best_indices, indices, sizeof(indices));
+        }
+
+        if ( iteration == settings.refine_iterations || error == 0.0f ) {
+            break;
+        }
+
+        float weights[16];
+        for ( uint32_t i = 0; i < 16; ++i ) {
+            weights[i] = four_color ? four_color_weights[indices[i]]
+                                    : three_color_weights[indices[i]];
+        }
+
+        if ( !refine_endpoints(block, weights, 0, 3, opaque, e0, e1) ) {
+            break;
+        }
+    }
+
+    out[0] = static_cast<uint8_t>(best_color0 & 0xFF);
+    out[1] = static_cast<uint8_t>(best_color0 >> 8);
+    out[2] = static_cast<uint8_t>(best_color1 & 0xFF);
+    out[3] = static_cast<uint8_t>(best_color1 >> 8);
+
+    for ( uint32_t i = 0; i < 16; ++i ) {
+        out[4 + i / 4] |= static_cast<uint8_t>(best_indices[i] << ((i % 4) * 2));
+    }
+}
+
+static void decode_bc1_color(const uint8_t* block, const bool force_four_color, uint8_t* rgba,
+                             const uint32_t stride)
+{
+    auto color0 = static_cast<uint16_t>(block[0] | (block[1] << 8));
+    auto color1 = static_cast<uint16_t>(block[2] | (block[3] << 8));
+
+    uint32_t palette[4][4]{};
+    bc1_palette(color0, color1, force_four_color || color0 > color1, palette);
+
+    for ( uint32_t i = 0; i < 16; ++i ) {
+        auto index = (block[4 + i / 4] >> ((i % 4) * 2)) & 3u;
+        auto px = rgba + (i / 4) * stride + (i % 4) * 4;
+        for ( uint32_t c = 0; c < 4; ++c ) {
+            px[c] = static_cast<uint8_t>(palette[index][c]);
+        }
+    }
+}
+
+//////////////////////////
+// BC4                  //
+//////////////////////////
+
+static void bc4_palette(const uint32_t value0, const uint32_t value1, uint32_t* palette)
+{
+    palette[0] = value0;
+    palette[1] = value1;
+
+    if ( value0 > value1 ) {
+        for ( uint32_t i = 2; i < 8; ++i ) {
+            palette[i] = ((8 - i) * value0 + (i - 1) * value1) / 7;
+        }
+        return;
+    }
+
+    for ( uint32_t i = 2; i < 6; ++i ) {
+        palette[i] = ((6 - i) * value0 + (i - 1) * value1) / 5;
+    }
+    palette[6] = 0;
+    palette[7] = 255;
+}
+
+static float try_bc4_endpoints(const BlockPixels& block, const uint32_t channel,
+                               const uint32_t value0, const uint32_t value1, uint8_t* indices)
+{
+    uint32_t palette_int[8];
+    bc4_palette(value0, value1, palette_int);
+
+    float palette[8][4]{};
+    for ( uint32_t k = 0; k < 8; ++k ) {
+        palette[k][channel] = static_cast<float>(palette_int[k]);
+    }
+
+    return fit_indices(block, palette, 8, channel, channel + 1, all_pixels, indices);
+}
+
+/// Encodes a single channel of the block into an 8 byte BC4 block, as used for BC3 alpha, BC4
+/// and both halves of BC5
+static void encode_bc4_channel(const BlockPixels& block, const QualitySettings& settings,
+                               const uint32_t channel, uint8_t* out)
+{
+    uint32_t lo = 255;
+    uint32_t hi = 0;
+    for ( uint32_t i = 0; i < 16; ++i ) {
+        auto value = static_cast<uint32_t>(block.channels[channel][i]);
+        lo = std::min(lo, value);
+        hi = std::max(hi, value);
+    }
+
+    uint32_t best_value0 = hi;
+    uint32_t best_value1 = lo;
+    uint8_t best_indices[16]{};
+
+    if ( hi == lo ) {
+        // Constant blocks are exact using only the first endpoint
+        memset(best_indices, 0, sizeof(best_indices));
+    } else {
+        auto best_error = try_bc4_endpoints(block, channel, hi, lo, best_indices);
+
+        // Pulling the endpoints inwards often reduces the error of the interpolated values
+        auto range = settings.exhaustive_bc4 ? 3u : 0u;
+        for ( uint32_t shrink_hi = 0; shrink_hi <= range; ++shrink_hi ) {
+            for ( uint32_t shrink_lo = 0; shrink_lo <= range; ++shrink_lo ) {
+                if ( shrink_hi + shrink_lo == 0 || hi - shrink_hi <= lo + shrink_lo ) {
+                    continue;
+                }
+
+                uint8_t indices[16];
+                auto error = try_bc4_endpoints(block, channel, hi - shrink_hi, lo + shrink_lo,
+                                               indices);
+                if ( error < best_error ) {
+                    best_error = error;
+                    best_value0 = hi - shrink_hi;
+                    best_value1 = lo + shrink_lo;
+                    memcpy(best_indices, indices, sizeof(indices));
+                }
+            }
+        }
+    }
+
+    memset(out, 0, 8);
+    out[0] = static_cast<uint8_t>(best_value0);
+    out[1] = static_cast<uint8_t>(best_value1);
+
+    BitWriter writer { out, 16 };
+    for ( uint32_t i = 0; i < 16; ++i ) {
+        writer.write(best_indices[i], 3);
+    }
+}
+
+static void decode_bc4_channel(const uint8_t* block, uint8_t* dest, const uint32_t stride,
+                               const uint32_t pixel_size)
+{
+    uint32_t palette[8];
+    bc4_palette(block[0], block[1], palette);
+
+    BitReader reader { block, 16 };
+    for ( uint32_t i = 0; i < 16; ++i ) {
+        auto value = palette[reader.read(3)];
+        dest[(i / 4) * stride + (i % 4) * pixel_size] = static_cast<uint8_t>(value);
+    }
+}
+
+//////////////////////////
+// BC7                  //
+//////////////////////////
+
+static constexpr uint32_t bc7_weights[16] = {
+    0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64
+};
+
+static inline uint32_t bc7_interpolate(const uint32_t e0, const uint32_t e1, const uint32_t index)
+{
+    return ((64 - bc7_weights[index]) * e0 + bc7_weights[index] * e1 + 32) >> 6;
+}
+
+/// Quantizes an RGBA endpoint to mode 6's 7 bits per channel plus a shared p-bit, choosing the
+/// p-bit with the lowest error
+static void quantize_bc7_endpoint(const float* endpoint, uint32_t* quantized, uint32_t& pbit)
+{
+    auto best_error = FLT_MAX;
+
+    for ( uint32_t p = 0; p < 2; ++p ) {
+        uint32_t q[4];
+        auto error = 0.0f;
+
+        for ( uint32_t c = 0; c < 4; ++c ) {
+            auto value = std::round((clamp_unorm8(endpoint[c]) - p) / 2.0f);
+            q[c] = static_cast<uint32_t>(std::min(std::max(value, 0.0f), 127.0f));
+            auto diff = static_cast<float>((q[c] << 1) | p) - endpoint[c];
+            error += diff * diff;
+        }
+
+        if ( error < best_error ) {
+            best_error = error;
+            pbit = p;
+            memcpy(quantized, q, sizeof(q));
+        }
+    }
+}
+
+static void encode_bc7_mode6(const BlockPixels& block, const QualitySettings& settings,
+                             uint8_t* out)
+{
+    float e0[4]{};
+    float e1[4]{};
+    initial_endpoints(block, settings, 0, 4, all_pixels, e0, e1);
+
+    auto best_error = FLT_MAX;
+    uint32_t best_q[2][4]{};
+    uint32_t best_p[2]{};
+    uint8_t best_indices[16]{};
+
+    for ( uint32_t iteration = 0; iteration <= settings.refine_iterations; ++iteration ) {
+        uint32_t q[2][4];
+        uint32_t p[2];
+        quantize_bc7_endpoint(e0, q[0], p[0]);
+        quantize_bc7_endpoint(e1, q[1], p[1]);
+
+        float palette[16][4];
+        for ( uint32_t k = 0; k < 16; ++k ) {
+            for ( uint32_t c = 0; c < 4; ++c ) {
+                auto v0 = (q[0][c] << 1) | p[0];
+                auto v1 = (q[1][c] << 1) | p[1];
+                palette[k][c] = static_cast<float>(bc7_interpolate(v0, v1, k));
+            }
+        }
+
+        uint8_t indices[16];
+        auto error = fit_indices(block, palette, 16, 0, 4, all_pixels, indices);
+
+        if ( error < best_error ) {
+            best_error = error;
+            memcpy(best_q, q, sizeof(q));
+            memcpy(best_p, p, sizeof(p));
+            memcpy(best_indices, indices, sizeof(indices));
+        }
+
+        if ( iteration == settings.refine_iterations || error == 0.0f ) {
+            break;
+        }
+
+        float weights[16];
+        for ( uint32_t i = 0; i < 16; ++i ) {
+            weights[i] = bc7_weights[indices[i]] / 64.0f;
+        }
+
+        if ( !refine_endpoints(block, weights, 0, 4, all_pixels, e0, e1) ) {
+            break;
+        }
+    }
+
+    // The anchor (first) index is stored without its high bit so it must be less than 8 -
+    // swapping the endpoints and inverting the indices represents the same colors
+    if ( best_indices[0] >= 8 ) {
+        for ( uint32_t c = 0; c < 4; ++c ) {
+            std::swap(best_q[0][c], best_q[1][c]);
+        }
+        std::swap(best_p[0], best_p[1]);
+
+        for ( auto& index : best_indices ) {
+            index = static_cast<uint8_t>(15 - index);
+        }
+    }
+
+    memset(out, 0, 16);
+    BitWriter writer { out, 0 };
+    writer.write(1u << 6, 7);
+
+    for ( uint32_t c = 0; c < 4; ++c ) {
+        writer.write(best_q[0][c], 7);
+        writer.write(best_q[1][c], 7);
+    }
+
+    writer.write(best_p[0], 1);
+    writer.write(best_p[1], 1);
+    writer.write(best_indices[0], 3);
+
+    for ( uint32_t i = 1; i < 16; ++i ) {
+        writer.write(best_indices[i], 4);
+    }
+}
+
+static bool decode_bc7_mode6(const uint8_t* block, uint8_t* rgba, const uint32_t stride)
+{
+    BitReader reader { block, 0 };
+    if ( reader.read(7) != (1u << 6) ) {
+        return false;
+    }
+
+    uint32_t endpoints[2][4];
+    for ( uint32_t c = 0; c < 4; ++c ) {
+        endpoints[0][c] = reader.read(7) << 1;
+        endpoints[1][c] = reader.read(7) << 1;
+    }
+
+    auto p0 = reader.read(1);
+    auto p1 = reader.read(1);
+    for ( uint32_t c = 0; c < 4; ++c ) {
+        endpoints[0][c] |= p0;
+        endpoints[1][c] |= p1;
+    }
+
+    for ( uint32_t i = 0; i < 16; ++i ) {
+        auto index = reader.read(i == 0 ? 3 : 4);
+        auto px = rgba + (i / 4) * stride + (i % 4) * 4;
+        for ( uint32_t c = 0; c < 4; ++c ) {
+            auto value = bc7_interpolate(endpoints[0][c], endpoints[1][c], index);
+            px[c] = static_cast<uint8_t>(value);
+        }
+    }
+
+    return true;
+}
+
+//////////////////////////
+// Image level          //
+//////////////////////////
+
+struct CompressionJob {
+    const uint8_t* src;
+    uint32_t width;
+    uint32_t height;
+    uint32_t src_channels;
+    PixelFormat::Enum format;
+    QualitySettings settings;
+    uint8_t* dest;
+    uint32_t blocks_wide;
+    uint32_t block_size;
+};
+
+static void compress_block_rows(const uint32_t begin, const uint32_t end, void* user_data)
+{
+    auto job = static_cast<const CompressionJob*>(user_data);
+    BlockPixels block{};
+
+    for ( uint32_t by = begin; by < end; ++by ) {
+        for ( uint32_t bx = 0; bx < job->blocks_wide; ++bx ) {
+            auto index = static_cast<size_t>(by) * job->blocks_wide + bx;
+            auto out = job->dest + index * job->block_size;
+            load_block(job->src, job->width, job->height, job->src_channels, bx, by, block);
+
+            switch (job->format) {
+                case PixelFormat::Enum::bc1:
+                {
+                    uint16_t opaque = 0;
+                    for ( uint32_t i = 0; i < 16; ++i ) {
+                        opaque |= (block.channels[3][i] >= 128.0f ? 1u : 0u) << i;
+                    }
+                    encode_bc1_color(block, job->settings, opaque, out);
+                } break;
+
+                case PixelFormat::Enum::bc3:
+                {
+                    encode_bc4_channel(block, job->settings, 3, out);
+                    encode_bc1_color(block, job->settings, all_pixels, out + 8);
+                } break;
+
+                case PixelFormat::Enum::bc4:
+                {
+                    encode_bc4_channel(block, job->settings, 0, out);
+                } break;
+
+                case PixelFormat::Enum::bc5:
+                {
+                    encode_bc4_channel(block, job->settings, 0, out);
+                    encode_bc4_channel(block, job->settings, 1, out + 8);
+                } break;
+
+                case PixelFormat::Enum::bc7:
+                {
+                    encode_bc7_mode6(block, job->settings, out);
+                } break;
+
+                default: break;
+            }
+        }
+    }
+}
+
+static uint32_t get_source_channels(const PixelFormat::Enum format)
+{
+    switch (format) {
+        case PixelFormat::Enum::r8:
+            return 1;
+        case PixelFormat::Enum::rg8:
+            return 2;
+        case PixelFormat::Enum::rgb8:
+            return 3;
+        case PixelFormat::Enum::rgba8:
+            return 4;
+        default:
+            return 0;
+    }
+}
+
+bool compress_image(const uint8_t* src, const uint32_t width, const uint32_t height,
+                    const PixelFormat::Enum src_format, const PixelFormat::Enum dest_format,
+                    const CompressionQuality quality, uint8_t* dest)
+{
+    auto src_channels = get_source_channels(src_format);
+    if ( src_channels == 0 ) {
+        SKY_ERROR("TextureCompression", "Only r8, rg8, rgb8 and rgba8 images can be compressed");
+        return false;
+    }
+
+    if ( !PixelFormat::is_compressed(dest_format) ) {
+        SKY_ERROR("TextureCompression", "Destination format must be block compressed");
+        return false;
+    }
+
+    if ( width == 0 || height == 0 ) {
+        return true;
+    }
+
+    CompressionJob job{};
+    job.src = src;
+    job.width = width;
+    job.height = height;
+    job.src_channels = src_channels;
+    job.format = dest_format;
+    job.settings = get_quality_settings(quality);
+    job.dest = dest;
+    job.blocks_wide = (width + 3) / 4;
+    job.block_size = PixelFormat::block_size(dest_format);
+
+    auto blocks_high = (height + 3) / 4;
+    auto rows_per_batch = std::max(1u, blocks_per_batch / job.blocks_wide);
+    jobs::parallel_for(blocks_high, rows_per_batch, compress_block_rows, &job);
+    return true;
+}
+
+bool decompress_image(const uint8_t* src, const uint32_t width, const uint32_t height,
+                      const PixelFormat::Enum src_format, uint8_t* dest)
+{
+    auto block_size = PixelFormat::block_size(src_format);
+    if ( block_size == 0 ) {
+        SKY_ERROR("TextureCompression", "Source format must be block compressed");
+        return false;
+    }
+
+    const auto blocks_wide = (width + 3) / 4;
+    const auto blocks_high = (height + 3) / 4;
+    const auto stride = 16u;
+
+    uint8_t decoded[16 * 4];
+
+    for ( uint32_t by = 0; by < blocks_high; ++by ) {
+        for ( uint32_t bx = 0; bx < blocks_wide; ++bx ) {
+            auto block = src + (static_cast<size_t>(by) * blocks_wide + bx) * block_size;
+
+            // Channels not stored by the format decode the same way GL and Metal sample them
+            for ( uint32_t i = 0; i < 16; ++i ) {
+                decoded[i * 4] = decoded[i * 4 + 1] = decoded[i * 4 + 2] = 0;
+                decoded[i * 4 + 3] = 255;
+            }
+
+            switch (src_format) {
+                case PixelFormat::Enum::bc1:
+                    decode_bc1_color(block, false, decoded, stride);
+                    break;
+                case PixelFormat::Enum::bc3:
+                    decode_bc1_color(block + 8, true, decoded, stride);
+                    decode_bc4_channel(block, decoded + 3, stride, 4);
+                    break;
+                case PixelFormat::Enum::bc4:
+                    decode_bc4_channel(block, decoded, stride, 4);
+                    break;
+                case PixelFormat::Enum::bc5:
+                    decode_bc4_channel(block, decoded, stride, 4);
+                    decode_bc4_channel(block + 8, decoded + 1, stride, 4);
+                    break;
+                case PixelFormat::Enum::bc7:
+                    if ( !decode_bc7_mode6(block, decoded, stride) ) {
+                        SKY_ERROR("TextureCompression", "Only mode 6 BC7 blocks can be decoded");
+                        return false;
+                    }
+                    break;
+                default:
+                    return false;
+            }
+
+            for ( uint32_t y = 0; y < 4 && by * 4 + y < height; ++y ) {
+                auto row = dest + ((static_cast<size_t>(by) * 4 + y) * width + bx * 4) * 4;
+                auto count = std::min(4u, width - bx * 4);
+                memcpy(row, decoded + y * stride, count * 4);
+            }
+        }
+    }
+
+    return true;
+}
+
+
+} // namespace sky
@@ -0,0 +1,47 @@
+//
+//  TextureCompression.hpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#pragma once
+
+#include "Skyrocket/Graphics/Renderer/Definitions.hpp"
+
+#include <cstdint>
+
+namespace sky {
+
+
+/// @brief Trades encoding time for quality. `fast` is suitable for compressing at load time,
+/// `high` for offline asset builds
+enum class CompressionQuality {
+    fast,
+    normal,
+    high
+};
+
+/// @brief Compresses an image into one of the block compressed pixel formats. Blocks are encoded
+/// in parallel on the job workers if running.
+///
+/// `src_format` must be one of r8, rg8, rgb8 or rgba8. bc4 encodes the red channel and bc5 the red
+/// and green channels, bc1 encodes pixels with alpha below 128 as transparent and bc7 is encoded
+/// using the single-subset RGBA mode (mode 6) only. `dest` must be at least
+/// `PixelFormat::image_size(dest_format, width, height)` bytes
+bool compress_image(const uint8_t* src, uint32_t width, uint32_t height,
+                    PixelFormat::Enum src_format, PixelFormat::Enum dest_format,
+                    CompressionQuality quality, uint8_t* dest);
+
+/// @brief Decompresses block compressed data into rgba8 pixels, i.e. for renderers without
+/// hardware support for the format or for inspecting encoder output. bc7 blocks are only decoded
+/// if they use mode 6 as produced by `compress_image`
+bool decompress_image(const uint8_t* src, uint32_t width, uint32_t height,
+                      PixelFormat::Enum src_format, uint8_t* dest);
+
+
+} // namespace sky
@@ -13,8 +13,9 @@
 #include "Skyrocket/Core/Diagnostics/Error.hpp"
 
 #include <cstdio>
-#include <fstream>
-#include <sstream>
+#include <cstring>
+#include <utility>
+#include <sys/stat.h>
 
 namespace sky {
 
@@ -195,23 +196,105 @@ void Path::make_null_terminated()
 }
 
 
+MappedFile::MappedFile(const Path& path, const MapAccess access)
+{
+    open(path, access);
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(other.data_),
+      size_(other.size_)
+{
+    other.data_ = nullptr;
+    other.size_ = 0;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+    return *this;
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+
 namespace fs {
 
 
-std::string slurp_file(const Path& path)
+size_t file_size(const Path& filepath)
 {
-    std::ifstream file(path.str());
+    struct stat st{};
+    if ( stat(filepath.str(), &st) != 0 ) {
+        return 0;
+    }
+
+    return static_cast<size_t>(st.st_size);
+}
+
+size_t read_file(const Path& filepath, void* dest, const size_t size, const size_t offset)
+{
+    auto file = fopen(filepath.str(), "rb");
+
+    if ( file == nullptr ) {
+        SKY_ERROR("Reading file", "No such file found with the specified name %s", filepath.str());
+        return 0;
+    }
 
-    if ( !file ) {
+    // Data is read straight into `dest` so stdio's internal buffer would only add another copy
+    setvbuf(file, nullptr, _IONBF, 0);
+
+    if ( offset > 0 && fseek(file, static_cast<long>(offset), SEEK_SET) != 0 ) {
+        SKY_ERROR("Reading file", "Unable to seek to offset %zu in %s", offset, filepath.str());
+        fclose(file);
+        return 0;
+    }
+
+    auto bytes_read = fread(dest, 1, size, file);
+    fclose(file);
+
+    return bytes_read;
+}
+
+std::string slurp_file(const Path& path)
+{
+    if ( !path.exists() ) {
         SKY_ERROR("Slurping file", "No such file found with the specified name %s", path.str());
         return "";
     }
 
-    std::stringstream ss;
-    ss << file.rdbuf();
-    file.close();
+    std::string contents(file_size(path), '\0');
+    if ( contents.empty() ) {
+        return contents;
+    }
+
+    auto bytes_read = read_file(path, &contents[0], contents.size());
+    contents.resize(bytes_read);
+
+    return contents;
+}
+
+bool write_file(const Path& filepath, const void* data, const size_t size)
+{
+    auto file = fopen(filepath.str(), "wb");
+
+    if ( file == nullptr ) {
+        SKY_ERROR("Writing file", "Unable to open %s for writing", filepath.str());
+        return false;
+    }
+
+    auto bytes_written = fwrite(data, 1, size, file);
+    auto closed = fclose(file) == 0;
 
-    return ss.str();
+    if ( bytes_written != size || !closed ) {
+        SKY_ERROR("Writing file", "Unable to write %zu bytes to %s", size, filepath.str());
+        return false;
+    }
+
+    return true;
 }
 
 
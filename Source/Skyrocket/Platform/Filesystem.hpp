@@ -11,7 +11,9 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <string>
 #include <vector>
 
 namespace sky {
@@ -100,11 +102,94 @@ private:
     int32_t last_char_pos(const char c) const;
 };
 
+/// @brief Access pattern hints for memory-mapped files. These are passed on to the OS so it can
+/// tune read-ahead and page eviction for the way the mapping is going to be read.
+enum class MapAccess {
+    /// No special treatment
+    normal,
+    /// Pages will be read from start to end, i.e. when decoding or parsing a whole file
+    sequential,
+    /// Pages will be read in no particular order, i.e. lookups into an archive or font face
+    random,
+    /// The whole range will be needed soon and should be paged in ahead of time
+    will_need
+};
+
+/// @brief A read-only view of a file mapped into the address space of the process. Parsers and
+/// decoders can read straight from the page cache via `data()` without first copying the file
+/// into heap memory. The mapping stays valid until the object is closed or destroyed.
+class MappedFile {
+public:
+    MappedFile() = default;
+
+    explicit MappedFile(const Path& path, MapAccess access = MapAccess::sequential);
+
+    MappedFile(const MappedFile& other) = delete;
+    MappedFile& operator=(const MappedFile& other) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    ~MappedFile();
+
+    /// @brief Maps the entire file at `path` into memory, closing any previously mapped file
+    /// @return True if the file was mapped successfully
+    bool open(const Path& path, MapAccess access = MapAccess::sequential);
+
+    /// @brief Unmaps the file. All pointers into the mapping are invalid afterwards
+    void close();
+
+    /// @brief Gives the OS a hint about how a range of the mapping will be accessed. A `size` of
+    /// zero applies the hint from `offset` to the end of the file
+    void advise(MapAccess access, size_t offset = 0, size_t size = 0) const;
+
+    inline bool is_open() const
+    {
+        return data_ != nullptr;
+    }
+
+    inline const uint8_t* data() const
+    {
+        return data_;
+    }
+
+    inline size_t size() const
+    {
+        return size_;
+    }
+
+    inline const uint8_t* begin() const
+    {
+        return data_;
+    }
+
+    inline const uint8_t* end() const
+    {
+        return data_ + size_;
+    }
+private:
+    const uint8_t* data_{nullptr};
+    size_t size_{0};
+};
+
 namespace fs {
 
 
+/// @brief Gets the size in bytes of the file at `filepath` or zero if the file doesn't exist
+size_t file_size(const Path& filepath);
+
+/// @brief Reads `size` bytes starting at `offset` from the file at `filepath` directly into
+/// `dest` without any intermediate buffering. `dest` must be at least `size` bytes large.
+/// @return The number of bytes actually read
+size_t read_file(const Path& filepath, void* dest, size_t size, size_t offset = 0);
+
+/// @brief Reads the entire contents of a file into a string
 std::string slurp_file(const Path& filepath);
 
+/// @brief Creates or overwrites the file at `filepath` with `size` bytes from `data`
+/// @return false if the file couldn't be opened or fully written
+bool write_file(const Path& filepath, const void* data, size_t size);
+
 
 } // namespace fs
 
@@ -0,0 +1,290 @@
+//
+//  IOService.cpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#include "Skyrocket/Platform/IOService.hpp"
+#include "Skyrocket/Core/Diagnostics/Error.hpp"
+#include "Skyrocket/Core/Memory/Allocator.hpp"
+
+#include <cstring>
+
+namespace sky {
+
+
+constexpr uint32_t IOService::invalid_id;
+constexpr uint32_t IOService::max_requests;
+
+IOService::~IOService()
+{
+    shutdown();
+}
+
+void IOService::startup(const uint32_t num_threads)
+{
+    if ( running_ ) {
+        SKY_ERROR("IOService", "Service has already been started");
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        free_list_.clear();
+        free_list_.reserve(max_requests);
+        for ( uint32_t i = max_requests; i > 0; --i ) {
+            free_list_.push_back(i - 1);
+        }
+        running_ = true;
+    }
+
+    auto count = num_threads > 0 ? num_threads : 1;
+    for ( uint32_t t = 0; t < count; ++t ) {
+        threads_.emplace_back(&IOService::io_thread_proc, this);
+    }
+}
+
+void IOService::shutdown()
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if ( !running_ ) {
+            return;
+        }
+        running_ = false;
+    }
+
+    pending_cv_.notify_all();
+
+    for ( auto& thread : threads_ ) {
+        if ( thread.joinable() ) {
+            thread.join();
+        }
+    }
+
+    threads_.clear();
+}
+
+uint32_t IOService::read(const Path& path, void* dest, const size_t size, const size_t offset,
+                         io_callback_t callback, void* user_data)
+{
+    if ( dest == nullptr ) {
+        SKY_ERROR("IOService", "Cannot read %s into a null destination", path.str());
+        return invalid_id;
+    }
+
+    return submit(path, dest, size, offset, callback, user_data);
+}
+
+uint32_t IOService::read(const Path& path, Allocator* allocator, const size_t alignment,
+                         io_callback_t callback, void* user_data)
+{
+    auto size = fs::file_size(path);
+    if ( size == 0 ) {
+        SKY_ERROR("IOService", "No such file found with the specified name %s", path.str());
+        return invalid_id;
+    }
+
+    auto dest = allocator->allocate(size, alignment);
+    if ( dest == nullptr ) {
+        SKY_ERROR("IOService", "Unable to allocate %zu bytes to read %s into", size, path.str());
+        return invalid_id;
+    }
+
+    auto id = submit(path, dest, size, 0, callback, user_data);
+    if ( id == invalid_id ) {
+        allocator->free(dest);
+    }
+
+    return id;
+}
+
+uint32_t IOService::submit(const Path& path, void* dest, const size_t size, const size_t offset,
+                           io_callback_t callback, void* user_data)
+{
+    uint32_t index = 0;
+    uint32_t id = invalid_id;
+
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        if ( !running_ ) {
+            SKY_ERROR("IOService", "Reads cannot be submitted before calling `startup`");
+            return invalid_id;
+        }
+
+        if ( free_list_.empty() ) {
+            SKY_ERROR("IOService", "Submitting new read while capacity (%u) is reached",
+                      max_requests);
+            return invalid_id;
+        }
+
+        index = free_list_.back();
+        free_list_.pop_back();
+
+        auto& req = requests_[index];
+        id = make_id(index, ++req.generation);
+
+        strncpy(req.path, path.str(), SKY_MAX_PATH - 1);
+        req.size = size;
+        req.offset = offset;
+        req.callback = callback;
+        req.result = IOResult{};
+        req.result.id = id;
+        req.result.status = IOStatus::pending;
+        req.result.data = dest;
+        req.result.user_data = user_data;
+        req.status.store(IOStatus::pending, std::memory_order_release);
+
+        pending_.push(index);
+    }
+
+    pending_cv_.notify_one();
+    return id;
+}
+
+void IOService::release(const uint32_t index)
+{
+    requests_[index].result.id = invalid_id;
+    requests_[index].status.store(IOStatus::none, std::memory_order_release);
+    free_list_.push_back(index);
+}
+
+IOService::Request* IOService::get_request(const uint32_t id)
+{
+    auto index = get_index(id);
+    if ( id == invalid_id || index >= max_requests ) {
+        return nullptr;
+    }
+
+    auto& req = requests_[index];
+    return req.result.id == id ? &req : nullptr;
+}
+
+const IOService::Request* IOService::get_request(const uint32_t id) const
+{
+    return const_cast<IOService*>(this)->get_request(id);
+}
+
+IOStatus IOService::status(const uint32_t id) const
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto req = get_request(id);
+    return req == nullptr ? IOStatus::none : req->status.load(std::memory_order_acquire);
+}
+
+IOStatus IOService::wait(const uint32_t id, IOResult* result)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    auto req = get_request(id);
+    if ( req == nullptr ) {
+        return IOStatus::none;
+    }
+
+    complete_cv_.wait(lock, [&]() {
+        auto status = req->status.load(std::memory_order_acquire);
+        return req->result.id != id || (status != IOStatus::pending);
+    });
+
+    // Callback requests release themselves once complete so their result is only available to
+    // the callback. The slot may even have been reused by another read already
+    auto status = req->result.id == id ? req->status.load(std::memory_order_acquire)
+                                       : IOStatus::released;
+    if ( status == IOStatus::released ) {
+        if ( result != nullptr ) {
+            *result = IOResult{};
+            result->id = id;
+            result->status = status;
+        }
+        return status;
+    }
+
+    if ( result != nullptr ) {
+        *result = req->result;
+    }
+
+    release(get_index(id));
+    return status;
+}
+
+bool IOService::poll(const uint32_t id, IOResult* result)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    auto req = get_request(id);
+    if ( req == nullptr ) {
+        return false;
+    }
+
+    auto status = req->status.load(std::memory_order_acquire);
+    if ( status == IOStatus::released ) {
+        if ( result != nullptr ) {
+            *result = IOResult{};
+            result->id = id;
+            result->status = status;
+        }
+        return true;
+    }
+
+    if ( status != IOStatus::complete && status != IOStatus::failed ) {
+        return false;
+    }
+
+    if ( result != nullptr ) {
+        *result = req->result;
+    }
+
+    release(get_index(id));
+    return true;
+}
+
+void IOService::io_thread_proc()
+{
+    uint32_t index = 0;
+
+    while ( true ) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            pending_cv_.wait(lock, [&]() {
+                return !running_ || !pending_.empty();
+            });
+
+            // Pending reads are always drained before shutting down so nothing is left waiting
+            if ( pending_.empty() ) {
+                return;
+            }
+
+            index = pending_.front();
+            pending_.pop();
+        }
+
+        auto& req = requests_[index];
+        auto& result = req.result;
+        result.bytes_read = fs::read_file(Path(req.path), result.data, req.size, req.offset);
+        result.status = result.bytes_read == req.size ? IOStatus::complete : IOStatus::failed;
+
+        if ( req.callback != nullptr ) {
+            req.callback(result);
+
+            // The slot keeps its id until it's reused so `wait` and `poll` can still tell the
+            // request was released rather than never submitted
+            std::unique_lock<std::mutex> lock(mutex_);
+            req.status.store(IOStatus::released, std::memory_order_release);
+            free_list_.push_back(index);
+        } else {
+            std::unique_lock<std::mutex> lock(mutex_);
+            req.status.store(result.status, std::memory_order_release);
+        }
+
+        complete_cv_.notify_all();
+    }
+}
+
+
+} // namespace sky
@@ -0,0 +1,152 @@
+//
+//  IOService.hpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#pragma once
+
+#include "Skyrocket/Platform/Filesystem.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+namespace sky {
+
+class Allocator;
+
+enum class IOStatus : uint8_t {
+    none,
+    pending,
+    complete,
+    failed,
+    /// The request was submitted with a callback and released before its result could be read -
+    /// whether it succeeded is only known to the callback
+    released
+};
+
+/// @brief The result of an asynchronous read, passed to completion callbacks and returned from
+/// `IOService::wait`
+struct IOResult {
+    uint32_t id{0};
+    IOStatus status{IOStatus::none};
+    void* data{nullptr};
+    size_t bytes_read{0};
+    void* user_data{nullptr};
+};
+
+/// @brief Callback invoked on an I/O thread once a read has finished, successfully or not
+using io_callback_t = void (*)(const IOResult& result);
+
+/// @brief IOService reads files asynchronously on a small pool of dedicated I/O threads so that
+/// asset loads can overlap with simulation and render work. Reads go directly into memory
+/// supplied by the caller - either a raw destination pointer or an allocator - and never pass
+/// through an intermediate buffer.
+///
+/// Each read returns a uint32_t id that can be polled or waited on. Reads submitted with a
+/// callback are released automatically once the callback returns, after which their id is no
+/// longer valid, otherwise the id must be released by a successful `wait` or `poll`.
+class IOService {
+public:
+    static constexpr uint32_t invalid_id = 0;
+    static constexpr uint32_t max_requests = 256;
+    static constexpr uint32_t default_thread_count = 2;
+
+    IOService() = default;
+
+    IOService(const IOService& other) = delete;
+    IOService& operator=(const IOService& other) = delete;
+
+    ~IOService();
+
+    /// @brief Starts the I/O threads. Must be called before any reads are submitted
+    void startup(uint32_t num_threads = default_thread_count);
+
+    /// @brief Finishes all pending reads and joins the I/O threads
+    void shutdown();
+
+    /// @brief Reads `size` bytes from `path`, starting at `offset`, into `dest`
+    /// @return Id of the request or `invalid_id` if no request slots are available
+    uint32_t read(const Path& path, void* dest, size_t size, size_t offset = 0,
+                  io_callback_t callback = nullptr, void* user_data = nullptr);
+
+    /// @brief Reads the entire file at `path` into memory allocated from `allocator`. The
+    /// allocation happens on the calling thread so `allocator` needn't be thread-safe
+    /// @return Id of the request or `invalid_id` if the file doesn't exist or no request slots
+    /// are available, in which case the memory is returned to `allocator`
+    uint32_t read(const Path& path, Allocator* allocator, size_t alignment = 16,
+                  io_callback_t callback = nullptr, void* user_data = nullptr);
+
+    /// @brief Gets the current status of a request
+    IOStatus status(uint32_t id) const;
+
+    /// @brief Blocks the calling thread until the request has finished, copies its result into
+    /// `result` if not null and releases the request. Requests submitted with a callback
+    /// release themselves once the callback returns, in which case `IOStatus::released` is
+    /// returned and `result` only has its id and status set
+    IOStatus wait(uint32_t id, IOResult* result = nullptr);
+
+    /// @brief Checks if the request has finished without blocking. If it has, its result is
+    /// copied into `result` and the request is released. Callback requests that have released
+    /// themselves count as finished with a status of `IOStatus::released`
+    bool poll(uint32_t id, IOResult* result);
+
+    inline bool is_running() const
+    {
+        return running_;
+    }
+private:
+    struct Request {
+        std::atomic<IOStatus> status{IOStatus::none};
+        uint32_t generation{0};
+        char path[SKY_MAX_PATH]{};
+        size_t size{0};
+        size_t offset{0};
+        io_callback_t callback{nullptr};
+        IOResult result;
+    };
+
+    Request requests_[max_requests];
+    std::vector<uint32_t> free_list_;
+    std::queue<uint32_t> pending_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable pending_cv_;
+    std::condition_variable complete_cv_;
+
+    std::vector<std::thread> threads_;
+    bool running_{false};
+
+    uint32_t submit(const Path& path, void* dest, size_t size, size_t offset,
+                    io_callback_t callback, void* user_data);
+    void release(uint32_t index);
+    Request* get_request(uint32_t id);
+    const Request* get_request(uint32_t id) const;
+    void io_thread_proc();
+
+    static constexpr uint32_t index_bits_ = 9;
+    static constexpr uint32_t index_mask_ = (1u << index_bits_) - 1;
+
+    static_assert(max_requests < index_mask_, "IOService request ids reserve 9 bits for the index");
+
+    static inline uint32_t make_id(const uint32_t index, const uint32_t generation)
+    {
+        return (generation << index_bits_) | (index + 1);
+    }
+
+    static inline uint32_t get_index(const uint32_t id)
+    {
+        return (id & index_mask_) - 1;
+    }
+};
+
+
+} // namespace sky
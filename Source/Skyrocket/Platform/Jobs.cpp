@@ -0,0 +1,143 @@
+//
+//  Jobs.cpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#include "Skyrocket/Platform/Jobs.hpp"
+
+#include <Jobrocket/Jobrocket.hpp>
+
+#include <atomic>
+
+namespace sky {
+namespace jobs {
+
+
+static std::atomic<bool> running_{false};
+
+static constexpr uint32_t max_batches = 64;
+
+struct Batch {
+    parallel_for_t fn;
+    uint32_t begin;
+    uint32_t end;
+    void* user_data;
+};
+
+static void run_batch(Batch* batch)
+{
+    batch->fn(batch->begin, batch->end, batch->user_data);
+}
+
+void startup(const uint32_t num_main_threads)
+{
+    if ( running_ ) {
+        return;
+    }
+
+    jobrocket::startup(jobrocket::Scheduler::auto_thread_count, num_main_threads);
+    running_ = true;
+}
+
+void shutdown()
+{
+    if ( !running_ ) {
+        return;
+    }
+
+    running_ = false;
+    jobrocket::shutdown();
+}
+
+bool is_running()
+{
+    return running_;
+}
+
+uint32_t num_workers()
+{
+    return running_ ? static_cast<uint32_t>(jobrocket::current_scheduler()->num_workers()) : 0;
+}
+
+uint32_t num_main_threads()
+{
+    return running_ ? static_cast<uint32_t>(jobrocket::current_scheduler()->num_main_threads()) : 0;
+}
+
+void parallel_for(const uint32_t count, const uint32_t batch_size, parallel_for_t fn,
+                  void* user_data)
+{
+    if ( count == 0 ) {
+        return;
+    }
+
+    auto size = batch_size > 0 ? batch_size : 1;
+    auto num_batches = (count + size - 1) / size;
+
+    if ( !running_ || num_batches <= 1 ) {
+        fn(0, count, user_data);
+        return;
+    }
+
+    // Batches live on the stack so very large ranges are split into fewer, larger batches
+    if ( num_batches > max_batches ) {
+        size = (count + max_batches - 1) / max_batches;
+        num_batches = (count + size - 1) / size;
+    }
+
+    Batch batches[max_batches];
+    jobrocket::JobGroup group;
+
+    for ( uint32_t b = 0; b < num_batches; ++b ) {
+        auto begin = b * size;
+        batches[b] = Batch { fn, begin, begin + size < count ? begin + size : count, user_data };
+        group.run(jobrocket::make_job(run_batch, &batches[b]));
+    }
+
+    group.wait();
+}
+
+//==========================================
+//  JobGroup
+//==========================================
+
+struct JobGroup::Impl {
+    jobrocket::JobGroup group;
+};
+
+JobGroup::~JobGroup()
+{
+    wait();
+    delete impl_;
+}
+
+void JobGroup::run(job_t fn, void* user_data)
+{
+    if ( !running_ ) {
+        fn(user_data);
+        return;
+    }
+
+    if ( impl_ == nullptr ) {
+        impl_ = new Impl;
+    }
+
+    impl_->group.run(jobrocket::make_job(fn, user_data));
+}
+
+void JobGroup::wait()
+{
+    if ( impl_ != nullptr ) {
+        impl_->group.wait();
+    }
+}
+
+
+} // namespace jobs
+} // namespace sky
@@ -0,0 +1,77 @@
+//
+//  Jobs.hpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#pragma once
+
+#include <cstdint>
+
+namespace sky {
+
+/// @brief Function run over the range [begin, end) of a `parallel_for`
+using parallel_for_t = void (*)(uint32_t begin, uint32_t end, void* user_data);
+
+/// @brief Function run asynchronously by a `jobs::JobGroup`
+using job_t = void (*)(void* user_data);
+
+/// @brief Thin wrapper over the Jobrocket scheduler so the rest of the engine doesn't depend on
+/// it directly. Everything here falls back to running serially on the calling thread if the
+/// scheduler hasn't been started, i.e. in tests or single-threaded applications
+namespace jobs {
+
+
+/// @brief Starts the job scheduler with a worker thread per available core
+/// @param num_main_threads The number of threads other than the calling thread that will
+/// submit and wait on jobs
+void startup(uint32_t num_main_threads);
+
+/// @brief Stops all worker threads
+void shutdown();
+
+bool is_running();
+
+uint32_t num_workers();
+
+uint32_t num_main_threads();
+
+/// @brief Splits [0, count) into batches of at least `batch_size` and runs `fn` over each batch,
+/// on the job workers if running. Returns once all batches are complete
+void parallel_for(uint32_t count, uint32_t batch_size, parallel_for_t fn, void* user_data);
+
+/// @brief A set of jobs that run in the background without blocking the thread that submitted
+/// them, i.e. for streaming in assets. The group waits for all of its jobs when destroyed
+class JobGroup {
+public:
+    JobGroup() = default;
+
+    JobGroup(const JobGroup& other) = delete;
+    JobGroup& operator=(const JobGroup& other) = delete;
+
+    ~JobGroup();
+
+    /// @brief Runs `fn` on a job worker and returns straight away, or runs it to completion on
+    /// the calling thread if the scheduler isn't running. `user_data` must stay valid until the
+    /// job has finished
+    void run(job_t fn, void* user_data);
+
+    /// @brief Blocks until every job run so far has finished
+    void wait();
+
+private:
+    struct Impl;
+
+    Impl* impl_{nullptr};
+};
+
+
+} // namespace jobs
+
+
+} // namespace sky
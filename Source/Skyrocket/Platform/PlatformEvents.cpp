@@ -19,8 +19,8 @@ uint16_t PlatformEvents::vk_translation_table[static_cast<uint16_t>(Key::last)];
 
 void PlatformEvents::reset_keyboard_state()
 {
-    std::swap(keyboard.last_frame_mask_.bits, keyboard.this_frame_mask_.bits);
-    keyboard.last_frame_mask_.clear_all();
+    // Keys stay in this frame's mask until they're released, so it carries over as is
+    keyboard.last_frame_mask_ = keyboard.this_frame_mask_;
 }
 
 void PlatformEvents::key_down(const uint16_t keycode)
@@ -12,9 +12,14 @@
 #include "Skyrocket/Core/Diagnostics/Error.hpp"
 #include "Skyrocket/Platform/Filesystem.hpp"
 
+#include <algorithm>
 #include <cerrno>
+#include <cstring>
+#include <fcntl.h>
 #include <mach-o/dyld.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
+#include <unistd.h>
 
 namespace sky {
 
@@ -50,6 +55,7 @@ void Path::make_real()
     }
 
     strcpy(path_, ptr);
+    back_ = strlen(path_);
 
     free(ptr);
 }
@@ -61,4 +67,75 @@ bool Path::exists() const
 }
 
 
-}  // namespace sky
\ No newline at end of file
+static int get_madvise_flag(const MapAccess access)
+{
+    switch (access) {
+        case MapAccess::sequential: return MADV_SEQUENTIAL;
+        case MapAccess::random: return MADV_RANDOM;
+        case MapAccess::will_need: return MADV_WILLNEED;
+        default: return MADV_NORMAL;
+    }
+}
+
+bool MappedFile::open(const Path& path, const MapAccess access)
+{
+    close();
+
+    auto fd = ::open(path.str(), O_RDONLY);
+    if ( fd < 0 ) {
+        SKY_ERROR("MappedFile", "Unable to open %s: %s", path.str(), strerror(errno));
+        return false;
+    }
+
+    struct stat st{};
+    if ( fstat(fd, &st) != 0 || st.st_size <= 0 ) {
+        SKY_ERROR("MappedFile", "Unable to map empty or unreadable file %s", path.str());
+        ::close(fd);
+        return false;
+    }
+
+    auto size = static_cast<size_t>(st.st_size);
+    auto ptr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    // The mapping holds its own reference to the file so the descriptor isn't needed anymore
+    ::close(fd);
+
+    if ( ptr == MAP_FAILED ) {
+        SKY_ERROR("MappedFile", "Unable to map %s: %s", path.str(), strerror(errno));
+        return false;
+    }
+
+    data_ = static_cast<const uint8_t*>(ptr);
+    size_ = size;
+
+    advise(access);
+    return true;
+}
+
+void MappedFile::close()
+{
+    if ( data_ == nullptr ) {
+        return;
+    }
+
+    munmap(const_cast<uint8_t*>(data_), size_);
+    data_ = nullptr;
+    size_ = 0;
+}
+
+void MappedFile::advise(const MapAccess access, const size_t offset, const size_t size) const
+{
+    if ( data_ == nullptr || offset >= size_ ) {
+        return;
+    }
+
+    // madvise requires a page-aligned address so round the offset down to the nearest page
+    static const auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    auto begin = offset & ~(page_size - 1);
+    auto end = size == 0 ? size_ : std::min(offset + size, size_);
+
+    madvise(const_cast<uint8_t*>(data_) + begin, end - begin, get_madvise_flag(access));
+}
+
+
+}  // namespace sky
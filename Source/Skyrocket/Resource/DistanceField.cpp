@@ -0,0 +1,123 @@
+//
+//  DistanceField.cpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#include "Skyrocket/Resource/DistanceField.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace sky {
+
+
+static constexpr float edt_infinity = 1e20f;
+
+/// Felzenszwalb & Huttenlocher's linear time 1D squared euclidean distance transform over
+/// `count` values `stride` apart, using the lower envelope of the parabolas rooted at each value
+static void distance_transform_1d(float* grid, const uint32_t count, const uint32_t stride,
+                                  float* f, uint32_t* v, float* z)
+{
+    for ( uint32_t q = 0; q < count; ++q ) {
+        f[q] = grid[q * stride];
+    }
+
+    uint32_t k = 0;
+    v[0] = 0;
+    z[0] = -edt_infinity;
+    z[1] = edt_infinity;
+
+    for ( uint32_t q = 1; q < count; ++q ) {
+        auto fq = f[q] + static_cast<float>(q) * q;
+        auto s = (fq - f[v[k]] - static_cast<float>(v[k]) * v[k]) / (2.0f * q - 2.0f * v[k]);
+
+        while ( s <= z[k] ) {
+            --k;
+            s = (fq - f[v[k]] - static_cast<float>(v[k]) * v[k]) / (2.0f * q - 2.0f * v[k]);
+        }
+
+        ++k;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = edt_infinity;
+    }
+
+    k = 0;
+    for ( uint32_t q = 0; q < count; ++q ) {
+        while ( z[k + 1] < q ) {
+            ++k;
+        }
+        auto dq = static_cast<float>(q) - v[k];
+        grid[q * stride] = dq * dq + f[v[k]];
+    }
+}
+
+static void distance_transform_2d(float* grid, const uint32_t width, const uint32_t height,
+                                  float* f, uint32_t* v, float* z)
+{
+    for ( uint32_t x = 0; x < width; ++x ) {
+        distance_transform_1d(grid + x, height, width, f, v, z);
+    }
+
+    for ( uint32_t y = 0; y < height; ++y ) {
+        distance_transform_1d(grid + y * width, width, 1, f, v, z);
+    }
+}
+
+void generate_distance_field(const uint8_t* coverage, const uint32_t width, const uint32_t height,
+                             const int32_t pitch, const uint32_t spread, uint8_t* dest)
+{
+    auto field_width = distance_field_size(width, spread);
+    auto field_height = distance_field_size(height, spread);
+    auto field_size = static_cast<size_t>(field_width) * field_height;
+    auto max_side = std::max(field_width, field_height);
+
+    // Squared distances from texels outside the shape to its edge and from texels inside it
+    std::vector<float> outer(field_size, edt_infinity);
+    std::vector<float> inner(field_size, 0.0f);
+    std::vector<float> f(max_side);
+    std::vector<float> z(max_side + 1);
+    std::vector<uint32_t> v(max_side);
+
+    auto src_pitch = static_cast<size_t>(pitch >= 0 ? pitch : -pitch);
+
+    for ( uint32_t y = 0; y < height; ++y ) {
+        auto src_row = coverage + (pitch >= 0 ? y : height - 1 - y) * src_pitch;
+        auto dest_offset = (y + spread) * field_width + spread;
+
+        for ( uint32_t x = 0; x < width; ++x ) {
+            auto a = src_row[x] / 255.0f;
+            auto i = dest_offset + x;
+
+            if ( a >= 1.0f ) {
+                outer[i] = 0.0f;
+                inner[i] = edt_infinity;
+            } else if ( a > 0.0f ) {
+                // Partially covered texels lie on the edge, offset by how much of them is covered
+                auto d = 0.5f - a;
+                outer[i] = d > 0.0f ? d * d : 0.0f;
+                inner[i] = d < 0.0f ? d * d : 0.0f;
+            }
+        }
+    }
+
+    distance_transform_2d(outer.data(), field_width, field_height, f.data(), v.data(), z.data());
+    distance_transform_2d(inner.data(), field_width, field_height, f.data(), v.data(), z.data());
+
+    auto scale = 127.5f / static_cast<float>(spread > 0 ? spread : 1);
+    for ( size_t i = 0; i < field_size; ++i ) {
+        auto distance = std::sqrt(outer[i]) - std::sqrt(inner[i]);
+        auto value = 127.5f - distance * scale;
+        dest[i] = static_cast<uint8_t>(std::min(std::max(value, 0.0f), 255.0f) + 0.5f);
+    }
+}
+
+
+} // namespace sky
@@ -0,0 +1,36 @@
+//
+//  DistanceField.hpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#pragma once
+
+#include <cstdint>
+
+namespace sky {
+
+
+/// @brief Gets the width or height of a distance field generated from a `size` coverage bitmap
+inline uint32_t distance_field_size(const uint32_t size, const uint32_t spread)
+{
+    return size + 2 * spread;
+}
+
+/// @brief Generates an 8-bit signed distance field from an anti-aliased 8-bit coverage bitmap,
+/// i.e. a rasterised glyph. The field is padded by `spread` texels on every side and `dest` must
+/// hold distance_field_size(width, spread) * distance_field_size(height, spread) bytes.
+///
+/// Texels map distances in the range [-spread, spread] to [255, 0] so the shape's edge is at
+/// 0.5 when sampled as a normalized texture. Distances are exact euclidean distances to the
+/// nearest edge, with anti-aliased coverage used to place the edge between texels
+void generate_distance_field(const uint8_t* coverage, uint32_t width, uint32_t height,
+                             int32_t pitch, uint32_t spread, uint8_t* dest);
+
+
+} // namespace sky
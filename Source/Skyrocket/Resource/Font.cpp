@@ -10,7 +10,15 @@
 //
 
 #include "Skyrocket/Core/Diagnostics/Error.hpp"
+#include "Skyrocket/Core/Hash.hpp"
+#include "Skyrocket/Resource/DistanceField.hpp"
 #include "Skyrocket/Resource/Font.hpp"
+#include "Skyrocket/Platform/Jobs.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
 
 #include <ft2build.h>
 #include FT_FREETYPE_H
@@ -38,6 +46,24 @@ const struct {
 namespace sky {
 
 
+/// @brief A FreeType library and face over a fonts mapped file. Neither are thread safe so every
+/// thread rasterising glyphs at the same time needs its own
+struct GlyphRasterizer {
+    ~GlyphRasterizer()
+    {
+        if ( face != nullptr ) {
+            FT_Done_Face(face);
+        }
+        if ( lib != nullptr ) {
+            FT_Done_FreeType(lib);
+        }
+    }
+
+    FT_Library lib{nullptr};
+    FT_Face face{nullptr};
+    uint32_t pixel_size{0};
+};
+
 struct FontService {
     ~FontService()
     {
@@ -45,11 +71,168 @@ struct FontService {
     }
 
     static FT_Library lib;
-    FT_Face face;
+    FT_Face face{nullptr};
+    MappedFile file;
+
+    std::mutex rasterizer_mutex;
+    std::vector<std::unique_ptr<GlyphRasterizer>> rasterizers;
+    std::vector<GlyphRasterizer*> free_rasterizers;
+
+    /// @brief Gets a rasterizer not in use by any other thread, creating a new face over the
+    /// mapped file if they're all busy
+    GlyphRasterizer* acquire_rasterizer()
+    {
+        std::lock_guard<std::mutex> lock(rasterizer_mutex);
+
+        if ( !free_rasterizers.empty() ) {
+            auto rasterizer = free_rasterizers.back();
+            free_rasterizers.pop_back();
+            return rasterizer;
+        }
+
+        auto rasterizer = std::make_unique<GlyphRasterizer>();
+        auto err = FT_Init_FreeType(&rasterizer->lib);
+        if ( err != 0 ) {
+            SKY_ERROR("Font", "Unable to initialize freetype: %s", FT_errors[err].msg);
+            return nullptr;
+        }
+
+        err = FT_New_Memory_Face(rasterizer->lib, file.data(), static_cast<FT_Long>(file.size()),
+                                 0, &rasterizer->face);
+        if ( err != 0 ) {
+            SKY_ERROR("Font", "Unable to create font face: %s", FT_errors[err].msg);
+            return nullptr;
+        }
+
+        rasterizers.push_back(std::move(rasterizer));
+        return rasterizers.back().get();
+    }
+
+    void release_rasterizer(GlyphRasterizer* rasterizer)
+    {
+        std::lock_guard<std::mutex> lock(rasterizer_mutex);
+        free_rasterizers.push_back(rasterizer);
+    }
+
+    void destroy_rasterizers()
+    {
+        std::lock_guard<std::mutex> lock(rasterizer_mutex);
+        free_rasterizers.clear();
+        rasterizers.clear();
+    }
 };
 
 FT_Library FontService::lib = nullptr;
 
+static bool set_face_size(FT_Face face, const uint32_t pixel_size, uint32_t* current_size)
+{
+    if ( *current_size == pixel_size ) {
+        return true;
+    }
+
+    auto err = FT_Set_Pixel_Sizes(face, 0, pixel_size);
+    if ( err != 0 ) {
+        SKY_ERROR("Font", "Unable to set font pixel size to %u: %s", pixel_size,
+                  FT_errors[err].msg);
+        return false;
+    }
+
+    *current_size = pixel_size;
+    return true;
+}
+
+/// Renders a glyph with `face`, converting it to a distance field appended to `storage` if
+/// required. Coverage bitmaps are left in the faces glyph slot unless `copy_to_storage` is set.
+/// Bitmaps in `storage` are only valid until it's resized again
+static bool render_glyph(FT_Face face, const uint32_t codepoint, const GlyphRenderMode mode,
+                         const bool copy_to_storage, std::vector<uint8_t>* storage,
+                         GlyphBitmap* bitmap)
+{
+    auto err = FT_Load_Char(face, codepoint, FT_LOAD_RENDER);
+    if ( err != 0 ) {
+        SKY_ERROR("Font", "Unable to render glyph for codepoint U+%04X: %s", codepoint,
+                  FT_errors[err].msg);
+        return false;
+    }
+
+    const auto& slot = *face->glyph;
+
+    bitmap->width = slot.bitmap.width;
+    bitmap->height = slot.bitmap.rows;
+    bitmap->pitch = slot.bitmap.pitch;
+    bitmap->pixels = slot.bitmap.buffer;
+    bitmap->bearing.x = slot.bitmap_left;
+    bitmap->bearing.y = slot.bitmap_top;
+    bitmap->advance.x = static_cast<int32_t>(slot.advance.x >> 6);
+    bitmap->advance.y = static_cast<int32_t>(slot.advance.y >> 6);
+
+    if ( bitmap->width == 0 || bitmap->height == 0 ) {
+        return true;
+    }
+
+    if ( mode == GlyphRenderMode::distance_field ) {
+        auto spread = Font::distance_field_spread;
+        auto field_width = distance_field_size(bitmap->width, spread);
+        auto field_height = distance_field_size(bitmap->height, spread);
+        auto offset = storage->size();
+        storage->resize(offset + static_cast<size_t>(field_width) * field_height);
+
+        generate_distance_field(bitmap->pixels, bitmap->width, bitmap->height, bitmap->pitch,
+                                spread, storage->data() + offset);
+
+        bitmap->width = field_width;
+        bitmap->height = field_height;
+        bitmap->pitch = static_cast<int32_t>(field_width);
+        bitmap->pixels = storage->data() + offset;
+        bitmap->bearing.x -= static_cast<int32_t>(spread);
+        bitmap->bearing.y += static_cast<int32_t>(spread);
+        return true;
+    }
+
+    if ( copy_to_storage ) {
+        auto src_pitch = static_cast<size_t>(std::abs(bitmap->pitch));
+        auto offset = storage->size();
+        storage->resize(offset + static_cast<size_t>(bitmap->width) * bitmap->height);
+
+        auto dest = storage->data() + offset;
+        for ( uint32_t row = 0; row < bitmap->height; ++row ) {
+            auto src_row = bitmap->pitch >= 0 ? row : bitmap->height - 1 - row;
+            memcpy(dest + row * bitmap->width, bitmap->pixels + src_row * src_pitch,
+                   bitmap->width);
+        }
+
+        bitmap->pitch = static_cast<int32_t>(bitmap->width);
+        bitmap->pixels = dest;
+    }
+
+    return true;
+}
+
+static uint64_t make_kerning_key(const uint32_t left, const uint32_t right)
+{
+    return (static_cast<uint64_t>(left) << 32) | right;
+}
+
+/// Gets the kerning between two glyph indices in font units, which are independent of pixel size
+static int16_t query_kerning(FT_Face face, const FT_UInt left, const FT_UInt right)
+{
+    if ( left == 0 || right == 0 ) {
+        return 0;
+    }
+
+    FT_Vector kerning{};
+    if ( FT_Get_Kerning(face, left, right, FT_KERNING_UNSCALED, &kerning) != 0 ) {
+        return 0;
+    }
+
+    auto units = std::min<FT_Pos>(std::max<FT_Pos>(kerning.x, INT16_MIN), INT16_MAX);
+    return static_cast<int16_t>(units);
+}
+
+constexpr uint32_t Font::default_atlas_size;
+constexpr uint32_t Font::distance_field_base_size;
+constexpr uint32_t Font::distance_field_spread;
+
 Font::Font()
     : service(std::make_unique<FontService>())
 {}
@@ -60,136 +243,625 @@ void Font::init_library()
 {
     if ( service->lib == nullptr ) {
         auto err = FT_Init_FreeType(&service->lib);
-        if ( err == 1 ) {
+        if ( err != 0 ) {
             SKY_ERROR("FontService", "Unable to initialize freetype: %s", FT_errors[err].msg);
             return;
         }
     }
 }
 
-void Font::load_from_file(const Path& path, const float pixel_size)
+void Font::load_from_file(const Path& path, const uint32_t pixel_size, const uint32_t atlas_size,
+                          const GlyphRenderMode render_mode)
 {
-    init_library();
-    // This loads from file but we should allow loading from memory. The above
-    // code is therefore redundant
-    auto err = FT_New_Face(service->lib, path.str(), 0, &service->face);
-    if ( err == 1 ) {
-        SKY_ERROR("Font", "Unable to load font '%s': %s", path.str(), FT_errors[err].msg);
+    if ( service->face != nullptr ) {
+        FT_Done_Face(service->face);
+        service->face = nullptr;
+    }
+
+    // Worker faces read from the previous file's mapping
+    service->destroy_rasterizers();
+
+    // FreeType reads glyph outlines from the face on demand so the file stays mapped for the
+    // lifetime of the face instead of being copied into the heap
+    if ( !service->file.open(path, MapAccess::random) ) {
+        SKY_ERROR("Font", "Unable to load font '%s'", path.str());
         return;
     }
 
-    glyphs_.resize(static_cast<uint64_t>(service->face->num_glyphs));
+    font_hash_ = hash::murmur3_32(service->file.data(),
+                                  static_cast<uint32_t>(service->file.size()), 0);
+
+    // Glyphs are only rasterised the first time they're looked up so loading a face costs the
+    // same regardless of how many glyphs it defines. The FreeType face itself isn't created
+    // until then either, so fonts restored from a baked atlas cache never touch FreeType
+    glyph_cache_.reset(atlas_size, atlas_size);
+    kerning_.clear();
+    kerning_codepoints_.clear();
+    kerning_known_ = false;
+    has_kerning_ = false;
+    units_per_em_ = 0;
+    render_mode_ = render_mode;
+    face_size_ = 0;
     set_pixel_size(pixel_size);
 }
 
+bool Font::load_face()
+{
+    if ( service->face != nullptr ) {
+        return true;
+    }
+
+    if ( service->file.data() == nullptr ) {
+        return false;
+    }
+
+    init_library();
+
+    auto err = FT_New_Memory_Face(service->lib, service->file.data(),
+                                  static_cast<FT_Long>(service->file.size()), 0, &service->face);
+    if ( err != 0 ) {
+        SKY_ERROR("Font", "Unable to create font face: %s", FT_errors[err].msg);
+        service->face = nullptr;
+        return false;
+    }
+
+    face_size_ = 0;
+    units_per_em_ = service->face->units_per_EM;
+    has_kerning_ = FT_HAS_KERNING(service->face) != 0;
+    kerning_known_ = true;
+    return true;
+}
+
 void Font::load_from_memory(uint8_t* memory, const float pixel_size)
 {
     SKY_ERROR("Font", "Load from memory not implemented");
 }
 
-Glyph Font::get_glyph(const char character)
+const Glyph& Font::get_glyph(const uint32_t codepoint)
 {
-    auto index = static_cast<uint32_t>(character);
-    SKY_ASSERT(index < glyphs_.size(),
-               "Font face doesn't contain a definition for '%c'", character);
-    return glyphs_[index];
+    return get_glyph(codepoint, size_);
 }
 
-void Font::set_pixel_size(const uint32_t size)
+const Glyph& Font::get_glyph(const uint32_t codepoint, const uint32_t pixel_size)
 {
-    SKY_ASSERT(service->face != nullptr, "Font face has been loaded before assigning pixel size");
+    static const Glyph empty_glyph{};
+
+    // Every size shares the same distance field glyph
+    auto raster_size = render_mode_ == GlyphRenderMode::distance_field
+                     ? distance_field_base_size
+                     : pixel_size;
+
+    auto glyph = glyph_cache_.find(codepoint, raster_size);
+    if ( glyph == nullptr ) {
+        glyph = rasterize_glyph(codepoint, raster_size);
+    }
 
-    auto err = FT_Set_Pixel_Sizes(service->face, 0, size);
+    return glyph != nullptr ? *glyph : empty_glyph;
+}
 
-    if ( err == 1) {
-        SKY_ERROR("Font", "Unable to set font pixel size");
+bool Font::has_kerning()
+{
+    if ( !kerning_known_ ) {
+        load_face();
+    }
+    return has_kerning_;
+}
+
+float Font::get_kerning(const uint32_t left, const uint32_t right)
+{
+    return get_kerning(left, right, size_);
+}
+
+float Font::get_kerning(const uint32_t left, const uint32_t right, const uint32_t pixel_size)
+{
+    if ( !has_kerning() || units_per_em_ == 0 ) {
+        return 0.0f;
+    }
+
+    auto key = make_kerning_key(left, right);
+    auto found = kerning_.find(key);
+    int16_t units = 0;
+
+    if ( found != nullptr ) {
+        units = *found;
+    } else {
+        auto extracted = std::binary_search(kerning_codepoints_.begin(), kerning_codepoints_.end(),
+                                            left)
+                      && std::binary_search(kerning_codepoints_.begin(), kerning_codepoints_.end(),
+                                            right);
+        // Pairs missing from the extracted set have no kerning. Anything else is looked up once
+        // and cached, even if it's zero
+        if ( !extracted ) {
+            if ( !load_face() ) {
+                return 0.0f;
+            }
+
+            units = query_kerning(service->face, FT_Get_Char_Index(service->face, left),
+                                  FT_Get_Char_Index(service->face, right));
+            kerning_.insert(key, units);
+        }
+    }
+
+    return static_cast<float>(units) * pixel_size / static_cast<float>(units_per_em_);
+}
+
+void Font::extract_kerning(const uint32_t* codepoints, const uint32_t count)
+{
+    // Extraction is quadratic in the number of codepoints so very large character sets fall
+    // back to looking pairs up as they're used
+    static constexpr size_t max_kerning_codepoints = 512;
+
+    if ( !has_kerning() || !load_face() ) {
         return;
     }
 
+    std::vector<uint32_t> added;
+    for ( uint32_t i = 0; i < count; ++i ) {
+        if ( !std::binary_search(kerning_codepoints_.begin(), kerning_codepoints_.end(),
+                                 codepoints[i]) ) {
+            added.push_back(codepoints[i]);
+        }
+    }
+
+    std::sort(added.begin(), added.end());
+    added.erase(std::unique(added.begin(), added.end()), added.end());
+
+    auto available = max_kerning_codepoints - std::min(max_kerning_codepoints,
+                                                       kerning_codepoints_.size());
+    if ( added.size() > available ) {
+        added.resize(available);
+    }
+
+    if ( added.empty() ) {
+        return;
+    }
+
+    std::vector<uint32_t> merged(kerning_codepoints_.size() + added.size());
+    std::merge(kerning_codepoints_.begin(), kerning_codepoints_.end(), added.begin(), added.end(),
+               merged.begin());
+
+    auto face = service->face;
+    std::vector<FT_UInt> indices(merged.size());
+    std::vector<bool> is_new(merged.size());
+    for ( size_t i = 0; i < merged.size(); ++i ) {
+        indices[i] = FT_Get_Char_Index(face, merged[i]);
+        is_new[i] = std::binary_search(added.begin(), added.end(), merged[i]);
+    }
+
+    // Only pairs involving a new codepoint need extracting, and only non-zero ones are stored
+    for ( size_t l = 0; l < merged.size(); ++l ) {
+        for ( size_t r = 0; r < merged.size(); ++r ) {
+            if ( !is_new[l] && !is_new[r] ) {
+                continue;
+            }
+
+            auto units = query_kerning(face, indices[l], indices[r]);
+            if ( units != 0 ) {
+                kerning_.insert(make_kerning_key(merged[l], merged[r]), units);
+            }
+        }
+    }
+
+    kerning_codepoints_ = std::move(merged);
+}
+
+void Font::set_pixel_size(const uint32_t size)
+{
+    SKY_ASSERT(service->file.data() != nullptr,
+               "Font face has been loaded before assigning pixel size");
+
     size_ = size;
+}
 
-    reset_glyphs();
+bool Font::flush_atlas(UIntRect* dirty_region)
+{
+    return glyph_cache_.flush_dirty_region(dirty_region);
 }
 
-void Font::reset_glyphs()
+const Glyph* Font::rasterize_glyph(const uint32_t codepoint, const uint32_t pixel_size)
 {
-    width_ = 0;
-    uint32_t c = 0;
-    size_t bitmap_size = 0;
-    FT_Error err;
+    if ( !load_face() ) {
+        return nullptr;
+    }
+
     auto face = service->face;
+    if ( !set_face_size(face, pixel_size, &face_size_) ) {
+        return nullptr;
+    }
 
-    height_ = 0;
-    uint32_t row = 0;
-    uint32_t col = 0;
-    uint32_t cur_row_height = 0;
-    for ( auto& g : glyphs_ ) {
-        auto index = FT_Get_Char_Index(face, c);
-
-        err = FT_Load_Glyph(face, index, FT_LOAD_RENDER);
-        if ( err == 1 ) {
-            SKY_ERROR("Font", "Unable to load glyph for character %c: %s",
-                      static_cast<char>(c), FT_errors[err].msg)
-            continue;
-        }
+    GlyphBitmap bitmap;
+    raster_storage_.clear();
+    if ( !render_glyph(face, codepoint, render_mode_, false, &raster_storage_, &bitmap) ) {
+        return nullptr;
+    }
 
-        err = FT_Render_Glyph(face->glyph, FT_RENDER_MODE_NORMAL);
-        if ( err == 1 ) {
-            SKY_ERROR("Font", "Unable to render glyph for character %c: %s",
-                      static_cast<char>(c), FT_errors[err].msg)
-            continue;
+    auto glyph = glyph_cache_.insert(codepoint, pixel_size, bitmap);
+    if ( glyph == nullptr ) {
+        SKY_ERROR("Font", "Unable to fit glyph for codepoint U+%04X into the %ux%u glyph atlas",
+                  codepoint, glyph_cache_.atlas_width(), glyph_cache_.atlas_height());
+    }
+
+    return glyph;
+}
+
+struct PreloadGlyph {
+    uint32_t codepoint{0};
+    bool rendered{false};
+    bool reserved{false};
+    GlyphBitmap bitmap;
+    UIntRect bounds;
+};
+
+struct PreloadJob {
+    FontService* service{nullptr};
+    GlyphCache* cache{nullptr};
+    GlyphRenderMode render_mode{GlyphRenderMode::bitmap};
+    uint32_t raster_size{0};
+    PreloadGlyph* glyphs{nullptr};
+
+    // Every batch renders its bitmaps into one arena, which is kept until they're all written
+    std::mutex arena_mutex;
+    std::vector<std::vector<uint8_t>> arenas;
+};
+
+static void render_preload_batch(const uint32_t begin, const uint32_t end, void* user_data)
+{
+    auto job = static_cast<PreloadJob*>(user_data);
+    auto rasterizer = job->service->acquire_rasterizer();
+    if ( rasterizer == nullptr ) {
+        return;
+    }
+
+    // Sized for distance fields, or bitmaps at the raster size, so the arena rarely grows
+    std::vector<uint8_t> arena;
+    auto padded_size = distance_field_size(job->raster_size, Font::distance_field_spread);
+    arena.reserve(static_cast<size_t>(end - begin) * padded_size * padded_size);
+
+    std::vector<size_t> offsets(end - begin);
+
+    if ( set_face_size(rasterizer->face, job->raster_size, &rasterizer->pixel_size) ) {
+        for ( auto i = begin; i < end; ++i ) {
+            auto& glyph = job->glyphs[i];
+            glyph.rendered = render_glyph(rasterizer->face, glyph.codepoint, job->render_mode,
+                                          true, &arena, &glyph.bitmap);
+            if ( glyph.rendered && glyph.bitmap.width > 0 && glyph.bitmap.height > 0 ) {
+                offsets[i - begin] = static_cast<size_t>(glyph.bitmap.pixels - arena.data());
+            }
         }
+    }
 
-        bitmap_size = face->glyph->bitmap.width * face->glyph->bitmap.rows;
+    job->service->release_rasterizer(rasterizer);
 
-        ++c;
+    // The arena may have been reallocated while rendering so bitmaps point into it by offset
+    // until it's finished. Moving it into the job keeps its buffer at the same address
+    for ( auto i = begin; i < end; ++i ) {
+        auto& glyph = job->glyphs[i];
+        if ( glyph.rendered && glyph.bitmap.width > 0 && glyph.bitmap.height > 0 ) {
+            glyph.bitmap.pixels = arena.data() + offsets[i - begin];
+        }
+    }
 
-        if ( index == 0 ) {
-            g.bounds.width = 0;
-            g.bounds.height = 0;
-            g.data = nullptr;
-            g.character = '\0';
-            continue;
+    std::lock_guard<std::mutex> lock(job->arena_mutex);
+    job->arenas.push_back(std::move(arena));
+}
+
+static void write_preload_batch(const uint32_t begin, const uint32_t end, void* user_data)
+{
+    auto job = static_cast<PreloadJob*>(user_data);
+    for ( auto i = begin; i < end; ++i ) {
+        auto& glyph = job->glyphs[i];
+        if ( glyph.reserved ) {
+            job->cache->write_bitmap(glyph.bounds, glyph.bitmap);
         }
+    }
+}
 
-        g.data = static_cast<uint8_t*>(malloc(bitmap_size));
-        memcpy(g.data, face->glyph->bitmap.buffer, bitmap_size);
+void Font::preload_glyphs(const uint32_t* codepoints, const uint32_t count)
+{
+    preload_glyphs(codepoints, count, size_);
+}
 
-        g.character = static_cast<char>(c);
+void Font::preload_glyphs(const uint32_t* codepoints, const uint32_t count,
+                          const uint32_t pixel_size)
+{
+    static constexpr uint32_t glyphs_per_batch = 16;
 
-        g.bounds.width = face->glyph->bitmap.width;
-        g.bounds.height = face->glyph->bitmap.rows;
+    if ( service->file.data() == nullptr ) {
+        return;
+    }
 
-        g.bearing.x = face->glyph->bitmap_left;
-        g.bearing.y = face->glyph->bitmap_top;
-        g.advance.x = static_cast<int32_t>(face->glyph->advance.x >> 6);
-        g.advance.y = static_cast<int32_t>(face->glyph->advance.y >> 6);
+    extract_kerning(codepoints, count);
 
-        g.bounds.position.x = col;
-        g.bounds.position.y = row;
+    auto raster_size = render_mode_ == GlyphRenderMode::distance_field
+                     ? distance_field_base_size
+                     : pixel_size;
 
-        col += g.bounds.width + 1;
+    std::vector<uint32_t> missing;
+    missing.reserve(count);
+    for ( uint32_t i = 0; i < count; ++i ) {
+        if ( glyph_cache_.find(codepoints[i], raster_size) == nullptr ) {
+            missing.push_back(codepoints[i]);
+        }
+    }
+
+    std::sort(missing.begin(), missing.end());
+    missing.erase(std::unique(missing.begin(), missing.end()), missing.end());
+
+    if ( missing.empty() ) {
+        return;
+    }
 
-        if ( col > width_ ) {
-            width_ = col;
+    std::vector<PreloadGlyph> glyphs(missing.size());
+    for ( size_t i = 0; i < missing.size(); ++i ) {
+        glyphs[i].codepoint = missing[i];
+    }
+
+    PreloadJob job;
+    job.service = service.get();
+    job.cache = &glyph_cache_;
+    job.render_mode = render_mode_;
+    job.raster_size = raster_size;
+    job.glyphs = glyphs.data();
+    auto num_glyphs = static_cast<uint32_t>(glyphs.size());
+
+    // Glyphs are rendered on the workers with a face each, then space is reserved for all of
+    // them in the atlas at once, tallest first, so the bitmaps can be copied in parallel
+    jobs::parallel_for(num_glyphs, glyphs_per_batch, render_preload_batch, &job);
+
+    std::vector<uint32_t> order(num_glyphs);
+    for ( uint32_t i = 0; i < num_glyphs; ++i ) {
+        order[i] = i;
+    }
+
+    std::sort(order.begin(), order.end(), [&](const uint32_t a, const uint32_t b) {
+        return glyphs[a].bitmap.height > glyphs[b].bitmap.height;
+    });
+
+    for ( auto i : order ) {
+        auto& glyph = glyphs[i];
+        if ( !glyph.rendered ) {
+            continue;
         }
 
-        if ( col >= 4096 ) {
-            col = 0;
-            row += cur_row_height;
-            cur_row_height = 0;
+        auto reserved = glyph_cache_.reserve(glyph.codepoint, raster_size, glyph.bitmap);
+        if ( reserved == nullptr ) {
+            SKY_ERROR("Font", "Unable to fit glyph for codepoint U+%04X into the %ux%u glyph atlas",
+                      glyph.codepoint, glyph_cache_.atlas_width(), glyph_cache_.atlas_height());
+            continue;
         }
 
-        cur_row_height = std::max(cur_row_height, g.bounds.height);
-        height_ = std::max(height_, g.bounds.position.y + g.bounds.height);
+        glyph.bounds = glyph_cache_.placement(*reserved).bounds;
+        glyph.reserved = true;
+    }
+
+    jobs::parallel_for(num_glyphs, glyphs_per_batch, write_preload_batch, &job);
+}
+
+//==========================================
+//  Baked atlas cache
+//==========================================
+
+static constexpr uint32_t atlas_cache_magic = 0x41464b53; // 'SKFA'
+static constexpr uint32_t atlas_cache_version = 2;
+static constexpr size_t atlas_cache_alignment = 64;
+
+/// Kerning has been read from the face, otherwise it's looked up again when the cache is loaded
+static constexpr uint32_t atlas_cache_kerning_known = 1u << 0;
+static constexpr uint32_t atlas_cache_has_kerning = 1u << 1;
+
+/// Baked atlas files are laid out as this header, `glyph_count` BakedGlyphs from least to most
+/// recently used, the sorted codepoints kerning was extracted for, the kerning pairs and then the
+/// atlas texels, each section aligned to 64 bytes so a mapped file can be read in place
+struct AtlasCacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t font_hash;
+    uint32_t font_size;
+    uint32_t pixel_size;
+    uint32_t render_mode;
+    uint32_t atlas_width;
+    uint32_t atlas_height;
+    uint32_t glyph_count;
+    uint32_t glyphs_offset;
+    uint32_t atlas_offset;
+    uint32_t kerning_flags;
+    uint32_t units_per_em;
+    uint32_t kerning_codepoint_count;
+    uint32_t kerning_codepoints_offset;
+    uint32_t kerning_pair_count;
+    uint32_t kerning_pairs_offset;
+};
+
+struct BakedKerningPair {
+    uint32_t left;
+    uint32_t right;
+    int32_t units;
+};
+
+struct BakedGlyph {
+    uint32_t x, y, width, height;
+    uint32_t codepoint;
+    uint32_t pixel_size;
+    int32_t bearing_x, bearing_y;
+    int32_t advance_x, advance_y;
+    float s, t, s2, t2;
+};
+
+static size_t align_cache_offset(const size_t offset)
+{
+    return (offset + atlas_cache_alignment - 1) & ~(atlas_cache_alignment - 1);
+}
+
+Path Font::atlas_cache_path(const Path& directory) const
+{
+    char name[64];
+    snprintf(name, sizeof(name), "%08x-%u-%s.skyfont", font_hash_, size_,
+             render_mode_ == GlyphRenderMode::distance_field ? "sdf" : "bitmap");
+    return directory.relative_path(name);
+}
+
+bool Font::save_atlas_cache(const Path& path) const
+{
+    if ( service->file.data() == nullptr ) {
+        return false;
+    }
+
+    AtlasCacheHeader header{};
+    header.magic = atlas_cache_magic;
+    header.version = atlas_cache_version;
+    header.font_hash = font_hash_;
+    header.font_size = static_cast<uint32_t>(service->file.size());
+    header.pixel_size = size_;
+    header.render_mode = static_cast<uint32_t>(render_mode_);
+    header.atlas_width = glyph_cache_.atlas_width();
+    header.atlas_height = glyph_cache_.atlas_height();
+    header.glyph_count = glyph_cache_.size();
+    header.kerning_flags = (kerning_known_ ? atlas_cache_kerning_known : 0u)
+                         | (has_kerning_ ? atlas_cache_has_kerning : 0u);
+    header.units_per_em = units_per_em_;
+    header.kerning_codepoint_count = static_cast<uint32_t>(kerning_codepoints_.size());
+    header.kerning_pair_count = static_cast<uint32_t>(kerning_.size());
+
+    header.glyphs_offset = static_cast<uint32_t>(align_cache_offset(sizeof(AtlasCacheHeader)));
+    header.kerning_codepoints_offset = static_cast<uint32_t>(
+        align_cache_offset(header.glyphs_offset + header.glyph_count * sizeof(BakedGlyph))
+    );
+    header.kerning_pairs_offset = static_cast<uint32_t>(
+        align_cache_offset(header.kerning_codepoints_offset
+                           + header.kerning_codepoint_count * sizeof(uint32_t))
+    );
+    header.atlas_offset = static_cast<uint32_t>(
+        align_cache_offset(header.kerning_pairs_offset
+                           + header.kerning_pair_count * sizeof(BakedKerningPair))
+    );
+
+    auto atlas_bytes = static_cast<size_t>(header.atlas_width) * header.atlas_height;
+    std::vector<uint8_t> contents(header.atlas_offset + atlas_bytes, 0);
+
+    memcpy(contents.data(), &header, sizeof(AtlasCacheHeader));
+
+    auto baked = reinterpret_cast<BakedGlyph*>(contents.data() + header.glyphs_offset);
+    glyph_cache_.for_each_glyph([&](const Glyph& glyph, const GlyphPlacement& placement) {
+        *baked++ = BakedGlyph {
+            placement.bounds.position.x, placement.bounds.position.y,
+            placement.bounds.width, placement.bounds.height,
+            glyph.codepoint, placement.pixel_size,
+            glyph.bearing_x, glyph.bearing_y,
+            glyph.advance_x, glyph.advance_y,
+            glyph.s, glyph.t, glyph.s2, glyph.t2
+        };
+    });
+
+    if ( !kerning_codepoints_.empty() ) {
+        memcpy(contents.data() + header.kerning_codepoints_offset, kerning_codepoints_.data(),
+               kerning_codepoints_.size() * sizeof(uint32_t));
+    }
+
+    auto pair = reinterpret_cast<BakedKerningPair*>(contents.data() + header.kerning_pairs_offset);
+    kerning_.for_each([&](const uint64_t key, const int16_t units) {
+        *pair++ = BakedKerningPair {
+            static_cast<uint32_t>(key >> 32), static_cast<uint32_t>(key & UINT32_MAX), units
+        };
+    });
+
+    memcpy(contents.data() + header.atlas_offset, glyph_cache_.atlas_data(), atlas_bytes);
+
+    return fs::write_file(path, contents.data(), contents.size());
+}
+
+bool Font::load_atlas_cache(const Path& path)
+{
+    if ( service->file.data() == nullptr || !path.exists() ) {
+        return false;
+    }
+
+    MappedFile cache(path, MapAccess::sequential);
+    if ( cache.data() == nullptr || cache.size() < sizeof(AtlasCacheHeader) ) {
+        return false;
+    }
+
+    const auto& header = *reinterpret_cast<const AtlasCacheHeader*>(cache.data());
+
+    // Caches baked from a different font file, size or mode are silently ignored so they can
+    // just be rebaked
+    auto matches = header.magic == atlas_cache_magic
+        && header.version == atlas_cache_version
+        && header.font_hash == font_hash_
+        && header.font_size == service->file.size()
+        && header.pixel_size == size_
+        && header.render_mode == static_cast<uint32_t>(render_mode_);
+
+    if ( !matches ) {
+        return false;
+    }
+
+    auto atlas_bytes = static_cast<size_t>(header.atlas_width) * header.atlas_height;
+    auto glyphs_end = static_cast<size_t>(header.glyphs_offset)
+        + static_cast<size_t>(header.glyph_count) * sizeof(BakedGlyph);
+
+    auto kerning_codepoints_end = static_cast<size_t>(header.kerning_codepoints_offset)
+        + static_cast<size_t>(header.kerning_codepoint_count) * sizeof(uint32_t);
+    auto kerning_pairs_end = static_cast<size_t>(header.kerning_pairs_offset)
+        + static_cast<size_t>(header.kerning_pair_count) * sizeof(BakedKerningPair);
+
+    if ( glyphs_end > cache.size() || header.atlas_offset + atlas_bytes > cache.size()
+        || kerning_codepoints_end > cache.size() || kerning_pairs_end > cache.size() ) {
+        SKY_ERROR("Font", "Baked font atlas '%s' is truncated", path.str());
+        return false;
     }
 
-    for ( auto& g : glyphs_ ) {
-        g.s = static_cast<float>(g.bounds.position.x) / static_cast<float>(width_);
-        g.t = static_cast<float>(g.bounds.position.y) / static_cast<float>(height_);
-        g.s2 = static_cast<float>(g.bounds.position.x + g.bounds.width) / static_cast<float>(width_);
-        g.t2 = static_cast<float>(g.bounds.position.y + g.bounds.height) / static_cast<float>(height_);
+    auto baked = reinterpret_cast<const BakedGlyph*>(cache.data() + header.glyphs_offset);
+    std::vector<Glyph> glyphs(header.glyph_count);
+    std::vector<GlyphPlacement> placements(header.glyph_count);
+
+    for ( uint32_t i = 0; i < header.glyph_count; ++i ) {
+        auto& glyph = glyphs[i];
+        glyph.s = baked[i].s;
+        glyph.t = baked[i].t;
+        glyph.s2 = baked[i].s2;
+        glyph.t2 = baked[i].t2;
+        glyph.codepoint = baked[i].codepoint;
+        glyph.width = static_cast<uint16_t>(baked[i].width);
+        glyph.height = static_cast<uint16_t>(baked[i].height);
+        glyph.bearing_x = static_cast<int16_t>(baked[i].bearing_x);
+        glyph.bearing_y = static_cast<int16_t>(baked[i].bearing_y);
+        glyph.advance_x = static_cast<int16_t>(baked[i].advance_x);
+        glyph.advance_y = static_cast<int16_t>(baked[i].advance_y);
+
+        placements[i].bounds = UIntRect(baked[i].x, baked[i].y, baked[i].width, baked[i].height);
+        placements[i].pixel_size = baked[i].pixel_size;
     }
+
+    if ( !glyph_cache_.restore(header.atlas_width, header.atlas_height,
+                               cache.data() + header.atlas_offset, glyphs.data(),
+                               placements.data(), header.glyph_count) ) {
+        SKY_ERROR("Font", "Baked font atlas '%s' contains invalid glyphs", path.str());
+        return false;
+    }
+
+    // Caches baked before the face was loaded leave kerning to be read from the face
+    if ( (header.kerning_flags & atlas_cache_kerning_known) != 0 ) {
+        kerning_known_ = true;
+        has_kerning_ = (header.kerning_flags & atlas_cache_has_kerning) != 0;
+        units_per_em_ = header.units_per_em;
+
+        auto codepoints = reinterpret_cast<const uint32_t*>(
+            cache.data() + header.kerning_codepoints_offset
+        );
+        kerning_codepoints_.assign(codepoints, codepoints + header.kerning_codepoint_count);
+
+        kerning_.clear();
+        auto pairs = reinterpret_cast<const BakedKerningPair*>(
+            cache.data() + header.kerning_pairs_offset
+        );
+        kerning_.reserve(header.kerning_pair_count);
+        for ( uint32_t i = 0; i < header.kerning_pair_count; ++i ) {
+            kerning_.insert(make_kerning_key(pairs[i].left, pairs[i].right),
+                            static_cast<int16_t>(pairs[i].units));
+        }
+    }
+
+    return true;
 }
 
 
@@ -11,48 +11,118 @@
 
 #pragma once
 
-#include "Skyrocket/Core/Math/Vector2.hpp"
-#include "Skyrocket/Core/Geometry/Rectangle.hpp"
+#include "Skyrocket/Resource/GlyphCache.hpp"
 #include "Skyrocket/Platform/Filesystem.hpp"
 
+#include <memory>
+
 namespace sky {
 
 
 struct FontService;
 
-struct Glyph {
-    UIntRect bounds;
-    uint8_t* data{};
-    char character{};
-    float s, t, s2, t2;
-    Vector2<int32_t> bearing;
-    Vector2<int32_t> advance;
+enum class GlyphRenderMode {
+    /// Glyphs are rasterised into coverage bitmaps separately for each pixel size
+    bitmap,
+    /// Glyphs are rasterised once into signed distance fields which are scaled to any pixel size
+    /// and need to be drawn with a distance field text shader, i.e. `text_sdf_frag`
+    distance_field
 };
 
+/// @brief A font face loaded with FreeType. Glyphs are rasterised the first time they're looked
+/// up into a glyph atlas shared by every pixel size used with the font
 struct Font {
+    static constexpr uint32_t default_atlas_size = 1024;
+    /// Pixel size distance field glyphs are rasterised at before being scaled
+    static constexpr uint32_t distance_field_base_size = 48;
+    /// Distance in texels from a glyphs edge covered by its distance field
+    static constexpr uint32_t distance_field_spread = 6;
+
     Font();
     ~Font();
 
-    void load_from_file(const Path& path, const float pixel_size);
+    void load_from_file(const Path& path, uint32_t pixel_size,
+                        uint32_t atlas_size = default_atlas_size,
+                        GlyphRenderMode render_mode = GlyphRenderMode::bitmap);
     void load_from_memory(uint8_t* memory, const float pixel_size);
 
-    Glyph get_glyph(const char character);
+    /// @brief Gets the glyph for a unicode codepoint at the fonts current pixel size,
+    /// rasterising it into the atlas if it hasn't been used recently. The glyph is only valid
+    /// until another glyph is rasterised. Glyphs that can't be rasterised are empty
+    const Glyph& get_glyph(uint32_t codepoint);
+
+    /// @brief Gets the glyph for a unicode codepoint at a specific pixel size
+    const Glyph& get_glyph(uint32_t codepoint, uint32_t pixel_size);
+
+    /// @brief Gets the scale from a glyphs atlas texels, bearing and advance to pixels at
+    /// `pixel_size`. Only distance field glyphs, which are shared by every size, are scaled
+    inline float glyph_scale(const uint32_t pixel_size) const
+    {
+        return render_mode_ == GlyphRenderMode::distance_field
+             ? static_cast<float>(pixel_size) / static_cast<float>(distance_field_base_size)
+             : 1.0f;
+    }
+
+    inline float glyph_scale() const
+    {
+        return glyph_scale(size_);
+    }
+
+    /// @brief Gets the horizontal kerning adjustment in pixels to apply between two codepoints at
+    /// the fonts current pixel size. Pairs are looked up in the fonts kerning table, which is
+    /// extracted from FreeType for preloaded glyphs and filled in on demand for any others
+    float get_kerning(uint32_t left, uint32_t right);
+
+    float get_kerning(uint32_t left, uint32_t right, uint32_t pixel_size);
 
+    /// @brief Rasterises any of the glyphs for `codepoints` that aren't already cached at the
+    /// fonts current pixel size, i.e. to load a known character set up front. Glyphs are rendered
+    /// in parallel on the job workers, each with its own face over the mapped font file. Kerning
+    /// between every pair of preloaded codepoints is extracted at the same time
+    void preload_glyphs(const uint32_t* codepoints, uint32_t count);
+
+    void preload_glyphs(const uint32_t* codepoints, uint32_t count, uint32_t pixel_size);
+
+    /// @brief Sets the pixel size used by `get_glyph`. Glyphs already rasterised at other sizes
+    /// stay in the atlas
     void set_pixel_size(const uint32_t size);
 
+    /// @brief Gets the path of the baked atlas cache for the fonts file, pixel size and render
+    /// mode in `directory`
+    Path atlas_cache_path(const Path& directory) const;
+
+    /// @brief Bakes every cached glyph and the atlas into a file that can be loaded with
+    /// `load_atlas_cache` on later runs instead of rasterising glyphs again
+    bool save_atlas_cache(const Path& path) const;
+
+    /// @brief Restores glyphs and the atlas from a file written by `save_atlas_cache`, replacing
+    /// any glyphs already cached. Glyphs missing from the cache are still rasterised on demand.
+    /// @return false if the file doesn't exist or was baked from a different font file, pixel
+    /// size or render mode
+    bool load_atlas_cache(const Path& path);
+
+    /// @brief Gets the rows of the atlas changed since the last flush, which need to be uploaded
+    /// before drawing text laid out since then. See GlyphCache::flush_dirty_region
+    bool flush_atlas(UIntRect* dirty_region);
+
+    inline const uint8_t* atlas_data() const
+    {
+        return glyph_cache_.atlas_data();
+    }
+
     inline uint32_t width()
     {
-        return width_;
+        return glyph_cache_.atlas_width();
     }
 
     inline uint32_t height()
     {
-        return height_;
+        return glyph_cache_.atlas_height();
     }
 
     inline uint32_t glyph_count()
     {
-        return static_cast<uint32_t>(glyphs_.size());
+        return glyph_cache_.size();
     }
 
     inline uint32_t size()
@@ -60,26 +130,55 @@ struct Font {
         return size_;
     }
 
-    Glyph* begin()
+    inline GlyphRenderMode render_mode() const
+    {
+        return render_mode_;
+    }
+
+    /// @brief Checks if the font defines any kerning pairs. Fonts without a kerning table never
+    /// pay for kerning lookups
+    bool has_kerning();
+
+    /// @brief Gets the hash of the font file's contents
+    inline uint32_t font_hash() const
     {
-        return &glyphs_[0];
+        return font_hash_;
     }
 
-    Glyph* end()
+    /// @brief Gets the atlas generation, which changes whenever previously returned glyphs may
+    /// no longer be valid. See GlyphCache::generation
+    inline uint64_t atlas_generation() const
     {
-        return &(*glyphs_.end());
+        return glyph_cache_.generation();
+    }
+
+    /// @brief Gets the fraction of the atlas covered by glyph bitmaps
+    inline float atlas_occupancy() const
+    {
+        return glyph_cache_.occupancy();
     }
 private:
     std::unique_ptr<FontService> service;
-    std::vector<Glyph> glyphs_;
+    GlyphCache glyph_cache_;
+    GlyphRenderMode render_mode_{GlyphRenderMode::bitmap};
+    std::vector<uint8_t> raster_storage_;
+
+    // Kerning in font units keyed by `(left << 32) | right`. Every non-zero pair between the
+    // sorted `kerning_codepoints_` has been extracted, other pairs are cached as they're used
+    HashMap<uint64_t, int16_t> kerning_;
+    std::vector<uint32_t> kerning_codepoints_;
+    uint32_t units_per_em_{0};
+    bool kerning_known_{false};
+    bool has_kerning_{false};
 
-    uint32_t width_{0};
-    uint32_t height_{0};
     uint32_t size_{0};
+    uint32_t face_size_{0};
+    uint32_t font_hash_{0};
 
     void init_library();
-    void reset_glyphs();
+    bool load_face();
+    const Glyph* rasterize_glyph(uint32_t codepoint, uint32_t pixel_size);
+    void extract_kerning(const uint32_t* codepoints, uint32_t count);
 };
 
-
 } // namespace sky
\ No newline at end of file
@@ -0,0 +1,274 @@
+//
+//  GlyphCache.cpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#include "Skyrocket/Resource/GlyphCache.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace sky {
+
+
+constexpr uint32_t GlyphCache::invalid_entry;
+constexpr uint32_t GlyphCache::padding;
+
+uint64_t GlyphCache::make_key(const uint32_t codepoint, const uint32_t pixel_size)
+{
+    return (static_cast<uint64_t>(pixel_size) << 32) | codepoint;
+}
+
+void GlyphCache::reset(const uint32_t width, const uint32_t height)
+{
+    packer_.reset(width, height, RectanglePacker::Heuristic::maxrects_best_short_side, padding);
+    atlas_.assign(static_cast<size_t>(width) * height, 0);
+    glyphs_.clear();
+    placements_.clear();
+    entries_.clear();
+    free_entries_.clear();
+    lookup_.clear();
+
+    head_ = invalid_entry;
+    tail_ = invalid_entry;
+    evictions_ = 0;
+    ++generation_;
+    dirty_top_ = UINT32_MAX;
+    dirty_bottom_ = 0;
+}
+
+const Glyph* GlyphCache::find(const uint32_t codepoint, const uint32_t pixel_size)
+{
+    auto found = lookup_.find(make_key(codepoint, pixel_size));
+    if ( found == nullptr ) {
+        return nullptr;
+    }
+
+    auto entry = *found;
+    if ( entry != head_ ) {
+        unlink(entry);
+        link_front(entry);
+    }
+
+    entries_[entry].flush_index = flush_index_;
+    return &glyphs_[entry];
+}
+
+const Glyph* GlyphCache::insert(const uint32_t codepoint, const uint32_t pixel_size,
+                                const GlyphBitmap& bitmap)
+{
+    auto glyph = find(codepoint, pixel_size);
+    if ( glyph != nullptr ) {
+        return glyph;
+    }
+
+    glyph = reserve(codepoint, pixel_size, bitmap);
+    if ( glyph != nullptr ) {
+        write_bitmap(placement(*glyph).bounds, bitmap);
+    }
+    return glyph;
+}
+
+const Glyph* GlyphCache::reserve(const uint32_t codepoint, const uint32_t pixel_size,
+                                 const GlyphBitmap& bitmap)
+{
+    auto key = make_key(codepoint, pixel_size);
+    if ( lookup_.find(key) != nullptr ) {
+        return find(codepoint, pixel_size);
+    }
+
+    if ( bitmap.width + padding > packer_.width() || bitmap.height + padding > packer_.height() ) {
+        return nullptr;
+    }
+
+    UIntRect bounds;
+    while ( !packer_.insert(bitmap.width, bitmap.height, &bounds) ) {
+        if ( !evict_least_recent() ) {
+            return nullptr;
+        }
+    }
+
+    if ( bitmap.height > 0 ) {
+        dirty_top_ = std::min(dirty_top_, bounds.position.y);
+        dirty_bottom_ = std::max(dirty_bottom_, bounds.bottom());
+    }
+
+    uint32_t entry = 0;
+    if ( !free_entries_.empty() ) {
+        entry = free_entries_.back();
+        free_entries_.pop_back();
+    } else {
+        entry = static_cast<uint32_t>(entries_.size());
+        glyphs_.emplace_back();
+        placements_.emplace_back();
+        entries_.emplace_back();
+    }
+
+    auto inv_width = 1.0f / static_cast<float>(packer_.width());
+    auto inv_height = 1.0f / static_cast<float>(packer_.height());
+
+    auto& glyph = glyphs_[entry];
+    glyph.s = bounds.position.x * inv_width;
+    glyph.t = bounds.position.y * inv_height;
+    glyph.s2 = bounds.right() * inv_width;
+    glyph.t2 = bounds.bottom() * inv_height;
+    glyph.codepoint = codepoint;
+    glyph.width = static_cast<uint16_t>(bounds.width);
+    glyph.height = static_cast<uint16_t>(bounds.height);
+    glyph.bearing_x = static_cast<int16_t>(bitmap.bearing.x);
+    glyph.bearing_y = static_cast<int16_t>(bitmap.bearing.y);
+    glyph.advance_x = static_cast<int16_t>(bitmap.advance.x);
+    glyph.advance_y = static_cast<int16_t>(bitmap.advance.y);
+
+    placements_[entry].bounds = bounds;
+    placements_[entry].pixel_size = pixel_size;
+
+    entries_[entry].key = key;
+    entries_[entry].flush_index = flush_index_;
+    link_front(entry);
+    lookup_.insert(key, entry);
+
+    return &glyph;
+}
+
+void GlyphCache::write_bitmap(const UIntRect& bounds, const GlyphBitmap& bitmap)
+{
+    auto atlas_width = packer_.width();
+    auto src_pitch = static_cast<size_t>(bitmap.pitch >= 0 ? bitmap.pitch : -bitmap.pitch);
+    auto width = std::min(bounds.width, bitmap.width);
+    auto height = std::min(bounds.height, bitmap.height);
+
+    for ( uint32_t row = 0; row < height; ++row ) {
+        auto src_row = bitmap.pitch >= 0 ? row : bitmap.height - 1 - row;
+        memcpy(&atlas_[(bounds.position.y + row) * atlas_width + bounds.position.x],
+               bitmap.pixels + src_row * src_pitch, width);
+    }
+}
+
+bool GlyphCache::restore(const uint32_t width, const uint32_t height, const uint8_t* atlas,
+                         const Glyph* glyphs, const GlyphPlacement* placements,
+                         const uint32_t count)
+{
+    reset(width, height);
+    memcpy(atlas_.data(), atlas, atlas_.size());
+
+    glyphs_.assign(glyphs, glyphs + count);
+    placements_.assign(placements, placements + count);
+    entries_.resize(count);
+    lookup_.reserve(count);
+
+    for ( uint32_t i = 0; i < count; ++i ) {
+        const auto& bounds = placements[i].bounds;
+        if ( bounds.right() > width || bounds.bottom() > height ) {
+            reset(width, height);
+            return false;
+        }
+
+        packer_.occupy(bounds);
+
+        entries_[i].key = make_key(glyphs[i].codepoint, placements[i].pixel_size);
+        entries_[i].flush_index = 0;
+        link_front(i);
+        lookup_.insert(entries_[i].key, i);
+    }
+
+    dirty_top_ = 0;
+    dirty_bottom_ = height;
+    return true;
+}
+
+bool GlyphCache::flush_dirty_region(UIntRect* region)
+{
+    ++flush_index_;
+
+    if ( dirty_top_ >= dirty_bottom_ ) {
+        return false;
+    }
+
+    *region = UIntRect(0, dirty_top_, packer_.width(), dirty_bottom_ - dirty_top_);
+    dirty_top_ = UINT32_MAX;
+    dirty_bottom_ = 0;
+    return true;
+}
+
+void GlyphCache::unlink(const uint32_t entry)
+{
+    auto& e = entries_[entry];
+
+    if ( e.prev != invalid_entry ) {
+        entries_[e.prev].next = e.next;
+    } else {
+        head_ = e.next;
+    }
+
+    if ( e.next != invalid_entry ) {
+        entries_[e.next].prev = e.prev;
+    } else {
+        tail_ = e.prev;
+    }
+
+    e.prev = invalid_entry;
+    e.next = invalid_entry;
+}
+
+void GlyphCache::link_front(const uint32_t entry)
+{
+    auto& e = entries_[entry];
+    e.prev = invalid_entry;
+    e.next = head_;
+
+    if ( head_ != invalid_entry ) {
+        entries_[head_].prev = entry;
+    }
+
+    head_ = entry;
+
+    if ( tail_ == invalid_entry ) {
+        tail_ = entry;
+    }
+}
+
+bool GlyphCache::evict_least_recent()
+{
+    // Entries are ordered by use so if the least recent glyph is still in use they all are
+    if ( tail_ == invalid_entry || entries_[tail_].flush_index == flush_index_ ) {
+        return false;
+    }
+
+    auto entry = tail_;
+    unlink(entry);
+
+    // Clear the evicted texels so they don't bleed into the padding of glyphs packed over them
+    const auto& bounds = placements_[entry].bounds;
+    auto atlas_width = packer_.width();
+    auto right = std::min(bounds.right() + padding, atlas_width);
+    auto bottom = std::min(bounds.bottom() + padding, packer_.height());
+    if ( bounds.position.x < right && bounds.position.y < bottom ) {
+        for ( auto row = bounds.position.y; row < bottom; ++row ) {
+            memset(&atlas_[row * atlas_width + bounds.position.x], 0, right - bounds.position.x);
+        }
+        dirty_top_ = std::min(dirty_top_, bounds.position.y);
+        dirty_bottom_ = std::max(dirty_bottom_, bottom);
+    }
+
+    packer_.remove(bounds);
+    lookup_.erase(entries_[entry].key);
+    free_entries_.push_back(entry);
+
+    // Once the last glyph is gone the whole atlas is free again, however it was carved up
+    if ( lookup_.size() == 0 ) {
+        packer_.clear();
+    }
+    ++evictions_;
+    ++generation_;
+    return true;
+}
+
+
+} // namespace sky
@@ -0,0 +1,196 @@
+//
+//  GlyphCache.hpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#pragma once
+
+#include "Skyrocket/Core/Containers/HashMap.hpp"
+#include "Skyrocket/Core/Geometry/RectanglePacker.hpp"
+#include "Skyrocket/Core/Math/Vector2.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace sky {
+
+
+/// @brief The metrics read when laying out and drawing a cached glyph. Anything only needed to
+/// manage the atlas is kept separately in a GlyphPlacement so two glyphs fit in a cache line
+struct Glyph {
+    /// Normalized texture coordinates of the glyphs bitmap in the atlas
+    float s{0.0f}, t{0.0f}, s2{0.0f}, t2{0.0f};
+    uint32_t codepoint{0};
+    /// Size of the glyphs bitmap in atlas texels
+    uint16_t width{0}, height{0};
+    int16_t bearing_x{0}, bearing_y{0};
+    int16_t advance_x{0}, advance_y{0};
+};
+
+static_assert(sizeof(Glyph) == 32, "Glyphs should be exactly half a cache line");
+
+/// @brief Where a cached glyph is stored in the atlas
+struct GlyphPlacement {
+    UIntRect bounds;
+    uint32_t pixel_size{0};
+};
+
+/// @brief A rasterised 8-bit coverage bitmap and its metrics to add to a GlyphCache. `pitch` is
+/// the byte offset from one row to the next and may be negative for bottom-up bitmaps, in which
+/// case `pixels` points to the first byte in memory, i.e. the bottom row
+struct GlyphBitmap {
+    uint32_t width{0};
+    uint32_t height{0};
+    int32_t pitch{0};
+    const uint8_t* pixels{nullptr};
+    Vector2<int32_t> bearing;
+    Vector2<int32_t> advance;
+};
+
+/// @brief Caches glyphs keyed by codepoint and pixel size in a single 8-bit atlas shared between
+/// all sizes. Glyphs are added as they're first used and the least recently used glyphs are
+/// evicted when the atlas runs out of space.
+///
+/// Glyphs looked up or inserted since the last call to `flush_dirty_region` are in use by text
+/// waiting to be drawn and are never evicted, so the atlas must be large enough to hold all the
+/// glyphs used between two flushes
+class GlyphCache {
+public:
+    GlyphCache() = default;
+
+    /// @brief Removes all glyphs and resizes the atlas to `width` by `height` texels
+    void reset(uint32_t width, uint32_t height);
+
+    /// @brief Finds a cached glyph, marking it as the most recently used. The glyph is only valid
+    /// until the next insertion or restore.
+    /// @return nullptr if the glyph hasn't been added to the cache
+    const Glyph* find(uint32_t codepoint, uint32_t pixel_size);
+
+    /// @brief Copies a glyphs bitmap into the atlas, evicting least recently used glyphs if
+    /// there's not enough space left.
+    /// @return nullptr if the bitmap is too large for the atlas or every glyph is in use
+    const Glyph* insert(uint32_t codepoint, uint32_t pixel_size, const GlyphBitmap& bitmap);
+
+    /// @brief Adds a glyph and reserves space for its bitmap in the atlas without copying any
+    /// pixels, which are written later with `write_bitmap`. Only `bitmap`s size and metrics are
+    /// used. Fails under the same conditions as `insert`
+    const Glyph* reserve(uint32_t codepoint, uint32_t pixel_size, const GlyphBitmap& bitmap);
+
+    /// @brief Copies a bitmap into space reserved in the atlas. Bitmaps can be written from
+    /// multiple threads at once as long as no other cache functions are called in the meantime
+    void write_bitmap(const UIntRect& bounds, const GlyphBitmap& bitmap);
+
+    /// @brief Replaces the cache with a previously baked atlas and its glyphs and placements,
+    /// ordered from least to most recently used. The whole atlas is marked as dirty.
+    /// @return false if any glyph lies outside the atlas, leaving the cache empty
+    bool restore(uint32_t width, uint32_t height, const uint8_t* atlas, const Glyph* glyphs,
+                 const GlyphPlacement* placements, uint32_t count);
+
+    /// @brief Gets where a glyph returned by the cache is stored in the atlas
+    inline const GlyphPlacement& placement(const Glyph& glyph) const
+    {
+        return placements_[&glyph - glyphs_.data()];
+    }
+
+    /// @brief Calls `fn(const Glyph&, const GlyphPlacement&)` for every cached glyph from least
+    /// to most recently used
+    template <typename Fn>
+    void for_each_glyph(Fn&& fn) const
+    {
+        for ( auto entry = tail_; entry != invalid_entry; entry = entries_[entry].prev ) {
+            fn(glyphs_[entry], placements_[entry]);
+        }
+    }
+
+    /// @brief Gets the rows of the atlas changed since the last flush as a full-width region.
+    /// The region's texels start at `atlas_data() + region.position.y * atlas_width()`.
+    /// @return false if nothing has changed
+    bool flush_dirty_region(UIntRect* region);
+
+    inline const uint8_t* atlas_data() const
+    {
+        return atlas_.data();
+    }
+
+    inline uint32_t atlas_width() const
+    {
+        return packer_.width();
+    }
+
+    inline uint32_t atlas_height() const
+    {
+        return packer_.height();
+    }
+
+    inline float occupancy() const
+    {
+        return packer_.occupancy();
+    }
+
+    inline uint32_t size() const
+    {
+        return static_cast<uint32_t>(lookup_.size());
+    }
+
+    inline uint64_t evictions() const
+    {
+        return evictions_;
+    }
+
+    /// @brief Gets a counter that changes whenever glyphs already handed out may have moved or
+    /// been removed from the atlas, i.e. after an eviction, reset or restore. Text laid out at an
+    /// older generation needs to look its glyphs up again
+    inline uint64_t generation() const
+    {
+        return generation_;
+    }
+
+private:
+    static constexpr uint32_t invalid_entry = UINT32_MAX;
+    /// Empty texels between glyphs so linear filtering doesn't sample neighbouring glyphs
+    static constexpr uint32_t padding = 1;
+
+    /// Glyphs are stored in an intrusive doubly-linked list ordered from most to least recently
+    /// used so lookups, insertions and evictions are all constant time
+    struct Entry {
+        uint64_t key{0};
+        uint64_t flush_index{0};
+        uint32_t prev{invalid_entry};
+        uint32_t next{invalid_entry};
+    };
+
+    RectanglePacker packer_;
+    std::vector<uint8_t> atlas_;
+
+    // Glyphs, their placements and LRU entries are parallel arrays indexed by entry so layout
+    // only touches the glyphs themselves
+    std::vector<Glyph> glyphs_;
+    std::vector<GlyphPlacement> placements_;
+    std::vector<Entry> entries_;
+    std::vector<uint32_t> free_entries_;
+    HashMap<uint64_t, uint32_t> lookup_;
+
+    uint32_t head_{invalid_entry};
+    uint32_t tail_{invalid_entry};
+    uint64_t flush_index_{1};
+    uint64_t evictions_{0};
+    uint64_t generation_{0};
+
+    uint32_t dirty_top_{UINT32_MAX};
+    uint32_t dirty_bottom_{0};
+
+    static uint64_t make_key(uint32_t codepoint, uint32_t pixel_size);
+
+    void unlink(uint32_t entry);
+    void link_front(uint32_t entry);
+    bool evict_least_recent();
+};
+
+
+} // namespace sky
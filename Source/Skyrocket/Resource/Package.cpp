@@ -0,0 +1,410 @@
+//
+//  Package.cpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#include "Skyrocket/Resource/Package.hpp"
+#include "Skyrocket/Core/Compression.hpp"
+#include "Skyrocket/Core/Diagnostics/Error.hpp"
+#include "Skyrocket/Core/Hash.hpp"
+#include "Skyrocket/Graphics/Image.hpp"
+#include "Skyrocket/Graphics/Mipmap.hpp"
+#include "Skyrocket/Graphics/PixelConversion.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace sky {
+
+
+constexpr uint32_t Package::magic;
+constexpr uint32_t Package::version;
+constexpr uint32_t Package::name_seed;
+
+static constexpr size_t package_alignment = 16;
+static constexpr size_t package_image_alignment = 64;
+
+/// The payload is an lz frame that decompresses to `uncompressed_size` bytes
+static constexpr uint32_t package_entry_compressed = 1u << 0;
+
+struct PackageHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entry_count;
+    uint32_t names_size;
+    uint64_t entries_offset;
+    uint64_t names_offset;
+    uint64_t file_size;
+};
+
+struct PackageEntry {
+    uint32_t hash;
+    uint32_t name_offset;
+    uint32_t name_length;
+    uint32_t type;
+    uint64_t offset;
+    uint64_t size;
+    uint64_t uncompressed_size;
+    uint32_t flags;
+    uint32_t reserved;
+    PackageImageInfo image;
+};
+
+static_assert(sizeof(PackageEntry) == 64, "Package entries must be tightly packed");
+
+static size_t align_package_offset(const size_t offset, const size_t alignment)
+{
+    return (offset + alignment - 1) & ~(alignment - 1);
+}
+
+static uint32_t hash_name(const char* name, const size_t length)
+{
+    return hash::murmur3_32(name, static_cast<uint32_t>(length), Package::name_seed);
+}
+
+/// Checks an image entry describes a mip chain that fits in its payload so its levels can be
+/// addressed without bounds checks
+static bool image_entry_valid(const PackageEntry& entry)
+{
+    const auto& image = entry.image;
+    if ( image.pixel_format >= static_cast<uint32_t>(PixelFormat::Enum::unknown)
+        || image.mip_levels == 0
+        || image.mip_levels > mip_level_count(image.width, image.height) ) {
+        return false;
+    }
+
+    auto format = static_cast<PixelFormat::Enum>(image.pixel_format);
+    auto payload_size = (entry.flags & package_entry_compressed) != 0 ? entry.uncompressed_size
+                                                                       : entry.size;
+    return mip_chain_size(image.width, image.height, format, image.mip_levels) <= payload_size;
+}
+
+//==========================================
+//  PackageAsset
+//==========================================
+
+const uint8_t* PackageAsset::image_level(const uint32_t level) const
+{
+    if ( type != AssetType::image || compressed || level >= image.mip_levels ) {
+        return nullptr;
+    }
+
+    auto format = static_cast<PixelFormat::Enum>(image.pixel_format);
+    return data + mip_chain_size(image.width, image.height, format, level);
+}
+
+//==========================================
+//  Package
+//==========================================
+
+Package::Package(const Path& path)
+{
+    open(path);
+}
+
+bool Package::open(const Path& path)
+{
+    close();
+
+    if ( !file_.open(path, MapAccess::random) ) {
+        return false;
+    }
+
+    auto fail = [&](const char* reason) {
+        SKY_ERROR("Package", "Unable to open package '%s': %s", path.str(), reason);
+        close();
+        return false;
+    };
+
+    if ( file_.size() < sizeof(PackageHeader) ) {
+        return fail("file is too small");
+    }
+
+    const auto& header = *reinterpret_cast<const PackageHeader*>(file_.data());
+    if ( header.magic != magic || header.version != version ) {
+        return fail("not a package or an unsupported version");
+    }
+
+    auto entries_end = header.entries_offset + static_cast<uint64_t>(header.entry_count)
+        * sizeof(PackageEntry);
+    if ( header.file_size != file_.size() || entries_end > file_.size()
+        || header.names_offset + header.names_size > file_.size()
+        || header.entries_offset % alignof(PackageEntry) != 0 ) {
+        return fail("file is truncated");
+    }
+
+    // Validating every entry up front means lookups never need to bounds check
+    auto entries = reinterpret_cast<const PackageEntry*>(file_.data() + header.entries_offset);
+    for ( uint32_t i = 0; i < header.entry_count; ++i ) {
+        const auto& entry = entries[i];
+        if ( entry.offset + entry.size > file_.size() || entry.offset + entry.size < entry.offset
+            || static_cast<uint64_t>(entry.name_offset) + entry.name_length >= header.names_size ) {
+            return fail("table of contents is corrupt");
+        }
+
+        auto is_image = entry.type == static_cast<uint32_t>(AssetType::image);
+        if ( is_image && !image_entry_valid(entry) ) {
+            return fail("image header is corrupt");
+        }
+
+        if ( i > 0 && entries[i - 1].hash > entry.hash ) {
+            return fail("table of contents isn't sorted");
+        }
+    }
+
+    entries_ = entries;
+    names_ = reinterpret_cast<const char*>(file_.data() + header.names_offset);
+    entry_count_ = header.entry_count;
+    return true;
+}
+
+void Package::close()
+{
+    file_.close();
+    entries_ = nullptr;
+    names_ = nullptr;
+    entry_count_ = 0;
+}
+
+const PackageEntry* Package::find_entry(const char* name) const
+{
+    if ( entry_count_ == 0 ) {
+        return nullptr;
+    }
+
+    auto length = strlen(name);
+    auto hash = hash_name(name, length);
+    auto end = entries_ + entry_count_;
+    auto entry = std::lower_bound(entries_, end, hash,
+                                  [](const PackageEntry& e, const uint32_t h) {
+                                      return e.hash < h;
+                                  });
+
+    for ( ; entry != end && entry->hash == hash; ++entry ) {
+        if ( entry->name_length == length
+            && memcmp(names_ + entry->name_offset, name, length) == 0 ) {
+            return entry;
+        }
+    }
+
+    return nullptr;
+}
+
+bool Package::find(const char* name, PackageAsset* asset) const
+{
+    auto entry = find_entry(name);
+    if ( entry == nullptr ) {
+        return false;
+    }
+
+    asset->type = static_cast<AssetType>(entry->type);
+    asset->data = file_.data() + entry->offset;
+    asset->size = static_cast<size_t>(entry->size);
+    asset->compressed = (entry->flags & package_entry_compressed) != 0;
+    asset->uncompressed_size = static_cast<size_t>(entry->uncompressed_size);
+    asset->image = entry->image;
+    return true;
+}
+
+bool Package::read(const PackageAsset& asset, void* dest)
+{
+    if ( !asset.compressed ) {
+        if ( asset.size > 0 ) {
+            memcpy(dest, asset.data, asset.size);
+        }
+        return true;
+    }
+
+    return lz::decompress_frame(asset.data, asset.size, static_cast<uint8_t*>(dest),
+                                asset.uncompressed_size);
+}
+
+bool Package::contains(const char* name) const
+{
+    return find_entry(name) != nullptr;
+}
+
+//==========================================
+//  PackageWriter
+//==========================================
+
+PackageWriter::Asset* PackageWriter::create_asset(const char* name, const AssetType type)
+{
+    auto length = strlen(name);
+    auto hash = hash_name(name, length);
+
+    for ( auto& asset : assets_ ) {
+        if ( asset.hash == hash && asset.name == name ) {
+            SKY_ERROR("Package", "An asset named '%s' has already been added", name);
+            return nullptr;
+        }
+    }
+
+    assets_.emplace_back();
+    auto& asset = assets_.back();
+    asset.name.assign(name, length);
+    asset.hash = hash;
+    asset.type = type;
+    asset.image = PackageImageInfo{};
+    asset.compressed = false;
+    asset.uncompressed_size = 0;
+    return &asset;
+}
+
+void PackageWriter::store(Asset* asset, const uint8_t* data, const size_t size,
+                          const bool compress)
+{
+    asset->uncompressed_size = size;
+
+    if ( compress && size > 0 ) {
+        asset->data.resize(lz::frame_bound(size));
+        auto frame_size = lz::compress_frame(data, size, asset->data.data(), asset->data.size());
+
+        if ( frame_size > 0 && frame_size < size ) {
+            asset->data.resize(frame_size);
+            asset->compressed = true;
+            return;
+        }
+    }
+
+    asset->data.assign(data, data + size);
+}
+
+bool PackageWriter::add(const char* name, const AssetType type, const void* data,
+                        const size_t size, const bool compress)
+{
+    auto asset = create_asset(name, type);
+    if ( asset == nullptr ) {
+        return false;
+    }
+
+    store(asset, static_cast<const uint8_t*>(data), size, compress);
+    return true;
+}
+
+bool PackageWriter::add_image(const char* name, const Image& image, const bool compress)
+{
+    if ( image.data == nullptr ) {
+        SKY_ERROR("Package", "Image '%s' has no pixels to add", name);
+        return false;
+    }
+
+    auto format = image.pixel_format;
+    if ( format == PixelFormat::Enum::rgb8 ) {
+        format = PixelFormat::Enum::rgba8;
+    }
+
+    auto asset = create_asset(name, AssetType::image);
+    if ( asset == nullptr ) {
+        return false;
+    }
+
+    asset->image.width = image.width;
+    asset->image.height = image.height;
+    asset->image.pixel_format = static_cast<uint32_t>(format);
+    asset->image.mip_levels = image.mip_levels;
+
+    std::vector<uint8_t> pixels(mip_chain_size(image.width, image.height, format,
+                                               image.mip_levels));
+    auto dest = pixels.data();
+    for ( uint32_t level = 0; level < image.mip_levels; ++level ) {
+        auto count = static_cast<size_t>(image.level_width(level)) * image.level_height(level);
+        auto level_size = PixelFormat::image_size(format, image.level_width(level),
+                                                  image.level_height(level));
+
+        if ( format != image.pixel_format ) {
+            convert_pixels(image.level_data(level), image.pixel_format, dest, format, count);
+        } else {
+            memcpy(dest, image.level_data(level), level_size);
+        }
+
+        dest += level_size;
+    }
+
+    if ( compress ) {
+        store(asset, pixels.data(), pixels.size(), true);
+    } else {
+        asset->uncompressed_size = pixels.size();
+        asset->data = std::move(pixels);
+    }
+
+    return true;
+}
+
+bool PackageWriter::save(const Path& path) const
+{
+    // Entries are sorted by hash so lookups can binary search the mapped table of contents
+    std::vector<const Asset*> sorted(assets_.size());
+    for ( size_t i = 0; i < assets_.size(); ++i ) {
+        sorted[i] = &assets_[i];
+    }
+
+    std::sort(sorted.begin(), sorted.end(), [](const Asset* lhs, const Asset* rhs) {
+        return lhs->hash < rhs->hash || (lhs->hash == rhs->hash && lhs->name < rhs->name);
+    });
+
+    PackageHeader header{};
+    header.magic = Package::magic;
+    header.version = Package::version;
+    header.entry_count = static_cast<uint32_t>(sorted.size());
+    header.entries_offset = align_package_offset(sizeof(PackageHeader), package_alignment);
+    header.names_offset = header.entries_offset + sorted.size() * sizeof(PackageEntry);
+
+    std::vector<PackageEntry> entries(sorted.size());
+    std::string names;
+
+    for ( size_t i = 0; i < sorted.size(); ++i ) {
+        entries[i].hash = sorted[i]->hash;
+        entries[i].name_offset = static_cast<uint32_t>(names.size());
+        entries[i].name_length = static_cast<uint32_t>(sorted[i]->name.size());
+        entries[i].type = static_cast<uint32_t>(sorted[i]->type);
+        entries[i].size = sorted[i]->data.size();
+        entries[i].uncompressed_size = sorted[i]->uncompressed_size;
+        entries[i].flags = sorted[i]->compressed ? package_entry_compressed : 0u;
+        entries[i].image = sorted[i]->image;
+
+        names.append(sorted[i]->name);
+        names.push_back('\0');
+    }
+
+    header.names_size = static_cast<uint32_t>(names.size());
+
+    auto offset = static_cast<size_t>(header.names_offset + names.size());
+    for ( size_t i = 0; i < sorted.size(); ++i ) {
+        auto alignment = sorted[i]->type == AssetType::image ? package_image_alignment
+                                                             : package_alignment;
+        offset = align_package_offset(offset, alignment);
+        entries[i].offset = offset;
+        offset += sorted[i]->data.size();
+    }
+
+    header.file_size = offset;
+
+    std::vector<uint8_t> contents(offset, 0);
+    memcpy(contents.data(), &header, sizeof(PackageHeader));
+
+    if ( !entries.empty() ) {
+        memcpy(contents.data() + header.entries_offset, entries.data(),
+               entries.size() * sizeof(PackageEntry));
+    }
+
+    memcpy(contents.data() + header.names_offset, names.data(), names.size());
+
+    for ( size_t i = 0; i < sorted.size(); ++i ) {
+        if ( !sorted[i]->data.empty() ) {
+            memcpy(contents.data() + entries[i].offset, sorted[i]->data.data(),
+                   sorted[i]->data.size());
+        }
+    }
+
+    return fs::write_file(path, contents.data(), contents.size());
+}
+
+
+} // namespace sky
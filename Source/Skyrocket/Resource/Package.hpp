@@ -0,0 +1,155 @@
+//
+//  Package.hpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#pragma once
+
+#include "Skyrocket/Graphics/Renderer/Definitions.hpp"
+#include "Skyrocket/Platform/Filesystem.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sky {
+
+
+struct Image;
+struct PackageEntry;
+
+enum class AssetType : uint32_t {
+    raw,
+    image,
+    shader,
+    font
+};
+
+/// @brief Layout of an image asset's pixels. Levels are stored tightly packed one after another
+/// from the largest down
+struct PackageImageInfo {
+    uint32_t width;
+    uint32_t height;
+    uint32_t pixel_format;
+    uint32_t mip_levels;
+};
+
+/// @brief View of an asset's payload inside a mapped package. The data is only valid for as long
+/// as the package stays open
+struct PackageAsset {
+    AssetType type{AssetType::raw};
+    const uint8_t* data{nullptr};
+    size_t size{0};
+
+    /// Compressed assets must be decompressed with `Package::read` before they can be used
+    bool compressed{false};
+    size_t uncompressed_size{0};
+
+    /// Only valid for image assets
+    PackageImageInfo image{};
+
+    /// @brief Gets the pixels of an uncompressed image asset's mip level, where level 0 is the
+    /// full image
+    const uint8_t* image_level(uint32_t level) const;
+};
+
+/// @brief Read-only archive of baked assets, i.e. a `.skypak`. The whole package is memory
+/// mapped when it's opened so finding an asset is a hash lookup in the table of contents and
+/// its payload is read in place, already in a layout that can be uploaded directly.
+///
+/// Packages are laid out as a header, the table of contents sorted by murmur3 hash of each
+/// asset's name, the names and then the payloads. Payloads are aligned to 16 bytes and images to
+/// 64 bytes. Assets can optionally be stored as lz frames, trading a little CPU for less I/O
+class Package {
+public:
+    static constexpr uint32_t magic = 0x4b504b53; // 'SKPK'
+    static constexpr uint32_t version = 3;
+    static constexpr uint32_t name_seed = 0x736b7970;
+
+    Package() = default;
+
+    explicit Package(const Path& path);
+
+    /// @brief Maps the package at `path`, closing any previously opened package
+    /// @return false if the file couldn't be mapped or isn't a valid package
+    bool open(const Path& path);
+
+    void close();
+
+    /// @brief Finds an asset by the name it was added to the package with
+    /// @return false if the package doesn't contain the asset
+    bool find(const char* name, PackageAsset* asset) const;
+
+    bool contains(const char* name) const;
+
+    /// @brief Copies an asset's payload to `dest`, which must hold `asset.uncompressed_size`
+    /// bytes, decompressing it if needed on the job workers.
+    /// @return false if the compressed data is corrupt
+    static bool read(const PackageAsset& asset, void* dest);
+
+    inline bool is_open() const
+    {
+        return file_.is_open();
+    }
+
+    inline uint32_t size() const
+    {
+        return entry_count_;
+    }
+
+private:
+    MappedFile file_;
+    const PackageEntry* entries_{nullptr};
+    const char* names_{nullptr};
+    uint32_t entry_count_{0};
+
+    const PackageEntry* find_entry(const char* name) const;
+};
+
+/// @brief Builds a package from assets in memory and writes it to disk. Asset data is copied when
+/// added so the source can be freed straight away
+class PackageWriter {
+public:
+    /// @brief Adds an asset's raw bytes, i.e. shader source or a font file. If `compress` is set
+    /// the asset is stored compressed unless it doesn't get any smaller
+    /// @return false if an asset with the same name has already been added
+    bool add(const char* name, AssetType type, const void* data, size_t size,
+             bool compress = false);
+
+    /// @brief Adds a loaded image and any mips it has. rgb8 images are expanded to rgba8 so every
+    /// image can be uploaded without conversion
+    bool add_image(const char* name, const Image& image, bool compress = false);
+
+    /// @brief Writes all added assets to a package at `path`
+    bool save(const Path& path) const;
+
+    inline size_t size() const
+    {
+        return assets_.size();
+    }
+
+private:
+    struct Asset {
+        std::string name;
+        uint32_t hash;
+        AssetType type;
+        PackageImageInfo image;
+        bool compressed;
+        size_t uncompressed_size;
+        std::vector<uint8_t> data;
+    };
+
+    std::vector<Asset> assets_;
+
+    Asset* create_asset(const char* name, AssetType type);
+    void store(Asset* asset, const uint8_t* data, size_t size, bool compress);
+};
+
+
+} // namespace sky
@@ -0,0 +1,301 @@
+//
+//  ResourceManager.cpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#include "Skyrocket/Resource/ResourceManager.hpp"
+#include "Skyrocket/Core/Diagnostics/Error.hpp"
+#include "Skyrocket/Core/Hash.hpp"
+
+#include <cinttypes>
+
+namespace sky {
+
+
+constexpr uint32_t ResourceManager::invalid_id;
+constexpr uint32_t ResourceManager::invalid_type;
+constexpr uint32_t ResourceManager::max_types;
+constexpr uint32_t ResourceManager::default_capacity;
+constexpr uint32_t ResourceManager::invalid_index;
+
+ResourceManager::ResourceManager(const uint32_t capacity)
+{
+    capacity_ = capacity < index_mask_ ? capacity : index_mask_ - 1;
+    slots_.reset(new Slot[capacity_]);
+
+    // At least twice as many buckets as slots keeps the chains short
+    uint32_t bucket_count = 1;
+    while ( bucket_count < capacity_ * 2 ) {
+        bucket_count <<= 1;
+    }
+    buckets_.assign(bucket_count, invalid_index);
+
+    free_list_.reserve(capacity_);
+    for ( uint32_t i = capacity_; i > 0; --i ) {
+        free_list_.push_back(i - 1);
+    }
+}
+
+ResourceManager::~ResourceManager()
+{
+    clear();
+}
+
+uint32_t ResourceManager::register_type(const ResourceLoader& loader)
+{
+    if ( type_count_ >= max_types ) {
+        SKY_ERROR("ResourceManager", "Unable to register more than %" PRIu32 " resource types",
+                  max_types);
+        return invalid_type;
+    }
+
+    SKY_ASSERT(loader.load != nullptr && loader.unload != nullptr,
+               "Resource loaders have both a load and unload function");
+
+    loaders_[type_count_] = loader;
+    return type_count_++;
+}
+
+uint32_t ResourceManager::find(const uint32_t type, const uint32_t hash, const Path& path) const
+{
+    auto index = buckets_[hash & (buckets_.size() - 1)];
+    while ( index != invalid_index ) {
+        const auto& slot = slots_[index];
+        if ( slot.hash == hash && slot.type == type && slot.path == path.str() ) {
+            return index;
+        }
+        index = slot.next;
+    }
+
+    return invalid_index;
+}
+
+uint32_t ResourceManager::load(const uint32_t type, const Path& path)
+{
+    if ( type >= type_count_ ) {
+        SKY_ERROR("ResourceManager", "Loading '%s' with an unregistered type", path.str());
+        return invalid_id;
+    }
+
+    // Seeding with the type keeps the same file loaded as different types separate
+    auto hash = hash::murmur3_32(path.str(), path.size(), type);
+    auto index = find(type, hash, path);
+
+    if ( index != invalid_index ) {
+        auto& slot = slots_[index];
+        ++slot.refcount;
+
+        // Loading a resource that failed tries again, i.e. once the file has been fixed
+        if ( slot.state == ResourceState::failed ) {
+            slot.state = ResourceState::loading;
+            slot.load_complete.store(false, std::memory_order_relaxed);
+            loading_.push_back(index);
+            jobs_.run(load_job, &slot);
+        }
+
+        return make_id(index, slot.generation);
+    }
+
+    if ( free_list_.empty() ) {
+        SKY_ERROR("ResourceManager", "Unable to load '%s': capacity (%" PRIu32 ") reached",
+                  path.str(), capacity_);
+        return invalid_id;
+    }
+
+    index = free_list_.back();
+    free_list_.pop_back();
+
+    auto& bucket = buckets_[hash & (buckets_.size() - 1)];
+    auto& slot = slots_[index];
+    slot.state = ResourceState::loading;
+    slot.load_complete.store(false, std::memory_order_relaxed);
+    slot.refcount = 1;
+    slot.type = type;
+    slot.hash = hash;
+    slot.next = bucket;
+    slot.path = path.str();
+    slot.data = nullptr;
+    slot.loader = &loaders_[type];
+
+    bucket = index;
+    loading_.push_back(index);
+    ++count_;
+
+    jobs_.run(load_job, &slot);
+    return make_id(index, slot.generation);
+}
+
+void ResourceManager::load_job(void* user_data)
+{
+    auto slot = static_cast<Slot*>(user_data);
+    slot->data = slot->loader->load(Path(slot->path.c_str()), slot->loader->user_data);
+    slot->load_complete.store(true, std::memory_order_release);
+}
+
+void ResourceManager::release(const uint32_t id)
+{
+    auto slot = get_slot(id);
+    if ( slot == nullptr ) {
+        SKY_ERROR("ResourceManager", "Releasing an invalid resource id (%" PRIu32 ")", id);
+        return;
+    }
+
+    if ( slot->refcount == 0 || --slot->refcount > 0 ) {
+        return;
+    }
+
+    // Resources still loading are unloaded by `update` once their job completes
+    if ( slot->state == ResourceState::loading ) {
+        return;
+    }
+
+    if ( slot->state == ResourceState::loaded ) {
+        slot->loader->unload(slot->data, true, slot->loader->user_data);
+    }
+
+    free_slot(get_index(id));
+}
+
+void ResourceManager::update()
+{
+    uint32_t i = 0;
+    while ( i < loading_.size() ) {
+        auto index = loading_[i];
+        if ( !slots_[index].load_complete.load(std::memory_order_acquire) ) {
+            ++i;
+            continue;
+        }
+
+        loading_[i] = loading_.back();
+        loading_.pop_back();
+        finish_load(index);
+    }
+}
+
+void ResourceManager::finish_load(const uint32_t index)
+{
+    auto& slot = slots_[index];
+    auto loader = slot.loader;
+
+    if ( slot.refcount == 0 ) {
+        if ( slot.data != nullptr ) {
+            loader->unload(slot.data, false, loader->user_data);
+        }
+        free_slot(index);
+        return;
+    }
+
+    if ( slot.data == nullptr ) {
+        SKY_ERROR("ResourceManager", "Failed to load '%s'", slot.path.c_str());
+        slot.state = ResourceState::failed;
+        return;
+    }
+
+    if ( loader->finalize != nullptr && !loader->finalize(slot.data, loader->user_data) ) {
+        SKY_ERROR("ResourceManager", "Failed to finalize '%s'", slot.path.c_str());
+        loader->unload(slot.data, false, loader->user_data);
+        slot.data = nullptr;
+        slot.state = ResourceState::failed;
+        return;
+    }
+
+    slot.state = ResourceState::loaded;
+}
+
+void ResourceManager::wait_all()
+{
+    jobs_.wait();
+    update();
+}
+
+void ResourceManager::clear()
+{
+    jobs_.wait();
+
+    for ( uint32_t i = 0; i < capacity_; ++i ) {
+        auto& slot = slots_[i];
+        if ( slot.state == ResourceState::none ) {
+            continue;
+        }
+
+        if ( slot.data != nullptr ) {
+            slot.loader->unload(slot.data, slot.state == ResourceState::loaded,
+                                slot.loader->user_data);
+        }
+
+        free_slot(i);
+    }
+
+    loading_.clear();
+}
+
+void ResourceManager::free_slot(const uint32_t index)
+{
+    auto& slot = slots_[index];
+
+    // Unlink the slot from its bucket's chain
+    auto link = &buckets_[slot.hash & (buckets_.size() - 1)];
+    while ( *link != index ) {
+        link = &slots_[*link].next;
+    }
+    *link = slot.next;
+
+    slot.state = ResourceState::none;
+    slot.refcount = 0;
+    slot.next = invalid_index;
+    slot.path.clear();
+    slot.data = nullptr;
+    slot.generation = (slot.generation + 1) & (UINT32_MAX >> index_bits_);
+
+    free_list_.push_back(index);
+    --count_;
+}
+
+ResourceState ResourceManager::state(const uint32_t id) const
+{
+    auto slot = get_slot(id);
+    return slot != nullptr ? slot->state : ResourceState::none;
+}
+
+void* ResourceManager::get(const uint32_t id) const
+{
+    auto slot = get_slot(id);
+    if ( slot == nullptr ) {
+        return nullptr;
+    }
+
+    return slot->state == ResourceState::loaded ? slot->data : slot->loader->placeholder;
+}
+
+ResourceManager::Slot* ResourceManager::get_slot(const uint32_t id)
+{
+    return const_cast<Slot*>(static_cast<const ResourceManager*>(this)->get_slot(id));
+}
+
+const ResourceManager::Slot* ResourceManager::get_slot(const uint32_t id) const
+{
+    if ( id == invalid_id ) {
+        return nullptr;
+    }
+
+    auto index = get_index(id);
+    if ( index >= capacity_ ) {
+        return nullptr;
+    }
+
+    const auto& slot = slots_[index];
+    if ( slot.state == ResourceState::none || make_id(index, slot.generation) != id ) {
+        return nullptr;
+    }
+
+    return &slot;
+}
+
+
+} // namespace sky
@@ -0,0 +1,177 @@
+//
+//  ResourceManager.hpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#pragma once
+
+#include "Skyrocket/Platform/Filesystem.hpp"
+#include "Skyrocket/Platform/Jobs.hpp"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace sky {
+
+
+enum class ResourceState : uint8_t {
+    none,
+    loading,
+    loaded,
+    failed
+};
+
+/// @brief Callbacks that load, finish and unload one type of resource, i.e. textures or fonts
+struct ResourceLoader {
+    /// Runs on a job worker. Reads and decodes the file at `path` and returns the result, or
+    /// nullptr if it couldn't be loaded
+    using load_t = void* (*)(const Path& path, void* user_data);
+
+    /// Runs on the thread calling `ResourceManager::update` once the resource has loaded, i.e. to
+    /// create GPU objects that can't be created on a worker
+    using finalize_t = bool (*)(void* data, void* user_data);
+
+    /// Frees everything returned from `load`. `finalized` is false if the resource was released
+    /// or failed before `finalize` completed
+    using unload_t = void (*)(void* data, bool finalized, void* user_data);
+
+    load_t load{nullptr};
+    finalize_t finalize{nullptr};
+    unload_t unload{nullptr};
+
+    /// Returned by `ResourceManager::get` while the resource is loading or if it failed to load
+    void* placeholder{nullptr};
+    void* user_data{nullptr};
+};
+
+/// @brief ResourceManager owns every resource loaded from disk and hands out uint32_t ids in
+/// place of the resources themselves. Paths are interned with murmur3 so loading the same file
+/// more than once returns the same id and increments its reference count rather than creating a
+/// duplicate, and each resource is unloaded as soon as its last reference is released which keeps
+/// memory bounded over long sessions.
+///
+/// Files are loaded asynchronously on the job workers. Until a resource has loaded, `get` returns
+/// the placeholder registered for its type so callers never need to check if it's ready. All
+/// member functions must be called from the same thread, usually the main thread, with `update`
+/// called once per frame to finish loads
+class ResourceManager {
+public:
+    static constexpr uint32_t invalid_id = 0;
+    static constexpr uint32_t invalid_type = UINT32_MAX;
+    static constexpr uint32_t max_types = 16;
+    static constexpr uint32_t default_capacity = 4096;
+
+    explicit ResourceManager(uint32_t capacity = default_capacity);
+
+    ResourceManager(const ResourceManager& other) = delete;
+    ResourceManager& operator=(const ResourceManager& other) = delete;
+
+    ~ResourceManager();
+
+    /// @brief Registers a resource type
+    /// @return The type's id, or `invalid_type` if `max_types` have already been registered
+    uint32_t register_type(const ResourceLoader& loader);
+
+    /// @brief Starts loading the resource at `path` or, if it's already loaded or loading, adds a
+    /// reference to it. Resources that failed to load are loaded again. Every call must be paired
+    /// with a call to `release`
+    /// @return The resource's id or `invalid_id` if the type is invalid or the manager is full
+    uint32_t load(uint32_t type, const Path& path);
+
+    /// @brief Removes a reference to a resource, unloading it if it was the last one
+    void release(uint32_t id);
+
+    /// @brief Finishes every load completed since the last update and unloads any resources
+    /// released while they were still loading
+    void update();
+
+    /// @brief Blocks until every pending load has completed and then updates
+    void wait_all();
+
+    /// @brief Unloads every resource regardless of its references
+    void clear();
+
+    ResourceState state(uint32_t id) const;
+
+    /// @brief Gets a loaded resource or its type's placeholder if it's still loading or failed
+    /// to load
+    /// @return nullptr if the id is invalid
+    void* get(uint32_t id) const;
+
+    template <typename T>
+    inline T* get(const uint32_t id) const
+    {
+        return static_cast<T*>(get(id));
+    }
+
+    /// @brief Gets the number of resources currently loaded or loading
+    inline uint32_t size() const
+    {
+        return count_;
+    }
+
+    inline uint32_t capacity() const
+    {
+        return capacity_;
+    }
+
+private:
+    static constexpr uint32_t invalid_index = UINT32_MAX;
+
+    struct Slot {
+        ResourceState state{ResourceState::none};
+        std::atomic<bool> load_complete{false};
+        uint32_t generation{0};
+        uint32_t refcount{0};
+        uint32_t type{0};
+        uint32_t hash{0};
+        uint32_t next{invalid_index};
+        std::string path;
+        void* data{nullptr};
+        const ResourceLoader* loader{nullptr};
+    };
+
+    uint32_t capacity_{0};
+    uint32_t count_{0};
+    uint32_t type_count_{0};
+    ResourceLoader loaders_[max_types];
+
+    std::unique_ptr<Slot[]> slots_;
+    std::vector<uint32_t> buckets_;
+    std::vector<uint32_t> free_list_;
+    std::vector<uint32_t> loading_;
+
+    jobs::JobGroup jobs_;
+
+    static void load_job(void* user_data);
+
+    Slot* get_slot(uint32_t id);
+    const Slot* get_slot(uint32_t id) const;
+    uint32_t find(uint32_t type, uint32_t hash, const Path& path) const;
+    void finish_load(uint32_t index);
+    void free_slot(uint32_t index);
+
+    static constexpr uint32_t index_bits_ = 16;
+    static constexpr uint32_t index_mask_ = (1u << index_bits_) - 1;
+
+    static inline uint32_t make_id(const uint32_t index, const uint32_t generation)
+    {
+        return (generation << index_bits_) | (index + 1);
+    }
+
+    static inline uint32_t get_index(const uint32_t id)
+    {
+        return (id & index_mask_) - 1;
+    }
+};
+
+
+} // namespace sky
@@ -0,0 +1,146 @@
+//
+//  TextShaper.cpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#include "Skyrocket/Resource/TextShaper.hpp"
+#include "Skyrocket/Core/Hash.hpp"
+#include "Skyrocket/Core/Unicode.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace sky {
+
+
+constexpr uint32_t TextShaper::default_max_runs;
+
+TextShaper::TextShaper(Font* font, const uint32_t max_runs)
+    : font_(font), max_runs_(std::max(max_runs, 1u))
+{}
+
+const ShapedRun& TextShaper::shape(const char* str, const size_t size)
+{
+    // Runs depend on the fonts pixel size so the same string is cached separately at each size.
+    // The size seeds the hash and the length is part of the key so strings with colliding hashes
+    // usually differ anyway, but the text and size are still compared before a run is reused
+    auto pixel_size = font_->size();
+    auto hash = hash::murmur3_32(str, static_cast<uint32_t>(size), pixel_size);
+    auto key = (static_cast<uint64_t>(hash) << 32) | static_cast<uint32_t>(size);
+
+    uint32_t index = 0;
+    auto found = lookup_.find(key);
+    if ( found != nullptr ) {
+        index = *found;
+        auto& cached = runs_[index];
+        cached.last_used = ++use_count_;
+
+        auto same_text = cached.text.size() == size && memcmp(cached.text.data(), str, size) == 0;
+        if ( same_text && cached.pixel_size == pixel_size
+            && cached.generation == font_->atlas_generation() ) {
+            ++hits_;
+            return cached.run;
+        }
+    } else {
+        index = allocate_run();
+        lookup_.insert(key, index);
+    }
+
+    ++misses_;
+
+    auto& cached = runs_[index];
+    cached.key = key;
+    cached.text.assign(str, size);
+    cached.pixel_size = pixel_size;
+    cached.last_used = ++use_count_;
+    layout(str, size, &cached.run);
+    // Laying out the run may evict glyphs so the generation is read afterwards
+    cached.generation = font_->atlas_generation();
+    return cached.run;
+}
+
+void TextShaper::clear()
+{
+    runs_.clear();
+    lookup_.clear();
+}
+
+uint32_t TextShaper::allocate_run()
+{
+    if ( runs_.size() < max_runs_ ) {
+        runs_.emplace_back();
+        return static_cast<uint32_t>(runs_.size() - 1);
+    }
+
+    // The cache is small so the least recently used run is found with a linear scan
+    uint32_t oldest = 0;
+    for ( uint32_t i = 1; i < runs_.size(); ++i ) {
+        if ( runs_[i].last_used < runs_[oldest].last_used ) {
+            oldest = i;
+        }
+    }
+
+    lookup_.erase(runs_[oldest].key);
+    return oldest;
+}
+
+void TextShaper::layout(const char* str, const size_t size, ShapedRun* run)
+{
+    run->glyphs.clear();
+    run->width = 0.0f;
+    run->lines = size > 0 ? 1 : 0;
+
+    auto line_height = static_cast<float>(font_->size());
+    auto kerning = font_->has_kerning();
+    auto scale = font_->glyph_scale();
+
+    auto x = 0.0f;
+    auto y = 0.0f;
+    uint32_t previous = 0;
+    size_t offset = 0;
+
+    while ( offset < size ) {
+        auto codepoint = unicode::utf8_decode(str, size, &offset);
+
+        if ( codepoint == '\n' ) {
+            run->width = std::max(run->width, x);
+            y -= line_height;
+            x = 0.0f;
+            previous = 0;
+            ++run->lines;
+            continue;
+        }
+
+        if ( kerning && previous != 0 ) {
+            x += font_->get_kerning(previous, codepoint);
+        }
+
+        const auto& glyph = font_->get_glyph(codepoint);
+
+        // Distance field glyphs are scaled from the size they were rasterised at
+        ShapedGlyph shaped;
+        shaped.width = glyph.width * scale;
+        shaped.height = glyph.height * scale;
+        shaped.x = x + glyph.bearing_x * scale;
+        shaped.y = y - (shaped.height - glyph.bearing_y * scale);
+        shaped.s = glyph.s;
+        shaped.t = glyph.t;
+        shaped.s2 = glyph.s2;
+        shaped.t2 = glyph.t2;
+        run->glyphs.push_back(shaped);
+
+        x += glyph.advance_x * scale;
+        previous = codepoint;
+    }
+
+    run->width = std::max(run->width, x);
+}
+
+
+} // namespace sky
@@ -0,0 +1,92 @@
+//
+//  TextShaper.hpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#pragma once
+
+#include "Skyrocket/Core/Containers/HashMap.hpp"
+#include "Skyrocket/Resource/Font.hpp"
+
+#include <string>
+#include <vector>
+
+namespace sky {
+
+
+/// @brief A glyph quad positioned relative to the origin of the run it was shaped in
+struct ShapedGlyph {
+    float x{0.0f}, y{0.0f}, width{0.0f}, height{0.0f};
+    float s{0.0f}, t{0.0f}, s2{0.0f}, t2{0.0f};
+};
+
+/// @brief A string laid out with a font. Lines start at the origin and move down by the fonts
+/// pixel size
+struct ShapedRun {
+    std::vector<ShapedGlyph> glyphs;
+    /// Width of the longest line
+    float width{0.0f};
+    uint32_t lines{0};
+};
+
+/// @brief Lays out UTF-8 strings with a font, applying kerning, and caches the result by the
+/// strings hash and the fonts pixel size so strings used repeatedly, i.e. UI labels, are only
+/// laid out once per size. Cached runs are laid out again when the fonts atlas generation
+/// changes as their atlas coordinates may no longer be valid
+class TextShaper {
+public:
+    static constexpr uint32_t default_max_runs = 256;
+
+    explicit TextShaper(Font* font, uint32_t max_runs = default_max_runs);
+
+    /// @brief Gets the layout of a UTF-8 string, shaping it if it isn't already cached. The run
+    /// is only valid until the next call to `shape`
+    const ShapedRun& shape(const char* str, size_t size);
+
+    /// @brief Removes all cached runs
+    void clear();
+
+    inline uint64_t hits() const
+    {
+        return hits_;
+    }
+
+    inline uint64_t misses() const
+    {
+        return misses_;
+    }
+
+    inline size_t size() const
+    {
+        return runs_.size();
+    }
+private:
+    struct CachedRun {
+        ShapedRun run;
+        std::string text;
+        uint64_t key{0};
+        uint32_t pixel_size{0};
+        uint64_t generation{0};
+        uint64_t last_used{0};
+    };
+
+    Font* font_;
+    uint32_t max_runs_;
+    std::vector<CachedRun> runs_;
+    HashMap<uint64_t, uint32_t> lookup_;
+    uint64_t use_count_{0};
+    uint64_t hits_{0};
+    uint64_t misses_{0};
+
+    void layout(const char* str, size_t size, ShapedRun* run);
+    uint32_t allocate_run();
+};
+
+
+} // namespace sky
@@ -0,0 +1,82 @@
+//
+//  HashBenchmark.cpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#include <Skyrocket/Core/Hash.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+/// Hashes the same buffer repeatedly with each hash function and prints its throughput, comparing
+/// murmur3_32 against XXH3 for key-sized inputs up to whole assets
+
+constexpr size_t total_bytes = 256 * 1024 * 1024;
+
+volatile uint64_t sink = 0;
+
+template <typename Fn>
+void run(const char* name, const std::vector<uint8_t>& input, const size_t size, Fn&& fn)
+{
+    auto iterations = total_bytes / size;
+    auto start = std::chrono::high_resolution_clock::now();
+
+    uint64_t result = 0;
+    for ( size_t i = 0; i < iterations; ++i ) {
+        // Offsetting the input stops the compiler hoisting the hash out of the loop
+        result += fn(input.data() + (i & 15), size);
+    }
+
+    std::chrono::duration<double, std::milli> ms_elapsed =
+        std::chrono::high_resolution_clock::now() - start;
+    sink = sink + result;
+
+    auto ms = ms_elapsed.count();
+    auto gbps = (static_cast<double>(iterations * size) / (1024.0 * 1024.0 * 1024.0))
+        / (ms / 1000.0);
+    printf("  %-16s %10.2f GB/s %10.1f ns/hash\n", name, gbps,
+           (ms * 1000000.0) / static_cast<double>(iterations));
+}
+
+int main(int argc, char** argv)
+{
+    const size_t sizes[] = { 8, 16, 32, 64, 128, 256, 1024, 4096, 64 * 1024, 1024 * 1024 };
+
+    std::vector<uint8_t> input(1024 * 1024 + 16);
+    for ( size_t i = 0; i < input.size(); ++i ) {
+        input[i] = static_cast<uint8_t>(i * 2654435761U >> 13);
+    }
+
+    for ( auto size : sizes ) {
+        printf("%zu bytes\n", size);
+
+        run("murmur3_32", input, size, [](const uint8_t* data, const size_t len) {
+            return static_cast<uint64_t>(
+                sky::hash::murmur3_32(data, static_cast<uint32_t>(len), 0));
+        });
+
+        run("xxh3_64", input, size, [](const uint8_t* data, const size_t len) {
+            return sky::hash::xxh3_64(data, len);
+        });
+
+        run("xxh3_128", input, size, [](const uint8_t* data, const size_t len) {
+            auto hash = sky::hash::xxh3_128(data, len);
+            return hash.low ^ hash.high;
+        });
+
+        run("streaming xxh3", input, size, [](const uint8_t* data, const size_t len) {
+            sky::hash::StreamingHasher hasher;
+            hasher.update(data, len);
+            return hasher.digest64();
+        });
+    }
+
+    return 0;
+}
@@ -0,0 +1,159 @@
+//
+//  HashMapBenchmark.cpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#include <Skyrocket/Core/Containers/HashMap.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// Times inserts, successful and failed lookups and erases for sky::HashMap and
+/// std::unordered_map using the engine's common key types: resource ids, 64-bit glyph keys and
+/// asset names
+
+volatile uint64_t sink = 0;
+
+template <typename Fn>
+double time_ns(const size_t count, Fn&& fn)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    fn();
+    std::chrono::duration<double, std::nano> elapsed =
+        std::chrono::high_resolution_clock::now() - start;
+    return elapsed.count() / static_cast<double>(count);
+}
+
+template <typename K>
+struct StdMap {
+    std::unordered_map<K, uint32_t> map;
+
+    void insert(const K& key, const uint32_t value)
+    {
+        map[key] = value;
+    }
+
+    const uint32_t* find(const K& key) const
+    {
+        auto it = map.find(key);
+        return it != map.end() ? &it->second : nullptr;
+    }
+
+    void erase(const K& key)
+    {
+        map.erase(key);
+    }
+};
+
+template <typename K>
+struct SkyMap {
+    sky::HashMap<K, uint32_t> map;
+
+    void insert(const K& key, const uint32_t value)
+    {
+        map.insert(key, value);
+    }
+
+    const uint32_t* find(const K& key) const
+    {
+        return map.find(key);
+    }
+
+    void erase(const K& key)
+    {
+        map.erase(key);
+    }
+};
+
+template <typename Map, typename K>
+void run(const char* name, const std::vector<K>& keys, const std::vector<K>& missing)
+{
+    Map map;
+    auto count = keys.size();
+
+    auto insert = time_ns(count, [&]() {
+        for ( size_t i = 0; i < count; ++i ) {
+            map.insert(keys[i], static_cast<uint32_t>(i));
+        }
+    });
+
+    auto hit = time_ns(count, [&]() {
+        uint64_t sum = 0;
+        for ( const auto& key : keys ) {
+            sum += *map.find(key);
+        }
+        sink = sink + sum;
+    });
+
+    auto miss = time_ns(count, [&]() {
+        uint64_t found = 0;
+        for ( const auto& key : missing ) {
+            found += map.find(key) != nullptr;
+        }
+        sink = sink + found;
+    });
+
+    auto erase = time_ns(count, [&]() {
+        for ( const auto& key : keys ) {
+            map.erase(key);
+        }
+    });
+
+    printf("  %-20s insert %7.1f ns  hit %7.1f ns  miss %7.1f ns  erase %7.1f ns\n", name,
+           insert, hit, miss, erase);
+}
+
+template <typename K, typename MakeKey>
+void run_key_type(const char* name, MakeKey&& make_key)
+{
+    const size_t counts[] = { 1024, 64 * 1024, 1024 * 1024 };
+
+    for ( auto count : counts ) {
+        std::vector<K> keys;
+        std::vector<K> missing;
+        keys.reserve(count);
+        missing.reserve(count);
+
+        for ( size_t i = 0; i < count; ++i ) {
+            keys.push_back(make_key(i * 2));
+            missing.push_back(make_key(i * 2 + 1));
+        }
+
+        // Lookups are shuffled so the maps can't rely on insertion order for locality
+        std::mt19937 rng(42);
+        std::shuffle(keys.begin(), keys.end(), rng);
+        std::shuffle(missing.begin(), missing.end(), rng);
+
+        printf("%s, %zu keys\n", name, count);
+        run<StdMap<K>>("std::unordered_map", keys, missing);
+        run<SkyMap<K>>("sky::HashMap", keys, missing);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    run_key_type<uint32_t>("uint32_t resource ids", [](const size_t i) {
+        return static_cast<uint32_t>(i);
+    });
+
+    run_key_type<uint64_t>("uint64_t glyph keys", [](const size_t i) {
+        return (static_cast<uint64_t>(i % 4096) << 32) | (i / 4096);
+    });
+
+    run_key_type<std::string>("std::string asset names", [](const size_t i) {
+        return "Assets/Textures/texture_" + std::to_string(i) + ".png";
+    });
+
+    return 0;
+}
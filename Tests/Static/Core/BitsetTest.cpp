@@ -14,6 +14,9 @@
 
 #include "catch/catch.hpp"
 
+#include <bitset>
+#include <random>
+
 constexpr size_t bitset_size = UINT8_MAX;
 using test_bitset_t = sky::Bitset<bitset_size>;
 
@@ -71,4 +74,111 @@ TEST_CASE("Bits are toggled correctly", "[bitset]")
         bitset.toggle_bit(i);
         REQUIRE(bitset.is_set(i));
     }
-}
\ No newline at end of file
+}
+
+template <size_t Size>
+void check_word_operations()
+{
+    using bitset_t = sky::Bitset<Size>;
+
+    std::mt19937 rng(Size);
+    bitset_t lhs;
+    bitset_t rhs;
+    std::bitset<Size> expected_lhs;
+    std::bitset<Size> expected_rhs;
+
+    for (size_t i = 0; i < Size; ++i) {
+        if (rng() % 3 == 0) {
+            lhs.set_bit(i);
+            expected_lhs.set(i);
+        }
+        if (rng() % 2 == 0) {
+            rhs.set_bit(i);
+            expected_rhs.set(i);
+        }
+    }
+
+    auto matches = [](const bitset_t& bits, const std::bitset<Size>& expected) {
+        if (bits.popcount() != expected.count()) {
+            return false;
+        }
+        for (size_t i = 0; i < Size; ++i) {
+            if (bits.is_set(i) != expected.test(i)) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    REQUIRE(matches(lhs, expected_lhs));
+    REQUIRE(matches(lhs & rhs, expected_lhs & expected_rhs));
+    REQUIRE(matches(lhs | rhs, expected_lhs | expected_rhs));
+    REQUIRE(matches(lhs ^ rhs, expected_lhs ^ expected_rhs));
+
+    auto and_not = lhs;
+    and_not.and_not(rhs);
+    REQUIRE(matches(and_not, expected_lhs & ~expected_rhs));
+
+    auto toggled = lhs;
+    toggled.toggle_all();
+    REQUIRE(matches(toggled, ~expected_lhs));
+
+    // Iterating with find_next_set and for_each_set visits the same bits in order
+    std::vector<size_t> found;
+    for (auto i = lhs.find_first_set(); i != bitset_t::npos; i = lhs.find_next_set(i + 1)) {
+        found.push_back(i);
+    }
+
+    std::vector<size_t> visited;
+    lhs.for_each_set([&](const size_t bit) {
+        visited.push_back(bit);
+    });
+
+    std::vector<size_t> expected_bits;
+    for (size_t i = 0; i < Size; ++i) {
+        if (expected_lhs.test(i)) {
+            expected_bits.push_back(i);
+        }
+    }
+
+    REQUIRE(found == expected_bits);
+    REQUIRE(visited == expected_bits);
+}
+
+TEST_CASE("Word operations match std::bitset", "[bitset]")
+{
+    SECTION("1 bit") { check_word_operations<1>(); }
+    SECTION("63 bits") { check_word_operations<63>(); }
+    SECTION("64 bits") { check_word_operations<64>(); }
+    SECTION("65 bits") { check_word_operations<65>(); }
+    SECTION("255 bits") { check_word_operations<255>(); }
+    SECTION("1000 bits") { check_word_operations<1000>(); }
+}
+
+TEST_CASE("Bits are counted and searched correctly", "[bitset]")
+{
+    test_bitset_t bitset;
+
+    REQUIRE(bitset.none());
+    REQUIRE(bitset.popcount() == 0);
+    REQUIRE(bitset.find_first_set() == test_bitset_t::npos);
+    REQUIRE(bitset.find_first_clear() == 0);
+
+    // Bits past the end of the set are never counted or found
+    bitset.set_all();
+    REQUIRE(bitset.popcount() == bitset_size);
+    REQUIRE(bitset.find_first_clear() == test_bitset_t::npos);
+    REQUIRE(bitset.find_next_set(bitset_size) == test_bitset_t::npos);
+
+    bitset.clear_bit(200);
+    REQUIRE(bitset.find_first_clear() == 200);
+
+    bitset.clear_all();
+    bitset.set_bit(70);
+    bitset.set_bit(254);
+    REQUIRE(bitset.any());
+    REQUIRE(bitset.find_first_set() == 70);
+    REQUIRE(bitset.find_next_set(70) == 70);
+    REQUIRE(bitset.find_next_set(71) == 254);
+    REQUIRE(bitset.find_next_set(255) == test_bitset_t::npos);
+}
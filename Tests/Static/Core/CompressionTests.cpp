@@ -0,0 +1,223 @@
+//
+//  CompressionTests.cpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#include <Skyrocket/Core/Compression.hpp>
+#include <Skyrocket/Platform/Jobs.hpp>
+
+#include "catch/catch.hpp"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+static std::vector<uint8_t> make_noise(const size_t size, uint32_t state)
+{
+    std::vector<uint8_t> data(size);
+    for ( auto& d : data ) {
+        state = state * 1664525u + 1013904223u;
+        d = static_cast<uint8_t>(state >> 24);
+    }
+    return data;
+}
+
+/// Text-like data with lots of repeated words at varying distances plus some short runs
+static std::vector<uint8_t> make_compressible(const size_t size)
+{
+    const char* words[] = { "skyrocket ", "glyph ", "texture ", "render ", "aaaaaaaa", "\n" };
+    std::vector<uint8_t> data;
+    uint32_t state = 7;
+
+    while ( data.size() < size ) {
+        state = state * 1664525u + 1013904223u;
+        auto word = words[(state >> 24) % 6];
+        data.insert(data.end(), word, word + strlen(word));
+    }
+
+    data.resize(size);
+    return data;
+}
+
+static std::vector<uint8_t> round_trip_block(const std::vector<uint8_t>& src)
+{
+    std::vector<uint8_t> compressed(sky::lz::compress_bound(src.size()));
+    auto compressed_size = sky::lz::compress(src.data(), src.size(), compressed.data(),
+                                             compressed.size());
+    REQUIRE(compressed_size > 0);
+    REQUIRE(compressed_size <= compressed.size());
+
+    std::vector<uint8_t> decompressed(src.size());
+    REQUIRE(sky::lz::decompress(compressed.data(), compressed_size, decompressed.data(),
+                                decompressed.size()));
+    return decompressed;
+}
+
+TEST_CASE("Blocks survive a round trip", "[compression]")
+{
+    const size_t sizes[] = { 0, 1, 12, 13, 16, 100, 4096, 65536, 100000 };
+
+    for ( auto size : sizes ) {
+        INFO("size " << size);
+
+        auto noise = make_noise(size, 1234);
+        REQUIRE(round_trip_block(noise) == noise);
+
+        auto text = make_compressible(size);
+        REQUIRE(round_trip_block(text) == text);
+
+        std::vector<uint8_t> zeros(size, 0);
+        REQUIRE(round_trip_block(zeros) == zeros);
+    }
+}
+
+TEST_CASE("Repetitive data compresses well", "[compression]")
+{
+    auto text = make_compressible(64 * 1024);
+    std::vector<uint8_t> compressed(sky::lz::compress_bound(text.size()));
+    auto compressed_size = sky::lz::compress(text.data(), text.size(), compressed.data(),
+                                             compressed.size());
+
+    REQUIRE(compressed_size > 0);
+    REQUIRE(compressed_size < text.size() / 3);
+
+    // Blocks don't fit in less space than they need
+    REQUIRE(sky::lz::compress(text.data(), text.size(), compressed.data(), 64) == 0);
+}
+
+TEST_CASE("Corrupt blocks are rejected", "[compression]")
+{
+    auto text = make_compressible(4096);
+    std::vector<uint8_t> compressed(sky::lz::compress_bound(text.size()));
+    auto compressed_size = sky::lz::compress(text.data(), text.size(), compressed.data(),
+                                             compressed.size());
+    std::vector<uint8_t> decompressed(text.size());
+
+    SECTION("truncated data")
+    {
+        REQUIRE_FALSE(sky::lz::decompress(compressed.data(), compressed_size / 2,
+                                          decompressed.data(), decompressed.size()));
+    }
+
+    SECTION("wrong decompressed size")
+    {
+        REQUIRE_FALSE(sky::lz::decompress(compressed.data(), compressed_size,
+                                          decompressed.data(), decompressed.size() - 1));
+    }
+
+    SECTION("garbage never reads or writes out of bounds")
+    {
+        for ( uint32_t seed = 0; seed < 64; ++seed ) {
+            auto garbage = make_noise(256, seed);
+            sky::lz::decompress(garbage.data(), garbage.size(), decompressed.data(),
+                                decompressed.size());
+        }
+    }
+}
+
+TEST_CASE("Frames are compressed in parallel and decompress to the original", "[compression]")
+{
+    sky::jobs::startup(0);
+
+    const size_t block_sizes[] = { 1024, sky::lz::default_block_size };
+
+    for ( auto block_size : block_sizes ) {
+        INFO("block size " << block_size);
+
+        // Alternate compressible and incompressible blocks so some are stored uncompressed
+        auto src = make_compressible(300 * 1024 + 17);
+        auto noise = make_noise(src.size(), 99);
+        for ( size_t i = 0; i < src.size(); ++i ) {
+            if ( (i / block_size) % 3 == 1 ) {
+                src[i] = noise[i];
+            }
+        }
+
+        std::vector<uint8_t> frame(sky::lz::frame_bound(src.size(), block_size));
+        auto frame_size = sky::lz::compress_frame(src.data(), src.size(), frame.data(),
+                                                  frame.size(), block_size);
+        REQUIRE(frame_size > 0);
+        REQUIRE(frame_size < src.size());
+
+        std::vector<uint8_t> decompressed(src.size());
+        REQUIRE(sky::lz::decompress_frame(frame.data(), frame_size, decompressed.data(),
+                                          decompressed.size()));
+        REQUIRE(decompressed == src);
+
+        REQUIRE_FALSE(sky::lz::decompress_frame(frame.data(), frame_size - 1,
+                                                decompressed.data(), decompressed.size()));
+        REQUIRE_FALSE(sky::lz::compress_frame(src.data(), src.size(), frame.data(),
+                                              frame.size() - 1, block_size));
+    }
+
+    sky::jobs::shutdown();
+}
+
+TEST_CASE("Streams can be written and read in chunks of any size", "[compression]")
+{
+    auto src = make_compressible(200 * 1024);
+    auto chunk_sizes = make_noise(1024, 5);
+
+    sky::lz::StreamEncoder encoder(16 * 1024);
+    size_t offset = 0;
+    for ( size_t i = 0; offset < src.size(); ++i ) {
+        auto size = std::min<size_t>(chunk_sizes[i % chunk_sizes.size()] * 7, src.size() - offset);
+        encoder.write(src.data() + offset, size);
+        offset += size;
+    }
+    encoder.flush();
+
+    const auto& frame = encoder.output();
+    REQUIRE(frame.size() < src.size());
+
+    SECTION("stream output is a frame")
+    {
+        std::vector<uint8_t> decompressed(src.size());
+        REQUIRE(sky::lz::decompress_frame(frame.data(), frame.size(), decompressed.data(),
+                                          decompressed.size()));
+        REQUIRE(decompressed == src);
+    }
+
+    SECTION("the decoder buffers partial blocks")
+    {
+        sky::lz::StreamDecoder decoder;
+        std::vector<uint8_t> decompressed;
+
+        for ( size_t i = 0; i < frame.size(); i += 1000 ) {
+            REQUIRE(decoder.write(frame.data() + i, std::min<size_t>(1000, frame.size() - i)));
+            decompressed.insert(decompressed.end(), decoder.output().begin(),
+                                decoder.output().end());
+            decoder.clear_output();
+        }
+
+        REQUIRE(decoder.complete());
+        REQUIRE(decompressed == src);
+    }
+
+    SECTION("corrupt streams stop decoding")
+    {
+        auto corrupt = frame;
+        corrupt[0] = 0xFF;
+        corrupt[1] = 0xFF;
+        corrupt[2] = 0xFF;
+        corrupt[3] = 0x7F;
+        corrupt[4] = 0xFF;
+        corrupt[5] = 0xFF;
+        corrupt[6] = 0xFF;
+        corrupt[7] = 0xFF;
+
+        sky::lz::StreamDecoder decoder;
+        REQUIRE_FALSE(decoder.write(corrupt.data(), corrupt.size()));
+        REQUIRE_FALSE(decoder.write(frame.data(), frame.size()));
+
+        decoder.reset();
+        REQUIRE(decoder.write(frame.data(), frame.size()));
+        REQUIRE(decoder.output() == src);
+    }
+}
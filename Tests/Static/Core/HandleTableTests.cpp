@@ -0,0 +1,150 @@
+//
+//  HandleTableTests.cpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#include <Skyrocket/Core/Containers/HandleTable.hpp>
+
+#include "catch/catch.hpp"
+
+#include <memory>
+#include <random>
+#include <unordered_map>
+
+TEST_CASE("Handles are created, found and destroyed with external ids", "[handle_table]")
+{
+    sky::HandleTable<uint32_t> table;
+
+    REQUIRE(table.create(sky::HandleTable<uint32_t>::invalid_id, 1) == nullptr);
+
+    REQUIRE(*table.create(1, 10) == 10);
+    REQUIRE(*table.create(2, 20) == 20);
+    REQUIRE(*table.create(3, 30) == 30);
+    REQUIRE(table.create(2, 40) == nullptr);
+    REQUIRE(table.size() == 3);
+
+    // Ids aren't limited to a fixed capacity
+    REQUIRE(*table.create(100000, 50) == 50);
+    REQUIRE(table.size() == 4);
+
+    REQUIRE(!table.contains(4));
+    REQUIRE(!table.contains(99999));
+
+    // Destroying from the middle moves the last handle into the hole
+    table.destroy(2);
+    REQUIRE(!table.contains(2));
+    REQUIRE(table.get(2) == nullptr);
+    REQUIRE(*table.get(1) == 10);
+    REQUIRE(*table.get(3) == 30);
+    REQUIRE(*table.get(100000) == 50);
+    REQUIRE(table.size() == 3);
+
+    table.destroy(1);
+    table.destroy(100000);
+    REQUIRE(*table.get(3) == 30);
+    REQUIRE(table.size() == 1);
+
+    // Destroyed ids can be created again
+    REQUIRE(*table.create(2, 60) == 60);
+    REQUIRE(*table.get(2) == 60);
+
+    table.clear();
+    REQUIRE(table.empty());
+    REQUIRE(!table.contains(3));
+}
+
+TEST_CASE("Generated ids reject stale handles", "[handle_table]")
+{
+    sky::HandleTable<int> table;
+
+    auto a = table.add(1);
+    auto b = table.add(2);
+    REQUIRE(a != sky::HandleTable<int>::invalid_id);
+    REQUIRE(b != sky::HandleTable<int>::invalid_id);
+    REQUIRE(a != b);
+
+    table.destroy(a);
+    REQUIRE(!table.contains(a));
+
+    // The index is reused with a new generation so the old id stays invalid
+    auto c = table.add(3);
+    REQUIRE((c & sky::HandleTable<int>::index_mask) == (a & sky::HandleTable<int>::index_mask));
+    REQUIRE(c != a);
+    REQUIRE(!table.contains(a));
+    REQUIRE(table.get(a) == nullptr);
+    REQUIRE(*table.get(c) == 3);
+    REQUIRE(*table.get(b) == 2);
+
+    for ( int i = 0; i < 1000; ++i ) {
+        auto id = table.add(i);
+        INFO("iteration " << i);
+        REQUIRE(id != a);
+        REQUIRE(id != sky::HandleTable<int>::invalid_id);
+        table.destroy(id);
+    }
+}
+
+TEST_CASE("Handle table matches std::unordered_map and iterates contiguously", "[handle_table]")
+{
+    sky::HandleTable<uint32_t> table;
+    std::unordered_map<uint32_t, uint32_t> expected;
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<uint32_t> id_dist(1, 5000);
+
+    for ( uint32_t i = 0; i < 20000; ++i ) {
+        auto id = id_dist(rng);
+        INFO("operation " << i << ", id " << id);
+
+        if ( expected.count(id) > 0 ) {
+            table.destroy(id);
+            expected.erase(id);
+        } else {
+            REQUIRE(table.create(id, i) != nullptr);
+            expected[id] = i;
+        }
+
+        REQUIRE(table.size() == expected.size());
+    }
+
+    for ( const auto& pair : expected ) {
+        INFO("id " << pair.first);
+        REQUIRE(table.get(pair.first) != nullptr);
+        REQUIRE(*table.get(pair.first) == pair.second);
+    }
+
+    size_t visited = 0;
+    for ( auto& handle : table ) {
+        REQUIRE(expected.at(handle.id) == handle.data);
+        ++visited;
+    }
+    REQUIRE(visited == expected.size());
+}
+
+TEST_CASE("Handle tables support move-only data", "[handle_table]")
+{
+    sky::HandleTable<std::unique_ptr<int>> table;
+
+    for ( uint32_t id = 1; id <= 100; ++id ) {
+        table.create(id, std::unique_ptr<int>(new int(static_cast<int>(id))));
+    }
+
+    for ( uint32_t id = 1; id <= 100; id += 3 ) {
+        table.destroy(id);
+    }
+
+    for ( uint32_t id = 1; id <= 100; ++id ) {
+        INFO("id " << id);
+        if ( (id - 1) % 3 == 0 ) {
+            REQUIRE(!table.contains(id));
+        } else {
+            REQUIRE(**table.get(id) == static_cast<int>(id));
+        }
+    }
+}
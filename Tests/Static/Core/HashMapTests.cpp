@@ -0,0 +1,262 @@
+//
+//  HashMapTests.cpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#include <Skyrocket/Core/Containers/HashMap.hpp>
+
+#include "catch/catch.hpp"
+
+#include <random>
+#include <string>
+#include <unordered_map>
+
+namespace {
+
+/// Counts allocations so tests can check the map only uses the allocator it was given
+class CountingAllocator : public sky::Allocator {
+public:
+    int allocations{0};
+    int frees{0};
+
+    void* allocate(const size_t byte_size, const size_t /*alignment*/) override
+    {
+        ++allocations;
+        return ::operator new(byte_size);
+    }
+
+    void free(void* ptr) override
+    {
+        ++frees;
+        ::operator delete(ptr);
+    }
+
+    void reset() override {}
+
+    bool is_valid(void* ptr) const override
+    {
+        return ptr != nullptr;
+    }
+};
+
+/// Puts every key in the same probe group with only a handful of distinct control bytes, which
+/// forces long probe sequences and lots of tombstones
+struct CollidingHash {
+    size_t operator()(const uint32_t key) const
+    {
+        return key % 4;
+    }
+};
+
+/// Tracks how many instances are alive to check entries are destroyed exactly once
+struct Tracked {
+    static int alive;
+
+    int value{0};
+
+    Tracked()
+    {
+        ++alive;
+    }
+
+    explicit Tracked(const int v)
+        : value(v)
+    {
+        ++alive;
+    }
+
+    Tracked(const Tracked& other)
+        : value(other.value)
+    {
+        ++alive;
+    }
+
+    Tracked& operator=(const Tracked& other) = default;
+
+    ~Tracked()
+    {
+        --alive;
+    }
+};
+
+int Tracked::alive = 0;
+
+}
+
+TEST_CASE("HashMap inserts, finds and erases values", "[hash_map]")
+{
+    sky::HashMap<uint64_t, uint32_t> map;
+
+    REQUIRE(map.empty());
+    REQUIRE(map.find(10) == nullptr);
+    REQUIRE(!map.erase(10));
+
+    REQUIRE(map.insert(10, 1));
+    REQUIRE(map.insert(20, 2));
+    REQUIRE(!map.insert(10, 3));
+
+    REQUIRE(map.size() == 2);
+    REQUIRE(*map.find(10) == 3);
+    REQUIRE(*map.find(20) == 2);
+    REQUIRE(map.contains(20));
+    REQUIRE(!map.contains(30));
+
+    map[30] += 5;
+    REQUIRE(map[30] == 5);
+    REQUIRE(map.size() == 3);
+
+    REQUIRE(map.erase(10));
+    REQUIRE(!map.erase(10));
+    REQUIRE(map.find(10) == nullptr);
+    REQUIRE(map.size() == 2);
+
+    auto capacity = map.capacity();
+    map.clear();
+    REQUIRE(map.empty());
+    REQUIRE(map.capacity() == capacity);
+    REQUIRE(map.find(20) == nullptr);
+}
+
+TEST_CASE("HashMap matches std::unordered_map under random operations", "[hash_map]")
+{
+    sky::HashMap<uint32_t, uint32_t> map;
+    sky::HashMap<uint32_t, uint32_t, CollidingHash> colliding;
+    std::unordered_map<uint32_t, uint32_t> expected;
+
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<uint32_t> key_dist(0, 2000);
+
+    for ( uint32_t i = 0; i < 50000; ++i ) {
+        auto key = key_dist(rng);
+        INFO("operation " << i << ", key " << key);
+
+        if ( rng() % 3 == 0 ) {
+            auto erased = expected.erase(key) > 0;
+            REQUIRE(map.erase(key) == erased);
+            REQUIRE(colliding.erase(key) == erased);
+        } else {
+            auto inserted = expected.insert({key, i}).second;
+            expected[key] = i;
+            REQUIRE(map.insert(key, i) == inserted);
+            REQUIRE(colliding.insert(key, i) == inserted);
+        }
+
+        REQUIRE(map.size() == expected.size());
+        REQUIRE(colliding.size() == expected.size());
+    }
+
+    for ( uint32_t key = 0; key <= 2000; ++key ) {
+        INFO("key " << key);
+        auto it = expected.find(key);
+        if ( it == expected.end() ) {
+            REQUIRE(map.find(key) == nullptr);
+            REQUIRE(colliding.find(key) == nullptr);
+        } else {
+            REQUIRE(map.find(key) != nullptr);
+            REQUIRE(*map.find(key) == it->second);
+            REQUIRE(*colliding.find(key) == it->second);
+        }
+    }
+
+    size_t visited = 0;
+    map.for_each([&](const uint32_t key, const uint32_t value) {
+        REQUIRE(expected.at(key) == value);
+        ++visited;
+    });
+    REQUIRE(visited == expected.size());
+}
+
+TEST_CASE("HashMap supports string keys", "[hash_map]")
+{
+    sky::HashMap<std::string, int> map;
+
+    for ( int i = 0; i < 1000; ++i ) {
+        map.insert("asset_" + std::to_string(i), i);
+    }
+
+    REQUIRE(map.size() == 1000);
+    for ( int i = 0; i < 1000; ++i ) {
+        INFO("asset " << i);
+        auto value = map.find("asset_" + std::to_string(i));
+        REQUIRE(value != nullptr);
+        REQUIRE(*value == i);
+    }
+
+    REQUIRE(map.find("asset_1000") == nullptr);
+    REQUIRE(map.erase("asset_500"));
+    REQUIRE(!map.contains("asset_500"));
+}
+
+TEST_CASE("HashMap reserves capacity up front", "[hash_map]")
+{
+    sky::HashMap<uint32_t, uint32_t> map;
+    map.reserve(1000);
+
+    auto capacity = map.capacity();
+    REQUIRE(capacity >= 1000);
+
+    for ( uint32_t i = 0; i < 1000; ++i ) {
+        map.insert(i, i);
+    }
+
+    REQUIRE(map.capacity() == capacity);
+}
+
+TEST_CASE("HashMap uses the allocator it's given", "[hash_map]")
+{
+    CountingAllocator allocator;
+
+    {
+        sky::HashMap<uint32_t, uint32_t> map(&allocator);
+        for ( uint32_t i = 0; i < 1000; ++i ) {
+            map.insert(i, i * 2);
+        }
+
+        REQUIRE(allocator.allocations > 0);
+
+        auto copy = map;
+        REQUIRE(copy.size() == map.size());
+        REQUIRE(*copy.find(999) == 1998);
+
+        auto moved = std::move(copy);
+        REQUIRE(moved.size() == 1000);
+        REQUIRE(copy.empty());
+        REQUIRE(copy.find(1) == nullptr);
+    }
+
+    REQUIRE(allocator.allocations == allocator.frees);
+}
+
+TEST_CASE("HashMap constructs and destroys each value exactly once", "[hash_map]")
+{
+    {
+        sky::HashMap<uint32_t, Tracked> map;
+        for ( uint32_t i = 0; i < 500; ++i ) {
+            map.insert(i, Tracked(static_cast<int>(i)));
+        }
+        REQUIRE(Tracked::alive == 500);
+
+        for ( uint32_t i = 0; i < 500; i += 2 ) {
+            map.erase(i);
+        }
+        REQUIRE(Tracked::alive == 250);
+
+        // Overwriting a value doesn't create another
+        map.insert(1, Tracked(-1));
+        REQUIRE(Tracked::alive == 250);
+        REQUIRE(map.find(1)->value == -1);
+
+        auto copy = map;
+        REQUIRE(Tracked::alive == 500);
+        copy.clear();
+        REQUIRE(Tracked::alive == 250);
+    }
+
+    REQUIRE(Tracked::alive == 0);
+}
@@ -0,0 +1,274 @@
+//
+//  RectanglePackerTests.cpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#include <Skyrocket/Core/Geometry/RectanglePacker.hpp>
+
+#include "catch/catch.hpp"
+
+#include <algorithm>
+#include <random>
+
+using Heuristic = sky::RectanglePacker::Heuristic;
+
+static const Heuristic all_heuristics[] = {
+    Heuristic::skyline_bottom_left,
+    Heuristic::maxrects_best_short_side,
+    Heuristic::maxrects_best_area
+};
+
+static bool no_overlaps(const std::vector<sky::UIntRect>& rects, const uint32_t padding)
+{
+    for ( size_t i = 0; i < rects.size(); ++i ) {
+        sky::UIntRect a(rects[i].position, rects[i].width + padding, rects[i].height + padding);
+        for ( size_t j = i + 1; j < rects.size(); ++j ) {
+            if ( a.intersects(rects[j]) ) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static bool in_bounds(const std::vector<sky::UIntRect>& rects, const sky::RectanglePacker& packer)
+{
+    for ( auto& r : rects ) {
+        if ( r.right() > packer.width() || r.bottom() > packer.height() ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST_CASE("Packed rectangles don't overlap and stay in bounds", "[rect_packer]")
+{
+    for ( auto heuristic : all_heuristics ) {
+        INFO("heuristic: " << static_cast<int>(heuristic));
+
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<uint32_t> dist(1, 24);
+
+        sky::RectanglePacker packer(256, 256, heuristic, 1);
+        std::vector<sky::UIntRect> rects;
+
+        sky::UIntRect rect;
+        while ( packer.insert(dist(rng), dist(rng), &rect) ) {
+            rects.push_back(rect);
+        }
+
+        REQUIRE(rects.size() > 50);
+        REQUIRE(no_overlaps(rects, 1));
+        REQUIRE(in_bounds(rects, packer));
+        REQUIRE(packer.occupancy() > 0.5f);
+    }
+}
+
+TEST_CASE("Uniform rectangles fill the area completely", "[rect_packer]")
+{
+    for ( auto heuristic : all_heuristics ) {
+        INFO("heuristic: " << static_cast<int>(heuristic));
+
+        sky::RectanglePacker packer(64, 64, heuristic);
+        sky::UIntRect rect;
+
+        for ( int i = 0; i < 64; ++i ) {
+            REQUIRE(packer.insert(8, 8, &rect));
+        }
+
+        REQUIRE_FALSE(packer.insert(1, 1, &rect));
+        REQUIRE(packer.occupancy() == Approx(1.0f));
+    }
+}
+
+TEST_CASE("Removed rectangles free their space", "[rect_packer]")
+{
+    for ( auto heuristic : all_heuristics ) {
+        INFO("heuristic: " << static_cast<int>(heuristic));
+
+        sky::RectanglePacker packer(64, 64, heuristic);
+        std::vector<sky::UIntRect> rects;
+        sky::UIntRect rect;
+
+        for ( int i = 0; i < 16; ++i ) {
+            REQUIRE(packer.insert(16, 16, &rect));
+            rects.push_back(rect);
+        }
+
+        REQUIRE_FALSE(packer.insert(16, 16, &rect));
+
+        // Free a rectangle in the middle of the area and every other rectangle in the top row
+        auto removed = rects[5];
+        packer.remove(removed);
+        packer.remove(rects[0]);
+        packer.remove(rects[2]);
+        REQUIRE(packer.used_area() == 13 * 16 * 16);
+
+        std::vector<sky::UIntRect> kept;
+        for ( size_t i = 0; i < rects.size(); ++i ) {
+            if ( i != 0 && i != 2 && i != 5 ) {
+                kept.push_back(rects[i]);
+            }
+        }
+
+        for ( int i = 0; i < 3; ++i ) {
+            REQUIRE(packer.insert(16, 16, &rect));
+            kept.push_back(rect);
+        }
+
+        REQUIRE_FALSE(packer.insert(16, 16, &rect));
+        REQUIRE(no_overlaps(kept, 0));
+        REQUIRE(packer.occupancy() == Approx(1.0f));
+    }
+}
+
+TEST_CASE("Packers grow in powers of two keeping existing rectangles", "[rect_packer]")
+{
+    for ( auto heuristic : all_heuristics ) {
+        INFO("heuristic: " << static_cast<int>(heuristic));
+
+        sky::RectanglePacker packer(32, 32, heuristic, 1);
+        std::vector<sky::UIntRect> rects;
+        sky::UIntRect rect;
+
+        for ( int i = 0; i < 100; ++i ) {
+            REQUIRE(packer.insert_and_grow(15, 15, 1024, &rect));
+            rects.push_back(rect);
+        }
+
+        REQUIRE(packer.width() == sky::RectanglePacker::next_power_of_two(packer.width()));
+        REQUIRE(packer.height() == sky::RectanglePacker::next_power_of_two(packer.height()));
+        REQUIRE(packer.width() * packer.height() <= 256 * 256);
+        REQUIRE(no_overlaps(rects, 1));
+        REQUIRE(in_bounds(rects, packer));
+
+        REQUIRE_FALSE(packer.insert_and_grow(2048, 1, 1024, &rect));
+        REQUIRE_FALSE(packer.resize(16, 16));
+    }
+}
+
+TEST_CASE("Next power of two is calculated correctly", "[rect_packer]")
+{
+    REQUIRE(sky::RectanglePacker::next_power_of_two(0) == 1);
+    REQUIRE(sky::RectanglePacker::next_power_of_two(1) == 1);
+    REQUIRE(sky::RectanglePacker::next_power_of_two(3) == 4);
+    REQUIRE(sky::RectanglePacker::next_power_of_two(512) == 512);
+    REQUIRE(sky::RectanglePacker::next_power_of_two(513) == 1024);
+}
+
+TEST_CASE("Occupied rectangles are never packed over", "[rect_packer]")
+{
+    for ( auto heuristic : all_heuristics ) {
+        INFO("heuristic: " << static_cast<int>(heuristic));
+
+        sky::RectanglePacker source(128, 128, heuristic, 1);
+        std::vector<sky::UIntRect> rects;
+        sky::UIntRect rect;
+
+        for ( uint32_t i = 0; i < 20; ++i ) {
+            REQUIRE(source.insert(5 + i % 7, 3 + i % 11, &rect));
+            rects.push_back(rect);
+        }
+
+        // Restoring the layout into a new packer keeps its occupancy and later inserts avoid it
+        sky::RectanglePacker restored(128, 128, heuristic, 1);
+        for ( auto& r : rects ) {
+            restored.occupy(r);
+        }
+
+        REQUIRE(restored.occupancy() == Approx(source.occupancy()));
+
+        while ( restored.insert(6, 6, &rect) ) {
+            rects.push_back(rect);
+        }
+
+        REQUIRE(rects.size() > 100);
+        REQUIRE(no_overlaps(rects, 1));
+        REQUIRE(in_bounds(rects, restored));
+    }
+}
+
+TEST_CASE("Removed rectangles merge back into larger free space", "[rect_packer]")
+{
+    for ( auto heuristic : all_heuristics ) {
+        INFO("heuristic: " << static_cast<int>(heuristic));
+
+        sky::RectanglePacker packer(64, 64, heuristic, 1);
+        sky::UIntRect rect;
+
+        // Emptying the packer makes the whole area available again
+        REQUIRE(packer.insert(10, 10, &rect));
+        packer.remove(rect);
+        REQUIRE(packer.insert(60, 60, &rect));
+        packer.remove(rect);
+
+        // Freeing a 2x2 block of neighbouring tiles leaves room for one tile twice the size
+        sky::RectanglePacker tiles(64, 64, heuristic);
+        std::vector<sky::UIntRect> rects;
+        for ( int i = 0; i < 16; ++i ) {
+            REQUIRE(tiles.insert(16, 16, &rect));
+            rects.push_back(rect);
+        }
+
+        std::vector<sky::UIntRect> kept;
+        for ( auto& r : rects ) {
+            if ( r.position.x >= 32 && r.position.y >= 32 ) {
+                tiles.remove(r);
+            } else {
+                kept.push_back(r);
+            }
+        }
+
+        REQUIRE(kept.size() == 12);
+        REQUIRE(tiles.insert(32, 32, &rect));
+        kept.push_back(rect);
+        REQUIRE(no_overlaps(kept, 0));
+        REQUIRE(tiles.occupancy() == Approx(1.0f));
+    }
+}
+
+TEST_CASE("Packers don't fragment when rectangles are repeatedly removed", "[rect_packer]")
+{
+    for ( auto heuristic : all_heuristics ) {
+        INFO("heuristic: " << static_cast<int>(heuristic));
+
+        std::mt19937 rng(7);
+        std::uniform_int_distribution<uint32_t> dist(2, 20);
+
+        sky::RectanglePacker packer(128, 128, heuristic, 1);
+        std::vector<sky::UIntRect> rects;
+        sky::UIntRect rect;
+
+        for ( int round = 0; round < 20; ++round ) {
+            INFO("round " << round);
+
+            while ( packer.insert(dist(rng), dist(rng), &rect) ) {
+                rects.push_back(rect);
+            }
+
+            REQUIRE(no_overlaps(rects, 1));
+            REQUIRE(in_bounds(rects, packer));
+            REQUIRE(packer.occupancy() > 0.5f);
+
+            // Evict a random half of the rectangles
+            std::shuffle(rects.begin(), rects.end(), rng);
+            for ( size_t i = rects.size() / 2; i < rects.size(); ++i ) {
+                packer.remove(rects[i]);
+            }
+            rects.resize(rects.size() / 2);
+        }
+
+        for ( auto& r : rects ) {
+            packer.remove(r);
+        }
+
+        REQUIRE(packer.used_area() == 0);
+        REQUIRE(packer.insert(127, 127, &rect));
+    }
+}
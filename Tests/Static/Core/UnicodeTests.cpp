@@ -0,0 +1,94 @@
+//
+//  UnicodeTests.cpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#include <Skyrocket/Core/Unicode.hpp>
+
+#include "catch/catch.hpp"
+
+#include <cstring>
+#include <vector>
+
+static std::vector<uint32_t> decode_all(const char* str, const size_t size)
+{
+    std::vector<uint32_t> codepoints;
+    size_t offset = 0;
+    while ( offset < size ) {
+        codepoints.push_back(sky::unicode::utf8_decode(str, size, &offset));
+    }
+    return codepoints;
+}
+
+TEST_CASE("UTF-8 sequences of every length are decoded", "[unicode]")
+{
+    // A, e-acute, euro sign, and a musical G clef from outside the basic multilingual plane
+    const char str[] = "A\xC3\xA9\xE2\x82\xAC\xF0\x9D\x84\x9E";
+    auto codepoints = decode_all(str, strlen(str));
+
+    REQUIRE(codepoints.size() == 4);
+    REQUIRE(codepoints[0] == 'A');
+    REQUIRE(codepoints[1] == 0xE9);
+    REQUIRE(codepoints[2] == 0x20AC);
+    REQUIRE(codepoints[3] == 0x1D11E);
+    REQUIRE(sky::unicode::utf8_length(str, strlen(str)) == 4);
+}
+
+TEST_CASE("Encoded codepoints decode to the same value", "[unicode]")
+{
+    const uint32_t codepoints[] = { 0, 0x7F, 0x80, 0x7FF, 0x800, 0xFFFF, 0x10000, 0x10FFFF };
+
+    for ( auto codepoint : codepoints ) {
+        INFO("Codepoint: " << codepoint);
+
+        char buffer[4];
+        auto length = sky::unicode::utf8_encode(codepoint, buffer);
+        REQUIRE(length > 0);
+
+        size_t offset = 0;
+        REQUIRE(sky::unicode::utf8_decode(buffer, length, &offset) == codepoint);
+        REQUIRE(offset == length);
+    }
+
+    char buffer[4];
+    REQUIRE(sky::unicode::utf8_encode(0xD800, buffer) == 0);
+    REQUIRE(sky::unicode::utf8_encode(0x110000, buffer) == 0);
+}
+
+TEST_CASE("Malformed UTF-8 decodes to the replacement character", "[unicode]")
+{
+    const auto replacement = sky::unicode::replacement_character;
+
+    // Stray continuation byte
+    auto codepoints = decode_all("\x80" "A", 2);
+    REQUIRE(codepoints.size() == 2);
+    REQUIRE(codepoints[0] == replacement);
+    REQUIRE(codepoints[1] == 'A');
+
+    // Truncated sequence followed by ASCII doesn't swallow the ASCII
+    codepoints = decode_all("\xE2\x82" "A", 3);
+    REQUIRE(codepoints.size() == 2);
+    REQUIRE(codepoints[0] == replacement);
+    REQUIRE(codepoints[1] == 'A');
+
+    // Truncated at the end of the string
+    codepoints = decode_all("\xF0\x9D", 2);
+    REQUIRE(codepoints.size() == 1);
+    REQUIRE(codepoints[0] == replacement);
+
+    // Overlong encoding of '/'
+    codepoints = decode_all("\xC0\xAF", 2);
+    REQUIRE(codepoints.size() == 1);
+    REQUIRE(codepoints[0] == replacement);
+
+    // Encoded surrogate
+    codepoints = decode_all("\xED\xA0\x80", 3);
+    REQUIRE(codepoints.size() == 1);
+    REQUIRE(codepoints[0] == replacement);
+}
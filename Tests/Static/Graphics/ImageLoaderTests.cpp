@@ -0,0 +1,187 @@
+//
+//  ImageLoaderTests.cpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#include <Skyrocket/Graphics/ImageLoader.hpp>
+#include <Skyrocket/Platform/Jobs.hpp>
+
+#include "catch/catch.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t image_count = 16;
+constexpr uint32_t image_width = 5;
+constexpr uint32_t image_height = 3;
+
+/// Writes an uncompressed, top-left origin 24-bit TGA filled with a color derived from `seed`
+void write_tga(const std::string& file_name, const uint8_t seed)
+{
+    uint8_t header[18] = {};
+    header[2] = 2;
+    header[12] = image_width;
+    header[14] = image_height;
+    header[16] = 24;
+    header[17] = 0x20;
+
+    std::vector<uint8_t> pixels;
+    for ( uint32_t p = 0; p < image_width * image_height; ++p ) {
+        // TGA stores pixels as BGR
+        pixels.push_back(static_cast<uint8_t>(seed + 2));
+        pixels.push_back(static_cast<uint8_t>(seed + 1));
+        pixels.push_back(static_cast<uint8_t>(seed + p));
+    }
+
+    auto file = fopen(file_name.c_str(), "wb");
+    fwrite(header, 1, sizeof(header), file);
+    fwrite(pixels.data(), 1, pixels.size(), file);
+    fclose(file);
+}
+
+std::string image_file_name(const uint32_t index)
+{
+    return "image_loader_test_" + std::to_string(index) + ".tga";
+}
+
+struct LoadCounter {
+    std::atomic<uint32_t> calls{0};
+    std::atomic<uint32_t> failures{0};
+};
+
+void count_loaded(const uint32_t /*index*/, sky::Image* /*image*/, const bool success,
+                  void* user_data)
+{
+    auto counter = static_cast<LoadCounter*>(user_data);
+    counter->calls.fetch_add(1);
+    if ( !success ) {
+        counter->failures.fetch_add(1);
+    }
+}
+
+}
+
+TEST_CASE("Batches of images are decoded on the job workers", "[image_loader]")
+{
+    sky::jobs::startup(0);
+
+    std::vector<sky::Path> paths;
+    for ( uint32_t i = 0; i < image_count; ++i ) {
+        write_tga(image_file_name(i), static_cast<uint8_t>(i * 10));
+        paths.emplace_back(image_file_name(i).c_str());
+    }
+
+    SECTION("images keep their channel layout by default")
+    {
+        std::vector<sky::Image> images(image_count);
+        REQUIRE(sky::load_images(paths.data(), image_count, images.data()) == image_count);
+
+        for ( uint32_t i = 0; i < image_count; ++i ) {
+            INFO("image " << i);
+            REQUIRE(images[i].width == image_width);
+            REQUIRE(images[i].height == image_height);
+            REQUIRE(images[i].pixel_format == sky::PixelFormat::Enum::rgb8);
+            REQUIRE(images[i].data[0] == i * 10);
+            REQUIRE(images[i].data[1] == i * 10 + 1);
+            REQUIRE(images[i].data[2] == i * 10 + 2);
+        }
+    }
+
+    SECTION("images are converted to the requested format")
+    {
+        const sky::PixelFormat::Enum formats[] = {
+            sky::PixelFormat::Enum::rgba8,
+            sky::PixelFormat::Enum::bgra8
+        };
+
+        for ( auto format : formats ) {
+            INFO("format " << format);
+
+            sky::ImageLoadOptions options;
+            options.format = format;
+
+            std::vector<sky::Image> images(image_count);
+            REQUIRE(sky::load_images(paths.data(), image_count, images.data(), options)
+                    == image_count);
+
+            auto r = format == sky::PixelFormat::Enum::rgba8 ? 0 : 2;
+            for ( uint32_t i = 0; i < image_count; ++i ) {
+                INFO("image " << i);
+                REQUIRE(images[i].pixel_format == format);
+
+                // Pixel 4 in the first row, whose red channel is seed + 4
+                auto pixel = images[i].data + 4 * 4;
+                REQUIRE(pixel[r] == i * 10 + 4);
+                REQUIRE(pixel[1] == i * 10 + 1);
+                REQUIRE(pixel[2 - r] == i * 10 + 2);
+                REQUIRE(pixel[3] == 255);
+            }
+        }
+    }
+
+    SECTION("mipmaps are generated when requested")
+    {
+        sky::ImageLoadOptions options;
+        options.format = sky::PixelFormat::Enum::rgba8;
+        options.generate_mipmaps = true;
+
+        std::vector<sky::Image> images(image_count);
+        REQUIRE(sky::load_images(paths.data(), image_count, images.data(), options)
+                == image_count);
+
+        for ( auto& image : images ) {
+            REQUIRE(image.mip_levels == sky::mip_level_count(image_width, image_height));
+        }
+    }
+
+    SECTION("every image reports back once, including ones that fail to load")
+    {
+        paths[3] = sky::Path("missing_image_loader_test.tga");
+
+        LoadCounter counter;
+        std::vector<sky::Image> images(image_count);
+        auto loaded = sky::load_images(paths.data(), image_count, images.data(),
+                                       sky::ImageLoadOptions{}, count_loaded, &counter);
+
+        REQUIRE(loaded == image_count - 1);
+        REQUIRE(counter.calls == image_count);
+        REQUIRE(counter.failures == 1);
+        REQUIRE(images[3].data == nullptr);
+    }
+
+    for ( uint32_t i = 0; i < image_count; ++i ) {
+        remove(image_file_name(i).c_str());
+    }
+
+    sky::jobs::shutdown();
+}
+
+TEST_CASE("Images can be reloaded into the same image", "[image_loader]")
+{
+    write_tga(image_file_name(0), 40);
+
+    sky::Image image;
+    REQUIRE(image.load_from_file(sky::Path(image_file_name(0).c_str())));
+    REQUIRE(image.generate_mipmaps());
+
+    REQUIRE(image.load_from_file(sky::Path(image_file_name(0).c_str()),
+                                 sky::PixelFormat::Enum::r8));
+    REQUIRE(image.pixel_format == sky::PixelFormat::Enum::r8);
+    REQUIRE(image.mip_levels == 1);
+    REQUIRE(image.mip_data == nullptr);
+
+    REQUIRE_FALSE(image.load_from_file(sky::Path(image_file_name(0).c_str()),
+                                       sky::PixelFormat::Enum::bc1));
+
+    remove(image_file_name(0).c_str());
+}
@@ -0,0 +1,155 @@
+//
+//  MipmapTests.cpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#include <Skyrocket/Graphics/Mipmap.hpp>
+#include <Skyrocket/Platform/Jobs.hpp>
+
+#include "catch/catch.hpp"
+
+#include <vector>
+
+namespace {
+
+std::vector<uint8_t> make_noise(const size_t size)
+{
+    std::vector<uint8_t> pixels(size);
+    uint32_t state = 12345;
+    for ( auto& p : pixels ) {
+        state = state * 1664525u + 1013904223u;
+        p = static_cast<uint8_t>(state >> 24);
+    }
+    return pixels;
+}
+
+}
+
+TEST_CASE("Mip chain dimensions are calculated correctly", "[mipmap]")
+{
+    REQUIRE(sky::mip_level_count(1, 1) == 1);
+    REQUIRE(sky::mip_level_count(256, 256) == 9);
+    REQUIRE(sky::mip_level_count(300, 17) == 9);
+
+    REQUIRE(sky::mip_dimension(300, 3) == 37);
+    REQUIRE(sky::mip_dimension(17, 8) == 1);
+
+    // 4x2 + 2x1 + 1x1
+    REQUIRE(sky::mip_chain_size(4, 2, sky::PixelFormat::Enum::r8, 3) == 11);
+    REQUIRE(sky::mip_chain_size(4, 2, sky::PixelFormat::Enum::rgba8, 3) == 44);
+}
+
+TEST_CASE("Box filter averages 2x2 blocks", "[mipmap]")
+{
+    sky::MipOptions options;
+    options.filter = sky::MipFilter::box;
+
+    SECTION("single channel data is filtered linearly")
+    {
+        const uint8_t src[] = {
+            0, 255, 10, 20,
+            255, 0, 30, 40
+        };
+        uint8_t dest[2]{};
+
+        REQUIRE(sky::generate_mip_level(src, 4, 2, sky::PixelFormat::Enum::r8, options, dest));
+        REQUIRE(dest[0] == 128);
+        REQUIRE(dest[1] == 25);
+    }
+
+    SECTION("color channels are filtered in linear space and alpha isn't")
+    {
+        const uint8_t src[] = {
+            0, 0, 0, 0,         255, 255, 255, 255,
+            0, 0, 0, 0,         255, 255, 255, 255
+        };
+        uint8_t dest[4]{};
+
+        REQUIRE(sky::generate_mip_level(src, 2, 2, sky::PixelFormat::Enum::rgba8, options, dest));
+        REQUIRE(dest[0] == 188);
+        REQUIRE(dest[1] == 188);
+        REQUIRE(dest[2] == 188);
+        REQUIRE(dest[3] == 128);
+
+        options.srgb = false;
+        REQUIRE(sky::generate_mip_level(src, 2, 2, sky::PixelFormat::Enum::rgba8, options, dest));
+        REQUIRE(dest[0] == 128);
+    }
+
+    SECTION("vectorized rgba path matches a scalar reference")
+    {
+        options.srgb = false;
+
+        const uint32_t width = 67;
+        const uint32_t height = 9;
+        auto src = make_noise(width * height * 4);
+        std::vector<uint8_t> dest(33 * 4 * 4);
+
+        REQUIRE(sky::generate_mip_level(src.data(), width, height, sky::PixelFormat::Enum::rgba8,
+                                        options, dest.data()));
+
+        for ( uint32_t y = 0; y < 4; ++y ) {
+            for ( uint32_t x = 0; x < 33; ++x ) {
+                for ( uint32_t c = 0; c < 4; ++c ) {
+                    auto at = [&](uint32_t sx, uint32_t sy) {
+                        return static_cast<uint32_t>(src[(sy * width + sx) * 4 + c]);
+                    };
+                    auto expected = (at(x * 2, y * 2) + at(x * 2 + 1, y * 2)
+                        + at(x * 2, y * 2 + 1) + at(x * 2 + 1, y * 2 + 1) + 2) >> 2;
+                    REQUIRE(dest[(y * 33 + x) * 4 + c] == expected);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Kaiser filter preserves flat regions", "[mipmap]")
+{
+    sky::MipOptions options;
+    options.filter = sky::MipFilter::kaiser;
+
+    const uint32_t width = 32;
+    const uint32_t height = 16;
+    std::vector<uint8_t> src(width * height * 4, 200);
+    std::vector<uint8_t> dest(16 * 8 * 4);
+
+    REQUIRE(sky::generate_mip_level(src.data(), width, height, sky::PixelFormat::Enum::rgba8,
+                                    options, dest.data()));
+
+    for ( auto value : dest ) {
+        REQUIRE(value == 200);
+    }
+}
+
+TEST_CASE("Mip chains are generated down to 1x1", "[mipmap]")
+{
+    sky::jobs::startup(0);
+
+    const uint32_t width = 256;
+    const uint32_t height = 64;
+    const auto levels = sky::mip_level_count(width, height);
+    const auto format = sky::PixelFormat::Enum::rgb8;
+
+    std::vector<uint8_t> chain(sky::mip_chain_size(width, height, format, levels));
+    std::fill(chain.begin(), chain.begin() + width * height * 3, 90);
+
+    sky::MipOptions options;
+    REQUIRE(sky::generate_mip_chain(chain.data(), width, height, format, levels, options));
+
+    auto last = chain.end() - 3;
+    REQUIRE(last[0] == 90);
+    REQUIRE(last[1] == 90);
+    REQUIRE(last[2] == 90);
+
+    REQUIRE_FALSE(sky::generate_mip_level(chain.data(), width, height,
+                                          sky::PixelFormat::Enum::rgba32, options,
+                                          chain.data()));
+
+    sky::jobs::shutdown();
+}
@@ -0,0 +1,189 @@
+//
+//  PixelConversionTests.cpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#include <Skyrocket/Graphics/PixelConversion.hpp>
+
+#include "catch/catch.hpp"
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+std::vector<uint8_t> make_noise(const size_t size)
+{
+    std::vector<uint8_t> pixels(size);
+    uint32_t state = 98765;
+    for ( auto& p : pixels ) {
+        state = state * 1664525u + 1013904223u;
+        p = static_cast<uint8_t>(state >> 24);
+    }
+    return pixels;
+}
+
+// Pixel counts covering empty input, partial SIMD blocks and several full ones with a remainder
+const size_t pixel_counts[] = { 0, 1, 3, 4, 7, 8, 15, 16, 17, 33, 100 };
+
+}
+
+TEST_CASE("Pixels are expanded to four channels", "[pixel_conversion]")
+{
+    for ( auto count : pixel_counts ) {
+        INFO("count " << count);
+
+        SECTION("rgb8 to rgba8 and bgra8")
+        {
+            auto src = make_noise(count * 3);
+            std::vector<uint8_t> rgba(count * 4);
+            std::vector<uint8_t> bgra(count * 4);
+
+            REQUIRE(sky::convert_pixels(src.data(), sky::PixelFormat::Enum::rgb8, rgba.data(),
+                                        sky::PixelFormat::Enum::rgba8, count));
+            REQUIRE(sky::convert_pixels(src.data(), sky::PixelFormat::Enum::rgb8, bgra.data(),
+                                        sky::PixelFormat::Enum::bgra8, count));
+
+            for ( size_t i = 0; i < count; ++i ) {
+                INFO("pixel " << i);
+                REQUIRE(rgba[i * 4] == src[i * 3]);
+                REQUIRE(rgba[i * 4 + 1] == src[i * 3 + 1]);
+                REQUIRE(rgba[i * 4 + 2] == src[i * 3 + 2]);
+                REQUIRE(rgba[i * 4 + 3] == 255);
+
+                REQUIRE(bgra[i * 4] == src[i * 3 + 2]);
+                REQUIRE(bgra[i * 4 + 1] == src[i * 3 + 1]);
+                REQUIRE(bgra[i * 4 + 2] == src[i * 3]);
+                REQUIRE(bgra[i * 4 + 3] == 255);
+            }
+        }
+
+        SECTION("r8 to rgba8")
+        {
+            auto src = make_noise(count);
+            std::vector<uint8_t> rgba(count * 4);
+
+            REQUIRE(sky::convert_pixels(src.data(), sky::PixelFormat::Enum::r8, rgba.data(),
+                                        sky::PixelFormat::Enum::rgba8, count));
+
+            for ( size_t i = 0; i < count; ++i ) {
+                INFO("pixel " << i);
+                REQUIRE(rgba[i * 4] == src[i]);
+                REQUIRE(rgba[i * 4 + 1] == src[i]);
+                REQUIRE(rgba[i * 4 + 2] == src[i]);
+                REQUIRE(rgba[i * 4 + 3] == 255);
+            }
+        }
+    }
+}
+
+TEST_CASE("rgba8 and bgra8 can be swizzled in place", "[pixel_conversion]")
+{
+    for ( auto count : pixel_counts ) {
+        INFO("count " << count);
+
+        auto src = make_noise(count * 4);
+        auto pixels = src;
+
+        REQUIRE(sky::convert_pixels(pixels.data(), sky::PixelFormat::Enum::rgba8, pixels.data(),
+                                    sky::PixelFormat::Enum::bgra8, count));
+
+        for ( size_t i = 0; i < count; ++i ) {
+            INFO("pixel " << i);
+            REQUIRE(pixels[i * 4] == src[i * 4 + 2]);
+            REQUIRE(pixels[i * 4 + 1] == src[i * 4 + 1]);
+            REQUIRE(pixels[i * 4 + 2] == src[i * 4]);
+            REQUIRE(pixels[i * 4 + 3] == src[i * 4 + 3]);
+        }
+
+        REQUIRE(sky::convert_pixels(pixels.data(), sky::PixelFormat::Enum::bgra8, pixels.data(),
+                                    sky::PixelFormat::Enum::rgba8, count));
+        REQUIRE(pixels == src);
+    }
+}
+
+TEST_CASE("Unsupported pixel conversions are rejected", "[pixel_conversion]")
+{
+    uint8_t src[16] = {};
+    uint8_t dest[16] = {};
+
+    REQUIRE_FALSE(sky::pixel_conversion_supported(sky::PixelFormat::Enum::rgba8,
+                                                  sky::PixelFormat::Enum::rgb8));
+    REQUIRE_FALSE(sky::pixel_conversion_supported(sky::PixelFormat::Enum::bc1,
+                                                  sky::PixelFormat::Enum::bc1));
+    REQUIRE_FALSE(sky::convert_pixels(src, sky::PixelFormat::Enum::rg8, dest,
+                                      sky::PixelFormat::Enum::rgba8, 4));
+    REQUIRE(sky::convert_pixels(src, sky::PixelFormat::Enum::rg8, dest,
+                                sky::PixelFormat::Enum::rg8, 4));
+}
+
+TEST_CASE("Alpha is premultiplied into the color channels", "[pixel_conversion]")
+{
+    for ( auto count : pixel_counts ) {
+        INFO("count " << count);
+
+        auto src = make_noise(count * 4);
+        auto pixels = src;
+        sky::premultiply_alpha(pixels.data(), count);
+
+        for ( size_t i = 0; i < count * 4; ++i ) {
+            INFO("channel " << i);
+            auto alpha = src[i - i % 4 + 3];
+            auto expected = i % 4 == 3 ? alpha : std::lround(src[i] * alpha / 255.0);
+            REQUIRE(pixels[i] == expected);
+        }
+    }
+}
+
+TEST_CASE("sRGB colors round trip through linear space", "[pixel_conversion]")
+{
+    // Every 8-bit value in each channel, with alpha covering all values too
+    std::vector<uint8_t> src(256 * 4);
+    for ( size_t i = 0; i < 256; ++i ) {
+        src[i * 4] = static_cast<uint8_t>(i);
+        src[i * 4 + 1] = static_cast<uint8_t>(255 - i);
+        src[i * 4 + 2] = static_cast<uint8_t>(i * 7);
+        src[i * 4 + 3] = static_cast<uint8_t>(i);
+    }
+
+    std::vector<float> linear(src.size());
+    std::vector<uint8_t> encoded(src.size());
+
+    REQUIRE(sky::srgb_to_linear(src.data(), sky::PixelFormat::Enum::rgba8, linear.data(), 256));
+
+    REQUIRE(linear[0] == 0.0f);
+    REQUIRE(linear[4 * 255] == Approx(1.0f));
+    // sRGB 0.5 is roughly 0.214 in linear space while alpha is converted directly
+    REQUIRE(linear[4 * 128] == Approx(0.2158605f).epsilon(0.001));
+    REQUIRE(linear[4 * 128 + 3] == Approx(128 / 255.0f));
+
+    REQUIRE(sky::linear_to_srgb(linear.data(), sky::PixelFormat::Enum::rgba8, encoded.data(), 256));
+    REQUIRE(encoded == src);
+
+    SECTION("out of range values are clamped")
+    {
+        const float values[] = { -1.0f, 2.0f, 0.0f, 1.0f, 0.5f };
+        uint8_t result[5] = {};
+        REQUIRE(sky::linear_to_srgb(values, sky::PixelFormat::Enum::r8, result, 5));
+
+        REQUIRE(result[0] == 0);
+        REQUIRE(result[1] == 255);
+        REQUIRE(result[2] == 0);
+        REQUIRE(result[3] == 255);
+        REQUIRE(result[4] == 188);
+    }
+
+    SECTION("formats without 8-bit channels are rejected")
+    {
+        REQUIRE_FALSE(sky::srgb_to_linear(src.data(), sky::PixelFormat::Enum::rgba16,
+                                          linear.data(), 1));
+        REQUIRE_FALSE(sky::linear_to_srgb(linear.data(), sky::PixelFormat::Enum::bc1,
+                                          encoded.data(), 1));
+    }
+}
@@ -0,0 +1,168 @@
+//
+//  TextureCompressionTests.cpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#include <Skyrocket/Graphics/TextureCompression.hpp>
+
+#include "catch/catch.hpp"
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+/// Smooth gradients with a little noise, similar to photographic texture content
+std::vector<uint8_t> make_test_image(const uint32_t width, const uint32_t height)
+{
+    std::vector<uint8_t> pixels(width * height * 4);
+    uint32_t state = 9876;
+
+    for ( uint32_t y = 0; y < height; ++y ) {
+        for ( uint32_t x = 0; x < width; ++x ) {
+            state = state * 1664525u + 1013904223u;
+            auto noise = static_cast<int>(state >> 29) - 4;
+            auto px = &pixels[(y * width + x) * 4];
+            auto red = static_cast<int>(x * 255 / width) + noise;
+            px[0] = static_cast<uint8_t>(std::min(255, std::max(0, red)));
+            px[1] = static_cast<uint8_t>(y * 255 / height);
+            px[2] = static_cast<uint8_t>(128 + 100 * std::sin(x * 0.1f));
+            px[3] = static_cast<uint8_t>(255 - (x + y) * 255 / (width + height));
+        }
+    }
+
+    return pixels;
+}
+
+/// Root mean squared error over the given channels
+double rmse(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b, const uint32_t first,
+            const uint32_t last)
+{
+    double total = 0.0;
+    size_t count = 0;
+    for ( size_t i = 0; i < a.size(); i += 4 ) {
+        for ( uint32_t c = first; c < last; ++c ) {
+            auto diff = static_cast<double>(a[i + c]) - b[i + c];
+            total += diff * diff;
+            ++count;
+        }
+    }
+    return std::sqrt(total / count);
+}
+
+std::vector<uint8_t> round_trip(const std::vector<uint8_t>& src, const uint32_t width,
+                                const uint32_t height, const sky::PixelFormat::Enum format,
+                                const sky::CompressionQuality quality)
+{
+    std::vector<uint8_t> blocks(sky::PixelFormat::image_size(format, width, height));
+    std::vector<uint8_t> decoded(width * height * 4);
+
+    REQUIRE(sky::compress_image(src.data(), width, height, sky::PixelFormat::Enum::rgba8, format,
+                                quality, blocks.data()));
+    REQUIRE(sky::decompress_image(blocks.data(), width, height, format, decoded.data()));
+    return decoded;
+}
+
+}
+
+TEST_CASE("Compressed image sizes are rounded up to whole blocks", "[texture_compression]")
+{
+    REQUIRE(sky::PixelFormat::is_compressed(sky::PixelFormat::Enum::bc7));
+    REQUIRE_FALSE(sky::PixelFormat::is_compressed(sky::PixelFormat::Enum::rgba8));
+
+    REQUIRE(sky::PixelFormat::image_size(sky::PixelFormat::Enum::bc1, 4096, 4096) == 8388608);
+    REQUIRE(sky::PixelFormat::image_size(sky::PixelFormat::Enum::bc7, 5, 3) == 2 * 16);
+    REQUIRE(sky::PixelFormat::image_size(sky::PixelFormat::Enum::bc4, 1, 1) == 8);
+}
+
+TEST_CASE("Compressed images decode close to the source", "[texture_compression]")
+{
+    const uint32_t width = 64;
+    const uint32_t height = 36;
+    auto src = make_test_image(width, height);
+
+    SECTION("bc1")
+    {
+        // Alpha below 128 would be encoded as transparent black
+        for ( size_t i = 3; i < src.size(); i += 4 ) {
+            src[i] = 255;
+        }
+
+        auto decoded = round_trip(src, width, height, sky::PixelFormat::Enum::bc1,
+                                  sky::CompressionQuality::normal);
+        REQUIRE(rmse(src, decoded, 0, 3) < 6.0);
+    }
+
+    SECTION("bc3")
+    {
+        auto decoded = round_trip(src, width, height, sky::PixelFormat::Enum::bc3,
+                                  sky::CompressionQuality::normal);
+        REQUIRE(rmse(src, decoded, 0, 3) < 6.0);
+        REQUIRE(rmse(src, decoded, 3, 4) < 2.0);
+    }
+
+    SECTION("bc4 and bc5")
+    {
+        auto bc4 = round_trip(src, width, height, sky::PixelFormat::Enum::bc4,
+                              sky::CompressionQuality::normal);
+        REQUIRE(rmse(src, bc4, 0, 1) < 3.0);
+
+        auto bc5 = round_trip(src, width, height, sky::PixelFormat::Enum::bc5,
+                              sky::CompressionQuality::normal);
+        REQUIRE(rmse(src, bc5, 0, 2) < 3.0);
+    }
+
+    SECTION("bc7")
+    {
+        auto decoded = round_trip(src, width, height, sky::PixelFormat::Enum::bc7,
+                                  sky::CompressionQuality::normal);
+        REQUIRE(rmse(src, decoded, 0, 4) < 5.0);
+    }
+
+    SECTION("higher quality presets don't increase error")
+    {
+        for ( auto format : { sky::PixelFormat::Enum::bc1, sky::PixelFormat::Enum::bc7 } ) {
+            auto fast = round_trip(src, width, height, format, sky::CompressionQuality::fast);
+            auto high = round_trip(src, width, height, format, sky::CompressionQuality::high);
+            REQUIRE(rmse(src, high, 0, 3) <= rmse(src, fast, 0, 3));
+        }
+    }
+}
+
+TEST_CASE("Solid blocks are encoded accurately", "[texture_compression]")
+{
+    const uint8_t color[] = { 13, 200, 77, 190 };
+    std::vector<uint8_t> src(8 * 8 * 4);
+    for ( size_t i = 0; i < src.size(); ++i ) {
+        src[i] = color[i % 4];
+    }
+
+    // Mode 6 endpoints share a low bit across channels so mixed parity colors can be off by one
+    auto bc7 = round_trip(src, 8, 8, sky::PixelFormat::Enum::bc7, sky::CompressionQuality::fast);
+    for ( size_t i = 0; i < src.size(); ++i ) {
+        REQUIRE(std::abs(bc7[i] - src[i]) <= 1);
+    }
+
+    auto bc4 = round_trip(src, 8, 8, sky::PixelFormat::Enum::bc4, sky::CompressionQuality::fast);
+    REQUIRE(bc4[0] == color[0]);
+}
+
+TEST_CASE("BC1 encodes transparent pixels", "[texture_compression]")
+{
+    std::vector<uint8_t> src(4 * 4 * 4, 255);
+    src[3] = 0;
+    src[7] = 0;
+
+    auto decoded = round_trip(src, 4, 4, sky::PixelFormat::Enum::bc1,
+                              sky::CompressionQuality::high);
+    REQUIRE(decoded[3] == 0);
+    REQUIRE(decoded[7] == 0);
+    REQUIRE(decoded[11] == 255);
+    REQUIRE(decoded[8] == 255);
+}
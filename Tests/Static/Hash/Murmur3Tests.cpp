@@ -47,6 +47,15 @@ TEST_CASE("test_murmur3_x86_32", "[murmur3]")
         test_string("abcd", 0x9747b28c, 0xF0478627);
     } //one full chunk
 
+    SECTION("test partial chunks")
+    {
+        test_string("a", 0x9747b28c, 0x7FA09EA6);
+        test_string("aa", 0x9747b28c, 0x5D211726);
+        test_string("aaa", 0x9747b28c, 0x283E0130);
+        test_string("abc", 0x9747b28c, 0xC84A62DD);
+        test_string("Hello, world!", 0x9747b28c, 0x24884CBA);
+    }
+
     SECTION("test utf-8 characters")
     {
         //U+03C0: Greek Small Letter Pi
@@ -0,0 +1,205 @@
+//
+//  XXH3Tests.cpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#include <Skyrocket/Core/Hash.hpp>
+
+#include "catch/catch.hpp"
+
+#include <cstring>
+#include <vector>
+
+namespace {
+
+struct Expected {
+    size_t len;
+    uint64_t seed;
+    uint64_t hash64;
+    uint64_t low;
+    uint64_t high;
+};
+
+/// Generated with the reference xxHash implementation, covering every length class and both the
+/// default and a seeded secret
+const Expected expected[] = {
+    { 0, 0x0ULL, 0x2D06800538D394C2ULL,
+      0x6001C324468D497FULL, 0x99AA06D3014798D8ULL },
+    { 1, 0x0ULL, 0xC44BDFF4074EECDBULL,
+      0xC44BDFF4074EECDBULL, 0xA6CD5E9392000F6AULL },
+    { 3, 0x0ULL, 0xA1C4A8259B827291ULL,
+      0xA1C4A8259B827291ULL, 0x95C705060A313BF8ULL },
+    { 4, 0x0ULL, 0xBB4E3D89EE0B271DULL,
+      0xFDE8D93AE8794D8EULL, 0xAFBF64F9281B8DE2ULL },
+    { 8, 0x0ULL, 0x79D02238B80E37B1ULL,
+      0x0234362AAF47B71AULL, 0x2761698C33953C43ULL },
+    { 9, 0x0ULL, 0xF64CECC4271FF461ULL,
+      0x895C8A562DA51412ULL, 0x0D39DB6431D37A74ULL },
+    { 16, 0x0ULL, 0x222E9AEAD6BDDD51ULL,
+      0xAAFFFCEC5DF2CB27ULL, 0x29BE75B0BBBB5284ULL },
+    { 17, 0x0ULL, 0x47AAD6B375EB4BBAULL,
+      0x878751509ECFDB8BULL, 0xDB7E8F77961E47FDULL },
+    { 32, 0x0ULL, 0x774140158F21FF0AULL,
+      0xDE94574D7A589440ULL, 0x3E97336E6CBB6EE0ULL },
+    { 33, 0x0ULL, 0x537E7ED26D825E92ULL,
+      0xE2928442749DBE83ULL, 0x3411CFE692C2E51EULL },
+    { 64, 0x0ULL, 0x70A70E66815E67E5ULL,
+      0x66FA129223BE93A5ULL, 0x4928933168865587ULL },
+    { 65, 0x0ULL, 0x4B4CE7050EEB9559ULL,
+      0xF5B4ADE8DE9A76A3ULL, 0xB6DFA5AAC5C63DC2ULL },
+    { 96, 0x0ULL, 0xA97F9AE93C0FF67AULL,
+      0xB9DE9A9696C420FCULL, 0xE83E939B9571947CULL },
+    { 97, 0x0ULL, 0x0DD88DB1BBAF7326ULL,
+      0x8EA932450271FDE4ULL, 0xDD6AD8D4FB1433A9ULL },
+    { 128, 0x0ULL, 0x421A9C905C6E66BAULL,
+      0xBBE087D879EDCC78ULL, 0xBA44FD018231AF4CULL },
+    { 129, 0x0ULL, 0x9E2414800F83768AULL,
+      0xB8075934107218E5ULL, 0x522C922743FD67F1ULL },
+    { 200, 0x0ULL, 0x20A87DB907CE74E4ULL,
+      0x293B2BB62EE3D385ULL, 0xFC856E6538FC9E49ULL },
+    { 240, 0x0ULL, 0xB714C5FD22744964ULL,
+      0x407883EA5EF95B9AULL, 0x4F49CCC8526AA7ADULL },
+    { 241, 0x0ULL, 0xBC424A2C480DD281ULL,
+      0xBC424A2C480DD281ULL, 0x50B62EE1EE6455A7ULL },
+    { 1024, 0x0ULL, 0x1FD15E7D36F5E1BCULL,
+      0x1FD15E7D36F5E1BCULL, 0x53BD178B75AB292EULL },
+    { 1025, 0x0ULL, 0xFE08E5A874D23FD2ULL,
+      0xFE08E5A874D23FD2ULL, 0xD1AD5F4A3CCE4374ULL },
+    { 2047, 0x0ULL, 0x00E9914A63660650ULL,
+      0x00E9914A63660650ULL, 0x02EE993D673C5657ULL },
+    { 4999, 0x0ULL, 0x1933F07D27F01F6EULL,
+      0x1933F07D27F01F6EULL, 0xFC080C6572EEA502ULL },
+    { 0, 0x9E3779B185EBCA8DULL, 0xA8A6B918B2F0364AULL,
+      0xA986DFC5D7605BFEULL, 0x00FEAA732A3CE25EULL },
+    { 1, 0x9E3779B185EBCA8DULL, 0x032BE332DD766EF8ULL,
+      0x032BE332DD766EF8ULL, 0x20E49ABCC53B3842ULL },
+    { 3, 0x9E3779B185EBCA8DULL, 0xA98592DB68BD3408ULL,
+      0xA98592DB68BD3408ULL, 0x28073D8A1A4CF4CFULL },
+    { 4, 0x9E3779B185EBCA8DULL, 0xF72C63BF41E6849CULL,
+      0x3FD2433E5D335AA8ULL, 0xB2B14D3FFE589847ULL },
+    { 8, 0x9E3779B185EBCA8DULL, 0x452FF06A9B57B746ULL,
+      0xD12629729C533E83ULL, 0x418ED55414499ABDULL },
+    { 9, 0x9E3779B185EBCA8DULL, 0x438304A991C0A62DULL,
+      0xA0C68A8E49302832ULL, 0xF9E9CF536DF80881ULL },
+    { 16, 0x9E3779B185EBCA8DULL, 0x737586751578FE8BULL,
+      0xC63A2F27831E012AULL, 0x0DCDD9BD78BF2527ULL },
+    { 17, 0x9E3779B185EBCA8DULL, 0x0890D4C8B8FDEB95ULL,
+      0x21715E74A0DD8EB3ULL, 0x62D026E9769F6901ULL },
+    { 32, 0x9E3779B185EBCA8DULL, 0x46E9DECB5CE100C0ULL,
+      0xEC6CCDC6E7E7D915ULL, 0x937C14E3F7786F61ULL },
+    { 33, 0x9E3779B185EBCA8DULL, 0xCD505D269C51EB9DULL,
+      0x33CD93D27C95C6D4ULL, 0x5C9A1239BC259D4AULL },
+    { 64, 0x9E3779B185EBCA8DULL, 0x2E2E2E2677490CD6ULL,
+      0x8C99935C22AA6335ULL, 0x3BB54FA27D3BA4AFULL },
+    { 65, 0x9E3779B185EBCA8DULL, 0xE33C22243840E6E5ULL,
+      0xA82082213842546BULL, 0x586348E4FF95433CULL },
+    { 96, 0x9E3779B185EBCA8DULL, 0x25EDC712D261A2DEULL,
+      0x75484B3D4CD167D8ULL, 0xD91C4213C41CB0E9ULL },
+    { 97, 0x9E3779B185EBCA8DULL, 0x53E270ADEE809A91ULL,
+      0x449C2AE8E90FA793ULL, 0x7D2D5D67D1449C50ULL },
+    { 128, 0x9E3779B185EBCA8DULL, 0xB996798C9DA01F8BULL,
+      0x9E2A9B55190C7DACULL, 0x5CDDE97387F40DEBULL },
+    { 129, 0x9E3779B185EBCA8DULL, 0x8E721C8F1EF25A4CULL,
+      0xFB23A666FB9002D2ULL, 0xC10999583A476B87ULL },
+    { 200, 0x9E3779B185EBCA8DULL, 0xEAFFBBA7D5724F94ULL,
+      0x284F7868A4646835ULL, 0xB630EE2FDBC8A7E1ULL },
+    { 240, 0x9E3779B185EBCA8DULL, 0x31693188DF3C6A2CULL,
+      0x7AB418A03ADB3B73ULL, 0x9D0D8A7645A42D46ULL },
+    { 241, 0x9E3779B185EBCA8DULL, 0xA8EB3585F433FBFFULL,
+      0xA8EB3585F433FBFFULL, 0xB2306BEEC524EC22ULL },
+    { 1024, 0x9E3779B185EBCA8DULL, 0x92EB2E32C50902BFULL,
+      0x92EB2E32C50902BFULL, 0x482B23954701A1B4ULL },
+    { 1025, 0x9E3779B185EBCA8DULL, 0x5E07F3F1E7A8D2A7ULL,
+      0x5E07F3F1E7A8D2A7ULL, 0xBE05ABE94D318702ULL },
+    { 2047, 0x9E3779B185EBCA8DULL, 0xBCB8B4B32FB0E8AFULL,
+      0xBCB8B4B32FB0E8AFULL, 0x9863DD8D23D0D696ULL },
+    { 4999, 0x9E3779B185EBCA8DULL, 0xE193FE6BEBD80CE8ULL,
+      0xE193FE6BEBD80CE8ULL, 0x9169B9FDC492848FULL },
+};
+
+std::vector<uint8_t> make_input()
+{
+    std::vector<uint8_t> input(5000);
+    for ( size_t i = 0; i < input.size(); ++i ) {
+        input[i] = static_cast<uint8_t>((i * 2654435761ULL) >> 13);
+    }
+    return input;
+}
+
+}
+
+static_assert(sky::hash::string_hash("Shaders/basic.vert") == 0xDAFB729C2EB11EA8ULL,
+              "String hashes are computed at compile time");
+
+TEST_CASE("XXH3 matches the reference implementation", "[xxh3]")
+{
+    auto input = make_input();
+
+    for ( const auto& e : expected ) {
+        INFO("length " << e.len << " seed " << e.seed);
+        REQUIRE(sky::hash::xxh3_64(input.data(), e.len, e.seed) == e.hash64);
+
+        auto hash = sky::hash::xxh3_128(input.data(), e.len, e.seed);
+        REQUIRE(hash.low == e.low);
+        REQUIRE(hash.high == e.high);
+    }
+}
+
+TEST_CASE("Compile time string hashes match runtime hashes", "[xxh3]")
+{
+    const char* long_string = "Resources/Shaders/Metal/basic_texture_vert.metal "
+        "Resources/Shaders/Metal/basic_texture_frag.metal "
+        "Resources/Shaders/Metal/sdf_text_vert.metal "
+        "Resources/Shaders/Metal/sdf_text_frag.metal "
+        "Resources/Shaders/Metal/debug_draw_vert.metal "
+        "Resources/Shaders/Metal/debug_draw_frag.metal";
+    auto long_len = strlen(long_string);
+    REQUIRE(long_len > 240);
+
+    REQUIRE(sky::hash::string_hash("") == sky::hash::xxh3_64("", 0));
+
+    for ( size_t len = 0; len <= long_len; ++len ) {
+        INFO("length " << len);
+        REQUIRE(sky::hash::string_hash(long_string, len)
+                    == sky::hash::xxh3_64(long_string, len));
+        REQUIRE(sky::hash::string_hash(long_string, len, 42)
+                    == sky::hash::xxh3_64(long_string, len, 42));
+    }
+}
+
+TEST_CASE("Streaming hashes match one-shot hashes", "[xxh3]")
+{
+    auto input = make_input();
+    const size_t chunk_sizes[] = { 1, 7, 63, 64, 65, 255, 256, 257, 1000, 5000 };
+    const size_t lengths[] = { 0, 5, 100, 240, 241, 256, 257, 320, 1024, 1025, 4999 };
+
+    for ( auto seed : { uint64_t(0), uint64_t(0x9E3779B185EBCA8DULL) } ) {
+        sky::hash::StreamingHasher hasher(seed);
+
+        for ( auto len : lengths ) {
+            for ( auto chunk : chunk_sizes ) {
+                INFO("length " << len << " chunk " << chunk << " seed " << seed);
+                hasher.reset(seed);
+                for ( size_t offset = 0; offset < len; offset += chunk ) {
+                    hasher.update(input.data() + offset, std::min(chunk, len - offset));
+                }
+
+                REQUIRE(hasher.digest64() == sky::hash::xxh3_64(input.data(), len, seed));
+                REQUIRE(hasher.digest128() == sky::hash::xxh3_128(input.data(), len, seed));
+            }
+        }
+
+        // Digesting doesn't stop the hasher from continuing
+        hasher.reset(seed);
+        hasher.update(input.data(), 1000);
+        REQUIRE(hasher.digest64() == sky::hash::xxh3_64(input.data(), 1000, seed));
+        hasher.update(input.data() + 1000, 3000);
+        REQUIRE(hasher.digest64() == sky::hash::xxh3_64(input.data(), 4000, seed));
+    }
+}
@@ -9,11 +9,17 @@
 //  Copyright (c) 2016 Jacob Milligan. All rights reserved.
 //
 
+#include <Skyrocket/Core/Memory/FrameAllocator.hpp>
 #include <Skyrocket/Core/Memory/StackAllocator.hpp>
 #include <Skyrocket/Core/Memory/PoolAllocator.hpp>
 
 #include "catch/catch.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
 TEST_CASE("Fixed stack allocated memory is aligned correctly", "[FixedStackAllocator]")
 {
     constexpr size_t alignment = 4;
@@ -121,3 +127,289 @@ TEST_CASE("Fixed pool freeing resets memory correctly", "[FixedPoolAllocator]")
     }
 }
 
+TEST_CASE("Fixed pool blocks are aligned correctly", "[FixedPoolAllocator]")
+{
+    sky::FixedPoolAllocator allocator(24, 100, 64);
+    REQUIRE(allocator.block_alignment() == 64);
+
+    for (int i = 0; i < 100; ++i) {
+        INFO("Block: " << i);
+        auto mem = allocator.allocate(24, 64);
+        REQUIRE(mem != nullptr);
+        REQUIRE(sky::is_aligned(mem, 64));
+    }
+
+    REQUIRE(allocator.allocate(24, 64) == nullptr);
+
+    // Blocks default to the largest power of two dividing their size
+    sky::FixedPoolAllocator natural(24, 10);
+    REQUIRE(natural.block_alignment() == 8);
+    REQUIRE(natural.allocate(24, 16) == nullptr);
+    REQUIRE(natural.allocate(32, 8) == nullptr);
+    REQUIRE(natural.allocate(24, 8) != nullptr);
+}
+
+TEST_CASE("Fixed pool zeroing is optional", "[FixedPoolAllocator]")
+{
+    sky::FixedPoolAllocator allocator(sizeof(double), 1, 0, false);
+
+    auto mem = static_cast<double*>(allocator.allocate(sizeof(double)));
+    *mem = 25;
+    allocator.free(mem);
+
+    mem = static_cast<double*>(allocator.allocate(sizeof(double)));
+    REQUIRE(*mem == 25.0);
+}
+
+TEST_CASE("Fixed pool allocation is thread-safe", "[FixedPoolAllocator]")
+{
+    constexpr uint32_t thread_count = 8;
+    constexpr uint32_t max_blocks = 256;
+    constexpr int iterations = 20000;
+
+    sky::FixedPoolAllocator allocator(sizeof(uint64_t), max_blocks);
+    std::atomic<bool> corrupted(false);
+    std::atomic<int> allocations(0);
+
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&, t]() {
+            // Every thread stamps its blocks and checks nobody else was handed the same one
+            std::vector<uint64_t*> held;
+            for (int i = 0; i < iterations; ++i) {
+                if (held.size() < 16 && (i % 3) != 2) {
+                    auto mem = static_cast<uint64_t*>(allocator.allocate(sizeof(uint64_t)));
+                    if (mem == nullptr) {
+                        continue;
+                    }
+
+                    *mem = (static_cast<uint64_t>(t) << 32) | static_cast<uint32_t>(i);
+                    held.emplace_back(mem);
+                    ++allocations;
+                } else if (!held.empty()) {
+                    auto mem = held.back();
+                    held.pop_back();
+                    if ((*mem >> 32) != t) {
+                        corrupted = true;
+                    }
+                    allocator.free(mem);
+                }
+            }
+
+            for (auto mem : held) {
+                allocator.free(mem);
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(!corrupted);
+    REQUIRE(allocations > 0);
+    REQUIRE(allocator.blocks_initialized() == 0);
+
+    // Every block can still be allocated once, including those cached by the threads
+    std::vector<void*> blocks;
+    for (uint32_t i = 0; i < max_blocks; ++i) {
+        auto mem = allocator.allocate(sizeof(uint64_t));
+        REQUIRE(mem != nullptr);
+        blocks.push_back(mem);
+    }
+
+    REQUIRE(allocator.allocate(sizeof(uint64_t)) == nullptr);
+    std::sort(blocks.begin(), blocks.end());
+    REQUIRE(std::unique(blocks.begin(), blocks.end()) == blocks.end());
+}
+
+TEST_CASE("Fixed pool allocation only fails when every block is allocated", "[FixedPoolAllocator]")
+{
+    constexpr uint32_t thread_count = 8;
+    constexpr uint32_t blocks_per_thread = 16;
+    constexpr int iterations = 5000;
+
+    // There's exactly one block for everything the threads hold at once, so blocks cached in
+    // other threads' magazines must always be found
+    sky::FixedPoolAllocator allocator(sizeof(uint64_t), thread_count * blocks_per_thread);
+    std::atomic<int> failures(0);
+
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&]() {
+            void* held[blocks_per_thread];
+            for (int i = 0; i < iterations; ++i) {
+                uint32_t count = 0;
+                for (; count < blocks_per_thread; ++count) {
+                    held[count] = allocator.allocate(sizeof(uint64_t));
+                    if (held[count] == nullptr) {
+                        ++failures;
+                        break;
+                    }
+                }
+
+                for (uint32_t b = 0; b < count; ++b) {
+                    allocator.free(held[b]);
+                }
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(failures == 0);
+    REQUIRE(allocator.blocks_initialized() == 0);
+}
+
+TEST_CASE("Fixed stack allocation accounts for alignment padding", "[FixedStackAllocator]")
+{
+    sky::FixedStackAllocator allocator(64);
+
+    REQUIRE(allocator.allocate(1, 1) != nullptr);
+    REQUIRE(allocator.allocate(48, 16) != nullptr);
+    REQUIRE(allocator.cursor() == 64);
+
+    // Rewinding to the current cursor is allowed and does nothing
+    allocator.free_to_cursor(allocator.cursor());
+    REQUIRE(allocator.cursor() == 64);
+    REQUIRE(allocator.allocate(1, 1) == nullptr);
+}
+
+TEST_CASE("Frame allocations are aligned and bounded by the frame", "[FrameAllocator]")
+{
+    sky::FrameAllocator allocator(1024, 2);
+
+    auto a = allocator.allocate(3, 1);
+    auto b = allocator.allocate(sizeof(double), alignof(double));
+    auto c = allocator.allocate(16, 64);
+
+    REQUIRE(a != nullptr);
+    REQUIRE(sky::is_aligned(b, alignof(double)));
+    REQUIRE(sky::is_aligned(c, 64));
+    REQUIRE(allocator.allocate(1, 3) == nullptr);
+    REQUIRE(allocator.allocate(2048, 1) == nullptr);
+
+    auto ints = allocator.allocate_array<int>(10);
+    REQUIRE(sky::is_aligned(ints, alignof(int)));
+    REQUIRE(allocator.is_valid(ints));
+}
+
+TEST_CASE("Frame regions stay valid until they're reused", "[FrameAllocator]")
+{
+    constexpr uint32_t frame_count = 3;
+    sky::FrameAllocator allocator(1024, frame_count);
+
+    int* values[frame_count];
+    for (uint32_t f = 0; f < frame_count; ++f) {
+        values[f] = allocator.allocate_array<int>(1);
+        *values[f] = static_cast<int>(f);
+        allocator.begin_frame();
+    }
+
+    // Each frame had its own region so every value is intact
+    for (uint32_t f = 0; f < frame_count; ++f) {
+        INFO("Frame: " << f);
+        REQUIRE(*values[f] == static_cast<int>(f));
+    }
+
+    // The first region is reused once every frame has been cycled through
+    REQUIRE(allocator.frame() == frame_count);
+    REQUIRE(allocator.frame_size() == 0);
+    REQUIRE(allocator.allocate_array<int>(1) == values[0]);
+}
+
+TEST_CASE("Frame markers rewind allocations", "[FrameAllocator]")
+{
+    sky::FrameAllocator allocator(1024);
+    allocator.allocate(100, 1);
+
+    auto marker = allocator.marker();
+    void* first = nullptr;
+    {
+        sky::FrameScope scope(&allocator);
+        first = allocator.allocate(200, 1);
+        allocator.allocate_local(8, 8);
+        REQUIRE(allocator.frame_size() > 300);
+    }
+
+    REQUIRE(allocator.frame_size() == marker.offset);
+    REQUIRE(allocator.allocate(200, 1) == first);
+
+    // Markers from older frames are ignored
+    allocator.begin_frame();
+    allocator.allocate(10, 1);
+    allocator.rewind(marker);
+    REQUIRE(allocator.frame_size() == 10);
+}
+
+TEST_CASE("Frame allocators keep separate thread-local chunks", "[FrameAllocator]")
+{
+    sky::FrameAllocator a(sky::kibibytes(64));
+    sky::FrameAllocator b(sky::kibibytes(64));
+
+    // Switching between allocators reuses each one's chunk rather than carving a new one
+    for (int i = 0; i < 100; ++i) {
+        INFO("iteration " << i);
+        REQUIRE(a.allocate_local(16, 8) != nullptr);
+        REQUIRE(b.allocate_local(16, 8) != nullptr);
+    }
+
+    REQUIRE(a.frame_size() == sky::FrameAllocator::local_chunk_size);
+    REQUIRE(b.frame_size() == sky::FrameAllocator::local_chunk_size);
+
+    // Default constructed allocators have no regions to begin a frame in
+    sky::FrameAllocator empty;
+    empty.begin_frame();
+    REQUIRE(empty.frame() == 0);
+}
+
+TEST_CASE("Frame allocation is thread-safe", "[FrameAllocator]")
+{
+    constexpr uint32_t thread_count = 8;
+    constexpr uint32_t allocations = 2000;
+
+    sky::FrameAllocator allocator(sky::mebibytes(4), 2);
+
+    for (int frame = 0; frame < 3; ++frame) {
+        std::vector<std::vector<uint32_t*>> results(thread_count);
+        std::vector<std::thread> threads;
+
+        for (uint32_t t = 0; t < thread_count; ++t) {
+            threads.emplace_back([&, t]() {
+                for (uint32_t i = 0; i < allocations; ++i) {
+                    auto mem = static_cast<uint32_t*>(
+                        (i % 2 == 0) ? allocator.allocate_local(sizeof(uint32_t) * 4, 16)
+                                     : allocator.allocate(sizeof(uint32_t) * 4, 16));
+                    if (mem == nullptr) {
+                        continue;
+                    }
+
+                    for (uint32_t j = 0; j < 4; ++j) {
+                        mem[j] = t * allocations + i;
+                    }
+                    results[t].push_back(mem);
+                }
+            });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        // No two allocations overlapped
+        for (uint32_t t = 0; t < thread_count; ++t) {
+            INFO("Frame: " << frame << ", thread: " << t);
+            REQUIRE(results[t].size() == allocations);
+            for (uint32_t i = 0; i < allocations; ++i) {
+                REQUIRE(sky::is_aligned(results[t][i], 16));
+                for (uint32_t j = 0; j < 4; ++j) {
+                    REQUIRE(results[t][i][j] == t * allocations + i);
+                }
+            }
+        }
+
+        allocator.begin_frame();
+    }
+}
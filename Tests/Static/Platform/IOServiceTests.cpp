@@ -0,0 +1,168 @@
+//
+//  IOServiceTests.cpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#include <Skyrocket/Platform/IOService.hpp>
+#include <Skyrocket/Core/Memory/StackAllocator.hpp>
+
+#include "catch/catch.hpp"
+
+#include <atomic>
+#include <cstdio>
+
+namespace {
+
+constexpr const char* test_file_name = "io_service_test.txt";
+constexpr const char* test_file_contents = "Skyrocket asynchronous I/O test file contents";
+
+sky::Path make_test_file()
+{
+    auto file = fopen(test_file_name, "wb");
+    fwrite(test_file_contents, 1, strlen(test_file_contents), file);
+    fclose(file);
+    return sky::Path(test_file_name);
+}
+
+/// Hands out heap memory and counts the blocks still outstanding
+class CountingAllocator : public sky::Allocator {
+public:
+    using sky::Allocator::allocate;
+
+    uint32_t live{0};
+
+    void* allocate(const size_t byte_size, const size_t /*alignment*/) override
+    {
+        ++live;
+        return new uint8_t[byte_size];
+    }
+
+    void free(void* ptr) override
+    {
+        --live;
+        delete[] static_cast<uint8_t*>(ptr);
+    }
+
+    void reset() override {}
+
+    bool is_valid(void* ptr) const override
+    {
+        return ptr != nullptr;
+    }
+};
+
+}
+
+TEST_CASE("Files are read directly into caller memory", "[filesystem]")
+{
+    auto path = make_test_file();
+    auto len = strlen(test_file_contents);
+
+    REQUIRE(sky::fs::file_size(path) == len);
+    REQUIRE(sky::fs::slurp_file(path) == test_file_contents);
+
+    char buffer[16]{};
+    auto bytes_read = sky::fs::read_file(path, buffer, 5, 10);
+    REQUIRE(bytes_read == 5);
+    REQUIRE(strncmp(buffer, test_file_contents + 10, 5) == 0);
+
+    remove(test_file_name);
+}
+
+TEST_CASE("IOService completes reads asynchronously", "[io_service]")
+{
+    auto path = make_test_file();
+    auto len = strlen(test_file_contents);
+
+    sky::IOService io;
+    io.startup();
+
+    SECTION("waiting on a read returns its result")
+    {
+        char buffer[64]{};
+        auto id = io.read(path, buffer, len);
+        REQUIRE(id != sky::IOService::invalid_id);
+
+        sky::IOResult result;
+        REQUIRE(io.wait(id, &result) == sky::IOStatus::complete);
+        REQUIRE(result.bytes_read == len);
+        REQUIRE(result.data == buffer);
+        REQUIRE(strcmp(buffer, test_file_contents) == 0);
+
+        // The request is released after waiting
+        REQUIRE(io.status(id) == sky::IOStatus::none);
+    }
+
+    SECTION("reads into allocator memory")
+    {
+        sky::FixedStackAllocator allocator(sky::kibibytes(4));
+        auto id = io.read(path, &allocator, 16);
+
+        sky::IOResult result;
+        REQUIRE(io.wait(id, &result) == sky::IOStatus::complete);
+        REQUIRE(allocator.is_valid(result.data));
+        REQUIRE(sky::is_aligned(result.data, 16));
+        REQUIRE(strncmp(static_cast<char*>(result.data), test_file_contents, len) == 0);
+    }
+
+    SECTION("allocator memory is freed if the read can't be submitted")
+    {
+        CountingAllocator allocator;
+        io.shutdown();
+
+        REQUIRE(io.read(path, &allocator, 16) == sky::IOService::invalid_id);
+        REQUIRE(allocator.live == 0);
+    }
+
+    SECTION("waiting on a callback read reports it as released")
+    {
+        char buffer[64]{};
+        auto id = io.read(path, buffer, len, 0, [](const sky::IOResult& /*result*/) {});
+        REQUIRE(id != sky::IOService::invalid_id);
+
+        sky::IOResult result;
+        REQUIRE(io.wait(id, &result) == sky::IOStatus::released);
+        REQUIRE(result.id == id);
+        REQUIRE(result.status == sky::IOStatus::released);
+        REQUIRE(io.status(id) == sky::IOStatus::released);
+        REQUIRE(strcmp(buffer, test_file_contents) == 0);
+    }
+
+    SECTION("completion callbacks are invoked")
+    {
+        static std::atomic<uint32_t> completed{0};
+        completed = 0;
+
+        char buffers[8][64]{};
+        for ( auto& buffer : buffers ) {
+            io.read(path, buffer, len, 0, [](const sky::IOResult& result) {
+                if ( result.status == sky::IOStatus::complete ) {
+                    ++completed;
+                }
+            });
+        }
+
+        io.shutdown();
+        REQUIRE(completed == 8);
+
+        for ( auto& buffer : buffers ) {
+            REQUIRE(strcmp(buffer, test_file_contents) == 0);
+        }
+    }
+
+    SECTION("reading a missing file fails")
+    {
+        char buffer[64]{};
+        auto id = io.read(sky::Path("missing_io_service_test.txt"), buffer, len);
+        REQUIRE(io.wait(id) == sky::IOStatus::failed);
+    }
+
+    io.shutdown();
+    remove(test_file_name);
+}
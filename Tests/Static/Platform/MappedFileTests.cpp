@@ -0,0 +1,67 @@
+//
+//  MappedFileTests.cpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#include <Skyrocket/Platform/Filesystem.hpp>
+
+#include "catch/catch.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+TEST_CASE("Mapped files expose the file contents", "[mapped_file]")
+{
+    constexpr const char* file_name = "mapped_file_test.bin";
+    constexpr size_t file_size = 64 * 1024 + 13;
+
+    std::vector<uint8_t> contents(file_size);
+    for ( size_t i = 0; i < file_size; ++i ) {
+        contents[i] = static_cast<uint8_t>(i * 31);
+    }
+
+    auto file = fopen(file_name, "wb");
+    fwrite(contents.data(), 1, file_size, file);
+    fclose(file);
+
+    SECTION("mapping reads the same bytes as the file")
+    {
+        sky::MappedFile mapped(sky::Path(file_name), sky::MapAccess::sequential);
+        REQUIRE(mapped.is_open());
+        REQUIRE(mapped.size() == file_size);
+        REQUIRE(memcmp(mapped.data(), contents.data(), file_size) == 0);
+
+        // Hints on unaligned ranges must be safe
+        mapped.advise(sky::MapAccess::random, 4099, 100);
+        mapped.advise(sky::MapAccess::will_need);
+    }
+
+    SECTION("mappings can be moved and closed")
+    {
+        sky::MappedFile mapped(sky::Path(file_name), sky::MapAccess::normal);
+        auto data = mapped.data();
+
+        sky::MappedFile moved(std::move(mapped));
+        REQUIRE_FALSE(mapped.is_open());
+        REQUIRE(moved.data() == data);
+
+        moved.close();
+        REQUIRE_FALSE(moved.is_open());
+        REQUIRE(moved.size() == 0);
+    }
+
+    SECTION("missing files fail to map")
+    {
+        sky::MappedFile mapped;
+        REQUIRE_FALSE(mapped.open(sky::Path("missing_mapped_file_test.bin")));
+        REQUIRE_FALSE(mapped.is_open());
+    }
+
+    remove(file_name);
+}
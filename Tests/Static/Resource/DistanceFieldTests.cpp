@@ -0,0 +1,76 @@
+//
+//  DistanceFieldTests.cpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#include <Skyrocket/Resource/DistanceField.hpp>
+
+#include "catch/catch.hpp"
+
+#include <vector>
+
+TEST_CASE("Distance fields are signed around the shape's edge", "[distance_field]")
+{
+    constexpr uint32_t size = 16;
+    constexpr uint32_t spread = 4;
+
+    // A filled 8x8 square in the middle of the bitmap
+    uint8_t coverage[size * size] = {};
+    for ( uint32_t y = 4; y < 12; ++y ) {
+        for ( uint32_t x = 4; x < 12; ++x ) {
+            coverage[y * size + x] = 255;
+        }
+    }
+
+    auto field_size = sky::distance_field_size(size, spread);
+    REQUIRE(field_size == 24);
+
+    std::vector<uint8_t> field(field_size * field_size);
+    sky::generate_distance_field(coverage, size, size, size, spread, field.data());
+
+    auto at = [&](const uint32_t x, const uint32_t y) {
+        return field[(y + spread) * field_size + x + spread];
+    };
+
+    // Inside is above the 0.5 edge, outside below and the field saturates beyond the spread
+    REQUIRE(at(8, 8) == 255);
+    REQUIRE(at(4, 8) > 128);
+    REQUIRE(at(3, 8) < 128);
+    REQUIRE(field[0] == 0);
+
+    // Distances increase monotonically away from the edge
+    for ( uint32_t x = 0; x < 3; ++x ) {
+        REQUIRE(at(x, 8) <= at(x + 1, 8));
+    }
+
+    // The field is symmetric for a symmetric shape
+    for ( uint32_t y = 0; y < size; ++y ) {
+        for ( uint32_t x = 0; x < size; ++x ) {
+            REQUIRE(at(x, y) == at(size - 1 - x, y));
+            REQUIRE(at(x, y) == at(x, size - 1 - y));
+        }
+    }
+}
+
+TEST_CASE("Partial coverage moves the edge between texels", "[distance_field]")
+{
+    constexpr uint32_t spread = 2;
+
+    uint8_t half[4] = { 255, 128, 0, 0 };
+    uint8_t quarter[4] = { 255, 64, 0, 0 };
+
+    uint8_t half_field[8 * 5];
+    uint8_t quarter_field[8 * 5];
+    sky::generate_distance_field(half, 4, 1, 4, spread, half_field);
+    sky::generate_distance_field(quarter, 4, 1, 4, spread, quarter_field);
+
+    auto row = spread * 8 + spread;
+    REQUIRE(half_field[row + 1] == Approx(128).margin(1));
+    REQUIRE(quarter_field[row + 1] < half_field[row + 1]);
+}
@@ -0,0 +1,260 @@
+//
+//  GlyphCacheTests.cpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#include <Skyrocket/Resource/GlyphCache.hpp>
+
+#include "catch/catch.hpp"
+
+static sky::GlyphBitmap make_bitmap(const uint32_t size, const uint8_t* pixels)
+{
+    sky::GlyphBitmap bitmap;
+    bitmap.width = size;
+    bitmap.height = size;
+    bitmap.pitch = static_cast<int32_t>(size);
+    bitmap.pixels = pixels;
+    bitmap.advance.x = static_cast<int32_t>(size);
+    return bitmap;
+}
+
+TEST_CASE("Glyphs are cached by codepoint and pixel size", "[glyph_cache]")
+{
+    uint8_t pixels[16 * 16];
+    for ( int i = 0; i < 16 * 16; ++i ) {
+        pixels[i] = static_cast<uint8_t>(i);
+    }
+
+    sky::GlyphCache cache;
+    cache.reset(64, 64);
+
+    REQUIRE(cache.find('a', 16) == nullptr);
+
+    auto glyph = cache.insert('a', 16, make_bitmap(16, pixels));
+    REQUIRE(glyph != nullptr);
+    REQUIRE(glyph->width == 16);
+    REQUIRE(cache.placement(*glyph).bounds.width == 16);
+    REQUIRE(glyph->s2 - glyph->s == Approx(16.0f / 64.0f));
+
+    REQUIRE(cache.insert('a', 8, make_bitmap(8, pixels)) != nullptr);
+    REQUIRE(cache.size() == 2);
+
+    glyph = cache.find('a', 16);
+    REQUIRE(glyph != nullptr);
+    REQUIRE(cache.placement(*glyph).pixel_size == 16);
+    REQUIRE(glyph->advance_x == 16);
+
+    // The bitmap is copied into the atlas and reported as dirty
+    auto bounds = cache.placement(*glyph).bounds;
+    auto atlas_row = cache.atlas_data() + bounds.position.y * cache.atlas_width();
+    REQUIRE(memcmp(atlas_row + bounds.position.x, pixels, 16) == 0);
+
+    sky::UIntRect dirty;
+    REQUIRE(cache.flush_dirty_region(&dirty));
+    REQUIRE(dirty.width == 64);
+    REQUIRE(dirty.position.y <= bounds.position.y);
+    REQUIRE(dirty.bottom() >= bounds.bottom());
+    REQUIRE_FALSE(cache.flush_dirty_region(&dirty));
+}
+
+TEST_CASE("Bottom-up bitmaps are flipped into the atlas", "[glyph_cache]")
+{
+    const uint8_t pixels[] = { 1, 1, 2, 2 };
+
+    sky::GlyphBitmap bitmap;
+    bitmap.width = 2;
+    bitmap.height = 2;
+    bitmap.pitch = -2;
+    bitmap.pixels = pixels;
+
+    sky::GlyphCache cache;
+    cache.reset(16, 16);
+
+    auto glyph = cache.insert('b', 12, bitmap);
+    REQUIRE(glyph != nullptr);
+
+    auto bounds = cache.placement(*glyph).bounds;
+    auto top = cache.atlas_data() + bounds.position.y * cache.atlas_width() + bounds.position.x;
+    REQUIRE(top[0] == 2);
+    REQUIRE(top[cache.atlas_width()] == 1);
+}
+
+TEST_CASE("Least recently used glyphs are evicted when the atlas is full", "[glyph_cache]")
+{
+    uint8_t pixels[15 * 15] = {};
+
+    // Four 15x15 glyphs plus padding fill a 32x32 atlas
+    sky::GlyphCache cache;
+    cache.reset(32, 32);
+
+    sky::UIntRect dirty;
+    for ( uint32_t c = 0; c < 4; ++c ) {
+        REQUIRE(cache.insert(c, 15, make_bitmap(15, pixels)) != nullptr);
+    }
+
+    // Nothing can be evicted until the glyphs in use have been flushed
+    REQUIRE(cache.insert(4, 15, make_bitmap(15, pixels)) == nullptr);
+    cache.flush_dirty_region(&dirty);
+
+    // Using glyph 0 again makes glyph 1 the least recently used
+    auto generation = cache.generation();
+    REQUIRE(cache.find(0, 15) != nullptr);
+    REQUIRE(cache.generation() == generation);
+    REQUIRE(cache.insert(4, 15, make_bitmap(15, pixels)) != nullptr);
+
+    // Evicting a glyph invalidates any text laid out with it
+    REQUIRE(cache.evictions() == 1);
+    REQUIRE(cache.generation() != generation);
+    REQUIRE(cache.find(1, 15) == nullptr);
+    REQUIRE(cache.find(0, 15) != nullptr);
+    REQUIRE(cache.find(4, 15) != nullptr);
+    REQUIRE(cache.size() == 4);
+
+    // Oversized glyphs never fit
+    uint8_t large[40 * 40] = {};
+    cache.flush_dirty_region(&dirty);
+    REQUIRE(cache.insert(5, 40, make_bitmap(40, large)) == nullptr);
+}
+
+TEST_CASE("Evicted glyphs are cleared from the atlas", "[glyph_cache]")
+{
+    uint8_t large[30 * 30];
+    memset(large, 255, sizeof(large));
+    uint8_t small[4 * 4];
+    memset(small, 100, sizeof(small));
+
+    sky::GlyphCache cache;
+    cache.reset(32, 32);
+
+    sky::UIntRect dirty;
+    REQUIRE(cache.insert('L', 30, make_bitmap(30, large)) != nullptr);
+    cache.flush_dirty_region(&dirty);
+
+    // The small glyph can only fit by evicting the large one and packing into its space
+    auto glyph = cache.insert('s', 4, make_bitmap(4, small));
+    REQUIRE(glyph != nullptr);
+    REQUIRE(cache.evictions() == 1);
+
+    auto bounds = cache.placement(*glyph).bounds;
+    auto width = cache.atlas_width();
+    auto atlas = cache.atlas_data();
+    REQUIRE(atlas[bounds.position.y * width + bounds.position.x] == 100);
+
+    // The padding texels sampled when filtering the glyph's edges are empty
+    for ( auto y = bounds.position.y; y <= bounds.bottom(); ++y ) {
+        REQUIRE(atlas[y * width + bounds.right()] == 0);
+    }
+    for ( auto x = bounds.position.x; x <= bounds.right(); ++x ) {
+        REQUIRE(atlas[bounds.bottom() * width + x] == 0);
+    }
+
+    // As is the rest of the evicted glyph, and the cleared rows are uploaded
+    for ( uint32_t y = 0; y < 31; ++y ) {
+        for ( uint32_t x = 0; x < 31; ++x ) {
+            auto inside = x >= bounds.position.x && x < bounds.right()
+                       && y >= bounds.position.y && y < bounds.bottom();
+            if ( !inside ) {
+                REQUIRE(atlas[y * width + x] == 0);
+            }
+        }
+    }
+
+    REQUIRE(cache.flush_dirty_region(&dirty));
+    REQUIRE(dirty.position.y == 0);
+    REQUIRE(dirty.bottom() >= 31);
+}
+
+TEST_CASE("Restored caches keep their glyphs and usage order", "[glyph_cache]")
+{
+    uint8_t pixels[8 * 8];
+    memset(pixels, 200, sizeof(pixels));
+
+    sky::GlyphCache cache;
+    cache.reset(32, 32);
+    for ( uint32_t c = 0; c < 6; ++c ) {
+        REQUIRE(cache.insert(c, 8, make_bitmap(8, pixels)) != nullptr);
+    }
+
+    std::vector<sky::Glyph> glyphs;
+    std::vector<sky::GlyphPlacement> placements;
+    cache.for_each_glyph([&](const sky::Glyph& glyph, const sky::GlyphPlacement& placement) {
+        glyphs.push_back(glyph);
+        placements.push_back(placement);
+    });
+    REQUIRE(glyphs.size() == 6);
+    REQUIRE(glyphs.front().codepoint == 0);
+
+    sky::GlyphCache restored;
+    REQUIRE(restored.restore(32, 32, cache.atlas_data(), glyphs.data(), placements.data(), 6));
+    REQUIRE(restored.size() == 6);
+    REQUIRE(memcmp(restored.atlas_data(), cache.atlas_data(), 32 * 32) == 0);
+    REQUIRE(restored.placement(*restored.find(3, 8)).bounds
+            == cache.placement(*cache.find(3, 8)).bounds);
+
+    // The whole atlas needs uploading
+    sky::UIntRect dirty;
+    REQUIRE(restored.flush_dirty_region(&dirty));
+    REQUIRE(dirty.height == 32);
+
+    // New glyphs avoid the restored ones and the least recently used glyph is evicted first
+    std::vector<sky::UIntRect> rects;
+    restored.for_each_glyph([&](const sky::Glyph& /*glyph*/, const sky::GlyphPlacement& placement) {
+        rects.push_back(placement.bounds);
+    });
+
+    auto glyph = restored.insert(100, 8, make_bitmap(8, pixels));
+    REQUIRE(glyph != nullptr);
+    for ( auto& rect : rects ) {
+        REQUIRE_FALSE(restored.placement(*glyph).bounds.intersects(rect));
+    }
+
+    restored.flush_dirty_region(&dirty);
+    for ( uint32_t c = 101; restored.evictions() == 0; ++c ) {
+        REQUIRE(restored.insert(c, 8, make_bitmap(8, pixels)) != nullptr);
+    }
+    REQUIRE(restored.find(0, 8) == nullptr);
+    REQUIRE(restored.find(1, 8) != nullptr);
+
+    sky::Glyph outside;
+    sky::GlyphPlacement outside_placement;
+    outside_placement.bounds = sky::UIntRect(30, 30, 8, 8);
+    REQUIRE_FALSE(restored.restore(32, 32, cache.atlas_data(), &outside, &outside_placement, 1));
+    REQUIRE(restored.size() == 0);
+}
+
+TEST_CASE("Evicting glyphs doesn't fragment the atlas", "[glyph_cache]")
+{
+    static const uint32_t sizes[] = { 3, 7, 12, 5, 20, 9, 15, 4 };
+    uint8_t pixels[40 * 40] = {};
+
+    sky::GlyphCache cache;
+    cache.reset(128, 128);
+
+    // Churn through many atlases worth of mixed size glyphs, flushing regularly so older glyphs
+    // can be evicted
+    sky::UIntRect dirty;
+    uint32_t codepoint = 0;
+    for ( uint32_t i = 0; i < 20000; ++i ) {
+        auto size = sizes[i % 8];
+        INFO("glyph " << i << ", size " << size);
+        REQUIRE(cache.insert(codepoint++, size, make_bitmap(size, pixels)) != nullptr);
+
+        if ( i % 16 == 0 ) {
+            cache.flush_dirty_region(&dirty);
+        }
+    }
+
+    REQUIRE(cache.evictions() > 1000);
+
+    // A glyph nearly as large as the atlas still fits once everything else can be evicted
+    cache.flush_dirty_region(&dirty);
+    uint8_t large[120 * 120] = {};
+    REQUIRE(cache.insert(codepoint, 120, make_bitmap(120, large)) != nullptr);
+    REQUIRE(cache.size() == 1);
+}
@@ -0,0 +1,269 @@
+//
+//  PackageTests.cpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#include <Skyrocket/Graphics/Image.hpp>
+#include <Skyrocket/Resource/Package.hpp>
+
+#include "catch/catch.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr const char* package_file = "package_test.skypak";
+
+/// Fills an image with malloc'd pixels the same way stb_image would
+void make_rgb_image(sky::Image* image, const uint32_t width, const uint32_t height)
+{
+    image->width = width;
+    image->height = height;
+    image->pixel_format = sky::PixelFormat::Enum::rgb8;
+    image->data = static_cast<uint8_t*>(malloc(width * height * 3));
+
+    for ( uint32_t i = 0; i < width * height * 3; ++i ) {
+        image->data[i] = static_cast<uint8_t>(i * 13);
+    }
+}
+
+}
+
+TEST_CASE("Assets can be found in a saved package", "[package]")
+{
+    const std::string shader = "void main() {}";
+    const uint8_t font[] = { 0, 1, 0, 0, 42 };
+
+    sky::Image image;
+    make_rgb_image(&image, 16, 8);
+    REQUIRE(image.generate_mipmaps());
+
+    sky::PackageWriter writer;
+    REQUIRE(writer.add("Shaders/basic.vert", sky::AssetType::shader, shader.data(),
+                       shader.size()));
+    REQUIRE(writer.add("Fonts/Go-Regular.ttf", sky::AssetType::font, font, sizeof(font)));
+    REQUIRE(writer.add_image("Images/cube.png", image));
+    REQUIRE(writer.add("empty", sky::AssetType::raw, nullptr, 0));
+    REQUIRE_FALSE(writer.add("empty", sky::AssetType::raw, font, sizeof(font)));
+    REQUIRE(writer.size() == 4);
+    REQUIRE(writer.save(sky::Path(package_file)));
+
+    sky::Package package{sky::Path(package_file)};
+    REQUIRE(package.is_open());
+    REQUIRE(package.size() == 4);
+
+    SECTION("raw assets are stored unchanged")
+    {
+        sky::PackageAsset asset;
+        REQUIRE(package.find("Shaders/basic.vert", &asset));
+        REQUIRE(asset.type == sky::AssetType::shader);
+        REQUIRE(std::string(reinterpret_cast<const char*>(asset.data), asset.size) == shader);
+        REQUIRE(reinterpret_cast<uintptr_t>(asset.data) % 16 == 0);
+
+        REQUIRE(package.find("Fonts/Go-Regular.ttf", &asset));
+        REQUIRE(asset.type == sky::AssetType::font);
+        REQUIRE(asset.size == sizeof(font));
+        REQUIRE(memcmp(asset.data, font, sizeof(font)) == 0);
+
+        REQUIRE(package.find("empty", &asset));
+        REQUIRE(asset.size == 0);
+    }
+
+    SECTION("images are expanded to an uploadable layout with their mips")
+    {
+        sky::PackageAsset asset;
+        REQUIRE(package.find("Images/cube.png", &asset));
+        REQUIRE(asset.type == sky::AssetType::image);
+        REQUIRE(reinterpret_cast<uintptr_t>(asset.data) % 64 == 0);
+        REQUIRE(asset.image.width == 16);
+        REQUIRE(asset.image.height == 8);
+        REQUIRE(asset.image.pixel_format == sky::PixelFormat::Enum::rgba8);
+        REQUIRE(asset.image.mip_levels == image.mip_levels);
+
+        for ( uint32_t level = 0; level < image.mip_levels; ++level ) {
+            INFO("level " << level);
+            auto src = image.level_data(level);
+            auto dest = asset.image_level(level);
+            auto count = image.level_width(level) * image.level_height(level);
+
+            REQUIRE(dest != nullptr);
+            for ( uint32_t p = 0; p < count; ++p ) {
+                REQUIRE(dest[p * 4] == src[p * 3]);
+                REQUIRE(dest[p * 4 + 1] == src[p * 3 + 1]);
+                REQUIRE(dest[p * 4 + 2] == src[p * 3 + 2]);
+                REQUIRE(dest[p * 4 + 3] == 255);
+            }
+        }
+
+        REQUIRE(asset.image_level(image.mip_levels) == nullptr);
+    }
+
+    SECTION("missing assets aren't found")
+    {
+        sky::PackageAsset asset;
+        REQUIRE_FALSE(package.find("Shaders/basic.frag", &asset));
+        REQUIRE_FALSE(package.contains("Shaders/basic"));
+        REQUIRE_FALSE(package.contains(""));
+        REQUIRE(package.contains("Shaders/basic.vert"));
+    }
+
+    package.close();
+    REQUIRE_FALSE(package.contains("Shaders/basic.vert"));
+
+    remove(package_file);
+}
+
+TEST_CASE("Compressed assets are decompressed when read", "[package]")
+{
+    std::string shader;
+    for ( int i = 0; i < 512; ++i ) {
+        shader += "uniform vec4 color_" + std::to_string(i % 8) + ";\n";
+    }
+
+    uint8_t noise[256];
+    uint32_t state = 0x9e3779b9;
+    for ( auto& byte : noise ) {
+        state = state * 1664525 + 1013904223;
+        byte = static_cast<uint8_t>(state >> 24);
+    }
+
+    sky::Image image;
+    make_rgb_image(&image, 64, 64);
+    REQUIRE(image.generate_mipmaps());
+
+    sky::PackageWriter writer;
+    REQUIRE(writer.add("Shaders/large.frag", sky::AssetType::shader, shader.data(),
+                       shader.size(), true));
+    REQUIRE(writer.add("noise", sky::AssetType::raw, noise, sizeof(noise), true));
+    REQUIRE(writer.add_image("Images/ramp.png", image, true));
+    REQUIRE(writer.save(sky::Path(package_file)));
+
+    sky::Package package{sky::Path(package_file)};
+    REQUIRE(package.is_open());
+
+    sky::PackageAsset asset;
+    REQUIRE(package.find("Shaders/large.frag", &asset));
+    REQUIRE(asset.compressed);
+    REQUIRE(asset.size < shader.size());
+    REQUIRE(asset.uncompressed_size == shader.size());
+
+    std::string read(asset.uncompressed_size, '\0');
+    REQUIRE(sky::Package::read(asset, &read[0]));
+    REQUIRE(read == shader);
+
+    // Incompressible data is stored as is
+    REQUIRE(package.find("noise", &asset));
+    REQUIRE_FALSE(asset.compressed);
+    REQUIRE(asset.size == sizeof(noise));
+
+    uint8_t noise_read[sizeof(noise)];
+    REQUIRE(sky::Package::read(asset, noise_read));
+    REQUIRE(memcmp(noise_read, noise, sizeof(noise)) == 0);
+
+    REQUIRE(package.find("Images/ramp.png", &asset));
+    REQUIRE(asset.compressed);
+    REQUIRE(asset.image_level(0) == nullptr);
+
+    std::vector<uint8_t> pixels(asset.uncompressed_size);
+    REQUIRE(sky::Package::read(asset, pixels.data()));
+    for ( uint32_t p = 0; p < 64 * 64; ++p ) {
+        REQUIRE(pixels[p * 4] == image.data[p * 3]);
+        REQUIRE(pixels[p * 4 + 3] == 255);
+    }
+
+    package.close();
+    remove(package_file);
+}
+
+TEST_CASE("Invalid packages fail to open", "[package]")
+{
+    const std::string contents = "definitely not a package, just some text that is long enough";
+    auto file = fopen(package_file, "wb");
+    fwrite(contents.data(), 1, contents.size(), file);
+    fclose(file);
+
+    sky::Package package;
+    REQUIRE_FALSE(package.open(sky::Path(package_file)));
+    REQUIRE_FALSE(package.is_open());
+
+    SECTION("truncated packages are rejected")
+    {
+        const uint8_t data[256] = {};
+        sky::PackageWriter writer;
+        REQUIRE(writer.add("data", sky::AssetType::raw, data, sizeof(data)));
+        REQUIRE(writer.save(sky::Path(package_file)));
+
+        sky::MappedFile mapped{sky::Path(package_file)};
+        std::vector<uint8_t> saved(mapped.begin(), mapped.end());
+        mapped.close();
+
+        file = fopen(package_file, "wb");
+        fwrite(saved.data(), 1, saved.size() - 16, file);
+        fclose(file);
+
+        REQUIRE_FALSE(package.open(sky::Path(package_file)));
+    }
+
+    SECTION("images with corrupt headers are rejected")
+    {
+        sky::Image image;
+        make_rgb_image(&image, 16, 16);
+
+        sky::PackageWriter writer;
+        REQUIRE(writer.add_image("image", image));
+        REQUIRE(writer.save(sky::Path(package_file)));
+
+        sky::MappedFile mapped{sky::Path(package_file)};
+        std::vector<uint8_t> saved(mapped.begin(), mapped.end());
+        mapped.close();
+
+        // The only entry follows the 40 byte header aligned to 16 bytes and ends with the image's
+        // width, height, pixel format and mip levels
+        uint32_t image_info[4];
+        auto image_info_offset = 48 + 48;
+        memcpy(image_info, saved.data() + image_info_offset, sizeof(image_info));
+        REQUIRE(image_info[0] == 16);
+        REQUIRE(image_info[3] == 1);
+
+        auto write_corrupted = [&](const uint32_t field, const uint32_t value) {
+            auto corrupted = saved;
+            memcpy(corrupted.data() + image_info_offset + field * sizeof(uint32_t), &value,
+                   sizeof(uint32_t));
+            file = fopen(package_file, "wb");
+            fwrite(corrupted.data(), 1, corrupted.size(), file);
+            fclose(file);
+        };
+
+        write_corrupted(0, 16);
+        REQUIRE(package.open(sky::Path(package_file)));
+
+        write_corrupted(2, sky::PixelFormat::Enum::unknown);
+        REQUIRE_FALSE(package.open(sky::Path(package_file)));
+
+        // Larger than the payload
+        write_corrupted(0, 4096);
+        REQUIRE_FALSE(package.open(sky::Path(package_file)));
+        write_corrupted(2, sky::PixelFormat::Enum::rgba32);
+        REQUIRE_FALSE(package.open(sky::Path(package_file)));
+        write_corrupted(3, 3);
+        REQUIRE_FALSE(package.open(sky::Path(package_file)));
+
+        // More mips than the image has
+        write_corrupted(3, 100);
+        REQUIRE_FALSE(package.open(sky::Path(package_file)));
+    }
+
+    REQUIRE_FALSE(package.open(sky::Path("missing_package_test.skypak")));
+
+    remove(package_file);
+}
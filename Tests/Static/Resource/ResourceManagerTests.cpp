@@ -0,0 +1,289 @@
+//
+//  ResourceManagerTests.cpp
+//  Skyrocket
+//
+//  --------------------------------------------------------------
+//
+//  Created by
+//  Jacob Milligan on 19/10/2026
+//  Copyright (c) 2016 Jacob Milligan. All rights reserved.
+//
+
+#include <Skyrocket/Platform/Jobs.hpp>
+#include <Skyrocket/Resource/ResourceManager.hpp>
+
+#include "catch/catch.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <string>
+
+namespace {
+
+/// Counts every call to a test loader's callbacks so tests can check for leaks and duplicates
+struct LoaderStats {
+    std::atomic<int> loads{0};
+    std::atomic<int> created{0};
+    int finalized{0};
+    int unloaded{0};
+    int discarded{0};
+    bool fail_finalize{false};
+};
+
+void* load_text(const sky::Path& path, void* user_data)
+{
+    auto stats = static_cast<LoaderStats*>(user_data);
+    ++stats->loads;
+
+    auto file = fopen(path.str(), "rb");
+    if ( file == nullptr ) {
+        return nullptr;
+    }
+
+    auto text = new std::string;
+    ++stats->created;
+    char buffer[64];
+    size_t read = 0;
+    while ( (read = fread(buffer, 1, sizeof(buffer), file)) > 0 ) {
+        text->append(buffer, read);
+    }
+
+    fclose(file);
+    return text;
+}
+
+bool finalize_text(void* /*data*/, void* user_data)
+{
+    auto stats = static_cast<LoaderStats*>(user_data);
+    ++stats->finalized;
+    return !stats->fail_finalize;
+}
+
+void unload_text(void* data, const bool finalized, void* user_data)
+{
+    auto stats = static_cast<LoaderStats*>(user_data);
+    ++(finalized ? stats->unloaded : stats->discarded);
+    delete static_cast<std::string*>(data);
+}
+
+void write_text(const char* file_name, const std::string& text)
+{
+    auto file = fopen(file_name, "wb");
+    fwrite(text.data(), 1, text.size(), file);
+    fclose(file);
+}
+
+}
+
+TEST_CASE("Resources are deduplicated and reference counted", "[resource_manager]")
+{
+    write_text("resource_a.txt", "resource a");
+    write_text("resource_b.txt", "resource b");
+
+    std::string placeholder = "placeholder";
+    LoaderStats stats;
+    sky::ResourceLoader loader;
+    loader.load = load_text;
+    loader.finalize = finalize_text;
+    loader.unload = unload_text;
+    loader.placeholder = &placeholder;
+    loader.user_data = &stats;
+
+    sky::ResourceManager resources(8);
+    auto text_type = resources.register_type(loader);
+    REQUIRE(text_type != sky::ResourceManager::invalid_type);
+
+    SECTION("loading the same path returns the same resource")
+    {
+        auto a = resources.load(text_type, sky::Path("resource_a.txt"));
+        auto a_again = resources.load(text_type, sky::Path("resource_a.txt"));
+        auto b = resources.load(text_type, sky::Path("resource_b.txt"));
+
+        REQUIRE(a != sky::ResourceManager::invalid_id);
+        REQUIRE(a == a_again);
+        REQUIRE(a != b);
+        REQUIRE(resources.size() == 2);
+
+        resources.wait_all();
+        REQUIRE(stats.loads == 2);
+        REQUIRE(stats.finalized == 2);
+        REQUIRE(resources.state(a) == sky::ResourceState::loaded);
+        REQUIRE(*resources.get<std::string>(a) == "resource a");
+        REQUIRE(*resources.get<std::string>(b) == "resource b");
+
+        resources.release(a);
+        REQUIRE(resources.state(a) == sky::ResourceState::loaded);
+        REQUIRE(stats.unloaded == 0);
+
+        resources.release(a);
+        REQUIRE(resources.state(a) == sky::ResourceState::none);
+        REQUIRE(resources.get(a) == nullptr);
+        REQUIRE(stats.unloaded == 1);
+        REQUIRE(resources.size() == 1);
+
+        // Reloading after unloading creates a new resource with a new id
+        auto a_reloaded = resources.load(text_type, sky::Path("resource_a.txt"));
+        REQUIRE(a_reloaded != a);
+        resources.wait_all();
+        REQUIRE(stats.loads == 3);
+
+        resources.release(a_reloaded);
+        resources.release(b);
+        REQUIRE(resources.size() == 0);
+        REQUIRE(stats.unloaded == 3);
+    }
+
+    SECTION("placeholders are returned until the resource has loaded")
+    {
+        auto a = resources.load(text_type, sky::Path("resource_a.txt"));
+        REQUIRE(resources.state(a) == sky::ResourceState::loading);
+        REQUIRE(resources.get(a) == &placeholder);
+
+        resources.wait_all();
+        REQUIRE(resources.get(a) != &placeholder);
+        resources.release(a);
+    }
+
+    SECTION("missing files fail and return the placeholder")
+    {
+        auto missing = resources.load(text_type, sky::Path("missing_resource.txt"));
+        resources.wait_all();
+
+        REQUIRE(resources.state(missing) == sky::ResourceState::failed);
+        REQUIRE(resources.get(missing) == &placeholder);
+        REQUIRE(stats.finalized == 0);
+
+        resources.release(missing);
+        REQUIRE(resources.size() == 0);
+    }
+
+    SECTION("loading a failed resource again retries the load")
+    {
+        stats.fail_finalize = true;
+        auto failed = resources.load(text_type, sky::Path("resource_a.txt"));
+        resources.wait_all();
+        REQUIRE(resources.state(failed) == sky::ResourceState::failed);
+
+        stats.fail_finalize = false;
+        auto retried = resources.load(text_type, sky::Path("resource_a.txt"));
+        REQUIRE(retried == failed);
+        REQUIRE(resources.state(retried) == sky::ResourceState::loading);
+        REQUIRE(resources.size() == 1);
+
+        resources.wait_all();
+        REQUIRE(stats.loads == 2);
+        REQUIRE(resources.state(retried) == sky::ResourceState::loaded);
+        REQUIRE(*resources.get<std::string>(retried) == "resource a");
+
+        // Both loads hold a reference
+        resources.release(failed);
+        REQUIRE(resources.state(retried) == sky::ResourceState::loaded);
+        resources.release(retried);
+        REQUIRE(resources.size() == 0);
+    }
+
+    SECTION("failed finalizes discard the loaded data")
+    {
+        stats.fail_finalize = true;
+        auto a = resources.load(text_type, sky::Path("resource_a.txt"));
+        resources.wait_all();
+
+        REQUIRE(resources.state(a) == sky::ResourceState::failed);
+        REQUIRE(stats.discarded == 1);
+        resources.release(a);
+    }
+
+    SECTION("resources released while loading are discarded once loaded")
+    {
+        auto a = resources.load(text_type, sky::Path("resource_a.txt"));
+        resources.release(a);
+        REQUIRE(resources.size() == 1);
+
+        resources.wait_all();
+        REQUIRE(resources.size() == 0);
+        REQUIRE(stats.finalized == 0);
+        REQUIRE(stats.discarded == 1);
+    }
+
+    SECTION("loads fail once the manager is full")
+    {
+        for ( uint32_t i = 0; i < resources.capacity(); ++i ) {
+            auto name = "resource_" + std::to_string(i) + ".txt";
+            REQUIRE(resources.load(text_type, sky::Path(name.c_str()))
+                        != sky::ResourceManager::invalid_id);
+        }
+
+        REQUIRE(resources.load(text_type, sky::Path("one_too_many.txt"))
+                    == sky::ResourceManager::invalid_id);
+
+        // Existing resources can still be referenced
+        REQUIRE(resources.load(text_type, sky::Path("resource_0.txt"))
+                    != sky::ResourceManager::invalid_id);
+    }
+
+    REQUIRE(resources.load(text_type + 1, sky::Path("resource_a.txt"))
+                == sky::ResourceManager::invalid_id);
+    REQUIRE(resources.get(sky::ResourceManager::invalid_id) == nullptr);
+
+    resources.clear();
+    REQUIRE(resources.size() == 0);
+    REQUIRE(stats.unloaded + stats.discarded == stats.created);
+
+    remove("resource_a.txt");
+    remove("resource_b.txt");
+}
+
+TEST_CASE("Resources load asynchronously on the job workers", "[resource_manager]")
+{
+    constexpr uint32_t file_count = 32;
+
+    for ( uint32_t i = 0; i < file_count; ++i ) {
+        auto name = "async_resource_" + std::to_string(i) + ".txt";
+        write_text(name.c_str(), std::to_string(i));
+    }
+
+    sky::jobs::startup(0);
+
+    LoaderStats stats;
+    sky::ResourceLoader loader;
+    loader.load = load_text;
+    loader.unload = unload_text;
+    loader.user_data = &stats;
+
+    {
+        sky::ResourceManager resources;
+        auto text_type = resources.register_type(loader);
+
+        uint32_t ids[file_count];
+        for ( uint32_t i = 0; i < file_count; ++i ) {
+            auto name = "async_resource_" + std::to_string(i) + ".txt";
+            ids[i] = resources.load(text_type, sky::Path(name.c_str()));
+        }
+
+        // Releasing half the resources before they finish loading
+        for ( uint32_t i = 0; i < file_count; i += 2 ) {
+            resources.release(ids[i]);
+        }
+
+        resources.wait_all();
+        REQUIRE(resources.size() == file_count / 2);
+
+        for ( uint32_t i = 1; i < file_count; i += 2 ) {
+            INFO("resource " << i);
+            REQUIRE(resources.state(ids[i]) == sky::ResourceState::loaded);
+            REQUIRE(*resources.get<std::string>(ids[i]) == std::to_string(i));
+        }
+    }
+
+    // Destroying the manager unloads everything still referenced
+    REQUIRE(stats.loads == static_cast<int>(file_count));
+    REQUIRE(stats.created == static_cast<int>(file_count));
+    REQUIRE(stats.unloaded + stats.discarded == stats.created);
+
+    sky::jobs::shutdown();
+
+    for ( uint32_t i = 0; i < file_count; ++i ) {
+        auto name = "async_resource_" + std::to_string(i) + ".txt";
+        remove(name.c_str());
+    }
+}